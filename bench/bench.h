@@ -0,0 +1,54 @@
+#ifndef COLIBRA_BENCH_H
+#define COLIBRA_BENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace colibra {
+namespace bench {
+
+/**
+ * @brief: Prevent the compiler from optimizing away a computed value.
+ */
+template<typename T>
+inline void do_not_optimize(const T &value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief: Run fn repeatedly and return the median duration of one call in
+ * nanoseconds.
+ *
+ * @param fn The function to measure.
+ * @param repetitions How often the measurement is repeated.
+ */
+template<class Fn>
+double median_ns(Fn &&fn, const size_t repetitions = 9)
+{
+    using clock = std::chrono::steady_clock;
+
+    // Warm up caches and branch predictors.
+    fn();
+
+    std::vector<double> samples;
+    samples.reserve(repetitions);
+    for (size_t r = 0; r < repetitions; ++r)
+    {
+        const auto start = clock::now();
+        fn();
+        const auto stop = clock::now();
+        samples.push_back(
+            std::chrono::duration<double, std::nano>(stop - start).count());
+    }
+    std::nth_element(
+        samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+    return samples[samples.size() / 2];
+}
+
+} // namespace bench
+} // namespace colibra
+
+#endif
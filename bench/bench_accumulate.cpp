@@ -0,0 +1,87 @@
+#include "bench.h"
+#include "colibra/accumulate.h"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace colibra;
+
+namespace {
+
+template<size_t l>
+void run(std::mt19937 &rng)
+{
+    // Many Vectors, so a single measurement is long enough to time reliably.
+    constexpr size_t count = (size_t {1} << 20) / l;
+
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<Vector<l, float>>         a(count);
+    std::vector<Vector<l, float>>         b(count);
+    for (size_t n = 0; n < count; ++n)
+    {
+        for (size_t i = 0; i < l; ++i)
+        {
+            a[n][i] = dist(rng);
+            b[n][i] = dist(rng);
+        }
+    }
+
+    std::vector<long double> reference(count);
+    for (size_t n = 0; n < count; ++n)
+    {
+        reference[n] = dot<long double>(a[n], b[n]);
+    }
+
+    auto report = [&](const char *name, auto &&fn) {
+        std::vector<double> results(count);
+        const double        ns = bench::median_ns([&] {
+            for (size_t n = 0; n < count; ++n)
+            {
+                results[n] = fn(a[n], b[n]);
+            }
+            bench::do_not_optimize(results.data());
+        });
+
+        double max_error = 0;
+        for (size_t n = 0; n < count; ++n)
+        {
+            max_error = std::max(
+                max_error,
+                static_cast<double>(std::abs(results[n] - reference[n])));
+        }
+        std::printf("%6zu %-18s %12.3f %14.3e\n",
+                    l,
+                    name,
+                    ns / (count * l),
+                    max_error);
+    };
+
+    report("operator*", [](const auto &x, const auto &y) { return x * y; });
+    report("float naive", [](const auto &x, const auto &y) {
+        return dot<float, summation::naive>(x, y);
+    });
+    report("float pairwise", [](const auto &x, const auto &y) {
+        return dot<float, summation::pairwise>(x, y);
+    });
+    report("float kahan", [](const auto &x, const auto &y) {
+        return dot<float, summation::kahan>(x, y);
+    });
+    report("double naive", [](const auto &x, const auto &y) {
+        return dot<double, summation::naive>(x, y);
+    });
+}
+
+} // namespace
+
+int main()
+{
+    std::mt19937 rng(1);
+    std::printf(
+        "%6s %-18s %12s %14s\n", "l", "mode", "ns/element", "max abs error");
+    run<16>(rng);
+    run<256>(rng);
+    run<4096>(rng);
+    return 0;
+}
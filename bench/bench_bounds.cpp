@@ -0,0 +1,140 @@
+#include "bench.h"
+#include "colibra/bounds.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace colibra;
+
+namespace {
+
+void report(const char *name, const double ns, const size_t n)
+{
+    std::printf("  %-36s %10.3f\n", name, ns / static_cast<double>(n));
+}
+
+Batch<3, float> random_points(const size_t n, std::mt19937 &rng)
+{
+    std::uniform_real_distribution<float> dist(-1, 1);
+    Batch<3, float>                       batch;
+    for (size_t i = 0; i < n; ++i)
+    {
+        batch.push_back(Vector {dist(rng), dist(rng), dist(rng)});
+    }
+    return batch;
+}
+
+/// The scalar member function per point, the loop the batch calls replace.
+template<class Fn>
+double scalar_ns(const size_t n, std::vector<uint8_t> &out, const Fn &fn)
+{
+    return bench::median_ns([&] {
+        for (size_t i = 0; i < n; ++i)
+        {
+            out[i] = fn(i);
+        }
+        bench::do_not_optimize(out.data());
+    });
+}
+
+} // namespace
+
+int main()
+{
+    std::mt19937 rng(17);
+    const size_t n = 1 << 20;
+
+    const Batch<3, float>               points = random_points(n, rng);
+    const std::vector<Vector<3, float>> aos    = [&] {
+        std::vector<Vector<3, float>> result(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            result[i] = points[i];
+        }
+        return result;
+    }();
+    std::vector<uint8_t> out(n);
+
+    const Aabb box {Vector {-0.5f, -0.25f, 0.0f}, Vector {0.5f, 0.75f, 0.5f}};
+    const Sphere sphere {Vector {0.1f, 0.2f, -0.1f}, 0.6f};
+    Obb<float>   obb;
+    obb.center       = Vector {0.1f, 0.0f, 0.0f};
+    obb.rotation     = Matrix<3, 3, float> {
+        0.6f, -0.8f, 0.0f, 0.8f, 0.6f, 0.0f, 0.0f, 0.0f, 1.0f};
+    obb.half_extents = Vector {0.5f, 0.3f, 0.2f};
+
+    std::printf("float, %zu points, ns per point\n", n);
+    report("aabb contains scalar",
+           scalar_ns(n, out, [&](size_t i) { return box.contains(aos[i]); }),
+           n);
+    report("aabb contains_many",
+           bench::median_ns([&] {
+               contains_many(box, points, out);
+               bench::do_not_optimize(out.data());
+           }),
+           n);
+    report("sphere contains scalar",
+           scalar_ns(n, out, [&](size_t i) { return sphere.contains(aos[i]); }),
+           n);
+    report("sphere contains_many",
+           bench::median_ns([&] {
+               contains_many(sphere, points, out);
+               bench::do_not_optimize(out.data());
+           }),
+           n);
+    report("obb contains scalar",
+           scalar_ns(n, out, [&](size_t i) { return obb.contains(aos[i]); }),
+           n);
+    report("obb contains_many",
+           bench::median_ns([&] {
+               contains_many(obb, points, out);
+               bench::do_not_optimize(out.data());
+           }),
+           n);
+
+    const Batch<3, float> directions = random_points(n, rng);
+    Batch<3, float>       upper;
+    for (size_t i = 0; i < n; ++i)
+    {
+        upper.push_back(points[i] + directions[i] * 0.1f);
+    }
+    report("aabb overlaps scalar",
+           scalar_ns(n,
+                     out,
+                     [&](size_t i) {
+                         return box.overlaps(Aabb {aos[i], upper[i]});
+                     }),
+           n);
+    report("aabb overlaps_many",
+           bench::median_ns([&] {
+               overlaps_many(box, points, upper, out);
+               bench::do_not_optimize(out.data());
+           }),
+           n);
+
+    std::vector<float> entry(n);
+    report("ray slab scalar",
+           bench::median_ns([&] {
+               for (size_t i = 0; i < n; ++i)
+               {
+                   entry[i] = Ray {aos[i], directions[i]}.intersect(box);
+               }
+               bench::do_not_optimize(entry.data());
+           }),
+           n);
+    report("ray slab intersect_many",
+           bench::median_ns([&] {
+               intersect_many(box, points, directions, entry);
+               bench::do_not_optimize(entry.data());
+           }),
+           n);
+    report("ray slab intersect_many par",
+           bench::median_ns([&] {
+               intersect_many(execution::par, box, points, directions, entry);
+               bench::do_not_optimize(entry.data());
+           }),
+           n);
+    return 0;
+}
@@ -0,0 +1,154 @@
+#include "bench.h"
+#include "colibra/bvh.h"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace colibra;
+
+namespace {
+
+using Vec3 = Vector<3, float>;
+
+void report(const char *name, const double ns, const size_t n)
+{
+    std::printf("  %-36s %12.1f\n", name, ns / static_cast<double>(n));
+}
+
+/**
+ * A sphere of radius about 1 with a bumpy surface, tessellated into
+ * 2 * rings * segments triangles.
+ */
+std::vector<Triangle<float>> bumpy_sphere(const size_t rings,
+                                          const size_t segments)
+{
+    const auto vertex = [&](const size_t ring, const size_t segment) {
+        const float theta = static_cast<float>(M_PI) * static_cast<float>(ring)
+                            / static_cast<float>(rings);
+        const float phi   = 2.0f * static_cast<float>(M_PI)
+                          * static_cast<float>(segment % segments)
+                          / static_cast<float>(segments);
+        const float radius =
+            1.0f + 0.05f * std::sin(7.0f * theta) * std::cos(11.0f * phi);
+        return Vec3 {radius * std::sin(theta) * std::cos(phi),
+                     radius * std::sin(theta) * std::sin(phi),
+                     radius * std::cos(theta)};
+    };
+
+    std::vector<Triangle<float>> triangles;
+    triangles.reserve(2 * rings * segments);
+    for (size_t r = 0; r < rings; ++r)
+    {
+        for (size_t s = 0; s < segments; ++s)
+        {
+            const Vec3 a = vertex(r, s);
+            const Vec3 b = vertex(r + 1, s);
+            const Vec3 c = vertex(r + 1, s + 1);
+            const Vec3 d = vertex(r, s + 1);
+            triangles.push_back(Triangle<float> {a, b, c});
+            triangles.push_back(Triangle<float> {a, c, d});
+        }
+    }
+    return triangles;
+}
+
+} // namespace
+
+int main()
+{
+    const auto triangles = bumpy_sphere(500, 1000);
+    std::printf("%zu triangles\n", triangles.size());
+
+    std::printf("build, ms\n");
+    std::printf("  %-36s %12.1f\n",
+                "sequential",
+                bench::median_ns([&] { Bvh<float> bvh(triangles); }, 3) * 1e-6);
+    std::printf("  %-36s %12.1f\n",
+                "parallel",
+                bench::median_ns(
+                    [&] { Bvh<float> bvh(execution::par, triangles); }, 3)
+                    * 1e-6);
+
+    const Bvh<float> bvh(execution::par, triangles);
+    std::printf("  %-36s %12zu\n", "nodes", bvh.node_count());
+
+    // Rays from a shell around the mesh towards points inside it, half of
+    // them hit the surface from outside, the rest from inside.
+    std::mt19937                          rng(23);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    const size_t                          n = 1 << 18;
+    Batch<3, float>                       origins;
+    Batch<3, float>                       directions;
+    for (size_t i = 0; i < n; ++i)
+    {
+        const Vec3 origin =
+            i % 2 == 0 ? Vec3 {unit(rng), unit(rng), unit(rng)} * 3.0f
+                       : Vec3 {unit(rng), unit(rng), unit(rng)} * 0.5f;
+        const Vec3 target = Vec3 {unit(rng), unit(rng), unit(rng)} * 0.5f;
+        origins.push_back(origin);
+        const Vec3 outward = Vec3 {unit(rng), unit(rng), unit(rng)};
+        directions.push_back(i % 2 == 0 ? target - origin : outward);
+    }
+    // Nearest point queries just off the surface.
+    std::vector<Vec3> points(n);
+    for (auto &point : points)
+    {
+        const Vec3 direction = Vec3 {unit(rng), unit(rng), unit(rng)};
+        point = direction * (1.05f / static_cast<float>(direction.norm()));
+    }
+    std::vector<RayHit<float>> hits(n);
+
+    std::printf("queries, ns per query\n");
+    const size_t brute_force_rays = 16;
+    report("ray brute force",
+           bench::median_ns(
+               [&] {
+                   for (size_t i = 0; i < brute_force_rays; ++i)
+                   {
+                       const Ray<3, float> ray {origins[i], directions[i]};
+                       float               best = ray.intersect(bvh.bounds());
+                       for (const auto &triangle : triangles)
+                       {
+                           best = std::min(best, triangle.intersect(ray));
+                       }
+                       bench::do_not_optimize(best);
+                   }
+               },
+               3),
+           brute_force_rays);
+    report("ray intersect",
+           bench::median_ns([&] {
+               intersect_many(bvh, origins, directions, hits);
+               bench::do_not_optimize(hits.data());
+           }),
+           n);
+    report("ray intersect par",
+           bench::median_ns([&] {
+               intersect_many(execution::par, bvh, origins, directions, hits);
+               bench::do_not_optimize(hits.data());
+           }),
+           n);
+    report("ray occluded",
+           bench::median_ns([&] {
+               size_t occluded = 0;
+               for (size_t i = 0; i < n; ++i)
+               {
+                   occluded += bvh.occluded(Ray {origins[i], directions[i]});
+               }
+               bench::do_not_optimize(occluded);
+           }),
+           n);
+    report("nearest",
+           bench::median_ns([&] {
+               float sum = 0.0f;
+               for (size_t i = 0; i < n; ++i)
+               {
+                   sum += bvh.nearest(points[i]).distance_squared;
+               }
+               bench::do_not_optimize(sum);
+           }),
+           n);
+    return 0;
+}
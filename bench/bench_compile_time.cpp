@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Measures how long it takes to compile the Vector operators, and how much
+// code they produce, for a matrix of sizes and element types. Every case is
+// a separate translation unit compiled with the compiler colibra was
+// configured with, once as C++17 and once as C++20 where the operators are
+// constrained with concepts. CMake defines:
+//   COLIBRA_BENCH_CXX          the compiler
+//   COLIBRA_BENCH_INCLUDE      colibra's include directory
+//   COLIBRA_BENCH_TRACE_FLAG   -ftime-trace on Clang, -ftime-report on GCC
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/// Number of consecutive sizes instantiated per case, which lifts the
+/// template cost above the fixed cost of parsing the headers.
+constexpr size_t sizes_per_case = 16;
+
+struct Case
+{
+    size_t      size;
+    const char *type;
+    const char *other;
+};
+
+std::string source(const Case &c)
+{
+    std::string text = "#include \"colibra/vector.h\"\n";
+    if (c.type == nullptr)
+    {
+        return text;
+    }
+    text += "template<size_t l>\n"
+            "struct Ops\n"
+            "{\n"
+            "    using A = colibra::Vector<l, "
+            + std::string(c.type) + ">;\n"
+            + "    using B = colibra::Vector<l, " + c.other + ">;\n"
+            + "    static A add(const A &a, const A &b) { return a + b; }\n"
+              "    static auto sub(const A &a, const B &b) { return a - b; }\n"
+              "    static auto scale(const A &a, double s) { return a * s; }\n"
+              "    static auto dot(const A &a, const B &b) { return a * b; }\n"
+              "    static A neg(const A &a) { return -a; }\n"
+              "    static double norm(const A &a) { return a.norm(); }\n"
+              "    static bool eq(const A &a, const A &b) { return a == b; }\n"
+              "};\n";
+    for (size_t l = c.size; l < c.size + sizes_per_case; ++l)
+    {
+        text += "template struct Ops<" + std::to_string(l) + ">;\n";
+    }
+    return text;
+}
+
+std::string name(const Case &c)
+{
+    if (c.type == nullptr)
+    {
+        return "headers_only";
+    }
+    return "vector_" + std::to_string(c.size) + "_" + c.type + "_" + c.other;
+}
+
+/// Language standards every case is compiled with.
+constexpr const char *standards[] = {"c++17", "c++20"};
+
+/// Compile path into object and return the wall time in milliseconds, or a
+/// negative value if the compiler failed.
+double compile(const fs::path &path,
+               const fs::path &object,
+               const char     *standard)
+{
+    const std::string command = std::string(COLIBRA_BENCH_CXX) + " -std="
+                                + standard + " -O2 -c -I"
+                                + COLIBRA_BENCH_INCLUDE + " "
+                                + COLIBRA_BENCH_TRACE_FLAG + " "
+                                + path.string() + " -o " + object.string()
+                                + " 2> " + object.string() + ".log";
+
+    const auto start  = std::chrono::steady_clock::now();
+    const int  status = std::system(command.c_str());
+    const auto stop   = std::chrono::steady_clock::now();
+    if (status != 0)
+    {
+        return -1.0;
+    }
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const fs::path directory = argc > 1 ? fs::path(argv[1])
+                                        : fs::temp_directory_path()
+                                              / "colibra_compile_time";
+    fs::create_directories(directory);
+
+    // The first case only includes the headers, as the baseline.
+    std::vector<Case> cases {{0, nullptr, nullptr}};
+    for (const size_t size : {2, 16, 64, 256, 1024})
+    {
+        cases.push_back({size, "float", "float"});
+        cases.push_back({size, "double", "float"});
+        cases.push_back({size, "int", "double"});
+    }
+
+    std::printf("%zu sizes from l per case\n", sizes_per_case);
+    std::printf("%-30s %10s %10s %10s\n", "", "ms", "bytes", "ms c++20");
+    for (const auto &c : cases)
+    {
+        const fs::path path = directory / (name(c) + ".cpp");
+        std::ofstream(path) << source(c);
+
+        // Median wall time per standard, object size of the C++17 build.
+        double         ms[std::size(standards)];
+        std::uintmax_t bytes = 0;
+        for (size_t k = 0; k < std::size(standards); ++k)
+        {
+            const fs::path object =
+                directory / (name(c) + "_" + standards[k] + ".o");
+
+            std::vector<double> samples;
+            for (size_t r = 0; r < 3; ++r)
+            {
+                samples.push_back(compile(path, object, standards[k]));
+            }
+            std::sort(samples.begin(), samples.end());
+            ms[k] = samples.front() < 0 ? -1.0 : samples[1];
+            if (k == 0 && ms[k] >= 0)
+            {
+                bytes = fs::file_size(object);
+            }
+        }
+        if (ms[0] < 0 || ms[1] < 0)
+        {
+            std::printf("%-30s %10s\n", name(c).c_str(), "failed");
+            continue;
+        }
+        std::printf("%-30s %10.0f %10ju %10.0f\n",
+                    name(c).c_str(),
+                    ms[0],
+                    bytes,
+                    ms[1]);
+    }
+    std::printf("Sources, objects and time traces are in %s\n",
+                directory.string().c_str());
+    return 0;
+}
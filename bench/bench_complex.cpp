@@ -0,0 +1,94 @@
+#include "bench.h"
+#include "colibra/complex.h"
+
+#include <complex>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace colibra;
+
+namespace {
+
+void report(const char *name, const double ns, const size_t n)
+{
+    std::printf("  %-36s %10.3f\n", name, ns / static_cast<double>(n));
+}
+
+template<typename T>
+void run(const char *type, const size_t n, std::mt19937 &rng)
+{
+    std::uniform_real_distribution<T> dist(-1, 1);
+    std::vector<std::complex<T>>      a(n);
+    std::vector<std::complex<T>>      b(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        a[i] = std::complex<T>(dist(rng), dist(rng));
+        b[i] = std::complex<T>(dist(rng), dist(rng));
+    }
+    const SplitComplex<T> split_a {Span(a)};
+    const SplitComplex<T> split_b {Span(b)};
+
+    std::vector<std::complex<T>> out(n);
+    SplitComplex<T>              split_out(n);
+
+    std::printf("%s, %zu values, ns per value\n", type, n);
+    report("multiply std::complex loop",
+           bench::median_ns([&] {
+               for (size_t i = 0; i < n; ++i)
+               {
+                   out[i] = a[i] * b[i];
+               }
+               bench::do_not_optimize(out.data());
+           }),
+           n);
+    report("multiply interleaved",
+           bench::median_ns([&] {
+               complex_multiply(Span(a), Span(b), Span(out));
+               bench::do_not_optimize(out.data());
+           }),
+           n);
+    report("multiply split",
+           bench::median_ns([&] {
+               complex_multiply(split_a, split_b, split_out.view());
+               bench::do_not_optimize(split_out.real());
+           }),
+           n);
+
+    report("conjugate dot std::complex loop",
+           bench::median_ns([&] {
+               std::complex<T> sum {};
+               for (size_t i = 0; i < n; ++i)
+               {
+                   sum += std::conj(a[i]) * b[i];
+               }
+               bench::do_not_optimize(sum);
+           }),
+           n);
+    report("conjugate dot interleaved",
+           bench::median_ns(
+               [&] { bench::do_not_optimize(conjugate_dot(a, Span(b))); }),
+           n);
+    report("conjugate dot split",
+           bench::median_ns([&] {
+               bench::do_not_optimize(conjugate_dot(split_a, split_b));
+           }),
+           n);
+    report("conjugate dot split par",
+           bench::median_ns([&] {
+               bench::do_not_optimize(
+                   conjugate_dot(execution::par, split_a, split_b));
+           }),
+           n);
+}
+
+} // namespace
+
+int main()
+{
+    std::mt19937 rng(13);
+    const size_t n = 1 << 20;
+    run<float>("float", n, rng);
+    run<double>("double", n, rng);
+    return 0;
+}
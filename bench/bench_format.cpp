@@ -0,0 +1,87 @@
+#include "bench.h"
+#include "colibra/format.h"
+
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace colibra;
+
+namespace {
+
+constexpr size_t count = size_t {1} << 16;
+
+void report(const char *name, const double ns, const size_t bytes)
+{
+    std::printf("%-28s %12.1f %12.1f\n",
+                name,
+                ns / count,
+                static_cast<double>(bytes) / ns * 1e3);
+}
+
+template<typename T>
+void run(const char *type, std::mt19937 &rng)
+{
+    std::uniform_real_distribution<double> dist(-1e3, 1e3);
+    std::vector<Vector<3, T>>              vectors(count);
+    for (auto &vec : vectors)
+    {
+        for (size_t i = 0; i < 3; ++i)
+        {
+            vec[i] = static_cast<T>(dist(rng));
+        }
+    }
+
+    std::string buffer(count * (max_chars_v<3, T> + 1), '\0');
+    char *const first = buffer.data();
+    char *const last  = first + buffer.size();
+    const char *end   = first;
+
+    const double to_chars_ns = bench::median_ns([&] {
+        end = to_chars(first, last, Span<const Vector<3, T>>(vectors)).ptr;
+        bench::do_not_optimize(end);
+    });
+    const size_t bytes = static_cast<size_t>(end - first);
+
+    std::string  streamed;
+    const double ostream_ns = bench::median_ns([&] {
+        std::ostringstream os;
+        for (const auto &vec : vectors)
+        {
+            os << vec << '\n';
+        }
+        streamed = os.str();
+    });
+
+    std::vector<Vector<3, T>> parsed(count);
+    const double              from_chars_ns = bench::median_ns([&] {
+        const auto result = from_chars(first, end, Span(parsed));
+        bench::do_not_optimize(result.ptr);
+    });
+
+    std::printf("%s (%zu bytes as text, %zu via ostream)\n",
+                type,
+                bytes,
+                streamed.size());
+    report("  to_chars", to_chars_ns, bytes);
+    report("  ostream <<", ostream_ns, streamed.size());
+    report("  from_chars", from_chars_ns, bytes);
+    if (parsed != vectors)
+    {
+        std::printf("  round trip mismatch\n");
+    }
+}
+
+} // namespace
+
+int main()
+{
+    std::mt19937 rng(1);
+    std::printf("%-28s %12s %12s\n", "", "ns/Vector", "MB/s");
+    run<float>("Vector<3, float>", rng);
+    run<double>("Vector<3, double>", rng);
+    run<int>("Vector<3, int>", rng);
+    return 0;
+}
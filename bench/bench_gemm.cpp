@@ -0,0 +1,117 @@
+#include "bench.h"
+#include "colibra/dmatrix.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace colibra;
+
+namespace {
+
+double gflops(const double flops, const double ns)
+{
+    return flops / ns;
+}
+
+template<typename T>
+DMatrix<T> random_dmatrix(std::mt19937 &rng, const size_t n)
+{
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    DMatrix<T>                             m(n, n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (size_t j = 0; j < n; ++j)
+        {
+            m(i, j) = static_cast<T>(dist(rng));
+        }
+    }
+    return m;
+}
+
+/// The textbook i, j, p triple loop the blocked kernel is measured against.
+template<typename T>
+void naive_gemm(const DMatrix<T> &a, const DMatrix<T> &b, DMatrix<T> &c)
+{
+    const size_t n = a.rows();
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (size_t j = 0; j < n; ++j)
+        {
+            T sum {};
+            for (size_t p = 0; p < n; ++p)
+            {
+                sum += a(i, p) * b(p, j);
+            }
+            c(i, j) = sum;
+        }
+    }
+}
+
+template<typename T>
+void run(const char *type, const size_t n, std::mt19937 &rng)
+{
+    const auto a = random_dmatrix<T>(rng, n);
+    const auto b = random_dmatrix<T>(rng, n);
+    DMatrix<T> c(n, n);
+
+    const double flops       = 2.0 * n * n * n;
+    const size_t repetitions = n >= 1024 ? 3 : 9;
+
+    const double naive_ns = bench::median_ns(
+        [&] {
+            naive_gemm(a, b, c);
+            bench::do_not_optimize(c.data());
+        },
+        repetitions);
+    const double seq_ns = bench::median_ns(
+        [&] {
+            gemm(a, b, c);
+            bench::do_not_optimize(c.data());
+        },
+        repetitions);
+    const double par_ns = bench::median_ns(
+        [&] {
+            gemm(execution::par, a, b, c);
+            bench::do_not_optimize(c.data());
+        },
+        repetitions);
+
+    std::vector<T> x(n, T {1});
+    std::vector<T> y(n);
+    const double   gemv_ns = bench::median_ns([&] {
+        gemv(a, Span(x), Span(y));
+        bench::do_not_optimize(y.data());
+    });
+
+    std::printf("%-8s %6zu %10.2f %10.2f %10.2f %10.2f\n",
+                type,
+                n,
+                gflops(flops, naive_ns),
+                gflops(flops, seq_ns),
+                gflops(flops, par_ns),
+                gflops(2.0 * n * n, gemv_ns));
+}
+
+} // namespace
+
+int main()
+{
+    std::mt19937 rng(1);
+    std::printf("%-8s %6s %10s %10s %10s %10s\n",
+                "GFLOP/s",
+                "n",
+                "naive",
+                "gemm",
+                "gemm par",
+                "gemv");
+    for (const size_t n : {64, 256, 512, 1024})
+    {
+        run<float>("float", n, rng);
+    }
+    for (const size_t n : {64, 256, 512, 1024})
+    {
+        run<double>("double", n, rng);
+    }
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include "bench.h"
+#include "colibra/interpolation.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace colibra;
+
+namespace {
+
+void report(const char *name, const double ns, const size_t n)
+{
+    std::printf("  %-36s %10.3f\n", name, ns / static_cast<double>(n));
+}
+
+/// The scalar function per parameter, the loop the batch calls replace.
+template<size_t l, class Fn>
+double scalar_ns(const size_t n, Batch<l, float> &out, const Fn &fn)
+{
+    return bench::median_ns([&] {
+        for (size_t i = 0; i < n; ++i)
+        {
+            out.set(i, fn(i));
+        }
+        bench::do_not_optimize(out.component(0));
+    });
+}
+
+} // namespace
+
+int main()
+{
+    std::mt19937                          rng(29);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    const size_t                          n = 1 << 20;
+
+    std::vector<float> t(n);
+    for (auto &value : t)
+    {
+        value = unit(rng);
+    }
+
+    const auto a = Quaternion<float>::from_axis_angle(
+        Vector {0.0f, 1.0f, 1.0f}, 0.5f);
+    const auto b = Quaternion<float>::from_axis_angle(
+        Vector {1.0f, -1.0f, 0.0f}, -2.5f);
+    Batch<4, float> quaternions(n);
+
+    std::printf("float, %zu parameters, ns per parameter\n", n);
+    report("slerp scalar",
+           scalar_ns(n,
+                     quaternions,
+                     [&](size_t i) {
+                         return slerp(a, b, t[i]).coefficients();
+                     }),
+           n);
+    report("slerp_many",
+           bench::median_ns([&] {
+               slerp_many(a, b, t, quaternions.view());
+               bench::do_not_optimize(quaternions.component(0));
+           }),
+           n);
+    report("nlerp scalar",
+           scalar_ns(n,
+                     quaternions,
+                     [&](size_t i) {
+                         return nlerp(a, b, t[i]).coefficients();
+                     }),
+           n);
+    report("nlerp_many",
+           bench::median_ns([&] {
+               nlerp_many(a, b, t, quaternions.view());
+               bench::do_not_optimize(quaternions.component(0));
+           }),
+           n);
+
+    // A path of 1000 control points sampled at random parameters.
+    std::vector<Vector<3, float>> points(1000);
+    for (auto &point : points)
+    {
+        point = Vector {unit(rng), unit(rng), unit(rng)};
+    }
+    const auto         spline = HermiteSpline<3, float>::catmull_rom(points);
+    std::vector<float> s(n);
+    for (auto &value : s)
+    {
+        value = 999.0f * unit(rng);
+    }
+    Batch<3, float> positions(n);
+
+    report("spline scalar",
+           scalar_ns(n, positions, [&](size_t i) { return spline(s[i]); }),
+           n);
+    report("spline evaluate_many",
+           bench::median_ns([&] {
+               evaluate_many(spline, s, positions.view());
+               bench::do_not_optimize(positions.component(0));
+           }),
+           n);
+    report("spline evaluate_many par",
+           bench::median_ns([&] {
+               evaluate_many(execution::par, spline, s, positions.view());
+               bench::do_not_optimize(positions.component(0));
+           }),
+           n);
+    std::sort(s.begin(), s.end());
+    report("spline scalar sorted",
+           scalar_ns(n, positions, [&](size_t i) { return spline(s[i]); }),
+           n);
+    report("spline evaluate_many sorted",
+           bench::median_ns([&] {
+               evaluate_many(spline, s, positions.view());
+               bench::do_not_optimize(positions.component(0));
+           }),
+           n);
+    report("lerp_many",
+           bench::median_ns([&] {
+               lerp_many(points[0], points[1], t, positions.view());
+               bench::do_not_optimize(positions.component(0));
+           }),
+           n);
+    return 0;
+}
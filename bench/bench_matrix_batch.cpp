@@ -0,0 +1,88 @@
+#include "bench.h"
+#include "colibra/decompositions.h"
+#include "colibra/matrix_batch_ops.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace colibra;
+
+namespace {
+
+constexpr size_t count = size_t {1} << 16;
+
+void report(const char *name, const double ns)
+{
+    std::printf("%-32s %12.2f\n", name, ns / count);
+}
+
+template<size_t n>
+void run(std::mt19937 &rng)
+{
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<Matrix<n, n, float>>      matrices(count);
+    std::vector<Vector<n, float>>         vectors(count);
+    for (size_t k = 0; k < count; ++k)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            for (size_t j = 0; j < n; ++j)
+            {
+                matrices[k](i, j) = dist(rng) + (i == j ? 4.0f : 0.0f);
+            }
+            vectors[k][i] = dist(rng);
+        }
+    }
+    const MatrixBatch<n, n, float> a {Span(matrices)};
+    const Batch<n, float>          v {Span(vectors)};
+
+    std::printf("%zux%zu float\n", n, n);
+
+    std::vector<Matrix<n, n, float>> inverses(count);
+    report("  inverse, one at a time", bench::median_ns([&] {
+               for (size_t k = 0; k < count; ++k)
+               {
+                   inverses[k] = inverse(matrices[k]);
+               }
+               bench::do_not_optimize(inverses.data());
+           }));
+
+    MatrixBatch<n, n, float> inv(count);
+    report("  inverse_many", bench::median_ns([&] {
+               inverse_many(a, inv.view());
+               bench::do_not_optimize(inv.element(0, 0));
+           }));
+
+    std::vector<Matrix<n, n, float>> products(count);
+    report("  operator*, one at a time", bench::median_ns([&] {
+               for (size_t k = 0; k < count; ++k)
+               {
+                   products[k] = matrices[k] * matrices[k];
+               }
+               bench::do_not_optimize(products.data());
+           }));
+
+    MatrixBatch<n, n, float> product(count);
+    report("  multiply_many", bench::median_ns([&] {
+               multiply_many(a, a, product.view());
+               bench::do_not_optimize(product.element(0, 0));
+           }));
+
+    Batch<n, float> transformed(count);
+    report("  transform_many", bench::median_ns([&] {
+               transform_many(a, v, transformed.view());
+               bench::do_not_optimize(transformed.component(0));
+           }));
+}
+
+} // namespace
+
+int main()
+{
+    std::mt19937 rng(1);
+    std::printf("%-32s %12s\n", "", "ns/instance");
+    run<3>(rng);
+    run<4>(rng);
+    return 0;
+}
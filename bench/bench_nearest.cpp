@@ -0,0 +1,68 @@
+#include "bench.h"
+#include "colibra/nearest.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace colibra;
+
+namespace {
+
+std::vector<Vector<3, float>> random_points(const size_t n, std::mt19937 &rng)
+{
+    std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+    std::vector<Vector<3, float>>         points(n);
+    for (auto &p : points)
+    {
+        p = Vector {dist(rng), dist(rng), dist(rng)};
+    }
+    return points;
+}
+
+} // namespace
+
+int main()
+{
+    std::mt19937 rng(42);
+    const auto   queries = random_points(256, rng);
+
+    std::printf("%10s %14s %14s %14s %14s %14s\n",
+                "points",
+                "kd build us",
+                "brute 1nn ns",
+                "kd 1nn ns",
+                "brute 8nn ns",
+                "kd 8nn ns");
+
+    for (size_t n = 16; n <= (size_t {1} << 20); n *= 4)
+    {
+        const auto points = random_points(n, rng);
+
+        KdTree<3, float> tree;
+        const double     build_ns = bench::median_ns(
+            [&] { tree = KdTree<3, float>(Span(points)); }, 3);
+        const BruteForceIndex<3, float> brute {Span(points)};
+
+        std::vector<Neighbor<float>> out;
+        auto per_query = [&](auto &index, size_t k) {
+            return bench::median_ns([&] {
+                       for (const auto &q : queries)
+                       {
+                           index.knn(q, k, out);
+                           bench::do_not_optimize(out.data());
+                       }
+                   })
+                   / queries.size();
+        };
+
+        std::printf("%10zu %14.1f %14.1f %14.1f %14.1f %14.1f\n",
+                    n,
+                    build_ns / 1000.0,
+                    per_query(brute, 1),
+                    per_query(tree, 1),
+                    per_query(brute, 8),
+                    per_query(tree, 8));
+    }
+    return 0;
+}
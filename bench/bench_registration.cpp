@@ -0,0 +1,123 @@
+#include "bench.h"
+#include "colibra/registration.h"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace colibra;
+
+namespace {
+
+/// Points on a noisy, wavy surface, a stand-in for a lidar scan.
+std::vector<Vector<3, float>> surface(const size_t n, std::mt19937 &rng)
+{
+    std::uniform_real_distribution<float> coordinate(-50.0f, 50.0f);
+    std::normal_distribution<float>       noise(0.0f, 0.01f);
+    std::vector<Vector<3, float>>         points(n);
+    for (auto &p : points)
+    {
+        const float x = coordinate(rng);
+        const float y = coordinate(rng);
+        const float z = 2.0f * std::sin(0.2f * x) * std::cos(0.1f * y);
+        p             = Vector {x, y, z + noise(rng)};
+    }
+    return points;
+}
+
+RigidTransform<float> small_motion()
+{
+    const float angle = 0.005f;
+    return RigidTransform<float> {
+        Matrix<3, 3, float> {std::cos(angle),
+                             -std::sin(angle),
+                             0.0f,
+                             std::sin(angle),
+                             std::cos(angle),
+                             0.0f,
+                             0.0f,
+                             0.0f,
+                             1.0f},
+        Vector {0.1f, -0.05f, 0.02f}};
+}
+
+void report(const char *name, const double ns, const size_t points)
+{
+    std::printf("  %-28s %12.2f %10.2f\n",
+                name,
+                ns * 1e-6,
+                ns / static_cast<double>(points));
+}
+
+} // namespace
+
+int main()
+{
+    std::mt19937 rng(7);
+    std::printf("  %-28s %12s %10s\n", "", "ms", "ns/point");
+
+    const size_t n      = 1000000;
+    const auto   target = surface(n, rng);
+    const auto   motion = small_motion();
+
+    std::vector<Vector<3, float>> source(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        source[i] = motion.inverse()(target[i]);
+    }
+
+    std::printf("%zu point pairs\n", n);
+    report("kabsch",
+           bench::median_ns([&] {
+               bench::do_not_optimize(kabsch(source, Span(target)));
+           }),
+           n);
+    report("kabsch par",
+           bench::median_ns([&] {
+               bench::do_not_optimize(
+                   kabsch(execution::par, source, Span(target)));
+           }),
+           n);
+
+    // ICP is dominated by the nearest neighbor queries, measured here with
+    // a subsampled source against the full target cloud.
+    std::vector<Vector<3, float>> sparse_source;
+    for (size_t i = 0; i < n; i += 10)
+    {
+        sparse_source.push_back(source[i]);
+    }
+    IcpOptions options;
+    options.max_distance = 1.0;
+    options.tolerance    = 1e-4;
+
+    report("KdTree build",
+           bench::median_ns(
+               [&] {
+                   IcpRegistration<float> icp {Span(target)};
+                   bench::do_not_optimize(icp.tree().size());
+               },
+               3),
+           n);
+
+    IcpRegistration<float> icp {Span(target)};
+    std::printf("%zu source points, %zu target points\n",
+                sparse_source.size(),
+                n);
+    IcpResult<float> result;
+    const double     seq_ns = bench::median_ns(
+        [&] { result = icp.align(Span(sparse_source), {}, options); }, 3);
+    report("icp", seq_ns, sparse_source.size() * (result.iterations + 1));
+    const double par_ns = bench::median_ns(
+        [&] {
+            result =
+                icp.align(execution::par, Span(sparse_source), {}, options);
+        },
+        3);
+    report("icp par", par_ns, sparse_source.size() * (result.iterations + 1));
+    std::printf("  %zu iterations, rms %.4f, converged %d\n",
+                result.iterations,
+                result.rms,
+                result.converged ? 1 : 0);
+    return 0;
+}
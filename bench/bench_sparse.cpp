@@ -0,0 +1,136 @@
+#include "bench.h"
+#include "colibra/sparse.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace colibra;
+
+namespace {
+
+constexpr size_t dof = 6;
+
+struct Edge
+{
+    size_t from;
+    size_t to;
+};
+
+/// Odometry edges between consecutive poses plus random loop closures, the
+/// structure of a typical pose-graph SLAM problem.
+std::vector<Edge> pose_graph(const size_t poses, std::mt19937 &rng)
+{
+    std::vector<Edge> edges;
+    for (size_t i = 0; i + 1 < poses; ++i)
+    {
+        edges.push_back({i, i + 1});
+    }
+    std::uniform_int_distribution<size_t> pose(0, poses - 1);
+    for (size_t n = 0; n < poses / 4; ++n)
+    {
+        edges.push_back({pose(rng), pose(rng)});
+    }
+    return edges;
+}
+
+/// Every edge contributes a 6 x 12 residual Jacobian: one 6 x 6 block per
+/// pose it connects.
+void assemble(SparseBuilder<double> &  builder,
+              const std::vector<Edge> &edges,
+              const size_t             poses)
+{
+    Matrix<dof, dof, double> block;
+    for (size_t i = 0; i < dof; ++i)
+    {
+        for (size_t j = 0; j < dof; ++j)
+        {
+            block(i, j) = 1.0 / static_cast<double>(1 + i + j);
+        }
+    }
+    builder.reset(edges.size() * dof, poses * dof);
+    for (size_t e = 0; e < edges.size(); ++e)
+    {
+        builder.add_block(e * dof, edges[e].from * dof, block);
+        builder.add_block(e * dof, edges[e].to * dof, -block);
+    }
+}
+
+void report(const char *name, const double ns, const size_t nonzeros)
+{
+    // Every nonzero reads an 8 byte value and a 4 byte column index.
+    std::printf("  %-28s %10.3f %10.2f\n",
+                name,
+                ns / static_cast<double>(nonzeros),
+                12.0 * static_cast<double>(nonzeros) / ns);
+}
+
+void run(const size_t poses, std::mt19937 &rng)
+{
+    const auto edges = pose_graph(poses, rng);
+
+    SparseBuilder<double> builder;
+    assemble(builder, edges, poses);
+    CsrMatrix<double> jacobian = builder.build();
+
+    std::printf("%zu poses, %zu x %zu Jacobian, %zu nonzeros\n",
+                poses,
+                jacobian.rows(),
+                jacobian.cols(),
+                jacobian.nonzeros());
+
+    const double build_ns = bench::median_ns([&] {
+        assemble(builder, edges, poses);
+        builder.build(jacobian);
+        bench::do_not_optimize(jacobian.values().data());
+    });
+    report("assemble and build", build_ns, jacobian.nonzeros());
+
+    std::vector<double> x(jacobian.cols(), 1.0);
+    std::vector<double> y(jacobian.rows());
+    report("spmv",
+           bench::median_ns([&] {
+               spmv(jacobian, Span(x), Span(y));
+               bench::do_not_optimize(y.data());
+           }),
+           jacobian.nonzeros());
+    report("spmv par",
+           bench::median_ns([&] {
+               spmv(execution::par, jacobian, Span(x), Span(y));
+               bench::do_not_optimize(y.data());
+           }),
+           jacobian.nonzeros());
+
+    report("spmv_transpose",
+           bench::median_ns([&] {
+               spmv_transpose(jacobian, Span(y), Span(x));
+               bench::do_not_optimize(x.data());
+           }),
+           jacobian.nonzeros());
+    report("spmv_transpose par",
+           bench::median_ns([&] {
+               spmv_transpose(execution::par, jacobian, Span(y), Span(x));
+               bench::do_not_optimize(x.data());
+           }),
+           jacobian.nonzeros());
+    report("transpose() then spmv",
+           bench::median_ns([&] {
+               const auto transposed = jacobian.transpose();
+               spmv(transposed, Span(y), Span(x));
+               bench::do_not_optimize(x.data());
+           }),
+           jacobian.nonzeros());
+}
+
+} // namespace
+
+int main()
+{
+    std::mt19937 rng(1);
+    std::printf("  %-28s %10s %10s\n", "", "ns/nnz", "GB/s");
+    for (const size_t poses : {1000, 10000, 100000})
+    {
+        run(poses, rng);
+    }
+    return 0;
+}
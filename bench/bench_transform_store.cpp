@@ -0,0 +1,167 @@
+#include "bench.h"
+#include "colibra/quaternion.h"
+#include "colibra/transform_store.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using namespace colibra;
+
+namespace {
+
+using Vec3 = Vector<3, float>;
+
+/// The same interface as TransformStore, every access under a lock.
+template<class Mutex>
+class LockedStore
+{
+  public:
+    explicit LockedStore(const size_t frames) : m_transforms(frames) {}
+
+    void publish(const size_t frame, const RigidTransform<float> &transform)
+    {
+        std::unique_lock lock(m_mutex);
+        m_transforms[frame] = transform;
+    }
+
+    [[nodiscard]] RigidTransform<float> load(const size_t frame) const
+    {
+        if constexpr (std::is_same_v<Mutex, std::shared_mutex>)
+        {
+            std::shared_lock lock(m_mutex);
+            return m_transforms[frame];
+        }
+        else
+        {
+            std::unique_lock lock(m_mutex);
+            return m_transforms[frame];
+        }
+    }
+
+  private:
+    mutable Mutex                      m_mutex;
+    std::vector<RigidTransform<float>> m_transforms;
+};
+
+constexpr size_t frames          = 64;
+constexpr size_t points_per_read = 8;
+constexpr auto   duration        = std::chrono::milliseconds(300);
+
+/**
+ * Loads per microsecond summed over readers, each load followed by mapping
+ * a few points, while a writer republishes every frame in a loop or stays
+ * idle.
+ */
+template<class Store>
+double loads_per_us(const unsigned readers, const bool updating)
+{
+    Store             store(frames);
+    std::atomic<bool> done {false};
+    std::atomic<bool> started {false};
+
+    std::thread writer([&] {
+        float angle = 0.0f;
+        while (updating && !done.load(std::memory_order_relaxed))
+        {
+            for (size_t f = 0; f < frames; ++f)
+            {
+                angle += 1e-3f;
+                store.publish(
+                    f,
+                    RigidTransform<float> {
+                        Quaternion<float>::from_axis_angle(
+                            Vec3 {0.0f, 0.0f, 1.0f}, angle)
+                            .to_matrix(),
+                        Vec3 {angle, 0.0f, 1.0f}});
+            }
+        }
+    });
+
+    std::vector<size_t>      loads(readers, 0);
+    std::vector<std::thread> threads;
+    for (unsigned r = 0; r < readers; ++r)
+    {
+        threads.emplace_back([&, r] {
+            while (!started.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+            size_t count = 0;
+            float  sum   = 0.0f;
+            size_t frame = r;
+            while (!done.load(std::memory_order_relaxed))
+            {
+                const RigidTransform<float> transform = store.load(frame);
+                for (size_t p = 0; p < points_per_read; ++p)
+                {
+                    const float x = static_cast<float>(p);
+                    sum += transform(Vec3 {x, 1.0f, -x})[0];
+                }
+                frame = (frame + 7) % frames;
+                ++count;
+            }
+            bench::do_not_optimize(sum);
+            loads[r] = count;
+        });
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    started.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(duration);
+    done.store(true, std::memory_order_relaxed);
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    writer.join();
+
+    size_t total = 0;
+    for (const size_t count : loads)
+    {
+        total += count;
+    }
+    return static_cast<double>(total)
+           / std::chrono::duration<double, std::micro>(stop - start).count();
+}
+
+template<class Store>
+void report(const char *name, const unsigned readers, const bool updating)
+{
+    std::printf("  %-22s %7u %9s %10.2f\n",
+                name,
+                readers,
+                updating ? "yes" : "no",
+                loads_per_us<Store>(readers, updating));
+}
+
+} // namespace
+
+int main()
+{
+    std::printf("%zu frames, %zu points per load, %u hardware threads\n",
+                frames,
+                points_per_read,
+                std::thread::hardware_concurrency());
+    std::printf("  %-22s %7s %9s %10s\n",
+                "store",
+                "readers",
+                "updating",
+                "loads/us");
+    for (const bool updating : {false, true})
+    {
+        for (const unsigned readers : {1u, 2u, 4u})
+        {
+            report<TransformStore<float>>("TransformStore", readers, updating);
+            report<LockedStore<std::shared_mutex>>(
+                "shared_mutex", readers, updating);
+            report<LockedStore<std::mutex>>("mutex", readers, updating);
+        }
+    }
+}
@@ -0,0 +1,94 @@
+#include "bench.h"
+#include "colibra/vector.h"
+
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace colibra;
+
+namespace {
+
+/// Elements touched per measurement, independent of the Vector size.
+constexpr size_t elements = 1 << 20;
+
+template<size_t l, typename T>
+std::vector<Vector<l, T>> random_vectors(std::mt19937 &rng)
+{
+    std::uniform_real_distribution<T> dist(-1, 1);
+    std::vector<Vector<l, T>>         vectors(elements / l + 1);
+    for (auto &v : vectors)
+    {
+        for (size_t i = 0; i < l; ++i)
+        {
+            v[i] = dist(rng);
+        }
+    }
+    return vectors;
+}
+
+template<size_t l, typename T>
+void run(std::mt19937 &rng)
+{
+    const auto   a     = random_vectors<l, T>(rng);
+    const auto   b     = random_vectors<l, T>(rng);
+    const double count = static_cast<double>(a.size() * l);
+
+    const double dot = bench::median_ns([&] {
+        T total {};
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            total += a[i] * b[i];
+        }
+        bench::do_not_optimize(total);
+    });
+
+    std::vector<Vector<l, T>> out(a.size());
+    const double              add = bench::median_ns([&] {
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            out[i] = a[i] + b[i];
+        }
+        bench::do_not_optimize(out.data());
+    });
+
+    const double scale = bench::median_ns([&] {
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            out[i] = a[i] * T {3};
+        }
+        bench::do_not_optimize(out.data());
+    });
+
+    std::printf("%6zu %8s %12.3f %12.3f %12.3f\n",
+                l,
+                sizeof(T) == 4 ? "float" : "double",
+                dot / count,
+                add / count,
+                scale / count);
+}
+
+template<typename T, size_t... sizes>
+void run_all(std::mt19937 &rng, std::index_sequence<sizes...>)
+{
+    (run<sizes, T>(rng), ...);
+}
+
+} // namespace
+
+int main()
+{
+    std::mt19937 rng(11);
+    std::printf("unroll limit %zu\n", details::unroll_limit);
+    std::printf("%6s %8s %12s %12s %12s\n",
+                "l",
+                "type",
+                "dot ns/el",
+                "add ns/el",
+                "scale ns/el");
+    using sizes = std::index_sequence<3, 8, 16, 17, 32, 64, 128, 256, 1024>;
+    run_all<float>(rng, sizes {});
+    run_all<double>(rng, sizes {});
+    return 0;
+}
@@ -0,0 +1,100 @@
+#ifndef COLIBRA_ACCUMULATE_H
+#define COLIBRA_ACCUMULATE_H
+
+#include "details/accumulate.hpp"
+#include "details/math.hpp"
+#include "promotion.h"
+#include "vector.h"
+
+#include <cmath>
+
+namespace colibra {
+
+namespace details {
+
+/// Acc = void selects the promoted element type.
+template<typename Acc, typename T>
+using accumulator_t = std::conditional_t<std::is_void_v<Acc>, T, Acc>;
+
+} // namespace details
+
+/**
+ * @brief: Sum all entries of a Vector with explicit control over accumulator
+ * type and summation algorithm.
+ *
+ * Every entry is converted to Acc before it is added, so sum<double>(v) on a
+ * float Vector accumulates in double.
+ *
+ * @tparam Acc The accumulator and result type, void keeps the element type.
+ * @tparam Mode One of the summation modes, e.g. summation::kahan.
+ */
+template<typename Acc = void,
+         class Mode   = summation::naive,
+         size_t l,
+         typename T>
+[[nodiscard]] constexpr auto sum(const Vector<l, T> &vec)
+{
+    using A = details::accumulator_t<Acc, T>;
+    std::array<A, l> terms {};
+    for (size_t i = 0; i < l; ++i)
+    {
+        terms[i] = static_cast<A>(vec[i]);
+    }
+    return details::accumulate(terms, Mode {});
+}
+
+/**
+ * @brief: Dot multiply two Vectors with explicit control over accumulator
+ * type and summation algorithm.
+ *
+ * Both operands are converted to Acc before multiplying, so the products
+ * are exact for dot<double>(a, b) on float Vectors.
+ *
+ * @tparam Acc The accumulator and result type, void uses the promoted
+ * element type like Vector::operator*.
+ * @tparam Mode One of the summation modes, e.g. summation::pairwise.
+ */
+template<typename Acc = void,
+         class Mode   = summation::naive,
+         size_t l,
+         typename T,
+         typename S>
+[[nodiscard]] constexpr auto dot(const Vector<l, T> &vec,
+                                 const Vector<l, S> &other)
+{
+    using A = details::accumulator_t<Acc, promoted_t<T, S>>;
+    std::array<A, l> terms {};
+    for (size_t i = 0; i < l; ++i)
+    {
+        terms[i] = static_cast<A>(vec[i]) * static_cast<A>(other[i]);
+    }
+    return details::accumulate(terms, Mode {});
+}
+
+/**
+ * @brief: Calculate the norm of a Vector with explicit control over
+ * accumulator type and summation algorithm.
+ *
+ * Unlike Vector::norm(), which always computes in double, norm<float>(v)
+ * stays in single precision.
+ *
+ * @tparam Acc The accumulator and result type, void uses double like
+ * Vector::norm().
+ * @tparam Mode One of the summation modes, e.g. summation::kahan.
+ */
+template<typename Acc = void,
+         class Mode   = summation::naive,
+         size_t l,
+         typename T>
+[[nodiscard]] constexpr auto norm(const Vector<l, T> &vec)
+{
+    using A = details::accumulator_t<Acc, double>;
+    // Integer accumulators take the root in double, like std::sqrt would.
+    using R = std::conditional_t<std::is_floating_point_v<A>, A, double>;
+    return static_cast<A>(
+        details::sqrt(static_cast<R>(dot<A, Mode>(vec, vec))));
+}
+
+} // namespace colibra
+
+#endif
@@ -0,0 +1,270 @@
+#ifndef COLIBRA_BATCH_H
+#define COLIBRA_BATCH_H
+
+#include "span.h"
+#include "vector.h"
+
+#include <array>
+#include <stdexcept>
+#include <vector>
+
+namespace colibra {
+
+/**
+ * @brief: A non-owning structure-of-arrays view onto a batch of Vectors.
+ *
+ * Component d of the Vector with index i lives at component(d)[i]. This is the
+ * layout batch kernels prefer, since consecutive Vectors map to consecutive
+ * SIMD lanes.
+ *
+ * @tparam l The size of each Vector.
+ * @tparam T The data type of the Vectors, const qualified for read-only views.
+ */
+template<size_t l, typename T>
+class BatchView
+{
+    using value_type_ = std::remove_const_t<T>;
+
+  public:
+    constexpr BatchView() = default;
+
+    /**
+     * @brief: Create a view from one pointer per component, each pointing to
+     * size elements.
+     */
+    constexpr BatchView(const std::array<T *, l> &components, size_t size)
+        : m_components(components)
+        , m_size(size)
+    {
+    }
+
+    /**
+     * @brief: Allow implicit conversion from mutable to read-only views.
+     */
+    template<typename U,
+             typename = std::enable_if_t<!std::is_same_v<U, T>
+                                         && std::is_convertible_v<U *, T *>>>
+    constexpr BatchView(const BatchView<l, U> &other)
+        : m_size(other.size())
+    {
+        for (size_t d = 0; d < l; ++d)
+        {
+            m_components[d] = other.component(d);
+        }
+    }
+
+    [[nodiscard]] constexpr size_t size() const
+    {
+        return m_size;
+    }
+
+    [[nodiscard]] constexpr bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /**
+     * @brief: Get the contiguous array holding component d of all Vectors.
+     */
+    [[nodiscard]] constexpr T *component(const size_t d) const
+    {
+        return m_components[d];
+    }
+
+    /**
+     * @brief: Gather the Vector with the given index.
+     *
+     * @warning Does not perform range-checking.
+     */
+    [[nodiscard]] constexpr colibra::Vector<l, value_type_>
+    operator[](const size_t i) const
+    {
+        colibra::Vector<l, value_type_> vec;
+        for (size_t d = 0; d < l; ++d)
+        {
+            vec[d] = m_components[d][i];
+        }
+        return vec;
+    }
+
+    /**
+     * @brief: Create a view onto count Vectors starting at offset.
+     *
+     * @throws std::out_of_range When the requested range exceeds this view.
+     */
+    [[nodiscard]] constexpr BatchView subview(const size_t offset,
+                                              const size_t count) const
+    {
+        if (offset > m_size || count > m_size - offset)
+        {
+            throw std::out_of_range("colibra::BatchView::subview out of range");
+        }
+        std::array<T *, l> components {};
+        for (size_t d = 0; d < l; ++d)
+        {
+            components[d] = m_components[d] + offset;
+        }
+        return BatchView(components, count);
+    }
+
+  private:
+    std::array<T *, l> m_components {};
+    size_t             m_size = 0;
+};
+
+/**
+ * @brief: An owning structure-of-arrays container of Vectors.
+ *
+ * Use this instead of std::vector<Vector<l, T>> when the same operation is
+ * applied to many Vectors, see batch_ops.h.
+ *
+ * @tparam l The size of each Vector.
+ * @tparam T The data type of the Vectors.
+ */
+template<size_t l, typename T>
+class Batch
+{
+  public:
+    Batch() = default;
+
+    /**
+     * @brief: Create a batch of size null Vectors.
+     */
+    explicit Batch(const size_t size)
+    {
+        resize(size);
+    }
+
+    /**
+     * @brief: Transpose an array of Vectors into a new batch.
+     */
+    explicit Batch(Span<const colibra::Vector<l, T>> vectors)
+    {
+        resize(vectors.size());
+        for (size_t i = 0; i < vectors.size(); ++i)
+        {
+            set(i, vectors[i]);
+        }
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return m_components[0].size();
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return m_components[0].empty();
+    }
+
+    void reserve(const size_t capacity)
+    {
+        for (auto &component : m_components)
+        {
+            component.reserve(capacity);
+        }
+    }
+
+    void resize(const size_t size)
+    {
+        for (auto &component : m_components)
+        {
+            component.resize(size);
+        }
+    }
+
+    void clear()
+    {
+        for (auto &component : m_components)
+        {
+            component.clear();
+        }
+    }
+
+    void push_back(const colibra::Vector<l, T> &vec)
+    {
+        for (size_t d = 0; d < l; ++d)
+        {
+            m_components[d].push_back(vec[d]);
+        }
+    }
+
+    /**
+     * @brief: Scatter vec into the slot with the given index.
+     *
+     * @warning Does not perform range-checking.
+     */
+    void set(const size_t i, const colibra::Vector<l, T> &vec)
+    {
+        for (size_t d = 0; d < l; ++d)
+        {
+            m_components[d][i] = vec[d];
+        }
+    }
+
+    /**
+     * @brief: Gather the Vector with the given index.
+     *
+     * @warning Does not perform range-checking.
+     */
+    [[nodiscard]] colibra::Vector<l, T> operator[](const size_t i) const
+    {
+        return view()[i];
+    }
+
+    /**
+     * @brief: Gather the Vector with the given index with range checking.
+     *
+     * @throws std::out_of_range When accessing Vectors out of range.
+     */
+    [[nodiscard]] colibra::Vector<l, T> at(const size_t i) const
+    {
+        if (i >= size())
+        {
+            throw std::out_of_range("colibra::Batch::at out of range");
+        }
+        return view()[i];
+    }
+
+    [[nodiscard]] T *component(const size_t d)
+    {
+        return m_components[d].data();
+    }
+
+    [[nodiscard]] const T *component(const size_t d) const
+    {
+        return m_components[d].data();
+    }
+
+    [[nodiscard]] BatchView<l, T> view()
+    {
+        std::array<T *, l> components {};
+        for (size_t d = 0; d < l; ++d)
+        {
+            components[d] = m_components[d].data();
+        }
+        return BatchView<l, T>(components, size());
+    }
+
+    [[nodiscard]] BatchView<l, const T> view() const
+    {
+        std::array<const T *, l> components {};
+        for (size_t d = 0; d < l; ++d)
+        {
+            components[d] = m_components[d].data();
+        }
+        return BatchView<l, const T>(components, size());
+    }
+
+    operator BatchView<l, const T>() const
+    {
+        return view();
+    }
+
+  private:
+    std::array<std::vector<T>, l> m_components;
+};
+
+} // namespace colibra
+
+#endif
@@ -0,0 +1,220 @@
+#ifndef COLIBRA_BATCH_OPS_H
+#define COLIBRA_BATCH_OPS_H
+
+#include "batch.h"
+#include "details/batch_ops.hpp"
+#include "execution.h"
+#include "span.h"
+#include "vector.h"
+
+#include <vector>
+
+namespace colibra {
+
+template<class Policy>
+using enable_if_execution_policy_t =
+    std::enable_if_t<execution::is_execution_policy_v<Policy>>;
+
+/**
+ * @brief: Dot multiply query with every Vector of a batch.
+ *
+ * Computes out[i] = query * points[i]. The batch is processed in
+ * structure-of-arrays layout, so one SIMD register holds the same component
+ * of several points and the loop vectorizes across the batch.
+ *
+ * Batches of half or bfloat16 are widened to float chunk by chunk and
+ * produce float results. Fixed-point batches produce the exact dot_wide
+ * result, Q15 batches use pmaddwd when compiled with SSE4.1.
+ *
+ * @param policy execution::seq or execution::par.
+ * @param query The Vector all points are multiplied with.
+ * @param points The batch of Vectors.
+ * @param out Receives one result per point.
+ *
+ * @throws std::invalid_argument If out is smaller than points.
+ */
+template<class Policy,
+         size_t l,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+void dot_many(const Policy &                             policy,
+              const Vector<l, T> &                       query,
+              details::identity_t<BatchView<l, const T>> points,
+              Span<details::dot_type_t<T>>               out)
+{
+    details::dot_many(
+        policy, query, details::make_points(points), points.size(), out);
+}
+
+/**
+ * @brief: Dot multiply query with every Vector of an array.
+ *
+ * Prefer the Batch overload for large inputs, array-of-structures input
+ * needs shuffles to vectorize.
+ *
+ * @throws std::invalid_argument If out is smaller than points.
+ */
+template<class Policy,
+         size_t l,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+void dot_many(const Policy &                                policy,
+              const Vector<l, T> &                          query,
+              details::identity_t<Span<const Vector<l, T>>> points,
+              Span<details::dot_type_t<T>>                  out)
+{
+    details::dot_many(
+        policy, query, details::make_points(points), points.size(), out);
+}
+
+template<size_t l, typename T>
+void dot_many(const Vector<l, T> &                       query,
+              details::identity_t<BatchView<l, const T>> points,
+              Span<details::dot_type_t<T>>               out)
+{
+    dot_many(execution::seq, query, points, out);
+}
+
+template<size_t l, typename T>
+void dot_many(const Vector<l, T> &                          query,
+              details::identity_t<Span<const Vector<l, T>>> points,
+              Span<details::dot_type_t<T>>                  out)
+{
+    dot_many(execution::seq, query, points, out);
+}
+
+/**
+ * @brief: Calculate the norm of every Vector of a batch.
+ *
+ * Floating point batches produce results of their own type, half and
+ * bfloat16 batches produce float, all others produce double like
+ * Vector::norm().
+ *
+ * @throws std::invalid_argument If out is smaller than points.
+ */
+template<class Policy,
+         size_t l,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+void norm_many(const Policy &                                     policy,
+               BatchView<l, const T>                              points,
+               details::identity_t<Span<details::norm_type_t<T>>> out)
+{
+    details::norm_many<Policy, l, T>(
+        policy, details::make_points(points), points.size(), out);
+}
+
+template<class Policy,
+         size_t l,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+void norm_many(const Policy &                                     policy,
+               const Batch<l, T> &                                points,
+               details::identity_t<Span<details::norm_type_t<T>>> out)
+{
+    norm_many(policy, points.view(), out);
+}
+
+template<class Policy,
+         size_t l,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+void norm_many(const Policy &                                     policy,
+               Span<const Vector<l, T>>                           points,
+               details::identity_t<Span<details::norm_type_t<T>>> out)
+{
+    details::norm_many<Policy, l, T>(
+        policy, details::make_points(points), points.size(), out);
+}
+
+template<class Policy,
+         size_t l,
+         typename T,
+         typename A,
+         typename = enable_if_execution_policy_t<Policy>>
+void norm_many(const Policy &                                     policy,
+               const std::vector<Vector<l, T>, A> &               points,
+               details::identity_t<Span<details::norm_type_t<T>>> out)
+{
+    norm_many(policy, Span<const Vector<l, T>>(points), out);
+}
+
+template<size_t l, typename T>
+void norm_many(BatchView<l, const T>                              points,
+               details::identity_t<Span<details::norm_type_t<T>>> out)
+{
+    norm_many(execution::seq, points, out);
+}
+
+template<size_t l, typename T>
+void norm_many(const Batch<l, T> &                                points,
+               details::identity_t<Span<details::norm_type_t<T>>> out)
+{
+    norm_many(execution::seq, points.view(), out);
+}
+
+template<size_t l, typename T>
+void norm_many(Span<const Vector<l, T>>                           points,
+               details::identity_t<Span<details::norm_type_t<T>>> out)
+{
+    norm_many(execution::seq, points, out);
+}
+
+template<size_t l, typename T, typename A>
+void norm_many(const std::vector<Vector<l, T>, A> &               points,
+               details::identity_t<Span<details::norm_type_t<T>>> out)
+{
+    norm_many(execution::seq, Span<const Vector<l, T>>(points), out);
+}
+
+/**
+ * @brief: Calculate the euclidean distance between query and every Vector of
+ * a batch.
+ *
+ * @throws std::invalid_argument If out is smaller than points.
+ */
+template<class Policy,
+         size_t l,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+void distance_many(const Policy &                                     policy,
+                   const Vector<l, T> &                               query,
+                   details::identity_t<BatchView<l, const T>>         points,
+                   details::identity_t<Span<details::norm_type_t<T>>> out)
+{
+    details::distance_many(
+        policy, query, details::make_points(points), points.size(), out);
+}
+
+template<class Policy,
+         size_t l,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+void distance_many(const Policy &                                     policy,
+                   const Vector<l, T> &                               query,
+                   details::identity_t<Span<const Vector<l, T>>>      points,
+                   details::identity_t<Span<details::norm_type_t<T>>> out)
+{
+    details::distance_many(
+        policy, query, details::make_points(points), points.size(), out);
+}
+
+template<size_t l, typename T>
+void distance_many(const Vector<l, T> &                               query,
+                   details::identity_t<BatchView<l, const T>>         points,
+                   details::identity_t<Span<details::norm_type_t<T>>> out)
+{
+    distance_many(execution::seq, query, points, out);
+}
+
+template<size_t l, typename T>
+void distance_many(const Vector<l, T> &                               query,
+                   details::identity_t<Span<const Vector<l, T>>>      points,
+                   details::identity_t<Span<details::norm_type_t<T>>> out)
+{
+    distance_many(execution::seq, query, points, out);
+}
+
+} // namespace colibra
+
+#endif
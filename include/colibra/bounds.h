@@ -0,0 +1,554 @@
+#ifndef COLIBRA_BOUNDS_H
+#define COLIBRA_BOUNDS_H
+
+#include "batch.h"
+#include "batch_ops.h"
+#include "details/bounds.hpp"
+#include "details/math.hpp"
+#include "details/parallel.hpp"
+#include "execution.h"
+#include "matrix.h"
+#include "span.h"
+#include "vector.h"
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace colibra {
+
+/**
+ * @brief: An axis-aligned bounding box, the points p with
+ * lower[d] <= p[d] <= upper[d] in every dimension d.
+ *
+ * A box with lower[d] > upper[d] in any dimension is empty. empty() returns
+ * the box that every expand() and merge() starts from.
+ *
+ * @tparam l The dimension.
+ * @tparam T The data type of the coordinates.
+ */
+template<size_t l, typename T>
+struct Aabb
+{
+    static constexpr size_t dimension = l;
+    using value_type                  = T;
+
+    Vector<l, T> lower {};
+    Vector<l, T> upper {};
+
+    /**
+     * @brief: The box containing no points: lower is the largest and upper
+     * the lowest value of T.
+     */
+    [[nodiscard]] static constexpr Aabb empty()
+    {
+        Aabb box;
+        for (size_t d = 0; d < l; ++d)
+        {
+            box.lower[d] = std::numeric_limits<T>::max();
+            box.upper[d] = std::numeric_limits<T>::lowest();
+        }
+        return box;
+    }
+
+    /**
+     * @brief: The smallest box containing all points, empty() if there are
+     * none.
+     */
+    [[nodiscard]] static constexpr Aabb
+    from_points(Span<const Vector<l, T>> points)
+    {
+        Aabb box = empty();
+        for (const Vector<l, T> &point : points)
+        {
+            box.expand(point);
+        }
+        return box;
+    }
+
+    [[nodiscard]] constexpr bool is_empty() const
+    {
+        for (size_t d = 0; d < l; ++d)
+        {
+            if (lower[d] > upper[d]) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief: Whether the point lies inside the box or on its boundary.
+     */
+    [[nodiscard]] constexpr bool contains(const Vector<l, T> &point) const
+    {
+        for (size_t d = 0; d < l; ++d)
+        {
+            if (point[d] < lower[d] || point[d] > upper[d]) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief: Whether the boxes share at least one point, touching boxes
+     * overlap.
+     */
+    [[nodiscard]] constexpr bool overlaps(const Aabb &other) const
+    {
+        for (size_t d = 0; d < l; ++d)
+        {
+            if (other.lower[d] > upper[d] || lower[d] > other.upper[d])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]] constexpr Vector<l, T> center() const
+    {
+        Vector<l, T> result;
+        for (size_t d = 0; d < l; ++d)
+        {
+            result[d] = (lower[d] + upper[d]) / T {2};
+        }
+        return result;
+    }
+
+    /**
+     * @brief: The edge lengths of the box, upper - lower.
+     */
+    [[nodiscard]] constexpr Vector<l, T> extent() const
+    {
+        Vector<l, T> result;
+        for (size_t d = 0; d < l; ++d)
+        {
+            result[d] = upper[d] - lower[d];
+        }
+        return result;
+    }
+
+    /**
+     * @brief: Grow the box to contain the point.
+     */
+    constexpr Aabb &expand(const Vector<l, T> &point)
+    {
+        for (size_t d = 0; d < l; ++d)
+        {
+            lower[d] = point[d] < lower[d] ? point[d] : lower[d];
+            upper[d] = point[d] > upper[d] ? point[d] : upper[d];
+        }
+        return *this;
+    }
+
+    /**
+     * @brief: Grow the box to contain the other box.
+     */
+    constexpr Aabb &merge(const Aabb &other)
+    {
+        for (size_t d = 0; d < l; ++d)
+        {
+            lower[d] = other.lower[d] < lower[d] ? other.lower[d] : lower[d];
+            upper[d] = other.upper[d] > upper[d] ? other.upper[d] : upper[d];
+        }
+        return *this;
+    }
+
+    [[nodiscard]] constexpr bool operator==(const Aabb &other) const
+    {
+        return lower == other.lower && upper == other.upper;
+    }
+
+    [[nodiscard]] constexpr bool operator!=(const Aabb &other) const
+    {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @brief: A ball, the points with distance at most radius from center.
+ *
+ * @tparam l The dimension.
+ * @tparam T The data type of the coordinates.
+ */
+template<size_t l, typename T>
+struct Sphere
+{
+    static constexpr size_t dimension = l;
+    using value_type                  = T;
+
+    Vector<l, T> center {};
+    T            radius {};
+
+    /**
+     * @brief: Whether the point lies inside the sphere or on its surface.
+     * Compares squared distances, no square root is taken.
+     */
+    [[nodiscard]] constexpr bool contains(const Vector<l, T> &point) const
+    {
+        const Vector<l, T> diff = point - center;
+        return diff * diff <= radius * radius;
+    }
+
+    [[nodiscard]] constexpr bool overlaps(const Sphere &other) const
+    {
+        const Vector<l, T> diff = other.center - center;
+        const T            sum  = radius + other.radius;
+        return diff * diff <= sum * sum;
+    }
+
+    /**
+     * @brief: Whether the sphere and the box share at least one point, tested
+     * with the point of the box closest to the center.
+     */
+    [[nodiscard]] constexpr bool overlaps(const Aabb<l, T> &box) const
+    {
+        T distance_squared {};
+        for (size_t d = 0; d < l; ++d)
+        {
+            const T closest = center[d] < box.lower[d]   ? box.lower[d]
+                              : center[d] > box.upper[d] ? box.upper[d]
+                                                         : center[d];
+            const T diff    = closest - center[d];
+            distance_squared += diff * diff;
+        }
+        return distance_squared <= radius * radius;
+    }
+};
+
+/**
+ * @brief: An oriented bounding box in 3D.
+ *
+ * The columns of rotation are the axes of the box in world coordinates, a
+ * point with box coordinates q is at rotation * q + center. The box covers
+ * -half_extents[k] <= q[k] <= half_extents[k].
+ *
+ * @tparam T The data type of the coordinates.
+ */
+template<typename T>
+struct Obb
+{
+    static constexpr size_t dimension = 3;
+    using value_type                  = T;
+
+    Vector<3, T> center {};
+    /// An orthonormal Matrix with determinant +1.
+    Matrix<3, 3, T> rotation = Matrix<3, 3, T>::identity();
+    Vector<3, T>    half_extents {};
+
+    /**
+     * @brief: The oriented box covering the same points as an axis-aligned
+     * one.
+     */
+    [[nodiscard]] static constexpr Obb from_aabb(const Aabb<3, T> &box)
+    {
+        Obb result;
+        result.center = box.center();
+        for (size_t k = 0; k < 3; ++k)
+        {
+            result.half_extents[k] = (box.upper[k] - box.lower[k]) / T {2};
+        }
+        return result;
+    }
+
+    /**
+     * @brief: Whether the point lies inside the box or on its boundary.
+     */
+    [[nodiscard]] constexpr bool contains(const Vector<3, T> &point) const
+    {
+        const Vector<3, T> local = rotation.transpose() * (point - center);
+        for (size_t k = 0; k < 3; ++k)
+        {
+            if (details::abs(local[k]) > half_extents[k]) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief: Whether the boxes share at least one point.
+     *
+     * Separating axis test over the 3 axes of each box and their 9 cross
+     * products. The rotation between the boxes is padded with epsilon so
+     * nearly parallel edges, whose cross product is close to zero, do not
+     * report a separation.
+     */
+    [[nodiscard]] constexpr bool overlaps(const Obb &other) const
+    {
+        constexpr T epsilon = std::numeric_limits<T>::epsilon();
+
+        // other's axes and center in the frame of this box.
+        const Matrix<3, 3, T> r = rotation.transpose() * other.rotation;
+        const Vector<3, T>    t =
+            rotation.transpose() * (other.center - center);
+        Matrix<3, 3, T> abs_r;
+        for (size_t i = 0; i < 3; ++i)
+        {
+            for (size_t j = 0; j < 3; ++j)
+            {
+                abs_r(i, j) = details::abs(r(i, j)) + epsilon;
+            }
+        }
+
+        const Vector<3, T> &ea = half_extents;
+        const Vector<3, T> &eb = other.half_extents;
+        for (size_t i = 0; i < 3; ++i)
+        {
+            const T rb = eb[0] * abs_r(i, 0) + eb[1] * abs_r(i, 1)
+                         + eb[2] * abs_r(i, 2);
+            if (details::abs(t[i]) > ea[i] + rb) return false;
+        }
+        for (size_t j = 0; j < 3; ++j)
+        {
+            const T ra = ea[0] * abs_r(0, j) + ea[1] * abs_r(1, j)
+                         + ea[2] * abs_r(2, j);
+            const T distance = t[0] * r(0, j) + t[1] * r(1, j) + t[2] * r(2, j);
+            if (details::abs(distance) > ra + eb[j]) return false;
+        }
+        for (size_t i = 0; i < 3; ++i)
+        {
+            const size_t i1 = (i + 1) % 3;
+            const size_t i2 = (i + 2) % 3;
+            for (size_t j = 0; j < 3; ++j)
+            {
+                const size_t j1 = (j + 1) % 3;
+                const size_t j2 = (j + 2) % 3;
+                const T      ra = ea[i1] * abs_r(i2, j) + ea[i2] * abs_r(i1, j);
+                const T      rb = eb[j1] * abs_r(i, j2) + eb[j2] * abs_r(i, j1);
+                const T      distance = t[i2] * r(i1, j) - t[i1] * r(i2, j);
+                if (details::abs(distance) > ra + rb) return false;
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]] constexpr bool overlaps(const Aabb<3, T> &box) const
+    {
+        return overlaps(from_aabb(box));
+    }
+};
+
+/**
+ * @brief: A half-line, the points origin + t * direction for t >= 0.
+ *
+ * direction need not be normalized, parameters are measured in multiples of
+ * it.
+ *
+ * @tparam l The dimension.
+ * @tparam T A floating point type.
+ */
+template<size_t l, typename T>
+struct Ray
+{
+    static_assert(std::is_floating_point_v<T>,
+                  "colibra::Ray requires a floating point type");
+
+    static constexpr size_t dimension = l;
+    using value_type                  = T;
+
+    Vector<l, T> origin {};
+    Vector<l, T> direction {};
+
+    [[nodiscard]] constexpr Vector<l, T> at(const T t) const
+    {
+        return origin + direction * t;
+    }
+
+    /**
+     * @brief: Intersect the ray with a box using the slab test.
+     *
+     * Direction components may be zero, the ray then runs parallel to the
+     * corresponding faces.
+     *
+     * @return The parameter where the ray enters the box, 0 if the origin is
+     * inside, infinity if the ray misses the box.
+     */
+    [[nodiscard]] constexpr T intersect(const Aabb<l, T> &box) const
+    {
+        return details::slab_entry<l>(box.lower.data(),
+                                      box.upper.data(),
+                                      origin.data(),
+                                      direction.data());
+    }
+};
+
+template<size_t l, typename T>
+Aabb(Vector<l, T>, Vector<l, T>) -> Aabb<l, T>;
+
+template<size_t l, typename T>
+Sphere(Vector<l, T>, T) -> Sphere<l, T>;
+
+template<size_t l, typename T>
+Ray(Vector<l, T>, Vector<l, T>) -> Ray<l, T>;
+
+namespace details {
+
+template<size_t l, typename T>
+void contains_points(const Aabb<l, T>      &box,
+                     const SoaPoints<l, T> &points,
+                     uint8_t               *out,
+                     const size_t           begin,
+                     const size_t           end)
+{
+    contains_box_kernel(box.lower, box.upper, points, out, begin, end);
+}
+
+template<size_t l, typename T>
+void contains_points(const Sphere<l, T>    &sphere,
+                     const SoaPoints<l, T> &points,
+                     uint8_t               *out,
+                     const size_t           begin,
+                     const size_t           end)
+{
+    contains_sphere_kernel(
+        sphere.center, sphere.radius, points, out, begin, end);
+}
+
+template<typename T>
+void contains_points(const Obb<T>          &box,
+                     const SoaPoints<3, T> &points,
+                     uint8_t               *out,
+                     const size_t           begin,
+                     const size_t           end)
+{
+    contains_obb_kernel(
+        box.center, box.rotation, box.half_extents, points, out, begin, end);
+}
+
+} // namespace details
+
+/**
+ * @brief: Test which points of a batch lie inside a volume,
+ * out[i] = volume.contains(points[i]).
+ *
+ * The tests are evaluated without branches on structure-of-arrays input, so
+ * the loop vectorizes across the batch.
+ *
+ * @param volume An Aabb, Sphere or Obb.
+ * @param points The batch of points.
+ * @param out Receives 1 for points inside and 0 for points outside.
+ *
+ * @throws std::invalid_argument If out is smaller than points.
+ */
+template<class Policy,
+         class Volume,
+         typename = enable_if_execution_policy_t<Policy>>
+void contains_many(
+    const Policy &policy,
+    const Volume &volume,
+    BatchView<Volume::dimension, const typename Volume::value_type> points,
+    Span<uint8_t>                                                   out)
+{
+    details::check_output_size(
+        points.size(), out.size(), "colibra::contains_many: output too small");
+    const auto soa = details::make_points(points);
+    details::parallel_for(policy, points.size(), [&](size_t begin, size_t end) {
+        details::contains_points(volume, soa, out.data(), begin, end);
+    });
+}
+
+template<class Volume>
+void contains_many(
+    const Volume &volume,
+    BatchView<Volume::dimension, const typename Volume::value_type> points,
+    Span<uint8_t>                                                   out)
+{
+    contains_many(execution::seq, volume, points, out);
+}
+
+/**
+ * @brief: Test a box against a batch of boxes, out[i] = box.overlaps(
+ * {lower[i], upper[i]}).
+ *
+ * @param lower The lower corners of the batch of boxes.
+ * @param upper The upper corners, the same size as lower.
+ *
+ * @throws std::invalid_argument If lower and upper differ in size or out is
+ * smaller.
+ */
+template<class Policy,
+         size_t l,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+void overlaps_many(const Policy                              &policy,
+                   const Aabb<l, T>                          &box,
+                   details::identity_t<BatchView<l, const T>> lower,
+                   details::identity_t<BatchView<l, const T>> upper,
+                   Span<uint8_t>                              out)
+{
+    if (lower.size() != upper.size())
+    {
+        throw std::invalid_argument("colibra::overlaps_many: sizes differ");
+    }
+    details::check_output_size(
+        lower.size(), out.size(), "colibra::overlaps_many: output too small");
+    const auto lower_soa = details::make_points(lower);
+    const auto upper_soa = details::make_points(upper);
+    details::parallel_for(policy, lower.size(), [&](size_t begin, size_t end) {
+        details::overlaps_box_kernel(
+            box.lower, box.upper, lower_soa, upper_soa, out.data(), begin, end);
+    });
+}
+
+template<size_t l, typename T>
+void overlaps_many(const Aabb<l, T>                          &box,
+                   details::identity_t<BatchView<l, const T>> lower,
+                   details::identity_t<BatchView<l, const T>> upper,
+                   Span<uint8_t>                              out)
+{
+    overlaps_many(execution::seq, box, lower, upper, out);
+}
+
+/**
+ * @brief: Intersect a batch of rays with a box,
+ * out[i] = Ray {origins[i], directions[i]}.intersect(box).
+ *
+ * @param origins The ray origins.
+ * @param directions The ray directions, the same size as origins.
+ * @param out Receives the entry parameters, infinity for misses.
+ *
+ * @throws std::invalid_argument If origins and directions differ in size or
+ * out is smaller.
+ */
+template<class Policy,
+         size_t l,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+void intersect_many(const Policy                              &policy,
+                    const Aabb<l, T>                          &box,
+                    details::identity_t<BatchView<l, const T>> origins,
+                    details::identity_t<BatchView<l, const T>> directions,
+                    details::identity_t<Span<T>>               out)
+{
+    static_assert(std::is_floating_point_v<T>,
+                  "colibra::intersect_many requires a floating point type");
+    if (origins.size() != directions.size())
+    {
+        throw std::invalid_argument("colibra::intersect_many: sizes differ");
+    }
+    details::check_output_size(origins.size(),
+                               out.size(),
+                               "colibra::intersect_many: output too small");
+    const auto origin_soa    = details::make_points(origins);
+    const auto direction_soa = details::make_points(directions);
+    details::parallel_for(
+        policy, origins.size(), [&](size_t begin, size_t end) {
+            details::intersect_box_kernel(box.lower,
+                                          box.upper,
+                                          origin_soa,
+                                          direction_soa,
+                                          out.data(),
+                                          begin,
+                                          end);
+        });
+}
+
+template<size_t l, typename T>
+void intersect_many(const Aabb<l, T>                          &box,
+                    details::identity_t<BatchView<l, const T>> origins,
+                    details::identity_t<BatchView<l, const T>> directions,
+                    details::identity_t<Span<T>>               out)
+{
+    intersect_many(execution::seq, box, origins, directions, out);
+}
+
+} // namespace colibra
+
+#endif
@@ -0,0 +1,525 @@
+#ifndef COLIBRA_BVH_H
+#define COLIBRA_BVH_H
+
+#include "batch.h"
+#include "batch_ops.h"
+#include "bounds.h"
+#include "details/bvh.hpp"
+#include "details/parallel.hpp"
+#include "execution.h"
+#include "span.h"
+#include "vector.h"
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace colibra {
+
+/**
+ * @brief: A triangle given by its three corners.
+ *
+ * @tparam T A floating point type.
+ */
+template<typename T>
+struct Triangle
+{
+    Vector<3, T> a {};
+    Vector<3, T> b {};
+    Vector<3, T> c {};
+
+    [[nodiscard]] constexpr Aabb<3, T> bounds() const
+    {
+        Aabb<3, T> box {a, a};
+        box.expand(b).expand(c);
+        return box;
+    }
+
+    [[nodiscard]] constexpr Vector<3, T> centroid() const
+    {
+        return (a + b + c) * (T {1} / T {3});
+    }
+
+    /**
+     * @brief: Intersect a ray with the triangle, both sides count.
+     *
+     * @return The ray parameter of the hit, infinity if the ray misses.
+     */
+    [[nodiscard]] constexpr T intersect(const Ray<3, T> &ray) const
+    {
+        T u {};
+        T v {};
+        return details::intersect_triangle(a,
+                                           b,
+                                           c,
+                                           ray.origin,
+                                           ray.direction,
+                                           std::numeric_limits<T>::infinity(),
+                                           u,
+                                           v);
+    }
+
+    /**
+     * @brief: The point of the triangle closest to point.
+     */
+    [[nodiscard]] constexpr Vector<3, T>
+    closest_point(const Vector<3, T> &point) const
+    {
+        return details::closest_on_triangle(a, b, c, point);
+    }
+};
+
+/**
+ * @brief: The closest hit of a ray with a Bvh.
+ */
+template<typename T>
+struct RayHit
+{
+    /// Index of the triangle in the set the Bvh was built from.
+    size_t index = 0;
+    /// Ray parameter of the hit, infinity if the ray hit nothing.
+    T t = std::numeric_limits<T>::infinity();
+    /// Barycentric coordinates of the hit, the point is
+    /// (1 - u - v) * a + u * b + v * c.
+    T u {};
+    T v {};
+
+    [[nodiscard]] constexpr bool hit() const
+    {
+        return t != std::numeric_limits<T>::infinity();
+    }
+};
+
+/**
+ * @brief: The point of a Bvh closest to a query point.
+ */
+template<typename T>
+struct ClosestPoint
+{
+    /// Index of the triangle in the set the Bvh was built from.
+    size_t index = 0;
+    /// Squared euclidean distance between query and point.
+    T distance_squared = std::numeric_limits<T>::infinity();
+    /// The point on the triangle.
+    Vector<3, T> point {};
+};
+
+/**
+ * @brief: A bounding volume hierarchy over triangles for ray casts and
+ * closest point queries.
+ *
+ * The tree is built top down with the surface area heuristic, evaluated on
+ * 16 bins per axis. The binary tree this produces is then collapsed into
+ * nodes with four children, whose boxes are stored as structure of arrays
+ * in one 64 byte aligned node: a query tests all four children of a node
+ * at once, from two cache lines for float.
+ *
+ * Triangles are copied into leaf order, so each leaf is one contiguous
+ * range. Queries are const and may run concurrently.
+ *
+ * @tparam T A floating point type.
+ */
+template<typename T>
+class Bvh
+{
+    static_assert(std::is_floating_point_v<T>,
+                  "colibra::Bvh requires a floating point type");
+
+  public:
+    /// Largest supported number of triangles per leaf.
+    static constexpr size_t max_leaf_size = 16;
+
+    Bvh() = default;
+
+    /**
+     * @brief: Build the hierarchy from the given triangles. Hit indices
+     * refer to positions in this span.
+     *
+     * With execution::par, binning the top levels and building the subtrees
+     * below them are split across threads. The resulting tree can differ
+     * from a sequential build, query results do not.
+     *
+     * @param leaf_size Number of triangles below which a node always becomes
+     * a leaf. Larger nodes become leaves when the surface area heuristic
+     * rates that cheaper than splitting, up to max_leaf_size triangles.
+     *
+     * @throws std::invalid_argument If leaf_size is 0 or above
+     * max_leaf_size, or if there are more than 2^32 - 1 triangles.
+     */
+    template<class Policy, typename = enable_if_execution_policy_t<Policy>>
+    Bvh(const Policy                                 &policy,
+        details::identity_t<Span<const Triangle<T>>> triangles,
+        const size_t                                 leaf_size = 4)
+    {
+        if (leaf_size == 0 || leaf_size > max_leaf_size)
+        {
+            throw std::invalid_argument("colibra::Bvh: invalid leaf size");
+        }
+        if (triangles.size() >= details::bvh_no_child)
+        {
+            throw std::invalid_argument("colibra::Bvh: too many triangles");
+        }
+
+        std::vector<details::BvhPrimitive<T>> primitives(triangles.size());
+        details::parallel_for(
+            policy, triangles.size(), [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    const Aabb<3, T> box = triangles[i].bounds();
+                    primitives[i]        = details::BvhPrimitive<T> {
+                        box, box.center(), static_cast<uint32_t>(i)};
+                }
+            });
+
+        details::BvhBuilder<T> builder(
+            std::move(primitives), leaf_size, max_leaf_size);
+        const auto             binary = builder.build(policy);
+
+        m_indices = builder.indices();
+        m_triangles.resize(triangles.size());
+        for (size_t i = 0; i < m_indices.size(); ++i)
+        {
+            m_triangles[i] = triangles[m_indices[i]];
+        }
+        if (!binary.empty())
+        {
+            m_bounds = binary.front().bounds;
+            m_nodes.reserve(binary.size() / 2 + 1);
+            collapse(binary, 0);
+        }
+    }
+
+    explicit Bvh(Span<const Triangle<T>> triangles, const size_t leaf_size = 4)
+        : Bvh(execution::seq, triangles, leaf_size)
+    {
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return m_triangles.size();
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return m_triangles.empty();
+    }
+
+    /// Number of four wide nodes.
+    [[nodiscard]] size_t node_count() const
+    {
+        return m_nodes.size();
+    }
+
+    /**
+     * @brief: The box around all triangles, empty() for an empty Bvh.
+     */
+    [[nodiscard]] Aabb<3, T> bounds() const
+    {
+        return m_bounds;
+    }
+
+    /**
+     * @brief: Find the closest triangle hit by the ray with a parameter in
+     * [0, t_max).
+     *
+     * Children are visited front to back, subtrees are skipped as soon as
+     * they start behind the closest hit found so far.
+     *
+     * @return The hit, RayHit::hit() is false if the ray hit nothing.
+     */
+    [[nodiscard]] RayHit<T>
+    intersect(const Ray<3, T> &ray,
+              const T          t_max = std::numeric_limits<T>::infinity()) const
+    {
+        return traverse<false>(ray, t_max);
+    }
+
+    /**
+     * @brief: Whether the ray hits any triangle with a parameter in
+     * [0, t_max). Stops at the first hit, which is cheaper than intersect
+     * for shadow and visibility rays.
+     */
+    [[nodiscard]] bool
+    occluded(const Ray<3, T> &ray,
+             const T          t_max = std::numeric_limits<T>::infinity()) const
+    {
+        return traverse<true>(ray, t_max).hit();
+    }
+
+    /**
+     * @brief: Find the point on the triangles closest to query.
+     *
+     * @throws std::out_of_range If the Bvh is empty.
+     */
+    [[nodiscard]] ClosestPoint<T> nearest(const Vector<3, T> &query) const
+    {
+        if (m_nodes.empty())
+        {
+            throw std::out_of_range("colibra::Bvh is empty");
+        }
+
+        Entry  stack[details::bvh_stack_size];
+        size_t top   = 0;
+        stack[top++] = Entry {0, 0, T {0}};
+
+        ClosestPoint<T> best;
+        while (top > 0)
+        {
+            const Entry entry = stack[--top];
+            if (!(entry.key < best.distance_squared)) continue;
+
+            if (entry.count > 0)
+            {
+                for (uint32_t i = entry.child; i < entry.child + entry.count;
+                     ++i)
+                {
+                    const Triangle<T> &triangle = m_triangles[i];
+                    const Vector<3, T> point    = triangle.closest_point(query);
+                    const Vector<3, T> diff     = point - query;
+                    const T            distance = diff * diff;
+                    if (distance < best.distance_squared)
+                    {
+                        best = ClosestPoint<T> {m_indices[i], distance, point};
+                    }
+                }
+                continue;
+            }
+
+            const details::BvhNode<T> &node = m_nodes[entry.child];
+            T distances[details::bvh_width];
+            details::distance_to_children(node, query.data(), distances);
+            push_sorted(node, distances, best.distance_squared, stack, top);
+        }
+        return best;
+    }
+
+  private:
+    /// A child waiting on the traversal stack, key is its distance or entry
+    /// parameter.
+    struct Entry
+    {
+        uint32_t child;
+        uint32_t count;
+        T        key;
+    };
+
+    std::vector<details::BvhNode<T>> m_nodes;
+    std::vector<Triangle<T>>         m_triangles;
+    std::vector<uint32_t>            m_indices;
+    Aabb<3, T>                       m_bounds = Aabb<3, T>::empty();
+
+    /// Turn the binary subtree at index into a four wide node by repeatedly
+    /// replacing the inner child with the largest surface by its children.
+    uint32_t collapse(const std::vector<details::BvhBuildNode<T>> &binary,
+                      const uint32_t                               index)
+    {
+        const auto node = static_cast<uint32_t>(m_nodes.size());
+        m_nodes.emplace_back();
+
+        std::array<uint32_t, details::bvh_width> children {};
+        size_t                                   count = 0;
+        if (binary[index].count > 0)
+        {
+            children[count++] = index;
+        }
+        else
+        {
+            children[count++] = binary[index].left;
+            children[count++] = binary[index].right;
+        }
+        while (count < details::bvh_width)
+        {
+            size_t largest = details::bvh_width;
+            T      area    = -1;
+            for (size_t k = 0; k < count; ++k)
+            {
+                const details::BvhBuildNode<T> &child = binary[children[k]];
+                if (child.count == 0 && details::half_area(child.bounds) > area)
+                {
+                    largest = k;
+                    area    = details::half_area(child.bounds);
+                }
+            }
+            if (largest == details::bvh_width) break;
+
+            const details::BvhBuildNode<T> &child = binary[children[largest]];
+            children[largest]                     = child.left;
+            children[count++]                     = child.right;
+        }
+
+        for (size_t k = 0; k < details::bvh_width; ++k)
+        {
+            const bool used  = k < count;
+            const auto empty = Aabb<3, T>::empty();
+            const Aabb<3, T> &box =
+                used ? binary[children[k]].bounds : empty;
+            uint32_t child_index = details::bvh_no_child;
+            uint32_t child_count = 0;
+            if (used && binary[children[k]].count > 0)
+            {
+                child_index = binary[children[k]].begin;
+                child_count = binary[children[k]].count;
+            }
+            else if (used)
+            {
+                child_index = collapse(binary, children[k]);
+            }
+
+            details::BvhNode<T> &target = m_nodes[node];
+            for (size_t d = 0; d < 3; ++d)
+            {
+                target.lower[d][k] = box.lower[d];
+                target.upper[d][k] = box.upper[d];
+            }
+            target.child[k] = child_index;
+            target.count[k] = child_count;
+        }
+        return node;
+    }
+
+    /// Push the children of node closer than bound so that the closest one
+    /// is on top of the stack.
+    static void push_sorted(const details::BvhNode<T> &node,
+                            const T                   *key,
+                            const T                    bound,
+                            Entry                     *stack,
+                            size_t                    &top)
+    {
+        Entry  hits[details::bvh_width];
+        size_t count = 0;
+        for (size_t k = 0; k < details::bvh_width; ++k)
+        {
+            if (key[k] < bound && node.child[k] != details::bvh_no_child)
+            {
+                // Insertion sort by descending key.
+                size_t position = count++;
+                while (position > 0 && hits[position - 1].key < key[k])
+                {
+                    hits[position] = hits[position - 1];
+                    --position;
+                }
+                hits[position] = Entry {node.child[k], node.count[k], key[k]};
+            }
+        }
+        for (size_t k = 0; k < count; ++k)
+        {
+            stack[top++] = hits[k];
+        }
+    }
+
+    template<bool any_hit>
+    RayHit<T> traverse(const Ray<3, T> &ray, const T t_max) const
+    {
+        RayHit<T> best;
+        if (m_nodes.empty())
+        {
+            return best;
+        }
+
+        T    inverse[3];
+        bool negative[3];
+        for (size_t d = 0; d < 3; ++d)
+        {
+            inverse[d]  = T {1} / ray.direction[d];
+            negative[d] = inverse[d] < T {0};
+        }
+
+        Entry  stack[details::bvh_stack_size];
+        size_t top   = 0;
+        stack[top++] = Entry {0, 0, T {0}};
+
+        T bound = t_max;
+        while (top > 0)
+        {
+            const Entry entry = stack[--top];
+            if (!(entry.key < bound)) continue;
+
+            if (entry.count > 0)
+            {
+                for (uint32_t i = entry.child; i < entry.child + entry.count;
+                     ++i)
+                {
+                    const Triangle<T> &triangle = m_triangles[i];
+                    T                  u {};
+                    T                  v {};
+                    const T            t = details::intersect_triangle(
+                        triangle.a,
+                        triangle.b,
+                        triangle.c,
+                        ray.origin,
+                        ray.direction,
+                        bound,
+                        u,
+                        v);
+                    if (t < bound)
+                    {
+                        bound = t;
+                        best  = RayHit<T> {m_indices[i], t, u, v};
+                        if constexpr (any_hit)
+                        {
+                            return best;
+                        }
+                    }
+                }
+                continue;
+            }
+
+            const details::BvhNode<T> &node = m_nodes[entry.child];
+            T                          entries[details::bvh_width];
+            details::intersect_children(
+                node, ray.origin.data(), inverse, negative, bound, entries);
+            push_sorted(node, entries, bound, stack, top);
+        }
+        return best;
+    }
+};
+
+/**
+ * @brief: Cast a batch of rays into a Bvh, out[i] = bvh.intersect(
+ * Ray {origins[i], directions[i]}).
+ *
+ * @throws std::invalid_argument If origins and directions differ in size or
+ * out is smaller.
+ */
+template<class Policy,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+void intersect_many(const Policy                              &policy,
+                    const Bvh<T>                              &bvh,
+                    details::identity_t<BatchView<3, const T>> origins,
+                    details::identity_t<BatchView<3, const T>> directions,
+                    details::identity_t<Span<RayHit<T>>>       out)
+{
+    if (origins.size() != directions.size())
+    {
+        throw std::invalid_argument("colibra::intersect_many: sizes differ");
+    }
+    details::check_output_size(origins.size(),
+                               out.size(),
+                               "colibra::intersect_many: output too small");
+    // Rays cost far more than the elementwise operations the grain of a
+    // policy is measured in.
+    const auto rays = details::rows_policy(policy, 256);
+    details::parallel_for(rays, origins.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            out[i] = bvh.intersect(Ray<3, T> {origins[i], directions[i]});
+        }
+    });
+}
+
+template<typename T>
+void intersect_many(const Bvh<T>                              &bvh,
+                    details::identity_t<BatchView<3, const T>> origins,
+                    details::identity_t<BatchView<3, const T>> directions,
+                    details::identity_t<Span<RayHit<T>>>       out)
+{
+    intersect_many(execution::seq, bvh, origins, directions, out);
+}
+
+} // namespace colibra
+
+#endif
@@ -0,0 +1,510 @@
+#ifndef COLIBRA_COMPLEX_H
+#define COLIBRA_COMPLEX_H
+
+#include "batch_ops.h"
+#include "details/complex.hpp"
+#include "details/parallel.hpp"
+#include "execution.h"
+#include "span.h"
+#include "vector.h"
+
+#include <complex>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace colibra {
+
+/**
+ * @brief: A non-owning view onto complex values stored as two separate
+ * arrays, one with the real and one with the imaginary parts.
+ *
+ * This split layout is the structure-of-arrays form of std::complex: kernels
+ * on split arrays need no shuffles, so they vectorize as plain loops.
+ *
+ * @tparam T The data type of the parts, const qualified for read-only views.
+ */
+template<typename T>
+class SplitComplexView
+{
+    using value_type_ = std::remove_const_t<T>;
+
+  public:
+    constexpr SplitComplexView() = default;
+
+    /**
+     * @brief: Create a view onto size values with the given real and
+     * imaginary parts.
+     */
+    constexpr SplitComplexView(T *real, T *imag, const size_t size)
+        : m_real(real)
+        , m_imag(imag)
+        , m_size(size)
+    {
+    }
+
+    /**
+     * @brief: Allow implicit conversion from mutable to read-only views.
+     */
+    template<typename U,
+             typename = std::enable_if_t<!std::is_same_v<U, T>
+                                         && std::is_convertible_v<U *, T *>>>
+    constexpr SplitComplexView(const SplitComplexView<U> &other)
+        : m_real(other.real())
+        , m_imag(other.imag())
+        , m_size(other.size())
+    {
+    }
+
+    [[nodiscard]] constexpr size_t size() const
+    {
+        return m_size;
+    }
+
+    [[nodiscard]] constexpr bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    [[nodiscard]] constexpr T *real() const
+    {
+        return m_real;
+    }
+
+    [[nodiscard]] constexpr T *imag() const
+    {
+        return m_imag;
+    }
+
+    /**
+     * @brief: Gather the value with the given index.
+     *
+     * @warning Does not perform range-checking.
+     */
+    [[nodiscard]] constexpr std::complex<value_type_>
+    operator[](const size_t i) const
+    {
+        return std::complex<value_type_>(m_real[i], m_imag[i]);
+    }
+
+    /**
+     * @brief: Create a view onto count values starting at offset.
+     *
+     * @throws std::out_of_range When the requested range exceeds this view.
+     */
+    [[nodiscard]] constexpr SplitComplexView subview(const size_t offset,
+                                                     const size_t count) const
+    {
+        if (offset > m_size || count > m_size - offset)
+        {
+            throw std::out_of_range(
+                "colibra::SplitComplexView::subview out of range");
+        }
+        return SplitComplexView(m_real + offset, m_imag + offset, count);
+    }
+
+  private:
+    T     *m_real = nullptr;
+    T     *m_imag = nullptr;
+    size_t m_size = 0;
+};
+
+/**
+ * @brief: An owning container of complex values in split layout, see
+ * SplitComplexView.
+ *
+ * @tparam T The data type of the real and imaginary parts.
+ */
+template<typename T>
+class SplitComplex
+{
+  public:
+    SplitComplex() = default;
+
+    /**
+     * @brief: Create size zero values.
+     */
+    explicit SplitComplex(const size_t size)
+    {
+        resize(size);
+    }
+
+    /**
+     * @brief: Split interleaved std::complex values.
+     */
+    explicit SplitComplex(Span<const std::complex<T>> values)
+    {
+        resize(values.size());
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            set(i, values[i]);
+        }
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return m_real.size();
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return m_real.empty();
+    }
+
+    void reserve(const size_t capacity)
+    {
+        m_real.reserve(capacity);
+        m_imag.reserve(capacity);
+    }
+
+    void resize(const size_t size)
+    {
+        m_real.resize(size);
+        m_imag.resize(size);
+    }
+
+    void clear()
+    {
+        m_real.clear();
+        m_imag.clear();
+    }
+
+    void push_back(const std::complex<T> &value)
+    {
+        m_real.push_back(value.real());
+        m_imag.push_back(value.imag());
+    }
+
+    /**
+     * @brief: Store value in the slot with the given index.
+     *
+     * @warning Does not perform range-checking.
+     */
+    void set(const size_t i, const std::complex<T> &value)
+    {
+        m_real[i] = value.real();
+        m_imag[i] = value.imag();
+    }
+
+    /**
+     * @brief: Gather the value with the given index.
+     *
+     * @warning Does not perform range-checking.
+     */
+    [[nodiscard]] std::complex<T> operator[](const size_t i) const
+    {
+        return std::complex<T>(m_real[i], m_imag[i]);
+    }
+
+    /**
+     * @brief: Gather the value with the given index with range checking.
+     *
+     * @throws std::out_of_range When accessing values out of range.
+     */
+    [[nodiscard]] std::complex<T> at(const size_t i) const
+    {
+        if (i >= size())
+        {
+            throw std::out_of_range("colibra::SplitComplex::at out of range");
+        }
+        return (*this)[i];
+    }
+
+    [[nodiscard]] T *real()
+    {
+        return m_real.data();
+    }
+
+    [[nodiscard]] const T *real() const
+    {
+        return m_real.data();
+    }
+
+    [[nodiscard]] T *imag()
+    {
+        return m_imag.data();
+    }
+
+    [[nodiscard]] const T *imag() const
+    {
+        return m_imag.data();
+    }
+
+    [[nodiscard]] SplitComplexView<T> view()
+    {
+        return SplitComplexView<T>(m_real.data(), m_imag.data(), size());
+    }
+
+    [[nodiscard]] SplitComplexView<const T> view() const
+    {
+        return SplitComplexView<const T>(m_real.data(), m_imag.data(), size());
+    }
+
+    operator SplitComplexView<const T>() const
+    {
+        return view();
+    }
+
+    /**
+     * @brief: Write the values interleaved into out.
+     *
+     * @throws std::invalid_argument If out is smaller than this.
+     */
+    void interleave(Span<std::complex<T>> out) const
+    {
+        if (out.size() < size())
+        {
+            throw std::invalid_argument(
+                "colibra::SplitComplex::interleave: output too small");
+        }
+        for (size_t i = 0; i < size(); ++i)
+        {
+            out[i] = (*this)[i];
+        }
+    }
+
+  private:
+    std::vector<T> m_real;
+    std::vector<T> m_imag;
+};
+
+/**
+ * @brief: The complex conjugate of every element. Other element types are
+ * returned unchanged.
+ */
+template<size_t l, typename T>
+[[nodiscard]] constexpr Vector<l, T> conjugate(const Vector<l, T> &vec)
+{
+    Vector<l, T> result;
+    for (size_t i = 0; i < l; ++i)
+    {
+        result[i] = details::conjugate(vec[i]);
+    }
+    return result;
+}
+
+/**
+ * @brief: The complex inner product, sum of conj(vec[i]) * other[i].
+ *
+ * The first operand is conjugated, like numpy.vdot and BLAS cdotc. The
+ * result type follows the default promotion policy, see promotion.h. For
+ * real element types this is the dot product.
+ */
+template<size_t l, typename T, typename S, typename R = promoted_t<T, S>>
+[[nodiscard]] constexpr R conjugate_dot(const Vector<l, T> &vec,
+                                        const Vector<l, S> &other)
+{
+    return details::dot<R, l>(
+        [&vec](const size_t i) {
+            return details::conjugate(static_cast<R>(vec[i]));
+        },
+        [&other](const size_t i) { return static_cast<R>(other[i]); });
+}
+
+namespace details {
+
+inline void check_same_size(const size_t a, const size_t b, const char *what)
+{
+    if (a != b)
+    {
+        throw std::invalid_argument(what);
+    }
+}
+
+} // namespace details
+
+/**
+ * @brief: Multiply two complex signals element-wise, out[i] = a[i] * b[i].
+ *
+ * Split signals are processed as plain loops over the real and imaginary
+ * arrays, which the compiler vectorizes. Products use the textbook formula
+ * without the special handling of infinite components std::complex does.
+ * out may be a or b.
+ *
+ * @throws std::invalid_argument If a and b differ in size or out is smaller.
+ */
+template<class Policy,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+void complex_multiply(const Policy                                  &policy,
+                      details::identity_t<SplitComplexView<const T>> a,
+                      details::identity_t<SplitComplexView<const T>> b,
+                      SplitComplexView<T>                            out)
+{
+    details::check_same_size(
+        a.size(), b.size(), "colibra::complex_multiply: sizes differ");
+    details::check_output_size(
+        a.size(), out.size(), "colibra::complex_multiply: output too small");
+    details::parallel_for(policy, a.size(), [&](size_t begin, size_t end) {
+        details::complex_multiply_strided<1>(a.real(),
+                                             a.imag(),
+                                             b.real(),
+                                             b.imag(),
+                                             out.real(),
+                                             out.imag(),
+                                             begin,
+                                             end);
+    });
+}
+
+/**
+ * @brief: Multiply two interleaved complex signals element-wise,
+ * out[i] = a[i] * b[i].
+ *
+ * Uses SSE3 for float and double when compiled with it, see
+ * complex_multiply on split signals for the semantics.
+ *
+ * @throws std::invalid_argument If a and b differ in size or out is smaller.
+ */
+template<class Policy,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+void complex_multiply(const Policy                                    &policy,
+                      details::identity_t<Span<const std::complex<T>>> a,
+                      details::identity_t<Span<const std::complex<T>>> b,
+                      Span<std::complex<T>>                            out)
+{
+    details::check_same_size(
+        a.size(), b.size(), "colibra::complex_multiply: sizes differ");
+    details::check_output_size(
+        a.size(), out.size(), "colibra::complex_multiply: output too small");
+    details::parallel_for(policy, a.size(), [&](size_t begin, size_t end) {
+        details::complex_multiply_kernel(
+            a.data(), b.data(), out.data(), begin, end);
+    });
+}
+
+template<typename T>
+void complex_multiply(details::identity_t<SplitComplexView<const T>> a,
+                      details::identity_t<SplitComplexView<const T>> b,
+                      SplitComplexView<T>                            out)
+{
+    complex_multiply(execution::seq, a, b, out);
+}
+
+template<typename T>
+void complex_multiply(details::identity_t<Span<const std::complex<T>>> a,
+                      details::identity_t<Span<const std::complex<T>>> b,
+                      Span<std::complex<T>>                            out)
+{
+    complex_multiply(execution::seq, a, b, out);
+}
+
+/**
+ * @brief: The complex inner product of two signals, sum of
+ * conj(a[i]) * b[i].
+ *
+ * Accumulates in several independent partial sums, so the result can differ
+ * from a sequential sum in the last bits. Parallel execution adds the
+ * partial results of the threads in the order they finish.
+ *
+ * @throws std::invalid_argument If a and b differ in size.
+ */
+template<class Policy,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+[[nodiscard]] std::complex<T>
+conjugate_dot(const Policy                                  &policy,
+              SplitComplexView<const T>                      a,
+              details::identity_t<SplitComplexView<const T>> b)
+{
+    details::check_same_size(
+        a.size(), b.size(), "colibra::conjugate_dot: sizes differ");
+    return details::parallel_reduce<std::complex<T>>(
+        policy,
+        a.size(),
+        [&](const size_t begin, const size_t end, std::complex<T> &local) {
+            local = details::conjugate_dot_split(
+                a.real(), a.imag(), b.real(), b.imag(), begin, end);
+        },
+        [](std::complex<T> &total, const std::complex<T> &local) {
+            total += local;
+        });
+}
+
+template<class Policy,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+[[nodiscard]] std::complex<T>
+conjugate_dot(const Policy                                  &policy,
+              const SplitComplex<T>                         &a,
+              details::identity_t<SplitComplexView<const T>> b)
+{
+    return conjugate_dot(policy, a.view(), b);
+}
+
+/**
+ * @brief: The complex inner product of two interleaved signals, sum of
+ * conj(a[i]) * b[i]. Uses SSE3 for float and double when compiled with it.
+ *
+ * @throws std::invalid_argument If a and b differ in size.
+ */
+template<class Policy,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+[[nodiscard]] std::complex<T>
+conjugate_dot(const Policy                                    &policy,
+              Span<const std::complex<T>>                      a,
+              details::identity_t<Span<const std::complex<T>>> b)
+{
+    details::check_same_size(
+        a.size(), b.size(), "colibra::conjugate_dot: sizes differ");
+    return details::parallel_reduce<std::complex<T>>(
+        policy,
+        a.size(),
+        [&](const size_t begin, const size_t end, std::complex<T> &local) {
+            local =
+                details::conjugate_dot_kernel(a.data(), b.data(), begin, end);
+        },
+        [](std::complex<T> &total, const std::complex<T> &local) {
+            total += local;
+        });
+}
+
+template<class Policy,
+         typename T,
+         typename A,
+         typename = enable_if_execution_policy_t<Policy>>
+[[nodiscard]] std::complex<T>
+conjugate_dot(const Policy                                    &policy,
+              const std::vector<std::complex<T>, A>           &a,
+              details::identity_t<Span<const std::complex<T>>> b)
+{
+    return conjugate_dot(policy, Span<const std::complex<T>>(a), b);
+}
+
+template<typename T>
+[[nodiscard]] std::complex<T>
+conjugate_dot(SplitComplexView<const T>                      a,
+              details::identity_t<SplitComplexView<const T>> b)
+{
+    return conjugate_dot(execution::seq, a, b);
+}
+
+template<typename T>
+[[nodiscard]] std::complex<T>
+conjugate_dot(const SplitComplex<T>                         &a,
+              details::identity_t<SplitComplexView<const T>> b)
+{
+    return conjugate_dot(execution::seq, a.view(), b);
+}
+
+template<typename T>
+[[nodiscard]] std::complex<T>
+conjugate_dot(Span<const std::complex<T>>                      a,
+              details::identity_t<Span<const std::complex<T>>> b)
+{
+    return conjugate_dot(execution::seq, a, b);
+}
+
+template<typename T, typename A>
+[[nodiscard]] std::complex<T>
+conjugate_dot(const std::vector<std::complex<T>, A>           &a,
+              details::identity_t<Span<const std::complex<T>>> b)
+{
+    return conjugate_dot(execution::seq, Span<const std::complex<T>>(a), b);
+}
+
+} // namespace colibra
+
+#endif
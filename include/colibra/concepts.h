@@ -0,0 +1,123 @@
+#ifndef COLIBRA_CONCEPTS_H
+#define COLIBRA_CONCEPTS_H
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief: Whether operators are constrained with C++20 concepts.
+ *
+ * Defaults to 1 when the compiler supports concepts and 0 otherwise, in which
+ * case the same constraints are expressed with std::enable_if. Define
+ * COLIBRA_CONCEPTS=0 before including any colibra header to use the C++17
+ * constraints in a C++20 build.
+ */
+#ifndef COLIBRA_CONCEPTS
+#if defined(__cpp_concepts) && __cpp_concepts >= 201907L
+#define COLIBRA_CONCEPTS 1
+#else
+#define COLIBRA_CONCEPTS 0
+#endif
+#endif
+
+namespace colibra {
+
+template<size_t l, typename T>
+class Vector;
+
+template<int Frac, typename Rep>
+class Fixed;
+
+/**
+ * @brief: The kind of element type, which selects the kernels Vector
+ * operations use.
+ */
+enum class ElementCategory
+{
+    /// Built-in integer and floating point types.
+    arithmetic,
+    /// std::complex and other types with a floating point value_type and
+    /// real() and imag() members.
+    complex,
+    /// colibra::Fixed.
+    fixed_point,
+    /// Everything else, e.g. half. Uses the type's own operators.
+    other,
+};
+
+namespace details {
+
+template<typename T, typename = void>
+struct is_complex_like : std::false_type
+{
+};
+
+template<typename T>
+struct is_complex_like<T,
+                       std::void_t<typename T::value_type,
+                                   decltype(std::declval<const T &>().real()),
+                                   decltype(std::declval<const T &>().imag())>>
+    : std::is_floating_point<typename T::value_type>
+{
+};
+
+} // namespace details
+
+template<typename T>
+struct element_category
+    : std::integral_constant<ElementCategory,
+                             std::is_arithmetic_v<T>
+                                 ? ElementCategory::arithmetic
+                                 : (details::is_complex_like<T>::value
+                                        ? ElementCategory::complex
+                                        : ElementCategory::other)>
+{
+};
+
+template<int Frac, typename Rep>
+struct element_category<Fixed<Frac, Rep>>
+    : std::integral_constant<ElementCategory, ElementCategory::fixed_point>
+{
+};
+
+template<typename T>
+inline constexpr ElementCategory element_category_v =
+    element_category<T>::value;
+
+template<typename T>
+struct is_vector : std::false_type
+{
+};
+
+template<size_t l, typename T>
+struct is_vector<Vector<l, T>> : std::true_type
+{
+};
+
+template<typename T>
+inline constexpr bool is_vector_v = is_vector<T>::value;
+
+namespace details {
+
+/// S if it can be the scalar operand of a Vector operation. Vectors fail
+/// here, before the promotion policy is instantiated for them.
+template<typename S>
+using scalar_operand_t = std::enable_if_t<!is_vector_v<S>, S>;
+
+} // namespace details
+
+#if COLIBRA_CONCEPTS
+
+/**
+ * @brief: Anything that is not a Vector. Whether it combines with the
+ * elements of a Vector is left to the promotion policy.
+ */
+template<typename T>
+concept scalar_operand = !is_vector_v<T>;
+
+#endif
+
+} // namespace colibra
+
+#endif
@@ -0,0 +1,719 @@
+#ifndef COLIBRA_DECOMPOSITIONS_H
+#define COLIBRA_DECOMPOSITIONS_H
+
+#include "details/decompositions.hpp"
+#include "matrix.h"
+#include "vector.h"
+
+#include <array>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace colibra {
+
+namespace details {
+
+template<typename T>
+constexpr void require_floating_point()
+{
+    static_assert(std::is_floating_point_v<T>,
+                  "Decompositions require floating-point matrices");
+}
+
+} // namespace details
+
+/**
+ * @brief: LU decomposition with partial pivoting, P * A = L * U.
+ *
+ * L (unit diagonal, not stored) and U share one Matrix: U on and above the
+ * diagonal, the multipliers of L below it.
+ */
+template<size_t n, typename T>
+struct LU
+{
+    Matrix<n, n, T> factors;
+    /// Row i of P * A is row permutation[i] of A.
+    std::array<size_t, n> permutation;
+    /// Determinant of P, +1 or -1.
+    int sign;
+
+    /**
+     * @brief: Whether a pivot is exactly zero, i.e. A is singular.
+     */
+    [[nodiscard]] constexpr bool singular() const
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (factors(i, i) == T {0})
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    [[nodiscard]] constexpr T determinant() const
+    {
+        T det = static_cast<T>(sign);
+        for (size_t i = 0; i < n; ++i)
+        {
+            det *= factors(i, i);
+        }
+        return det;
+    }
+
+    /**
+     * @brief: Solve A * X = B for X.
+     *
+     * @throws std::domain_error If A is singular.
+     */
+    template<size_t m>
+    [[nodiscard]] constexpr Matrix<n, m, T>
+    solve(const Matrix<n, m, T> &b) const
+    {
+        if (singular())
+        {
+            throw std::domain_error("colibra::LU::solve: singular matrix");
+        }
+        Matrix<n, m, T> x;
+        for (size_t i = 0; i < n; ++i)
+        {
+            for (size_t k = 0; k < m; ++k)
+            {
+                x(i, k) = b(permutation[i], k);
+            }
+        }
+        // Forward substitution with the unit lower triangle.
+        for (size_t i = 1; i < n; ++i)
+        {
+            for (size_t j = 0; j < i; ++j)
+            {
+                for (size_t k = 0; k < m; ++k)
+                {
+                    x(i, k) -= factors(i, j) * x(j, k);
+                }
+            }
+        }
+        // Back substitution with the upper triangle.
+        for (size_t i = n; i-- > 0;)
+        {
+            for (size_t j = i + 1; j < n; ++j)
+            {
+                for (size_t k = 0; k < m; ++k)
+                {
+                    x(i, k) -= factors(i, j) * x(j, k);
+                }
+            }
+            for (size_t k = 0; k < m; ++k)
+            {
+                x(i, k) /= factors(i, i);
+            }
+        }
+        return x;
+    }
+
+    /**
+     * @brief: Solve A * x = b for x.
+     *
+     * @throws std::domain_error If A is singular.
+     */
+    [[nodiscard]] constexpr Vector<n, T> solve(const Vector<n, T> &b) const
+    {
+        return solve(Matrix<n, 1, T>::from_cols(b)).col(0);
+    }
+
+    /**
+     * @throws std::domain_error If A is singular.
+     */
+    [[nodiscard]] constexpr Matrix<n, n, T> inverse() const
+    {
+        return solve(Matrix<n, n, T>::identity());
+    }
+};
+
+/**
+ * @brief: Factorize a square Matrix into P * A = L * U with partial pivoting.
+ *
+ * For n up to 6 the elimination steps are unrolled at compile time. Never
+ * throws, check LU::singular() before relying on the factors.
+ */
+template<size_t n, typename T>
+[[nodiscard]] constexpr LU<n, T> lu(const Matrix<n, n, T> &a)
+{
+    details::require_floating_point<T>();
+
+    LU<n, T> result {a, {}, 1};
+    for (size_t i = 0; i < n; ++i)
+    {
+        result.permutation[i] = i;
+    }
+
+    Matrix<n, n, T> &m = result.factors;
+    details::unrolled_for<n>([&](const auto step) {
+        const size_t k = step;
+
+        size_t pivot = k;
+        for (size_t i = k + 1; i < n; ++i)
+        {
+            if (details::abs(m(i, k)) > details::abs(m(pivot, k)))
+            {
+                pivot = i;
+            }
+        }
+        if (pivot != k)
+        {
+            for (size_t j = 0; j < n; ++j)
+            {
+                const T tmp = m(k, j);
+                m(k, j)     = m(pivot, j);
+                m(pivot, j) = tmp;
+            }
+            const size_t tmp             = result.permutation[k];
+            result.permutation[k]        = result.permutation[pivot];
+            result.permutation[pivot]    = tmp;
+            result.sign                  = -result.sign;
+        }
+        if (m(k, k) == T {0})
+        {
+            return;
+        }
+        for (size_t i = k + 1; i < n; ++i)
+        {
+            const T factor = m(i, k) / m(k, k);
+            m(i, k)        = factor;
+            for (size_t j = k + 1; j < n; ++j)
+            {
+                m(i, j) -= factor * m(k, j);
+            }
+        }
+    });
+    return result;
+}
+
+/**
+ * @brief: Cholesky decomposition A = L * L^T of a symmetric positive
+ * definite Matrix.
+ */
+template<size_t n, typename T>
+struct Cholesky
+{
+    /// Lower triangular factor, zeros above the diagonal.
+    Matrix<n, n, T> l;
+    /// False if A turned out not to be positive definite, l is then
+    /// incomplete.
+    bool positive_definite;
+
+    /**
+     * @brief: Solve A * x = b for x.
+     *
+     * @throws std::domain_error If A is not positive definite.
+     */
+    [[nodiscard]] constexpr Vector<n, T> solve(const Vector<n, T> &b) const
+    {
+        if (!positive_definite)
+        {
+            throw std::domain_error(
+                "colibra::Cholesky::solve: matrix not positive definite");
+        }
+        Vector<n, T> x = b;
+        for (size_t i = 0; i < n; ++i)
+        {
+            for (size_t j = 0; j < i; ++j)
+            {
+                x[i] -= l(i, j) * x[j];
+            }
+            x[i] /= l(i, i);
+        }
+        for (size_t i = n; i-- > 0;)
+        {
+            for (size_t j = i + 1; j < n; ++j)
+            {
+                x[i] -= l(j, i) * x[j];
+            }
+            x[i] /= l(i, i);
+        }
+        return x;
+    }
+
+    [[nodiscard]] constexpr T determinant() const
+    {
+        T det {1};
+        for (size_t i = 0; i < n; ++i)
+        {
+            det *= l(i, i) * l(i, i);
+        }
+        return det;
+    }
+};
+
+/**
+ * @brief: Factorize a symmetric positive definite Matrix into L * L^T.
+ *
+ * Only the lower triangle of a is read. Never throws, check
+ * Cholesky::positive_definite.
+ */
+template<size_t n, typename T>
+[[nodiscard]] constexpr Cholesky<n, T> cholesky(const Matrix<n, n, T> &a)
+{
+    details::require_floating_point<T>();
+
+    Cholesky<n, T> result {Matrix<n, n, T> {}, true};
+    Matrix<n, n, T> &l = result.l;
+    details::unrolled_for<n>([&](const auto step) {
+        const size_t j = step;
+        if (!result.positive_definite)
+        {
+            return;
+        }
+
+        T diagonal = a(j, j);
+        for (size_t k = 0; k < j; ++k)
+        {
+            diagonal -= l(j, k) * l(j, k);
+        }
+        if (!(diagonal > T {0}))
+        {
+            result.positive_definite = false;
+            return;
+        }
+        l(j, j) = details::sqrt(diagonal);
+        for (size_t i = j + 1; i < n; ++i)
+        {
+            T sum = a(i, j);
+            for (size_t k = 0; k < j; ++k)
+            {
+                sum -= l(i, k) * l(j, k);
+            }
+            l(i, j) = sum / l(j, j);
+        }
+    });
+    return result;
+}
+
+/**
+ * @brief: QR decomposition A = Q * R with orthogonal Q and upper triangular
+ * R.
+ */
+template<size_t rows, size_t cols, typename T>
+struct QR
+{
+    Matrix<rows, rows, T> q;
+    Matrix<rows, cols, T> r;
+
+    /**
+     * @brief: Solve A * x = b in the least squares sense, for rows >= cols.
+     *
+     * @throws std::domain_error If A does not have full column rank.
+     */
+    [[nodiscard]] constexpr Vector<cols, T>
+    solve(const Vector<rows, T> &b) const
+    {
+        static_assert(rows >= cols,
+                      "Least squares needs at least as many rows as columns");
+        Vector<cols, T> x;
+        for (size_t i = 0; i < cols; ++i)
+        {
+            for (size_t k = 0; k < rows; ++k)
+            {
+                x[i] += q(k, i) * b[k];
+            }
+        }
+        for (size_t i = cols; i-- > 0;)
+        {
+            if (r(i, i) == T {0})
+            {
+                throw std::domain_error("colibra::QR::solve: rank deficient");
+            }
+            for (size_t j = i + 1; j < cols; ++j)
+            {
+                x[i] -= r(i, j) * x[j];
+            }
+            x[i] /= r(i, i);
+        }
+        return x;
+    }
+};
+
+/**
+ * @brief: Factorize a Matrix into Q * R using Householder reflections.
+ */
+template<size_t r, size_t c, typename T>
+[[nodiscard]] constexpr QR<r, c, T> qr(const Matrix<r, c, T> &a)
+{
+    details::require_floating_point<T>();
+
+    constexpr size_t steps = r - 1 < c ? r - 1 : c;
+
+    QR<r, c, T> result {Matrix<r, r, T>::identity(), a};
+    Matrix<r, r, T> &q = result.q;
+    Matrix<r, c, T> &m = result.r;
+    details::unrolled_for<steps>([&](const auto step) {
+        const size_t k = step;
+
+        T norm {};
+        for (size_t i = k; i < r; ++i)
+        {
+            norm += m(i, k) * m(i, k);
+        }
+        norm = details::sqrt(norm);
+        if (norm == T {0})
+        {
+            return;
+        }
+
+        // Reflect column k onto -sign(m(k, k)) * norm * e_k, the sign
+        // avoids cancellation in v.
+        const T      alpha = m(k, k) > T {0} ? -norm : norm;
+        Vector<r, T> v;
+        for (size_t i = k; i < r; ++i)
+        {
+            v[i] = m(i, k);
+        }
+        v[k] -= alpha;
+        T v_norm {};
+        for (size_t i = k; i < r; ++i)
+        {
+            v_norm += v[i] * v[i];
+        }
+        if (v_norm == T {0})
+        {
+            return;
+        }
+        const T scale = T {2} / v_norm;
+
+        for (size_t j = k; j < c; ++j)
+        {
+            T dot {};
+            for (size_t i = k; i < r; ++i)
+            {
+                dot += v[i] * m(i, j);
+            }
+            for (size_t i = k; i < r; ++i)
+            {
+                m(i, j) -= scale * dot * v[i];
+            }
+        }
+        for (size_t i = 0; i < r; ++i)
+        {
+            T dot {};
+            for (size_t p = k; p < r; ++p)
+            {
+                dot += q(i, p) * v[p];
+            }
+            for (size_t p = k; p < r; ++p)
+            {
+                q(i, p) -= scale * dot * v[p];
+            }
+        }
+        m(k, k) = alpha;
+        for (size_t i = k + 1; i < r; ++i)
+        {
+            m(i, k) = T {0};
+        }
+    });
+    return result;
+}
+
+/**
+ * @brief: Eigen decomposition A = V * diag(values) * V^T of a symmetric
+ * Matrix.
+ */
+template<size_t n, typename T>
+struct SymmetricEigen
+{
+    /// Eigenvalues in ascending order.
+    Vector<n, T> values;
+    /// Orthonormal eigenvectors, column i belongs to values[i].
+    Matrix<n, n, T> vectors;
+};
+
+/// Upper bound on the Jacobi sweeps of eigen_symmetric and svd, both
+/// converge quadratically and typically need fewer than 10.
+inline constexpr size_t max_jacobi_sweeps = 64;
+
+/**
+ * @brief: Eigenvalues and eigenvectors of a symmetric Matrix using cyclic
+ * Jacobi rotations, accurate to about machine precision.
+ */
+template<size_t n, typename T>
+[[nodiscard]] constexpr SymmetricEigen<n, T>
+eigen_symmetric(const Matrix<n, n, T> &a)
+{
+    details::require_floating_point<T>();
+
+    Matrix<n, n, T> m = a;
+    Matrix<n, n, T> v = Matrix<n, n, T>::identity();
+
+    T total {};
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (size_t j = 0; j < n; ++j)
+        {
+            total += m(i, j) * m(i, j);
+        }
+    }
+    constexpr T eps = std::numeric_limits<T>::epsilon();
+
+    for (size_t sweep = 0; sweep < max_jacobi_sweeps; ++sweep)
+    {
+        T off {};
+        for (size_t p = 0; p < n; ++p)
+        {
+            for (size_t q = p + 1; q < n; ++q)
+            {
+                off += m(p, q) * m(p, q);
+            }
+        }
+        if (!(off > eps * eps * total))
+        {
+            break;
+        }
+        for (size_t p = 0; p < n; ++p)
+        {
+            for (size_t q = p + 1; q < n; ++q)
+            {
+                if (m(p, q) == T {0})
+                {
+                    continue;
+                }
+                const T zeta = (m(q, q) - m(p, p)) / (T {2} * m(p, q));
+                const T t    = details::jacobi_tangent(zeta);
+                const T cos  = T {1} / details::hypot1(t);
+                const T sin  = t * cos;
+                details::rotate_cols(m, p, q, cos, sin);
+                details::rotate_rows(m, p, q, cos, sin);
+                details::rotate_cols(v, p, q, cos, sin);
+                m(p, q) = T {0};
+                m(q, p) = T {0};
+            }
+        }
+    }
+
+    SymmetricEigen<n, T> result {};
+    for (size_t i = 0; i < n; ++i)
+    {
+        result.values[i] = m(i, i);
+    }
+    // Selection sort, n is small and swaps move whole columns.
+    for (size_t i = 0; i < n; ++i)
+    {
+        size_t smallest = i;
+        for (size_t j = i + 1; j < n; ++j)
+        {
+            if (result.values[j] < result.values[smallest])
+            {
+                smallest = j;
+            }
+        }
+        if (smallest != i)
+        {
+            const T tmp             = result.values[i];
+            result.values[i]        = result.values[smallest];
+            result.values[smallest] = tmp;
+            details::swap_cols(v, i, smallest);
+        }
+    }
+    result.vectors = v;
+    return result;
+}
+
+/**
+ * @brief: Thin singular value decomposition A = U * diag(s) * V^T.
+ */
+template<size_t r, size_t c, typename T>
+struct SVD
+{
+    /// Left singular vectors, orthonormal columns.
+    Matrix<r, c, T> u;
+    /// Singular values in descending order.
+    Vector<c, T> singular_values;
+    /// Right singular vectors, orthogonal.
+    Matrix<c, c, T> v;
+};
+
+/**
+ * @brief: Singular value decomposition of a Matrix with r >= c using
+ * one-sided Jacobi rotations, which is accurate even for tiny singular
+ * values. Transpose wide matrices first.
+ *
+ * For rank deficient input the columns of u belonging to zero singular
+ * values are completed to an orthonormal set, so u is always orthonormal.
+ */
+template<size_t r, size_t c, typename T>
+[[nodiscard]] constexpr SVD<r, c, T> svd(const Matrix<r, c, T> &a)
+{
+    details::require_floating_point<T>();
+    static_assert(r >= c, "svd needs r >= c, decompose the transpose instead");
+
+    Matrix<r, c, T> u   = a;
+    Matrix<c, c, T> v   = Matrix<c, c, T>::identity();
+    constexpr T     eps = std::numeric_limits<T>::epsilon();
+
+    for (size_t sweep = 0; sweep < max_jacobi_sweeps; ++sweep)
+    {
+        bool rotated = false;
+        for (size_t p = 0; p < c; ++p)
+        {
+            for (size_t q = p + 1; q < c; ++q)
+            {
+                T alpha {};
+                T beta {};
+                T gamma {};
+                for (size_t i = 0; i < r; ++i)
+                {
+                    alpha += u(i, p) * u(i, p);
+                    beta += u(i, q) * u(i, q);
+                    gamma += u(i, p) * u(i, q);
+                }
+                if (!(details::abs(gamma)
+                      > eps * details::sqrt(alpha * beta)))
+                {
+                    continue;
+                }
+                rotated      = true;
+                const T zeta = (beta - alpha) / (T {2} * gamma);
+                const T t    = details::jacobi_tangent(zeta);
+                const T cos  = T {1} / details::hypot1(t);
+                const T sin  = t * cos;
+                details::rotate_cols(u, p, q, cos, sin);
+                details::rotate_cols(v, p, q, cos, sin);
+            }
+        }
+        if (!rotated)
+        {
+            break;
+        }
+    }
+
+    SVD<r, c, T> result {};
+    for (size_t j = 0; j < c; ++j)
+    {
+        T norm {};
+        for (size_t i = 0; i < r; ++i)
+        {
+            norm += u(i, j) * u(i, j);
+        }
+        norm                      = details::sqrt(norm);
+        result.singular_values[j] = norm;
+        for (size_t i = 0; i < r; ++i)
+        {
+            u(i, j) = norm > T {0} ? u(i, j) / norm : T {0};
+        }
+    }
+    for (size_t i = 0; i < c; ++i)
+    {
+        size_t largest = i;
+        for (size_t j = i + 1; j < c; ++j)
+        {
+            if (result.singular_values[j] > result.singular_values[largest])
+            {
+                largest = j;
+            }
+        }
+        if (largest != i)
+        {
+            const T tmp                     = result.singular_values[i];
+            result.singular_values[i]       = result.singular_values[largest];
+            result.singular_values[largest] = tmp;
+            details::swap_cols(u, i, largest);
+            details::swap_cols(v, i, largest);
+        }
+    }
+    details::complete_orthonormal(u, result.singular_values);
+    result.u = u;
+    result.v = v;
+    return result;
+}
+
+/**
+ * @brief: Determinant of a square Matrix, in closed form up to 3x3 and via
+ * LU decomposition beyond.
+ */
+template<size_t n, typename T>
+[[nodiscard]] constexpr T determinant(const Matrix<n, n, T> &m)
+{
+    if constexpr (n == 1)
+    {
+        return m(0, 0);
+    }
+    else if constexpr (n == 2)
+    {
+        return m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0);
+    }
+    else if constexpr (n == 3)
+    {
+        return m(0, 0) * (m(1, 1) * m(2, 2) - m(1, 2) * m(2, 1))
+               - m(0, 1) * (m(1, 0) * m(2, 2) - m(1, 2) * m(2, 0))
+               + m(0, 2) * (m(1, 0) * m(2, 1) - m(1, 1) * m(2, 0));
+    }
+    else
+    {
+        return lu(m).determinant();
+    }
+}
+
+/**
+ * @brief: Inverse of a square Matrix, using the adjugate up to 3x3 and LU
+ * decomposition beyond.
+ *
+ * @throws std::domain_error If m is singular.
+ */
+template<size_t n, typename T>
+[[nodiscard]] constexpr Matrix<n, n, T> inverse(const Matrix<n, n, T> &m)
+{
+    details::require_floating_point<T>();
+
+    if constexpr (n <= 3)
+    {
+        const T det = determinant(m);
+        if (det == T {0})
+        {
+            throw std::domain_error("colibra::inverse: singular matrix");
+        }
+        const T         inv = T {1} / det;
+        Matrix<n, n, T> result;
+        if constexpr (n == 1)
+        {
+            result(0, 0) = inv;
+        }
+        else if constexpr (n == 2)
+        {
+            result(0, 0) = m(1, 1) * inv;
+            result(0, 1) = -m(0, 1) * inv;
+            result(1, 0) = -m(1, 0) * inv;
+            result(1, 1) = m(0, 0) * inv;
+        }
+        else
+        {
+            for (size_t i = 0; i < 3; ++i)
+            {
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    // Cofactor of element (j, i), cyclic indices supply the
+                    // sign.
+                    const size_t j1 = (j + 1) % 3;
+                    const size_t j2 = (j + 2) % 3;
+                    const size_t i1 = (i + 1) % 3;
+                    const size_t i2 = (i + 2) % 3;
+                    result(i, j) =
+                        (m(j1, i1) * m(j2, i2) - m(j1, i2) * m(j2, i1)) * inv;
+                }
+            }
+        }
+        return result;
+    }
+    else
+    {
+        const LU<n, T> decomposition = lu(m);
+        if (decomposition.singular())
+        {
+            throw std::domain_error("colibra::inverse: singular matrix");
+        }
+        return decomposition.inverse();
+    }
+}
+
+} // namespace colibra
+
+#endif
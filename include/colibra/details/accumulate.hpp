@@ -0,0 +1,99 @@
+#ifndef COLIBRA_DETAILS_ACCUMULATE_HPP
+#define COLIBRA_DETAILS_ACCUMULATE_HPP
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+namespace colibra {
+namespace summation {
+
+/**
+ * @brief: Add terms one after another. Fastest, error grows linearly with
+ * the number of terms.
+ */
+struct naive
+{
+};
+
+/**
+ * @brief: Kahan compensated summation. Carries the rounding error of each
+ * addition forward, so the error is independent of the number of terms.
+ * Roughly four times the work of naive summation.
+ *
+ * @warning Compilers may remove the compensation under -ffast-math.
+ */
+struct kahan
+{
+};
+
+/**
+ * @brief: Pairwise (cascade) summation. Adds terms in a balanced tree, so the
+ * error grows logarithmically with the number of terms. Costs about the same
+ * as naive summation and shortens the dependency chain between additions.
+ */
+struct pairwise
+{
+};
+
+} // namespace summation
+
+namespace details {
+
+/// Below this many terms pairwise summation falls back to a plain loop.
+inline constexpr size_t pairwise_block = 8;
+
+template<typename Acc, size_t n>
+constexpr Acc accumulate(const std::array<Acc, n> &terms, summation::naive)
+{
+    Acc sum {};
+    for (size_t i = 0; i < n; ++i)
+    {
+        sum += terms[i];
+    }
+    return sum;
+}
+
+template<typename Acc, size_t n>
+constexpr Acc accumulate(const std::array<Acc, n> &terms, summation::kahan)
+{
+    Acc sum {};
+    Acc compensation {};
+    for (size_t i = 0; i < n; ++i)
+    {
+        const Acc y = terms[i] - compensation;
+        const Acc t = sum + y;
+        compensation = (t - sum) - y;
+        sum          = t;
+    }
+    return sum;
+}
+
+template<typename Acc, size_t n>
+constexpr Acc pairwise_range(const std::array<Acc, n> &terms,
+                             const size_t              begin,
+                             const size_t              end)
+{
+    if (end - begin <= pairwise_block)
+    {
+        Acc sum {};
+        for (size_t i = begin; i < end; ++i)
+        {
+            sum += terms[i];
+        }
+        return sum;
+    }
+    const size_t mid = begin + (end - begin) / 2;
+    return pairwise_range(terms, begin, mid) + pairwise_range(terms, mid, end);
+}
+
+template<typename Acc, size_t n>
+constexpr Acc accumulate(const std::array<Acc, n> &terms, summation::pairwise)
+{
+    return pairwise_range(terms, 0, n);
+}
+
+} // namespace details
+} // namespace colibra
+
+#endif
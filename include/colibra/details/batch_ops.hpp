@@ -0,0 +1,88 @@
+#ifndef COLIBRA_DETAILS_BATCH_OPS_HPP
+#define COLIBRA_DETAILS_BATCH_OPS_HPP
+
+#include "../span.h"
+#include "fixed_point_kernels.hpp"
+#include "kernels.hpp"
+#include "parallel.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+
+namespace colibra {
+namespace details {
+
+inline void check_output_size(const size_t points,
+                              const size_t out,
+                              const char * what)
+{
+    if (out < points)
+    {
+        throw std::invalid_argument(what);
+    }
+}
+
+template<class Policy, size_t l, typename T, class Points>
+void dot_many(const Policy &               policy,
+              const colibra::Vector<l, T> &query,
+              const Points &               points,
+              const size_t                 size,
+              Span<dot_type_t<T>>          out)
+{
+    check_output_size(size, out.size(), "colibra::dot_many: output too small");
+    parallel_for(policy, size, [&](size_t begin, size_t end) {
+        dot_kernel(query, points, out.data(), begin, end);
+    });
+}
+
+template<class Policy, size_t l, typename T, class Points>
+void norm_many(const Policy &       policy,
+               const Points &       points,
+               const size_t         size,
+               Span<norm_type_t<T>> out)
+{
+    using R = norm_type_t<T>;
+    check_output_size(
+        size, out.size(), "colibra::norm_many: output too small");
+    parallel_for(policy, size, [&](size_t begin, size_t end) {
+        reduce_points<l, R>(
+            points,
+            out.data(),
+            begin,
+            end,
+            [](size_t, const auto &p) {
+                return static_cast<R>(p) * static_cast<R>(p);
+            },
+            [](const R &acc) { return std::sqrt(acc); });
+    });
+}
+
+template<class Policy, size_t l, typename T, class Points>
+void distance_many(const Policy &               policy,
+                   const colibra::Vector<l, T> &query,
+                   const Points &               points,
+                   const size_t                 size,
+                   Span<norm_type_t<T>>         out)
+{
+    using R = norm_type_t<T>;
+    check_output_size(
+        size, out.size(), "colibra::distance_many: output too small");
+    parallel_for(policy, size, [&](size_t begin, size_t end) {
+        reduce_points<l, R>(
+            points,
+            out.data(),
+            begin,
+            end,
+            [&query](size_t d, const auto &p) {
+                const R diff = static_cast<R>(p) - static_cast<R>(query[d]);
+                return diff * diff;
+            },
+            [](const R &acc) { return std::sqrt(acc); });
+    });
+}
+
+} // namespace details
+} // namespace colibra
+
+#endif
@@ -0,0 +1,181 @@
+#ifndef COLIBRA_DETAILS_BOUNDS_HPP
+#define COLIBRA_DETAILS_BOUNDS_HPP
+
+#include "../matrix.h"
+#include "../vector.h"
+#include "kernels.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+namespace colibra {
+namespace details {
+
+// The batch kernels below evaluate every test without branches, combining
+// the per component results with & instead of &&, so the loop over points
+// vectorizes. Points are read from structure-of-arrays input.
+
+template<size_t l, typename T>
+void contains_box_kernel(const colibra::Vector<l, T> &lower,
+                         const colibra::Vector<l, T> &upper,
+                         const SoaPoints<l, T>       &points,
+                         uint8_t                     *out,
+                         const size_t                 begin,
+                         const size_t                 end)
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        bool inside = true;
+        for (size_t d = 0; d < l; ++d)
+        {
+            const T p = points(d, i);
+            inside &= (p >= lower[d]) & (p <= upper[d]);
+        }
+        out[i] = inside;
+    }
+}
+
+template<size_t l, typename T>
+void contains_sphere_kernel(const colibra::Vector<l, T> &center,
+                            const T                      radius,
+                            const SoaPoints<l, T>       &points,
+                            uint8_t                     *out,
+                            const size_t                 begin,
+                            const size_t                 end)
+{
+    const T radius_squared = radius * radius;
+    for (size_t i = begin; i < end; ++i)
+    {
+        T distance_squared {};
+        for (size_t d = 0; d < l; ++d)
+        {
+            const T diff = points(d, i) - center[d];
+            distance_squared += diff * diff;
+        }
+        out[i] = distance_squared <= radius_squared;
+    }
+}
+
+/// Points are projected onto the box axes, the columns of rotation.
+template<typename T>
+void contains_obb_kernel(const colibra::Vector<3, T>    &center,
+                         const colibra::Matrix<3, 3, T> &rotation,
+                         const colibra::Vector<3, T>    &half_extents,
+                         const SoaPoints<3, T>          &points,
+                         uint8_t                        *out,
+                         const size_t                    begin,
+                         const size_t                    end)
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        const T x = points(0, i) - center[0];
+        const T y = points(1, i) - center[1];
+        const T z = points(2, i) - center[2];
+
+        bool inside = true;
+        for (size_t k = 0; k < 3; ++k)
+        {
+            const T local = x * rotation(0, k) + y * rotation(1, k)
+                            + z * rotation(2, k);
+            inside &= (local <= half_extents[k]) & (-local <= half_extents[k]);
+        }
+        out[i] = inside;
+    }
+}
+
+template<size_t l, typename T>
+void overlaps_box_kernel(const colibra::Vector<l, T> &lower,
+                         const colibra::Vector<l, T> &upper,
+                         const SoaPoints<l, T>       &other_lower,
+                         const SoaPoints<l, T>       &other_upper,
+                         uint8_t                     *out,
+                         const size_t                 begin,
+                         const size_t                 end)
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        bool overlap = true;
+        for (size_t d = 0; d < l; ++d)
+        {
+            overlap &= (other_lower(d, i) <= upper[d])
+                       & (lower[d] <= other_upper(d, i));
+        }
+        out[i] = overlap;
+    }
+}
+
+/**
+ * Slab test: each axis clips the ray parameter to the interval between the
+ * two planes of the box. Axes the ray runs parallel to are checked
+ * directly, dividing by their zero component would not be a constant
+ * expression.
+ *
+ * @return The entry parameter, clamped to 0 for rays that start inside, or
+ * infinity if the ray misses.
+ */
+template<size_t l, typename T>
+constexpr T slab_entry(const T *lower,
+                       const T *upper,
+                       const T *origin,
+                       const T *direction)
+{
+    constexpr T infinity = std::numeric_limits<T>::infinity();
+
+    T near = 0;
+    T far  = infinity;
+    for (size_t d = 0; d < l; ++d)
+    {
+        if (direction[d] == T {0})
+        {
+            if (origin[d] < lower[d] || origin[d] > upper[d]) return infinity;
+            continue;
+        }
+        const T inverse = T {1} / direction[d];
+        const T t1      = (lower[d] - origin[d]) * inverse;
+        const T t2      = (upper[d] - origin[d]) * inverse;
+        near            = std::max(near, std::min(t1, t2));
+        far             = std::min(far, std::max(t1, t2));
+    }
+    return near <= far ? near : infinity;
+}
+
+template<size_t l, typename T>
+void intersect_box_kernel(const colibra::Vector<l, T> &lower,
+                          const colibra::Vector<l, T> &upper,
+                          const SoaPoints<l, T>       &origins,
+                          const SoaPoints<l, T>       &directions,
+                          T                           *out,
+                          const size_t                 begin,
+                          const size_t                 end)
+{
+    constexpr T infinity = std::numeric_limits<T>::infinity();
+
+    // The run time form of slab_entry. Dividing by a zero component gives
+    // an infinite inverse directly, and 0 * infinity gives NaN for origins
+    // on a plane parallel to the ray. The comparisons are ordered so NaN
+    // never narrows the interval, which gives the results of the checks in
+    // slab_entry without any branches, so the loop vectorizes.
+    for (size_t i = begin; i < end; ++i)
+    {
+        T near = 0;
+        T far  = infinity;
+        for (size_t d = 0; d < l; ++d)
+        {
+            const T origin  = origins(d, i);
+            const T inverse = T {1} / directions(d, i);
+            const T t1      = (lower[d] - origin) * inverse;
+            const T t2      = (upper[d] - origin) * inverse;
+            const T lo      = t2 < t1 ? t2 : t1;
+            const T hi      = t2 < t1 ? t1 : t2;
+            near            = lo > near ? lo : near;
+            far             = hi < far ? hi : far;
+        }
+        out[i] = near <= far ? near : infinity;
+    }
+}
+
+} // namespace details
+} // namespace colibra
+
+#endif
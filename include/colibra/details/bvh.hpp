@@ -0,0 +1,632 @@
+#ifndef COLIBRA_DETAILS_BVH_HPP
+#define COLIBRA_DETAILS_BVH_HPP
+
+#include "../bounds.h"
+#include "../vector.h"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace colibra {
+namespace details {
+
+/// Number of children of a Bvh node.
+inline constexpr size_t bvh_width = 4;
+/// Number of bins per axis the SAH split is searched over.
+inline constexpr size_t bvh_bins = 16;
+/// Binary tree depth beyond which the builder stops evaluating the SAH and
+/// splits at the median, which bounds the depth of every tree.
+inline constexpr size_t bvh_sah_depth = 48;
+/// Size of the traversal stacks, enough for every tree the builder creates.
+inline constexpr size_t bvh_stack_size = 256;
+
+inline constexpr uint32_t bvh_no_child = std::numeric_limits<uint32_t>::max();
+
+/**
+ * A node with four children, stored as structure of arrays so the four
+ * child boxes are tested together: lower[d][k] is the lower bound of child
+ * k in dimension d.
+ *
+ * count[k] == 0 marks an inner child, child[k] is then a node index. Leaf
+ * children hold count[k] primitives starting at child[k]. Unused slots have
+ * inverted boxes that no ray or point query can enter.
+ */
+template<typename T>
+struct alignas(64) BvhNode
+{
+    T        lower[3][bvh_width];
+    T        upper[3][bvh_width];
+    uint32_t child[bvh_width];
+    uint32_t count[bvh_width];
+};
+
+/// Half the surface area of a box, proportional to the probability that a
+/// random ray hitting its parent hits it too.
+template<typename T>
+constexpr T half_area(const Aabb<3, T> &box)
+{
+    const colibra::Vector<3, T> e = box.extent();
+    return e[0] * e[1] + e[1] * e[2] + e[2] * e[0];
+}
+
+/**
+ * Entry parameters of a ray into the four child boxes of a node, infinity
+ * for children it misses or enters beyond t_max. Instead of ordering both
+ * slab parameters per child, the near plane of every axis is selected once
+ * from the sign of the direction, so inverted boxes of unused slots never
+ * report a hit.
+ */
+template<typename T>
+void intersect_children(const BvhNode<T> &node,
+                        const T          *origin,
+                        const T          *inverse,
+                        const bool       *negative,
+                        const T           t_max,
+                        T                *entry)
+{
+    constexpr T infinity = std::numeric_limits<T>::infinity();
+
+    T near[bvh_width];
+    T far[bvh_width];
+    for (size_t k = 0; k < bvh_width; ++k)
+    {
+        near[k] = 0;
+        far[k]  = t_max;
+    }
+    for (size_t d = 0; d < 3; ++d)
+    {
+        const T *near_plane = negative[d] ? node.upper[d] : node.lower[d];
+        const T *far_plane  = negative[d] ? node.lower[d] : node.upper[d];
+        for (size_t k = 0; k < bvh_width; ++k)
+        {
+            // NaN from origins on a plane the ray runs parallel to fails
+            // both comparisons and leaves the interval unchanged.
+            const T t_near = (near_plane[k] - origin[d]) * inverse[d];
+            const T t_far  = (far_plane[k] - origin[d]) * inverse[d];
+            near[k]        = t_near > near[k] ? t_near : near[k];
+            far[k]         = t_far < far[k] ? t_far : far[k];
+        }
+    }
+    for (size_t k = 0; k < bvh_width; ++k)
+    {
+        entry[k] = near[k] <= far[k] ? near[k] : infinity;
+    }
+}
+
+/// Squared distances from a point to the four child boxes of a node,
+/// infinity for unused slots.
+template<typename T>
+void distance_to_children(const BvhNode<T> &node,
+                          const T          *point,
+                          T                *distance_squared)
+{
+    for (size_t k = 0; k < bvh_width; ++k)
+    {
+        distance_squared[k] = 0;
+    }
+    for (size_t d = 0; d < 3; ++d)
+    {
+        for (size_t k = 0; k < bvh_width; ++k)
+        {
+            const T below = node.lower[d][k] - point[d];
+            const T above = point[d] - node.upper[d][k];
+            const T diff  = std::max(std::max(below, above), T {0});
+            distance_squared[k] += diff * diff;
+        }
+    }
+}
+
+/**
+ * Möller-Trumbore ray triangle intersection.
+ *
+ * @return The ray parameter of the hit, infinity if the ray misses the
+ * triangle, runs parallel to it, or hits it outside [0, t_max). u and v
+ * receive the barycentric coordinates of the hit relative to b and c.
+ */
+template<typename T>
+constexpr T intersect_triangle(const colibra::Vector<3, T> &a,
+                               const colibra::Vector<3, T> &b,
+                               const colibra::Vector<3, T> &c,
+                               const colibra::Vector<3, T> &origin,
+                               const colibra::Vector<3, T> &direction,
+                               const T                      t_max,
+                               T                           &u,
+                               T                           &v)
+{
+    constexpr T infinity = std::numeric_limits<T>::infinity();
+
+    const colibra::Vector<3, T> e1          = b - a;
+    const colibra::Vector<3, T> e2          = c - a;
+    const colibra::Vector<3, T> p           = cross(direction, e2);
+    const T                     determinant = e1 * p;
+    if (determinant == T {0}) return infinity;
+
+    const T                     inverse = T {1} / determinant;
+    const colibra::Vector<3, T> s       = origin - a;
+    u                                   = (s * p) * inverse;
+    if (u < T {0} || u > T {1}) return infinity;
+
+    const colibra::Vector<3, T> q = cross(s, e1);
+    v                             = (direction * q) * inverse;
+    if (v < T {0} || u + v > T {1}) return infinity;
+
+    const T t = (e2 * q) * inverse;
+    return t >= T {0} && t < t_max ? t : infinity;
+}
+
+/**
+ * The point of the triangle closest to p, from the Voronoi regions of its
+ * vertices and edges (Ericson, Real-Time Collision Detection, 5.1.5).
+ */
+template<typename T>
+constexpr colibra::Vector<3, T>
+closest_on_triangle(const colibra::Vector<3, T> &a,
+                    const colibra::Vector<3, T> &b,
+                    const colibra::Vector<3, T> &c,
+                    const colibra::Vector<3, T> &p)
+{
+    const colibra::Vector<3, T> ab = b - a;
+    const colibra::Vector<3, T> ac = c - a;
+    const colibra::Vector<3, T> ap = p - a;
+    const T                     d1 = ab * ap;
+    const T                     d2 = ac * ap;
+    if (d1 <= T {0} && d2 <= T {0}) return a;
+
+    const colibra::Vector<3, T> bp = p - b;
+    const T                     d3 = ab * bp;
+    const T                     d4 = ac * bp;
+    if (d3 >= T {0} && d4 <= d3) return b;
+
+    const T vc = d1 * d4 - d3 * d2;
+    if (vc <= T {0} && d1 >= T {0} && d3 <= T {0})
+    {
+        return a + ab * (d1 / (d1 - d3));
+    }
+
+    const colibra::Vector<3, T> cp = p - c;
+    const T                     d5 = ab * cp;
+    const T                     d6 = ac * cp;
+    if (d6 >= T {0} && d5 <= d6) return c;
+
+    const T vb = d5 * d2 - d1 * d6;
+    if (vb <= T {0} && d2 >= T {0} && d6 <= T {0})
+    {
+        return a + ac * (d2 / (d2 - d6));
+    }
+
+    const T va = d3 * d6 - d5 * d4;
+    if (va <= T {0} && d4 - d3 >= T {0} && d5 - d6 >= T {0})
+    {
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+
+    const T denominator = T {1} / (va + vb + vc);
+    return a + ab * (vb * denominator) + ac * (vc * denominator);
+}
+
+/**
+ * Node of the binary tree the builder creates before it is collapsed into
+ * BvhNodes. Leaves have count > 0.
+ */
+template<typename T>
+struct BvhBuildNode
+{
+    Aabb<3, T> bounds;
+    uint32_t   begin = 0;
+    uint32_t   count = 0;
+    uint32_t   left  = bvh_no_child;
+    uint32_t   right = bvh_no_child;
+};
+
+/// A primitive as the builder sees it. The builder reorders these records
+/// themselves rather than an index array, so every pass over a range reads
+/// contiguous memory.
+template<typename T>
+struct BvhPrimitive
+{
+    Aabb<3, T>            bounds;
+    colibra::Vector<3, T> centroid;
+    uint32_t              index;
+};
+
+/// Bounds of a range of primitives and of their centroids.
+template<typename T>
+struct BvhRange
+{
+    Aabb<3, T> bounds   = Aabb<3, T>::empty();
+    Aabb<3, T> centroid = Aabb<3, T>::empty();
+    size_t     count    = 0;
+
+    BvhRange &merge(const BvhRange &other)
+    {
+        bounds.merge(other.bounds);
+        centroid.merge(other.centroid);
+        count += other.count;
+        return *this;
+    }
+};
+
+/**
+ * Top down binned SAH builder. Every node bins the centroids of its
+ * primitives along all three axes and splits at the bin boundary with the
+ * lowest surface area cost. The bins also track the bounds of their
+ * primitives and centroids, so the bounds of both children are known
+ * without another pass over the primitives.
+ *
+ * Binning large nodes is split across threads, and once a node is small
+ * enough its whole subtree becomes a task of its own, so both the top and
+ * the bottom of the tree are built in parallel.
+ */
+template<typename T>
+class BvhBuilder
+{
+  public:
+    /// primitives[i].index must be i.
+    BvhBuilder(std::vector<BvhPrimitive<T>> primitives,
+               const size_t                 leaf_size,
+               const size_t                 max_leaf_size)
+        : m_primitives(std::move(primitives))
+        , m_leaf_size(leaf_size)
+        , m_max_leaf_size(max_leaf_size)
+    {
+    }
+
+    /// The primitive order the leaves refer to, valid after build().
+    [[nodiscard]] std::vector<uint32_t> indices() const
+    {
+        std::vector<uint32_t> result(m_primitives.size());
+        for (size_t i = 0; i < m_primitives.size(); ++i)
+        {
+            result[i] = m_primitives[i].index;
+        }
+        return result;
+    }
+
+    template<class Policy>
+    std::vector<BvhBuildNode<T>> build(const Policy &policy)
+    {
+        std::vector<BvhBuildNode<T>> nodes;
+        if (m_primitives.empty())
+        {
+            return nodes;
+        }
+
+        const BvhRange<T> root = range(policy, 0, m_primitives.size());
+        if constexpr (std::is_same_v<Policy, execution::sequenced_policy>)
+        {
+            build(policy, nodes, Task {0, 0, 0, root}, nullptr, 0);
+        }
+        else
+        {
+            size_t threads = policy.threads;
+            if (threads == 0)
+            {
+                threads =
+                    std::max<size_t>(1, std::thread::hardware_concurrency());
+            }
+            // Several tasks per thread balance subtrees of different cost.
+            const size_t task_size =
+                std::max(policy.grain, m_primitives.size() / (8 * threads) + 1);
+
+            std::vector<Task> tasks;
+            build(policy, nodes, Task {0, 0, 0, root}, &tasks, task_size);
+
+            std::vector<std::vector<BvhBuildNode<T>>> subtrees(tasks.size());
+            parallel_for(execution::parallel_policy {threads, 1},
+                         tasks.size(),
+                         [&](size_t begin, size_t end) {
+                             for (size_t t = begin; t < end; ++t)
+                             {
+                                 build(execution::seq,
+                                       subtrees[t],
+                                       Task {0,
+                                             tasks[t].begin,
+                                             tasks[t].depth,
+                                             tasks[t].range},
+                                       nullptr,
+                                       0);
+                             }
+                         });
+            for (size_t t = 0; t < tasks.size(); ++t)
+            {
+                attach(nodes, tasks[t].node, subtrees[t]);
+            }
+        }
+        return nodes;
+    }
+
+  private:
+    /// A range of primitives starting at begin, to become node.
+    struct Task
+    {
+        uint32_t    node;
+        size_t      begin;
+        size_t      depth;
+        BvhRange<T> range;
+    };
+
+    struct Split
+    {
+        size_t      axis = 0;
+        size_t      bin  = 0;
+        T           cost = std::numeric_limits<T>::infinity();
+        BvhRange<T> left;
+        BvhRange<T> right;
+    };
+
+    using Bins = std::array<std::array<BvhRange<T>, bvh_bins>, 3>;
+
+    std::vector<BvhPrimitive<T>> m_primitives;
+    size_t                       m_leaf_size;
+    size_t                       m_max_leaf_size;
+
+    template<class Policy>
+    BvhRange<T>
+    range(const Policy &policy, const size_t begin, const size_t end)
+    {
+        return parallel_reduce<BvhRange<T>>(
+            policy,
+            end - begin,
+            [&](size_t first, size_t last, BvhRange<T> &acc) {
+                for (size_t i = begin + first; i < begin + last; ++i)
+                {
+                    acc.bounds.merge(m_primitives[i].bounds);
+                    acc.centroid.expand(m_primitives[i].centroid);
+                }
+                acc.count += last - first;
+            },
+            [](BvhRange<T> &total, const BvhRange<T> &local) {
+                total.merge(local);
+            });
+    }
+
+    static size_t bin_of(const T value, const T lower, const T scale)
+    {
+        const T position = (value - lower) * scale;
+        return std::min(bvh_bins - 1,
+                        static_cast<size_t>(std::max(position, T {0})));
+    }
+
+    static std::array<T, 3> bin_scales(const Aabb<3, T> &centroid)
+    {
+        std::array<T, 3> scale {};
+        for (size_t d = 0; d < 3; ++d)
+        {
+            const T extent = centroid.upper[d] - centroid.lower[d];
+            scale[d] = extent > T {0} ? T {bvh_bins} / extent : T {0};
+        }
+        return scale;
+    }
+
+    template<class Policy>
+    Split find_split(const Policy           &policy,
+                     const Task             &task,
+                     const std::array<T, 3> &scale)
+    {
+        const size_t      begin    = task.begin;
+        const Aabb<3, T> &centroid = task.range.centroid;
+        const Bins        bins     = parallel_reduce<Bins>(
+            policy,
+            task.range.count,
+            [&](size_t first, size_t last, Bins &acc) {
+                for (size_t i = begin + first; i < begin + last; ++i)
+                {
+                    const BvhPrimitive<T> &primitive = m_primitives[i];
+                    const auto            &c         = primitive.centroid;
+                    for (size_t d = 0; d < 3; ++d)
+                    {
+                        BvhRange<T> &bin =
+                            acc[d][bin_of(c[d], centroid.lower[d], scale[d])];
+                        bin.bounds.merge(primitive.bounds);
+                        bin.centroid.expand(c);
+                        ++bin.count;
+                    }
+                }
+            },
+            [](Bins &total, const Bins &local) {
+                for (size_t d = 0; d < 3; ++d)
+                {
+                    for (size_t b = 0; b < bvh_bins; ++b)
+                    {
+                        total[d][b].merge(local[d][b]);
+                    }
+                }
+            });
+
+        // Sweep from the right to collect the cost of every right side, then
+        // from the left to combine it with the left side. Splitting before
+        // bin b puts bins [0, b) on the left.
+        Split best;
+        for (size_t d = 0; d < 3; ++d)
+        {
+            if (scale[d] == T {0}) continue;
+
+            std::array<T, bvh_bins> right_cost {};
+            BvhRange<T>             right;
+            for (size_t b = bvh_bins - 1; b > 0; --b)
+            {
+                right.merge(bins[d][b]);
+                right_cost[b] =
+                    half_area(right.bounds) * static_cast<T>(right.count);
+            }
+
+            BvhRange<T> left;
+            for (size_t b = 1; b < bvh_bins; ++b)
+            {
+                left.merge(bins[d][b - 1]);
+                if (left.count == 0 || left.count == task.range.count)
+                {
+                    continue;
+                }
+
+                const T cost =
+                    half_area(left.bounds) * static_cast<T>(left.count)
+                    + right_cost[b];
+                if (cost < best.cost)
+                {
+                    best.axis = d;
+                    best.bin  = b;
+                    best.cost = cost;
+                }
+            }
+        }
+        if (best.cost < std::numeric_limits<T>::infinity())
+        {
+            for (size_t b = 0; b < bvh_bins; ++b)
+            {
+                (b < best.bin ? best.left : best.right)
+                    .merge(bins[best.axis][b]);
+            }
+        }
+        return best;
+    }
+
+    template<class Policy>
+    uint32_t build(const Policy                 &policy,
+                   std::vector<BvhBuildNode<T>> &nodes,
+                   const Task                   &task,
+                   std::vector<Task>            *tasks,
+                   const size_t                  task_size)
+    {
+        const auto node = static_cast<uint32_t>(nodes.size());
+        nodes.emplace_back();
+        nodes[node].bounds = task.range.bounds;
+
+        const size_t begin     = task.begin;
+        const size_t count     = task.range.count;
+        const auto   make_leaf = [&] {
+            nodes[node].begin = static_cast<uint32_t>(begin);
+            nodes[node].count = static_cast<uint32_t>(count);
+            return node;
+        };
+        if (count <= m_leaf_size)
+        {
+            return make_leaf();
+        }
+        if (tasks && count <= task_size)
+        {
+            tasks->push_back(Task {node, begin, task.depth, task.range});
+            return node;
+        }
+
+        Split split;
+        if (task.depth < bvh_sah_depth)
+        {
+            const std::array<T, 3> scale = bin_scales(task.range.centroid);
+            split = find_split(policy, task, scale);
+            // A leaf costs one intersection per primitive, an inner node one
+            // traversal step plus the expected intersections of its children.
+            const T leaf_cost  = static_cast<T>(count);
+            const T split_cost =
+                T {1} + split.cost / half_area(task.range.bounds);
+            if (count <= m_max_leaf_size && !(split_cost < leaf_cost))
+            {
+                return make_leaf();
+            }
+            if (split.cost < std::numeric_limits<T>::infinity())
+            {
+                const size_t axis  = split.axis;
+                const T      lower = task.range.centroid.lower[axis];
+                std::partition(m_primitives.begin() + begin,
+                               m_primitives.begin() + begin + count,
+                               [&](const BvhPrimitive<T> &primitive) {
+                                   return bin_of(primitive.centroid[axis],
+                                                 lower,
+                                                 scale[axis])
+                                          < split.bin;
+                               });
+            }
+        }
+        if (split.left.count == 0)
+        {
+            // All centroids coincide, or the tree got too deep for the SAH.
+            if (count <= m_max_leaf_size && task.depth < bvh_sah_depth)
+            {
+                return make_leaf();
+            }
+            const size_t mid = median_split(begin, begin + count, task.range);
+            split.left       = range(policy, begin, mid);
+            split.right      = range(policy, mid, begin + count);
+        }
+
+        const size_t   depth = task.depth + 1;
+        const uint32_t left  = build(policy,
+                                    nodes,
+                                    Task {0, begin, depth, split.left},
+                                    tasks,
+                                    task_size);
+        const uint32_t right = build(policy,
+                                     nodes,
+                                     Task {0,
+                                           begin + split.left.count,
+                                           depth,
+                                           split.right},
+                                     tasks,
+                                     task_size);
+        nodes[node].left     = left;
+        nodes[node].right    = right;
+        return node;
+    }
+
+    /// Split a range at its median along the largest axis of the centroid
+    /// bounds.
+    size_t median_split(const size_t       begin,
+                        const size_t       end,
+                        const BvhRange<T> &range)
+    {
+        const colibra::Vector<3, T> extent = range.centroid.extent();
+        size_t                      axis   = 0;
+        for (size_t d = 1; d < 3; ++d)
+        {
+            if (extent[d] > extent[axis]) axis = d;
+        }
+        const size_t mid = begin + (end - begin) / 2;
+        std::nth_element(
+            m_primitives.begin() + begin,
+            m_primitives.begin() + mid,
+            m_primitives.begin() + end,
+            [axis](const BvhPrimitive<T> &a, const BvhPrimitive<T> &b) {
+                return a.centroid[axis] < b.centroid[axis];
+            });
+        return mid;
+    }
+
+    /// Replace the placeholder node with the root of a subtree built as a
+    /// task, and append the rest of the subtree.
+    static void attach(std::vector<BvhBuildNode<T>>       &nodes,
+                       const uint32_t                      placeholder,
+                       const std::vector<BvhBuildNode<T>> &subtree)
+    {
+        const auto offset = static_cast<uint32_t>(nodes.size() - 1);
+        const auto remap  = [&](const uint32_t index) {
+            return index == bvh_no_child ? bvh_no_child
+                   : index == 0          ? placeholder
+                                         : index + offset;
+        };
+        for (size_t i = 0; i < subtree.size(); ++i)
+        {
+            BvhBuildNode<T> node = subtree[i];
+            node.left            = remap(node.left);
+            node.right           = remap(node.right);
+            if (i == 0)
+            {
+                nodes[placeholder] = node;
+            }
+            else
+            {
+                nodes.push_back(node);
+            }
+        }
+    }
+};
+
+} // namespace details
+} // namespace colibra
+
+#endif
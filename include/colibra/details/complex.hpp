@@ -0,0 +1,317 @@
+#ifndef COLIBRA_DETAILS_COMPLEX_HPP
+#define COLIBRA_DETAILS_COMPLEX_HPP
+
+#include "vector.hpp"
+
+#include <complex>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__SSE3__)
+#include <pmmintrin.h>
+#endif
+
+namespace colibra {
+namespace details {
+
+/// Partial sums of conjugate_dot, enough to fill a 256 bit register so the
+/// loop vectorizes without reassociating a single running sum.
+template<typename T>
+inline constexpr size_t complex_lanes = 32 / sizeof(T);
+
+/**
+ * out = a * b for the complex values [begin, end), whose real parts are at
+ * real[stride * i] and imaginary parts at imag[stride * i]. Stride 1 is the
+ * split layout, stride 2 with imag = real + 1 the interleaved layout of
+ * std::complex. Each value is read before it is written, so out may alias a
+ * or b.
+ */
+template<size_t stride, typename T>
+void complex_multiply_strided(const T     *a_real,
+                              const T     *a_imag,
+                              const T     *b_real,
+                              const T     *b_imag,
+                              T           *out_real,
+                              T           *out_imag,
+                              const size_t begin,
+                              const size_t end)
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        const size_t k  = stride * i;
+        const T      re = a_real[k] * b_real[k] - a_imag[k] * b_imag[k];
+        const T      im = a_real[k] * b_imag[k] + a_imag[k] * b_real[k];
+        out_real[k]     = re;
+        out_imag[k]     = im;
+    }
+}
+
+/**
+ * Sum of conj(a[i]) * b[i] for [begin, end) in the layout described at
+ * complex_multiply_strided.
+ */
+template<size_t stride, typename T>
+std::complex<T> conjugate_dot_strided(const T     *a_real,
+                                      const T     *a_imag,
+                                      const T     *b_real,
+                                      const T     *b_imag,
+                                      const size_t begin,
+                                      const size_t end)
+{
+    constexpr size_t lanes = complex_lanes<T>;
+
+    T      re[lanes] {};
+    T      im[lanes] {};
+    size_t i = begin;
+    for (; i + lanes <= end; i += lanes)
+    {
+        for (size_t j = 0; j < lanes; ++j)
+        {
+            const size_t k = stride * (i + j);
+            re[j] += a_real[k] * b_real[k] + a_imag[k] * b_imag[k];
+            im[j] += a_real[k] * b_imag[k] - a_imag[k] * b_real[k];
+        }
+    }
+    for (; i < end; ++i)
+    {
+        const size_t k = stride * i;
+        re[0] += a_real[k] * b_real[k] + a_imag[k] * b_imag[k];
+        im[0] += a_real[k] * b_imag[k] - a_imag[k] * b_real[k];
+    }
+    for (size_t width = lanes / 2; width > 0; width /= 2)
+    {
+        for (size_t j = 0; j < width; ++j)
+        {
+            re[j] += re[j + width];
+            im[j] += im[j + width];
+        }
+    }
+    return std::complex<T>(re[0], im[0]);
+}
+
+/**
+ * Sum of conj(a[i]) * b[i] for split arrays. The SSE2 path keeps two pairs of
+ * vector accumulators: left to itself, GCC vectorizes the lanes of
+ * conjugate_dot_strided across the outer loop and needs a shuffle per load.
+ */
+template<typename T>
+std::complex<T> conjugate_dot_split(const T     *a_real,
+                                    const T     *a_imag,
+                                    const T     *b_real,
+                                    const T     *b_imag,
+                                    const size_t begin,
+                                    const size_t end)
+{
+    size_t first = begin;
+    T      re {};
+    T      im {};
+#if defined(__SSE2__)
+    if constexpr (std::is_same_v<T, float>)
+    {
+        __m128 re0 = _mm_setzero_ps();
+        __m128 re1 = _mm_setzero_ps();
+        __m128 im0 = _mm_setzero_ps();
+        __m128 im1 = _mm_setzero_ps();
+        for (; first + 8 <= end; first += 8)
+        {
+            for (size_t j = 0; j < 8; j += 4)
+            {
+                const __m128 ar = _mm_loadu_ps(a_real + first + j);
+                const __m128 ai = _mm_loadu_ps(a_imag + first + j);
+                const __m128 br = _mm_loadu_ps(b_real + first + j);
+                const __m128 bi = _mm_loadu_ps(b_imag + first + j);
+
+                __m128 &r = j == 0 ? re0 : re1;
+                __m128 &i = j == 0 ? im0 : im1;
+                r = _mm_add_ps(
+                    r, _mm_add_ps(_mm_mul_ps(ar, br), _mm_mul_ps(ai, bi)));
+                i = _mm_add_ps(
+                    i, _mm_sub_ps(_mm_mul_ps(ar, bi), _mm_mul_ps(ai, br)));
+            }
+        }
+        float r[4];
+        float i[4];
+        _mm_storeu_ps(r, _mm_add_ps(re0, re1));
+        _mm_storeu_ps(i, _mm_add_ps(im0, im1));
+        re = (r[0] + r[1]) + (r[2] + r[3]);
+        im = (i[0] + i[1]) + (i[2] + i[3]);
+    }
+    else if constexpr (std::is_same_v<T, double>)
+    {
+        __m128d re0 = _mm_setzero_pd();
+        __m128d re1 = _mm_setzero_pd();
+        __m128d im0 = _mm_setzero_pd();
+        __m128d im1 = _mm_setzero_pd();
+        for (; first + 4 <= end; first += 4)
+        {
+            for (size_t j = 0; j < 4; j += 2)
+            {
+                const __m128d ar = _mm_loadu_pd(a_real + first + j);
+                const __m128d ai = _mm_loadu_pd(a_imag + first + j);
+                const __m128d br = _mm_loadu_pd(b_real + first + j);
+                const __m128d bi = _mm_loadu_pd(b_imag + first + j);
+
+                __m128d &r = j == 0 ? re0 : re1;
+                __m128d &i = j == 0 ? im0 : im1;
+                r = _mm_add_pd(
+                    r, _mm_add_pd(_mm_mul_pd(ar, br), _mm_mul_pd(ai, bi)));
+                i = _mm_add_pd(
+                    i, _mm_sub_pd(_mm_mul_pd(ar, bi), _mm_mul_pd(ai, br)));
+            }
+        }
+        double r[2];
+        double i[2];
+        _mm_storeu_pd(r, _mm_add_pd(re0, re1));
+        _mm_storeu_pd(i, _mm_add_pd(im0, im1));
+        re = r[0] + r[1];
+        im = i[0] + i[1];
+    }
+#endif
+    const std::complex<T> rest = conjugate_dot_strided<1>(
+        a_real, a_imag, b_real, b_imag, first, end);
+    return std::complex<T>(re + rest.real(), im + rest.imag());
+}
+
+#if defined(__SSE3__)
+
+/**
+ * Products of the interleaved complex values in a and b: with b duplicated
+ * into (re, re) and (im, im) pairs, a * re and swap(a) * im hold the four
+ * partial products, addsub combines them into (re, im).
+ */
+inline __m128 complex_multiply_sse(const __m128 a, const __m128 b)
+{
+    const __m128 real    = _mm_moveldup_ps(b);
+    const __m128 imag    = _mm_movehdup_ps(b);
+    const __m128 swapped = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_addsub_ps(_mm_mul_ps(a, real), _mm_mul_ps(swapped, imag));
+}
+
+inline __m128d complex_multiply_sse(const __m128d a, const __m128d b)
+{
+    const __m128d real    = _mm_movedup_pd(b);
+    const __m128d imag    = _mm_unpackhi_pd(b, b);
+    const __m128d swapped = _mm_shuffle_pd(a, a, 1);
+    return _mm_addsub_pd(_mm_mul_pd(a, real), _mm_mul_pd(swapped, imag));
+}
+
+#endif
+
+/**
+ * out[i] = a[i] * b[i] for interleaved std::complex arrays, using SSE3 for
+ * float and double where available.
+ */
+template<typename T>
+void complex_multiply_kernel(const std::complex<T> *a,
+                             const std::complex<T> *b,
+                             std::complex<T>       *out,
+                             const size_t           begin,
+                             const size_t           end)
+{
+    const T *x     = reinterpret_cast<const T *>(a);
+    const T *y     = reinterpret_cast<const T *>(b);
+    T       *z     = reinterpret_cast<T *>(out);
+    size_t   first = begin;
+#if defined(__SSE3__)
+    if constexpr (std::is_same_v<T, float>)
+    {
+        for (; first + 2 <= end; first += 2)
+        {
+            const __m128 product = complex_multiply_sse(
+                _mm_loadu_ps(x + 2 * first), _mm_loadu_ps(y + 2 * first));
+            _mm_storeu_ps(z + 2 * first, product);
+        }
+    }
+    else if constexpr (std::is_same_v<T, double>)
+    {
+        for (; first < end; ++first)
+        {
+            const __m128d product = complex_multiply_sse(
+                _mm_loadu_pd(x + 2 * first), _mm_loadu_pd(y + 2 * first));
+            _mm_storeu_pd(z + 2 * first, product);
+        }
+    }
+#endif
+    complex_multiply_strided<2>(x, x + 1, y, y + 1, z, z + 1, first, end);
+}
+
+/**
+ * Sum of conj(a[i]) * b[i] for interleaved std::complex arrays.
+ *
+ * The SSE3 path accumulates p = a * (b.re, b.re) and q = a * (b.im, b.im)
+ * without any shuffles, the result is (p.re + q.im, q.re - p.im).
+ */
+template<typename T>
+std::complex<T> conjugate_dot_kernel(const std::complex<T> *a,
+                                     const std::complex<T> *b,
+                                     const size_t           begin,
+                                     const size_t           end)
+{
+    const T *x     = reinterpret_cast<const T *>(a);
+    const T *y     = reinterpret_cast<const T *>(b);
+    size_t   first = begin;
+    T        re {};
+    T        im {};
+#if defined(__SSE3__)
+    if constexpr (std::is_same_v<T, float>)
+    {
+        __m128 p0 = _mm_setzero_ps();
+        __m128 p1 = _mm_setzero_ps();
+        __m128 q0 = _mm_setzero_ps();
+        __m128 q1 = _mm_setzero_ps();
+        for (; first + 4 <= end; first += 4)
+        {
+            const __m128 a0 = _mm_loadu_ps(x + 2 * first);
+            const __m128 a1 = _mm_loadu_ps(x + 2 * first + 4);
+            const __m128 b0 = _mm_loadu_ps(y + 2 * first);
+            const __m128 b1 = _mm_loadu_ps(y + 2 * first + 4);
+
+            p0 = _mm_add_ps(p0, _mm_mul_ps(a0, _mm_moveldup_ps(b0)));
+            p1 = _mm_add_ps(p1, _mm_mul_ps(a1, _mm_moveldup_ps(b1)));
+            q0 = _mm_add_ps(q0, _mm_mul_ps(a0, _mm_movehdup_ps(b0)));
+            q1 = _mm_add_ps(q1, _mm_mul_ps(a1, _mm_movehdup_ps(b1)));
+        }
+        float p[4];
+        float q[4];
+        _mm_storeu_ps(p, _mm_add_ps(p0, p1));
+        _mm_storeu_ps(q, _mm_add_ps(q0, q1));
+        re = (p[0] + p[2]) + (q[1] + q[3]);
+        im = (q[0] + q[2]) - (p[1] + p[3]);
+    }
+    else if constexpr (std::is_same_v<T, double>)
+    {
+        __m128d p0 = _mm_setzero_pd();
+        __m128d p1 = _mm_setzero_pd();
+        __m128d q0 = _mm_setzero_pd();
+        __m128d q1 = _mm_setzero_pd();
+        for (; first + 2 <= end; first += 2)
+        {
+            const __m128d a0 = _mm_loadu_pd(x + 2 * first);
+            const __m128d a1 = _mm_loadu_pd(x + 2 * first + 2);
+            const __m128d b0 = _mm_loadu_pd(y + 2 * first);
+            const __m128d b1 = _mm_loadu_pd(y + 2 * first + 2);
+
+            p0 = _mm_add_pd(p0, _mm_mul_pd(a0, _mm_movedup_pd(b0)));
+            p1 = _mm_add_pd(p1, _mm_mul_pd(a1, _mm_movedup_pd(b1)));
+            q0 = _mm_add_pd(q0, _mm_mul_pd(a0, _mm_unpackhi_pd(b0, b0)));
+            q1 = _mm_add_pd(q1, _mm_mul_pd(a1, _mm_unpackhi_pd(b1, b1)));
+        }
+        double p[2];
+        double q[2];
+        _mm_storeu_pd(p, _mm_add_pd(p0, p1));
+        _mm_storeu_pd(q, _mm_add_pd(q0, q1));
+        re = p[0] + q[1];
+        im = q[0] - p[1];
+    }
+#endif
+    const std::complex<T> rest =
+        conjugate_dot_strided<2>(x, x + 1, y, y + 1, first, end);
+    return std::complex<T>(re + rest.real(), im + rest.imag());
+}
+
+} // namespace details
+} // namespace colibra
+
+#endif
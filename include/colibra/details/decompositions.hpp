@@ -0,0 +1,173 @@
+#ifndef COLIBRA_DETAILS_DECOMPOSITIONS_HPP
+#define COLIBRA_DETAILS_DECOMPOSITIONS_HPP
+
+#include "../matrix.h"
+#include "math.hpp"
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace colibra {
+namespace details {
+
+/// Matrices up to this size get the outer loop of their decompositions
+/// unrolled at compile time, larger ones use plain loops.
+inline constexpr size_t max_unrolled_size = 6;
+
+template<size_t Begin, class Fn, size_t... Idx>
+constexpr void static_for(Fn &fn, std::index_sequence<Idx...>)
+{
+    (fn(std::integral_constant<size_t, Begin + Idx> {}), ...);
+}
+
+/**
+ * Call fn(k) for k in [0, n). For small n every call is instantiated with
+ * its own std::integral_constant, so all loop bounds derived from k are
+ * compile time constants and the compiler can unroll the inner loops too.
+ */
+template<size_t n, class Fn>
+constexpr void unrolled_for(Fn &&fn)
+{
+    if constexpr (n <= max_unrolled_size)
+    {
+        static_for<0>(fn, std::make_index_sequence<n> {});
+    }
+    else
+    {
+        for (size_t k = 0; k < n; ++k)
+        {
+            fn(k);
+        }
+    }
+}
+
+/// sqrt(1 + x * x) without overflow for large x.
+template<typename T>
+constexpr T hypot1(const T x)
+{
+    const T a = abs(x);
+    return a > T {1} ? a * sqrt(T {1} + (T {1} / a) * (T {1} / a))
+                     : sqrt(T {1} + a * a);
+}
+
+/**
+ * Tangent of the Jacobi rotation angle that annihilates an off-diagonal
+ * element, given zeta = (a_qq - a_pp) / (2 a_pq). Picks the smaller of the
+ * two roots so the rotation angle is at most pi / 4.
+ */
+template<typename T>
+constexpr T jacobi_tangent(const T zeta)
+{
+    const T t = T {1} / (abs(zeta) + hypot1(zeta));
+    return zeta < T {0} ? -t : t;
+}
+
+/// Apply the rotation (c, s) to columns p and q of m.
+template<size_t r, size_t c, typename T>
+constexpr void rotate_cols(Matrix<r, c, T> &m,
+                           const size_t     p,
+                           const size_t     q,
+                           const T          cos,
+                           const T          sin)
+{
+    for (size_t i = 0; i < r; ++i)
+    {
+        const T mp = m(i, p);
+        const T mq = m(i, q);
+        m(i, p)    = cos * mp - sin * mq;
+        m(i, q)    = sin * mp + cos * mq;
+    }
+}
+
+/// Apply the rotation (c, s) to rows p and q of m.
+template<size_t r, size_t c, typename T>
+constexpr void rotate_rows(Matrix<r, c, T> &m,
+                           const size_t     p,
+                           const size_t     q,
+                           const T          cos,
+                           const T          sin)
+{
+    for (size_t j = 0; j < c; ++j)
+    {
+        const T mp = m(p, j);
+        const T mq = m(q, j);
+        m(p, j)    = cos * mp - sin * mq;
+        m(q, j)    = sin * mp + cos * mq;
+    }
+}
+
+template<size_t r, size_t c, typename T>
+constexpr void swap_cols(Matrix<r, c, T> &m, const size_t p, const size_t q)
+{
+    for (size_t i = 0; i < r; ++i)
+    {
+        const T tmp = m(i, p);
+        m(i, p)     = m(i, q);
+        m(i, q)     = tmp;
+    }
+}
+
+/**
+ * Replace the zero columns of u by unit vectors orthogonal to all other
+ * columns, so u has orthonormal columns even for rank deficient input.
+ * The nonzero columns must already be orthonormal.
+ */
+template<size_t r, size_t c, typename T>
+constexpr void complete_orthonormal(Matrix<r, c, T> &            u,
+                                    const colibra::Vector<c, T> &norms)
+{
+    for (size_t j = 0; j < c; ++j)
+    {
+        if (norms[j] > T {0})
+        {
+            continue;
+        }
+        std::array<bool, c> filled {};
+        for (size_t p = 0; p < c; ++p)
+        {
+            filled[p] = norms[p] > T {0} || p < j;
+        }
+        // Try the canonical basis vectors, keep the one with the largest
+        // remainder after removing the components along the filled columns.
+        colibra::Vector<r, T> best;
+        T            best_norm {};
+        for (size_t e = 0; e < r; ++e)
+        {
+            colibra::Vector<r, T> v;
+            v[e] = T {1};
+            for (size_t p = 0; p < c; ++p)
+            {
+                if (filled[p])
+                {
+                    const T proj = u(e, p);
+                    for (size_t i = 0; i < r; ++i)
+                    {
+                        v[i] -= proj * u(i, p);
+                    }
+                }
+            }
+            T norm {};
+            for (size_t i = 0; i < r; ++i)
+            {
+                norm += v[i] * v[i];
+            }
+            if (norm > best_norm)
+            {
+                best      = v;
+                best_norm = norm;
+            }
+        }
+        const T scale = T {1} / sqrt(best_norm);
+        for (size_t i = 0; i < r; ++i)
+        {
+            u(i, j) = best[i] * scale;
+        }
+    }
+}
+
+} // namespace details
+} // namespace colibra
+
+#endif
@@ -0,0 +1,124 @@
+#ifndef COLIBRA_DETAILS_FIXED_POINT_HPP
+#define COLIBRA_DETAILS_FIXED_POINT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace colibra {
+namespace details {
+
+/// Signed integer type with twice the width of T, used for intermediate
+/// results that must not overflow.
+template<typename T>
+struct wide;
+
+template<>
+struct wide<int8_t>
+{
+    using type = int16_t;
+};
+
+template<>
+struct wide<int16_t>
+{
+    using type = int32_t;
+};
+
+template<>
+struct wide<int32_t>
+{
+    using type = int64_t;
+};
+
+#if defined(__SIZEOF_INT128__)
+/// The 128 bit integer of GCC and Clang, declared as an extension so that
+/// code including the headers stays free of -Wpedantic warnings.
+__extension__ typedef __int128 int128_t;
+
+template<>
+struct wide<int64_t>
+{
+    using type = int128_t;
+};
+#endif
+
+template<typename T>
+using wide_t = typename wide<T>::type;
+
+/// Clamp a wide integer into the range of Rep.
+template<typename Rep, typename W>
+constexpr Rep saturate(const W value) noexcept
+{
+    constexpr W lowest = static_cast<W>(std::numeric_limits<Rep>::min());
+    constexpr W highest = static_cast<W>(std::numeric_limits<Rep>::max());
+    return static_cast<Rep>(value < lowest ? lowest
+                                           : (value > highest ? highest : value));
+}
+
+/// Saturating integer addition and subtraction.
+template<typename T>
+constexpr T saturating_add(const T a, const T b) noexcept
+{
+    static_assert(std::is_integral_v<T> && std::is_signed_v<T>,
+                  "saturating arithmetic needs signed integers");
+    T result {};
+    if (__builtin_add_overflow(a, b, &result))
+    {
+        return b > 0 ? std::numeric_limits<T>::max()
+                     : std::numeric_limits<T>::min();
+    }
+    return result;
+}
+
+template<typename T>
+constexpr T saturating_sub(const T a, const T b) noexcept
+{
+    static_assert(std::is_integral_v<T> && std::is_signed_v<T>,
+                  "saturating arithmetic needs signed integers");
+    T result {};
+    if (__builtin_sub_overflow(a, b, &result))
+    {
+        return b < 0 ? std::numeric_limits<T>::max()
+                     : std::numeric_limits<T>::min();
+    }
+    return result;
+}
+
+/// Number of value bits (without sign) of a signed integer type.
+template<typename Rep>
+inline constexpr int value_bits = std::numeric_limits<Rep>::digits;
+
+/// Right shift that rounds to nearest, ties away from zero for positive and
+/// towards positive infinity for negative values, like most DSP libraries.
+template<typename W>
+constexpr W rounding_shift(const W value, const int shift) noexcept
+{
+    if (shift <= 0)
+    {
+        return value;
+    }
+    return (value + (W {1} << (shift - 1))) >> shift;
+}
+
+/// Right shift applied to products before accumulation so that at least
+/// 2^15 terms fit into an int64_t, and the fractional bits that remain.
+template<int Frac, typename Rep>
+struct dot_wide_format
+{
+    static constexpr int bits   = value_bits<Rep> + 1;
+    static constexpr int excess = 2 * bits - 50 > 0 ? 2 * bits - 50 : 0;
+    static constexpr int shift  = excess < 2 * Frac ? excess : 2 * Frac;
+    static constexpr int frac   = 2 * Frac - shift;
+};
+
+/// Terms a dot_wide_format accumulation can hold without overflow. For Q31
+/// a product of two -1.0 is 2^48 after the shift, 2^15 of them would just
+/// reach 2^63.
+inline constexpr size_t dot_wide_terms = (size_t {1} << 15) - 1;
+
+} // namespace details
+} // namespace colibra
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef COLIBRA_DETAILS_FIXED_POINT_KERNELS_HPP
+#define COLIBRA_DETAILS_FIXED_POINT_KERNELS_HPP
+
+#include "../fixed_point.h"
+#include "kernels.hpp"
+
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+
+namespace colibra {
+namespace details {
+
+/**
+ * Q15 dot products with pmaddwd. Each instruction multiplies two components
+ * of four points with the matching query components and adds the pairs in
+ * 32 bit, the pair sums are then accumulated in 64 bit per point.
+ *
+ * A pair sum lies in [-2^31 + 2^16, 2^31], where 2^31, from four inputs of
+ * -1.0, wraps to -2^31 in 32 bit. Subtracting the lower bound modulo 2^32
+ * maps the range to [0, 2^32 - 2^16], which zero extends exactly, and the
+ * bias is added back once per point.
+ */
+template<size_t l>
+void dot_kernel(const colibra::Vector<l, q15> &query,
+                const SoaPoints<l, q15> &      points,
+                dot_wide_t<q15> *              out,
+                const size_t                   begin,
+                const size_t                   end)
+{
+    size_t first = begin;
+#if defined(__SSE4_1__)
+    static_assert(sizeof(dot_wide_t<q15>) == sizeof(int64_t),
+                  "dot results are stored as raw int64_t");
+
+    __m128i query_pairs[(l + 1) / 2];
+    for (size_t d = 0; d < l; d += 2)
+    {
+        const auto q0 = static_cast<uint16_t>(query[d].raw());
+        const auto q1 =
+            static_cast<uint16_t>(d + 1 < l ? query[d + 1].raw() : 0);
+        query_pairs[d / 2] = _mm_set1_epi32(
+            static_cast<int32_t>((static_cast<uint32_t>(q1) << 16) | q0));
+    }
+
+    constexpr int64_t pair_min = -(int64_t {1} << 31) + (int64_t {1} << 16);
+    constexpr int64_t pairs    = static_cast<int64_t>((l + 1) / 2);
+
+    const __m128i bias       = _mm_set1_epi32(static_cast<int32_t>(pair_min));
+    const __m128i total_bias = _mm_set1_epi64x(pairs * pair_min);
+
+    auto load = [&points](size_t d, size_t i) {
+        return _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(points.components[d] + i));
+    };
+
+    for (; first + 8 <= end; first += 8)
+    {
+        __m128i acc0 = total_bias;
+        __m128i acc1 = total_bias;
+        __m128i acc2 = total_bias;
+        __m128i acc3 = total_bias;
+        for (size_t d = 0; d < l; d += 2)
+        {
+            const __m128i a = load(d, first);
+            const __m128i b =
+                d + 1 < l ? load(d + 1, first) : _mm_setzero_si128();
+            const __m128i q = query_pairs[d / 2];
+
+            const __m128i lo = _mm_sub_epi32(
+                _mm_madd_epi16(_mm_unpacklo_epi16(a, b), q), bias);
+            const __m128i hi = _mm_sub_epi32(
+                _mm_madd_epi16(_mm_unpackhi_epi16(a, b), q), bias);
+
+            acc0 = _mm_add_epi64(acc0, _mm_cvtepu32_epi64(lo));
+            acc1 = _mm_add_epi64(acc1,
+                                 _mm_cvtepu32_epi64(_mm_srli_si128(lo, 8)));
+            acc2 = _mm_add_epi64(acc2, _mm_cvtepu32_epi64(hi));
+            acc3 = _mm_add_epi64(acc3,
+                                 _mm_cvtepu32_epi64(_mm_srli_si128(hi, 8)));
+        }
+        auto *target = reinterpret_cast<__m128i *>(out + first);
+        _mm_storeu_si128(target + 0, acc0);
+        _mm_storeu_si128(target + 1, acc1);
+        _mm_storeu_si128(target + 2, acc2);
+        _mm_storeu_si128(target + 3, acc3);
+    }
+#endif
+    reduce_points<l, int64_t>(
+        points,
+        out,
+        first,
+        end,
+        [&query](size_t d, const q15 &p) { return wide_product(query[d], p); },
+        [](const int64_t acc) { return from_wide<q15>(acc); });
+}
+
+} // namespace details
+} // namespace colibra
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef COLIBRA_DETAILS_FORMAT_HPP
+#define COLIBRA_DETAILS_FORMAT_HPP
+
+#include "../fixed_point.h"
+#include "../half.h"
+
+#include <charconv>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+
+namespace colibra {
+namespace details {
+
+/// Type an element is printed and parsed as: 16 bit floats go through
+/// float, fixed-point numbers through double, which holds them exactly.
+template<typename T>
+using text_type_t = std::conditional_t<
+    is_float16_v<T>,
+    float,
+    std::conditional_t<is_fixed_point_v<T>, double, T>>;
+
+/// Upper bound on the characters to_chars produces for one element.
+template<typename T>
+constexpr size_t max_element_chars()
+{
+    using X = text_type_t<T>;
+    static_assert(std::is_arithmetic_v<X> && !std::is_same_v<X, bool>,
+                  "only arithmetic, half and fixed-point Vectors can be "
+                  "formatted");
+    if constexpr (std::is_floating_point_v<X>)
+    {
+        // Sign, digits, decimal point, 'e', exponent sign and digits.
+        return std::numeric_limits<X>::max_digits10 + 9;
+    }
+    else
+    {
+        // Sign and digits.
+        return std::numeric_limits<X>::digits10 + 2;
+    }
+}
+
+constexpr bool is_space(const char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+constexpr const char *skip_space(const char *first, const char *last)
+{
+    while (first != last && is_space(*first))
+    {
+        ++first;
+    }
+    return first;
+}
+
+/// Copy a literal, failing with value_too_large when it does not fit.
+inline std::to_chars_result
+put(char *first, char *last, const char *text, size_t length)
+{
+    if (static_cast<size_t>(last - first) < length)
+    {
+        return {last, std::errc::value_too_large};
+    }
+    for (size_t i = 0; i < length; ++i)
+    {
+        *first++ = text[i];
+    }
+    return {first, std::errc {}};
+}
+
+template<typename T>
+std::to_chars_result format_element(char *first, char *last, const T &value)
+{
+    return std::to_chars(first, last, static_cast<text_type_t<T>>(value));
+}
+
+template<typename T>
+std::from_chars_result
+parse_element(const char *first, const char *last, T &value)
+{
+    text_type_t<T>         parsed {};
+    std::from_chars_result result = std::from_chars(first, last, parsed);
+    if (result.ec != std::errc {})
+    {
+        return result;
+    }
+    if constexpr (is_fixed_point_v<T>)
+    {
+        // Fixed-point construction saturates, report it like from_chars.
+        if (parsed < static_cast<double>(T::lowest())
+            || parsed > static_cast<double>(T::highest()))
+        {
+            return {result.ptr, std::errc::result_out_of_range};
+        }
+    }
+    value = static_cast<T>(parsed);
+    return result;
+}
+
+} // namespace details
+} // namespace colibra
+
+#endif
@@ -0,0 +1,253 @@
+#ifndef COLIBRA_DETAILS_GEMM_HPP
+#define COLIBRA_DETAILS_GEMM_HPP
+
+#include "../execution.h"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace colibra {
+namespace details {
+
+/**
+ * Blocking parameters of the GEMM kernel. A packed kc x nc block of B is
+ * swept by packed mc x kc blocks of A, which stay in L2, while one kc x nr
+ * micro panel of B stays in L1. The micro kernel keeps an mr x nr block of
+ * C in registers: four rows of 32 bytes, which leaves half of the 16 SSE
+ * registers for the operands.
+ */
+template<typename R>
+struct GemmBlocking
+{
+    static constexpr size_t mr = 4;
+    static constexpr size_t nr = sizeof(R) >= 8 ? 4 : 8;
+    static constexpr size_t kc = 256;
+    static constexpr size_t mc = 64;
+    static constexpr size_t nc = 2048;
+};
+
+/**
+ * Pack rows [row, row + rows) and columns [col, col + depth) of the
+ * row-major matrix a into micro panels of mr rows. Within a panel the
+ * elements are stored column by column, and partial panels are padded with
+ * zeros, so the micro kernel always runs full width.
+ */
+template<typename R, typename T>
+void pack_a(const T *    a,
+            const size_t lda,
+            const size_t row,
+            const size_t rows,
+            const size_t col,
+            const size_t depth,
+            R *          packed)
+{
+    constexpr size_t mr = GemmBlocking<R>::mr;
+    for (size_t i0 = 0; i0 < rows; i0 += mr)
+    {
+        const size_t height = std::min(mr, rows - i0);
+        for (size_t p = 0; p < depth; ++p)
+        {
+            for (size_t i = 0; i < mr; ++i)
+            {
+                packed[i] = i < height ? static_cast<R>(
+                                a[(row + i0 + i) * lda + col + p])
+                                       : R {0};
+            }
+            packed += mr;
+        }
+    }
+}
+
+/**
+ * Pack rows [row, row + depth) and columns [col, col + cols) of the
+ * row-major matrix b into micro panels of nr columns, stored row by row and
+ * padded with zeros.
+ */
+template<typename R, typename S>
+void pack_b(const S *    b,
+            const size_t ldb,
+            const size_t row,
+            const size_t depth,
+            const size_t col,
+            const size_t cols,
+            R *          packed)
+{
+    constexpr size_t nr = GemmBlocking<R>::nr;
+    for (size_t j0 = 0; j0 < cols; j0 += nr)
+    {
+        const size_t width = std::min(nr, cols - j0);
+        for (size_t p = 0; p < depth; ++p)
+        {
+            const S *src = b + (row + p) * ldb + col + j0;
+            for (size_t j = 0; j < width; ++j)
+            {
+                packed[j] = static_cast<R>(src[j]);
+            }
+            for (size_t j = width; j < nr; ++j)
+            {
+                packed[j] = R {0};
+            }
+            packed += nr;
+        }
+    }
+}
+
+/**
+ * Multiply a packed mr x depth panel of A with a packed depth x nr panel of
+ * B and add the result to the height x width block of C at c. The
+ * accumulators have compile time extents and vectorize along the nr
+ * columns.
+ */
+template<typename R>
+void micro_kernel(const size_t depth,
+                  const R *    a,
+                  const R *    b,
+                  R *          c,
+                  const size_t ldc,
+                  const size_t height,
+                  const size_t width)
+{
+    constexpr size_t mr = GemmBlocking<R>::mr;
+    constexpr size_t nr = GemmBlocking<R>::nr;
+
+    R acc[mr][nr] = {};
+    for (size_t p = 0; p < depth; ++p)
+    {
+        for (size_t i = 0; i < mr; ++i)
+        {
+            const R scale = a[i];
+            for (size_t j = 0; j < nr; ++j)
+            {
+                acc[i][j] += scale * b[j];
+            }
+        }
+        a += mr;
+        b += nr;
+    }
+
+    if (height == mr && width == nr)
+    {
+        for (size_t i = 0; i < mr; ++i)
+        {
+            for (size_t j = 0; j < nr; ++j)
+            {
+                c[i * ldc + j] += acc[i][j];
+            }
+        }
+        return;
+    }
+    for (size_t i = 0; i < height; ++i)
+    {
+        for (size_t j = 0; j < width; ++j)
+        {
+            c[i * ldc + j] += acc[i][j];
+        }
+    }
+}
+
+/**
+ * c += a * b for row-major a (m x k), b (k x n) and c (m x n), restricted
+ * to the rows [row_begin, row_end) of a and c.
+ *
+ * Follows the usual five loop structure: blocks of B are packed once per
+ * thread and reused by every block of A, both are converted to the result
+ * type while packing.
+ */
+template<typename R, typename T, typename S>
+void gemm_rows(const T *    a,
+               const S *    b,
+               R *          c,
+               const size_t row_begin,
+               const size_t row_end,
+               const size_t k,
+               const size_t n)
+{
+    using Blocking = GemmBlocking<R>;
+
+    constexpr size_t mr = Blocking::mr;
+    constexpr size_t nr = Blocking::nr;
+
+    // Partial micro panels are padded to full width.
+    const size_t   mc = (Blocking::mc + mr - 1) / mr * mr;
+    const size_t   nc = std::min(Blocking::nc, (n + nr - 1) / nr * nr);
+    std::vector<R> packed_a(mc * Blocking::kc);
+    std::vector<R> packed_b(Blocking::kc * nc);
+
+    for (size_t jc = 0; jc < n; jc += Blocking::nc)
+    {
+        const size_t cols = std::min(Blocking::nc, n - jc);
+        for (size_t pc = 0; pc < k; pc += Blocking::kc)
+        {
+            const size_t depth = std::min(Blocking::kc, k - pc);
+            pack_b(b, n, pc, depth, jc, cols, packed_b.data());
+
+            for (size_t ic = row_begin; ic < row_end; ic += Blocking::mc)
+            {
+                const size_t rows = std::min(Blocking::mc, row_end - ic);
+                pack_a(a, k, ic, rows, pc, depth, packed_a.data());
+
+                for (size_t jr = 0; jr < cols; jr += nr)
+                {
+                    const R *b_panel = packed_b.data() + jr * depth;
+                    for (size_t ir = 0; ir < rows; ir += mr)
+                    {
+                        micro_kernel(depth,
+                                     packed_a.data() + ir * depth,
+                                     b_panel,
+                                     c + (ic + ir) * n + jc + jr,
+                                     n,
+                                     std::min(mr, rows - ir),
+                                     std::min(nr, cols - jr));
+                    }
+                }
+            }
+        }
+    }
+}
+
+/// Independent partial sums per row, so the reduction vectorizes without
+/// reassociating floating point math.
+inline constexpr size_t gemv_lanes = 16;
+
+/**
+ * y[i] = sum_j a[i][j] * x[j] for the rows [begin, end) of the row-major
+ * matrix a with n columns.
+ */
+template<typename R, typename T, typename S>
+void gemv_rows(const T *    a,
+               const S *    x,
+               R *          y,
+               const size_t begin,
+               const size_t end,
+               const size_t n)
+{
+    const size_t full = n / gemv_lanes * gemv_lanes;
+    for (size_t i = begin; i < end; ++i)
+    {
+        const T *row             = a + i * n;
+        R        acc[gemv_lanes] = {};
+        for (size_t j = 0; j < full; j += gemv_lanes)
+        {
+            for (size_t t = 0; t < gemv_lanes; ++t)
+            {
+                acc[t] += static_cast<R>(row[j + t]) * static_cast<R>(x[j + t]);
+            }
+        }
+        R sum {};
+        for (size_t t = 0; t < gemv_lanes; ++t)
+        {
+            sum += acc[t];
+        }
+        for (size_t j = full; j < n; ++j)
+        {
+            sum += static_cast<R>(row[j]) * static_cast<R>(x[j]);
+        }
+        y[i] = sum;
+    }
+}
+
+} // namespace details
+} // namespace colibra
+
+#endif
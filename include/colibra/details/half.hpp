@@ -0,0 +1,262 @@
+#ifndef COLIBRA_DETAILS_HALF_HPP
+#define COLIBRA_DETAILS_HALF_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace colibra {
+namespace details {
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_bit_cast)
+#define COLIBRA_HAS_BUILTIN_BIT_CAST 1
+#endif
+#endif
+
+/**
+ * Reinterpret the bits of a float as an integer and back. Constexpr where
+ * the compiler provides __builtin_bit_cast.
+ */
+template<typename To, typename From>
+constexpr To bit_cast(const From &from) noexcept
+{
+    static_assert(sizeof(To) == sizeof(From), "bit_cast requires equal sizes");
+#ifdef COLIBRA_HAS_BUILTIN_BIT_CAST
+    return __builtin_bit_cast(To, from);
+#else
+    To to;
+    std::memcpy(&to, &from, sizeof(To));
+    return to;
+#endif
+}
+
+/**
+ * IEEE 754 binary16: 1 sign, 5 exponent and 10 mantissa bits.
+ */
+struct binary16_format
+{
+    static constexpr uint16_t from_float(const float value) noexcept
+    {
+        const uint32_t x    = bit_cast<uint32_t>(value);
+        const uint32_t sign = (x >> 16) & 0x8000u;
+        uint32_t       mant = x & 0x007fffffu;
+        const int32_t  exp  = static_cast<int32_t>((x >> 23) & 0xffu);
+
+        if (exp == 0xff)
+        {
+            // Infinity stays infinity, NaN stays a quiet NaN.
+            return static_cast<uint16_t>(
+                sign | 0x7c00u | (mant != 0 ? 0x0200u | (mant >> 13) : 0u));
+        }
+
+        const int32_t half_exp = exp - 127 + 15;
+        if (half_exp >= 0x1f)
+        {
+            return static_cast<uint16_t>(sign | 0x7c00u);
+        }
+
+        if (half_exp <= 0)
+        {
+            // Subnormal result or underflow to zero.
+            if (half_exp < -10)
+            {
+                return static_cast<uint16_t>(sign);
+            }
+            mant |= 0x00800000u;
+            const uint32_t shift     = static_cast<uint32_t>(14 - half_exp);
+            uint32_t       half_mant = mant >> shift;
+            const uint32_t rest      = mant & ((1u << shift) - 1u);
+            const uint32_t halfway   = 1u << (shift - 1u);
+            if (rest > halfway || (rest == halfway && (half_mant & 1u) != 0))
+            {
+                ++half_mant;
+            }
+            return static_cast<uint16_t>(sign | half_mant);
+        }
+
+        // Round to nearest even, a carry into the exponent is intended.
+        uint32_t half = sign | (static_cast<uint32_t>(half_exp) << 10)
+                        | (mant >> 13);
+        const uint32_t rest = mant & 0x1fffu;
+        if (rest > 0x1000u || (rest == 0x1000u && (half & 1u) != 0))
+        {
+            ++half;
+        }
+        return static_cast<uint16_t>(half);
+    }
+
+    static constexpr float to_float(const uint16_t bits) noexcept
+    {
+        const uint32_t sign = static_cast<uint32_t>(bits & 0x8000u) << 16;
+        const uint32_t exp  = (bits >> 10) & 0x1fu;
+        uint32_t       mant = bits & 0x03ffu;
+
+        if (exp == 0x1f)
+        {
+            return bit_cast<float>(sign | 0x7f800000u | (mant << 13));
+        }
+        if (exp != 0)
+        {
+            return bit_cast<float>(sign | ((exp + 112u) << 23) | (mant << 13));
+        }
+        if (mant == 0)
+        {
+            return bit_cast<float>(sign);
+        }
+
+        // Subnormal half, normalize the mantissa.
+        uint32_t shift = 0;
+        while ((mant & 0x0400u) == 0)
+        {
+            mant <<= 1;
+            ++shift;
+        }
+        return bit_cast<float>(sign | ((113u - shift) << 23)
+                               | ((mant & 0x03ffu) << 13));
+    }
+};
+
+/**
+ * bfloat16: the upper half of a binary32, 1 sign, 8 exponent and 7 mantissa
+ * bits. Same range as float at reduced precision.
+ */
+struct bfloat16_format
+{
+    static constexpr uint16_t from_float(const float value) noexcept
+    {
+        const uint32_t x = bit_cast<uint32_t>(value);
+        if ((x & 0x7fffffffu) > 0x7f800000u)
+        {
+            return static_cast<uint16_t>((x >> 16) | 0x0040u);
+        }
+        // Round to nearest even.
+        return static_cast<uint16_t>((x + 0x7fffu + ((x >> 16) & 1u)) >> 16);
+    }
+
+    static constexpr float to_float(const uint16_t bits) noexcept
+    {
+        return bit_cast<float>(static_cast<uint32_t>(bits) << 16);
+    }
+};
+
+/**
+ * A 16 bit floating point storage type. Arithmetic converts to float,
+ * computes in float and rounds back.
+ */
+template<class Format>
+class Float16
+{
+  public:
+    constexpr Float16() = default;
+
+    /**
+     * Explicit, so float arithmetic never silently rounds to 16 bit.
+     */
+    explicit constexpr Float16(const float value) noexcept
+        : m_bits(Format::from_float(value))
+    {
+    }
+
+    constexpr operator float() const noexcept
+    {
+        return Format::to_float(m_bits);
+    }
+
+    [[nodiscard]] static constexpr Float16 from_bits(const uint16_t bits)
+    {
+        Float16 value;
+        value.m_bits = bits;
+        return value;
+    }
+
+    [[nodiscard]] constexpr uint16_t bits() const noexcept
+    {
+        return m_bits;
+    }
+
+    constexpr Float16 operator-() const noexcept
+    {
+        return from_bits(static_cast<uint16_t>(m_bits ^ 0x8000u));
+    }
+
+    friend constexpr Float16 operator+(const Float16 a, const Float16 b)
+    {
+        return Float16(static_cast<float>(a) + static_cast<float>(b));
+    }
+
+    friend constexpr Float16 operator-(const Float16 a, const Float16 b)
+    {
+        return Float16(static_cast<float>(a) - static_cast<float>(b));
+    }
+
+    friend constexpr Float16 operator*(const Float16 a, const Float16 b)
+    {
+        return Float16(static_cast<float>(a) * static_cast<float>(b));
+    }
+
+    friend constexpr Float16 operator/(const Float16 a, const Float16 b)
+    {
+        return Float16(static_cast<float>(a) / static_cast<float>(b));
+    }
+
+    constexpr Float16 &operator+=(const Float16 other)
+    {
+        return *this = *this + other;
+    }
+
+    constexpr Float16 &operator-=(const Float16 other)
+    {
+        return *this = *this - other;
+    }
+
+    constexpr Float16 &operator*=(const Float16 other)
+    {
+        return *this = *this * other;
+    }
+
+    constexpr Float16 &operator/=(const Float16 other)
+    {
+        return *this = *this / other;
+    }
+
+  private:
+    uint16_t m_bits = 0;
+};
+
+template<typename T>
+struct is_float16 : std::false_type
+{
+};
+
+template<class Format>
+struct is_float16<Float16<Format>> : std::true_type
+{
+};
+
+template<typename T>
+inline constexpr bool is_float16_v = is_float16<T>::value;
+
+/// Result of combining a 16 bit float with another arithmetic type:
+/// integers keep the 16 bit type, floating types win.
+template<typename F, typename S, typename = void>
+struct float16_common
+{
+};
+
+template<typename F, typename S>
+struct float16_common<F, S, std::enable_if_t<std::is_integral_v<S>>>
+{
+    using type = F;
+};
+
+template<typename F, typename S>
+struct float16_common<F, S, std::enable_if_t<std::is_floating_point_v<S>>>
+{
+    using type = std::common_type_t<float, S>;
+};
+
+} // namespace details
+} // namespace colibra
+
+#endif
@@ -0,0 +1,176 @@
+#ifndef COLIBRA_DETAILS_INTERPOLATION_HPP
+#define COLIBRA_DETAILS_INTERPOLATION_HPP
+
+#include "../batch.h"
+#include "../vector.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace colibra {
+namespace details {
+
+/// Batch kernels compute per parameter weights into stack buffers of this
+/// many elements, then apply them component by component.
+inline constexpr size_t interpolation_chunk = 256;
+
+/**
+ * Sine from its Taylor polynomial up to x^23, accurate to the rounding of
+ * double for |x| <= pi / 2. It has no branches and no library call, so
+ * loops over it vectorize.
+ */
+template<typename T>
+constexpr T sin_series(const T x)
+{
+    const T x2     = x * x;
+    T       result = T {1};
+    for (int k = 11; k > 0; --k)
+    {
+        const T factor = T {1} / static_cast<T>(2 * k * (2 * k + 1));
+        result         = T {1} - x2 * factor * result;
+    }
+    return x * result;
+}
+
+/**
+ * out[i] = a * wa(t[i]) + b * wb(t[i]) for i in [begin, end). weights(t,
+ * wa, wb) runs over a chunk of parameters first, then every component is a
+ * separate loop with two streams, which keeps both loops simple enough to
+ * vectorize.
+ */
+template<size_t l, typename T, class Weights>
+void blend_kernel(const colibra::Vector<l, T> &a,
+                  const colibra::Vector<l, T> &b,
+                  const T                     *t,
+                  const BatchView<l, T>       &out,
+                  const size_t                 begin,
+                  const size_t                 end,
+                  const Weights               &weights)
+{
+    std::array<T, interpolation_chunk> wa;
+    std::array<T, interpolation_chunk> wb;
+    for (size_t first = begin; first < end; first += interpolation_chunk)
+    {
+        const size_t n = std::min(interpolation_chunk, end - first);
+        for (size_t i = 0; i < n; ++i)
+        {
+            weights(t[first + i], wa[i], wb[i]);
+        }
+        for (size_t d = 0; d < l; ++d)
+        {
+            const T a_d = a[d];
+            const T b_d = b[d];
+            T      *o   = out.component(d) + first;
+            for (size_t i = 0; i < n; ++i)
+            {
+                o[i] = a_d * wa[i] + b_d * wb[i];
+            }
+        }
+    }
+}
+
+/**
+ * Locate parameter s on a spline with the given number of unit length
+ * segments: the segment index and the parameter within it. s is clamped to
+ * [0, segments], NaN maps to the end.
+ */
+template<typename T>
+constexpr void spline_locate(const T        s,
+                             const int32_t  segments,
+                             int32_t       &segment,
+                             T             &local)
+{
+    const T last    = static_cast<T>(segments);
+    const T clamped = s < last ? (s > T {0} ? s : T {0}) : last;
+    segment         = std::min(static_cast<int32_t>(clamped), segments - 1);
+    local           = clamped - static_cast<T>(segment);
+}
+
+/// Evaluate a cubic from its coefficients c[0] + c[1] u + c[2] u^2 +
+/// c[3] u^3.
+template<typename T>
+constexpr T horner(const T *c, const T u)
+{
+    return ((c[3] * u + c[2]) * u + c[1]) * u + c[0];
+}
+
+/**
+ * Evaluate a spline at parameters [begin, end). Segments and local
+ * parameters are computed for a chunk first. Gathering the coefficients of
+ * each parameter's segment does not vectorize, so when parameters stay in
+ * the same segment for long runs, as sorted parameters do, each run is
+ * evaluated with its coefficients held in registers instead.
+ */
+template<size_t l, typename T>
+void spline_kernel(const std::array<const T *, l> &coefficients,
+                   const int32_t                   segments,
+                   const T                        *parameters,
+                   const BatchView<l, T>          &out,
+                   const size_t                    begin,
+                   const size_t                    end)
+{
+    // Runs shorter than this on average are cheaper to gather.
+    constexpr size_t min_run = 8;
+
+    std::array<int32_t, interpolation_chunk> segment;
+    std::array<T, interpolation_chunk>       local;
+    for (size_t first = begin; first < end; first += interpolation_chunk)
+    {
+        const size_t n = std::min(interpolation_chunk, end - first);
+        for (size_t i = 0; i < n; ++i)
+        {
+            spline_locate(
+                parameters[first + i], segments, segment[i], local[i]);
+        }
+        size_t changes = 0;
+        for (size_t i = 1; i < n; ++i)
+        {
+            changes += segment[i] != segment[i - 1];
+        }
+
+        if (changes * min_run >= n)
+        {
+            for (size_t d = 0; d < l; ++d)
+            {
+                const T *c = coefficients[d];
+                T       *o = out.component(d) + first;
+                for (size_t i = 0; i < n; ++i)
+                {
+                    o[i] = horner(c + 4 * static_cast<size_t>(segment[i]),
+                                  local[i]);
+                }
+            }
+            continue;
+        }
+        for (size_t run = 0; run < n;)
+        {
+            const int32_t k       = segment[run];
+            size_t        run_end = run + 1;
+            while (run_end < n && segment[run_end] == k)
+            {
+                ++run_end;
+            }
+            for (size_t d = 0; d < l; ++d)
+            {
+                const T *c  = coefficients[d] + 4 * static_cast<size_t>(k);
+                const T  c0 = c[0];
+                const T  c1 = c[1];
+                const T  c2 = c[2];
+                const T  c3 = c[3];
+                T       *o  = out.component(d) + first;
+                for (size_t i = run; i < run_end; ++i)
+                {
+                    const T u = local[i];
+                    o[i]      = ((c3 * u + c2) * u + c1) * u + c0;
+                }
+            }
+            run = run_end;
+        }
+    }
+}
+
+} // namespace details
+} // namespace colibra
+
+#endif
@@ -0,0 +1,185 @@
+#ifndef COLIBRA_DETAILS_KERNELS_HPP
+#define COLIBRA_DETAILS_KERNELS_HPP
+
+#include "../batch.h"
+#include "../fixed_point.h"
+#include "../half.h"
+#include "../span.h"
+
+#include <algorithm>
+#include <array>
+#include <type_traits>
+
+namespace colibra {
+namespace details {
+
+/// Type batch kernels compute in: 16 bit floats are widened to float, all
+/// other types are used as they are.
+template<typename T>
+using compute_type_t = std::conditional_t<is_float16_v<T>, float, T>;
+
+/// Result type of batched dot products: the compute type, except for
+/// fixed-point Vectors which use the exact dot_wide result.
+template<typename T>
+using dot_type_t = typename std::conditional_t<is_fixed_point_v<T>,
+                                               dot_wide_type<T>,
+                                               identity<compute_type_t<T>>>::type;
+
+/// Result type of norms and distances: floating types stay as they are,
+/// everything else is computed in double just like Vector::norm().
+template<typename T>
+using norm_type_t =
+    std::conditional_t<std::is_floating_point_v<compute_type_t<T>>,
+                       compute_type_t<T>,
+                       double>;
+
+/**
+ * Accessor for structure-of-arrays input. Component d of point i is read
+ * from its own contiguous array, so the loop over i vectorizes cleanly.
+ */
+template<size_t l, typename T>
+struct SoaPoints
+{
+    std::array<const T *, l> components;
+
+    constexpr const T &operator()(const size_t d, const size_t i) const
+    {
+        return components[d][i];
+    }
+};
+
+template<size_t l, typename T>
+constexpr SoaPoints<l, T> make_points(const BatchView<l, const T> &view)
+{
+    SoaPoints<l, T> points {};
+    for (size_t d = 0; d < l; ++d)
+    {
+        points.components[d] = view.component(d);
+    }
+    return points;
+}
+
+/**
+ * Accessor for array-of-structures input, component d of point i lives at
+ * offset i * l + d.
+ */
+template<size_t l, typename T>
+struct AosPoints
+{
+    const colibra::Vector<l, T> *vectors;
+
+    constexpr const T &operator()(const size_t d, const size_t i) const
+    {
+        return vectors[i][d];
+    }
+};
+
+template<size_t l, typename T>
+constexpr AosPoints<l, T>
+make_points(const Span<const colibra::Vector<l, T>> &span)
+{
+    return AosPoints<l, T> {span.data()};
+}
+
+/**
+ * Reduce each point to a single value: out[i] = finish(sum_d term(d, p_id)).
+ * The loop over d has a compile time trip count and is unrolled, the loop
+ * over i is the one the compiler vectorizes.
+ */
+template<size_t l, typename A, class Points, typename R, class Term, class Finish>
+void reduce_points(const Points &points,
+                   R *           out,
+                   const size_t  begin,
+                   const size_t  end,
+                   const Term &  term,
+                   const Finish &finish)
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        A acc {};
+        for (size_t d = 0; d < l; ++d)
+        {
+            acc += term(d, points(d, i));
+        }
+        out[i] = finish(acc);
+    }
+}
+
+/**
+ * 16 bit floats are widened chunk by chunk into float buffers on the stack,
+ * then reduced with the float kernel.
+ */
+template<size_t l,
+         typename A,
+         class Format,
+         typename R,
+         class Term,
+         class Finish>
+void reduce_points(const SoaPoints<l, Float16<Format>> &points,
+                   R *                                  out,
+                   const size_t                         begin,
+                   const size_t                         end,
+                   const Term &                         term,
+                   const Finish &                       finish)
+{
+    constexpr size_t                         chunk = 256;
+    std::array<std::array<float, chunk>, l> buffer;
+
+    SoaPoints<l, float> widened {};
+    for (size_t d = 0; d < l; ++d)
+    {
+        widened.components[d] = buffer[d].data();
+    }
+
+    for (size_t first = begin; first < end; first += chunk)
+    {
+        const size_t n = std::min(chunk, end - first);
+        for (size_t d = 0; d < l; ++d)
+        {
+            widen(points.components[d] + first, n, buffer[d].data());
+        }
+        reduce_points<l, A>(widened, out + first, 0, n, term, finish);
+    }
+}
+
+/**
+ * Dot products of query with points [begin, end). Fixed-point input is
+ * accumulated exactly in 64 bit, everything else in the compute type.
+ * Specialized for some element types, see fixed_point_kernels.hpp.
+ */
+template<size_t l, typename T, class Points>
+void dot_kernel(const colibra::Vector<l, T> &query,
+                const Points &               points,
+                dot_type_t<T> *              out,
+                const size_t                 begin,
+                const size_t                 end)
+{
+    if constexpr (is_fixed_point_v<T>)
+    {
+        reduce_points<l, int64_t>(
+            points,
+            out,
+            begin,
+            end,
+            [&query](size_t d, const T &p) { return wide_product(query[d], p); },
+            [](const int64_t acc) { return from_wide<T>(acc); });
+    }
+    else
+    {
+        using R = compute_type_t<T>;
+        reduce_points<l, R>(
+            points,
+            out,
+            begin,
+            end,
+            [&query](size_t d, const auto &p) {
+                return static_cast<R>(query[d]) * static_cast<R>(p);
+            },
+            [](const R &acc) { return acc; });
+    }
+}
+
+} // namespace details
+} // namespace colibra
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef COLIBRA_DETAILS_MATH_HPP
+#define COLIBRA_DETAILS_MATH_HPP
+
+#include <cmath>
+#include <limits>
+
+namespace colibra {
+namespace details {
+
+template<typename T>
+constexpr T abs(const T x)
+{
+    return x < T {0} ? -x : x;
+}
+
+/**
+ * Square root usable in constant expressions. At run time this is
+ * std::sqrt, during constant evaluation Newton's method from above.
+ */
+template<typename T>
+constexpr T sqrt(const T x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    if (!__builtin_is_constant_evaluated())
+    {
+        return std::sqrt(x);
+    }
+    if (!(x > T {0}) || x == std::numeric_limits<T>::infinity())
+    {
+        return x == T {0} || x == std::numeric_limits<T>::infinity()
+                   ? x
+                   : std::numeric_limits<T>::quiet_NaN();
+    }
+    T guess = x > T {1} ? x : T {1};
+    while (true)
+    {
+        const T next = (guess + x / guess) / T {2};
+        if (!(next < guess))
+        {
+            return guess;
+        }
+        guess = next;
+    }
+#else
+    return std::sqrt(x);
+#endif
+}
+
+} // namespace details
+} // namespace colibra
+
+#endif
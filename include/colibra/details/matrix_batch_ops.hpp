@@ -0,0 +1,710 @@
+#ifndef COLIBRA_DETAILS_MATRIX_BATCH_OPS_HPP
+#define COLIBRA_DETAILS_MATRIX_BATCH_OPS_HPP
+
+#include "../batch.h"
+#include "../matrix_batch.h"
+#include "decompositions.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+
+namespace colibra {
+namespace details {
+
+/// Instances processed together by the batched matrix kernels. Every
+/// instance occupies one SIMD lane, the tile keeps the working set in L1.
+inline constexpr size_t matrix_tile = 64;
+
+/// Copy count lanes from src into a tile row and pad the rest with pad.
+template<typename T>
+void load_lanes(T (&dst)[matrix_tile],
+                const T *    src,
+                const size_t count,
+                const T      pad)
+{
+    if (count == matrix_tile)
+    {
+        // Full tiles make up nearly all work, a constant trip count lets
+        // the copy vectorize without a remainder loop.
+        std::copy(src, src + matrix_tile, dst);
+        return;
+    }
+    for (size_t t = 0; t < count; ++t)
+    {
+        dst[t] = src[t];
+    }
+    for (size_t t = count; t < matrix_tile; ++t)
+    {
+        dst[t] = pad;
+    }
+}
+
+template<typename T>
+void store_lanes(T *dst, const T (&src)[matrix_tile], const size_t count)
+{
+    if (count == matrix_tile)
+    {
+        std::copy(src, src + matrix_tile, dst);
+        return;
+    }
+    for (size_t t = 0; t < count; ++t)
+    {
+        dst[t] = src[t];
+    }
+}
+
+/**
+ * Copies a tile of matrices into local SoA arrays, where the innermost
+ * index is the instance. Partial tiles are padded with identity matrices,
+ * so the kernels always run the full, compile time tile width and vectorize
+ * even at -O2.
+ */
+template<size_t r, size_t c, typename T>
+struct MatrixTile
+{
+    T m[r][c][matrix_tile];
+
+    void load(const MatrixBatchView<r, c, const T> &matrices,
+              const size_t                          begin,
+              const size_t                          count)
+    {
+        for (size_t i = 0; i < r; ++i)
+        {
+            for (size_t j = 0; j < c; ++j)
+            {
+                load_lanes(m[i][j],
+                           matrices.element(i, j) + begin,
+                           count,
+                           i == j ? T {1} : T {0});
+            }
+        }
+    }
+
+    void store(const MatrixBatchView<r, c, T> &out,
+               const size_t                    begin,
+               const size_t                    count) const
+    {
+        for (size_t i = 0; i < r; ++i)
+        {
+            for (size_t j = 0; j < c; ++j)
+            {
+                store_lanes(out.element(i, j) + begin, m[i][j], count);
+            }
+        }
+    }
+};
+
+/// The Vector counterpart of MatrixTile, partial tiles are padded with
+/// zeros.
+template<size_t l, typename T>
+struct VectorTile
+{
+    T v[l][matrix_tile];
+
+    void load(const BatchView<l, const T> &vectors,
+              const size_t                 begin,
+              const size_t                 count)
+    {
+        for (size_t i = 0; i < l; ++i)
+        {
+            load_lanes(v[i], vectors.component(i) + begin, count, T {0});
+        }
+    }
+
+    void store(const BatchView<l, T> &out,
+               const size_t           begin,
+               const size_t           count) const
+    {
+        for (size_t i = 0; i < l; ++i)
+        {
+            store_lanes(out.component(i) + begin, v[i], count);
+        }
+    }
+};
+
+/// A tile of linear systems A x = b.
+template<size_t n, typename T>
+struct SystemTile
+{
+    MatrixTile<n, n, T> a;
+    VectorTile<n, T>    b;
+
+    void load(const MatrixBatchView<n, n, const T> &matrices,
+              const BatchView<n, const T> &         vectors,
+              const size_t                          begin,
+              const size_t                          count)
+    {
+        a.load(matrices, begin, count);
+        b.load(vectors, begin, count);
+    }
+
+    void store(const BatchView<n, T> &out,
+               const size_t           begin,
+               const size_t           count) const
+    {
+        b.store(out, begin, count);
+    }
+};
+
+/**
+ * Gaussian elimination with partial pivoting on a tile of systems, the
+ * solutions replace tile.b. Pivoting is branch free: rows are exchanged
+ * with per-lane selects, so different instances may pivot differently and
+ * the loops over t still vectorize.
+ */
+template<size_t n, typename T>
+void lu_solve_tile(SystemTile<n, T> &tile)
+{
+    auto &a = tile.a.m;
+    auto &b = tile.b.v;
+    unrolled_for<n>([&](const auto step) {
+        const size_t k = step;
+
+        // Bring the largest candidate into row k, one row at a time.
+        for (size_t p = k + 1; p < n; ++p)
+        {
+            bool take[matrix_tile];
+            for (size_t t = 0; t < matrix_tile; ++t)
+            {
+                take[t] = std::abs(a[p][k][t]) > std::abs(a[k][k][t]);
+            }
+            for (size_t j = k; j < n; ++j)
+            {
+                for (size_t t = 0; t < matrix_tile; ++t)
+                {
+                    const T upper = a[k][j][t];
+                    const T lower = a[p][j][t];
+                    a[k][j][t]    = take[t] ? lower : upper;
+                    a[p][j][t]    = take[t] ? upper : lower;
+                }
+            }
+            for (size_t t = 0; t < matrix_tile; ++t)
+            {
+                const T upper = b[k][t];
+                const T lower = b[p][t];
+                b[k][t]       = take[t] ? lower : upper;
+                b[p][t]       = take[t] ? upper : lower;
+            }
+        }
+
+        for (size_t i = k + 1; i < n; ++i)
+        {
+            T factor[matrix_tile];
+            for (size_t t = 0; t < matrix_tile; ++t)
+            {
+                factor[t] = a[i][k][t] / a[k][k][t];
+            }
+            for (size_t j = k + 1; j < n; ++j)
+            {
+                for (size_t t = 0; t < matrix_tile; ++t)
+                {
+                    a[i][j][t] -= factor[t] * a[k][j][t];
+                }
+            }
+            for (size_t t = 0; t < matrix_tile; ++t)
+            {
+                b[i][t] -= factor[t] * b[k][t];
+            }
+        }
+    });
+
+    for (size_t i = n; i-- > 0;)
+    {
+        for (size_t j = i + 1; j < n; ++j)
+        {
+            for (size_t t = 0; t < matrix_tile; ++t)
+            {
+                b[i][t] -= a[i][j][t] * b[j][t];
+            }
+        }
+        for (size_t t = 0; t < matrix_tile; ++t)
+        {
+            b[i][t] /= a[i][i][t];
+        }
+    }
+}
+
+/**
+ * Cholesky factorization and solve on a tile of symmetric positive definite
+ * systems, the solutions replace tile.b.
+ */
+template<size_t n, typename T>
+void cholesky_solve_tile(SystemTile<n, T> &tile)
+{
+    auto &a = tile.a.m;
+    auto &b = tile.b.v;
+    unrolled_for<n>([&](const auto step) {
+        const size_t j = step;
+        for (size_t k = 0; k < j; ++k)
+        {
+            for (size_t t = 0; t < matrix_tile; ++t)
+            {
+                a[j][j][t] -= a[j][k][t] * a[j][k][t];
+            }
+        }
+        for (size_t t = 0; t < matrix_tile; ++t)
+        {
+            a[j][j][t] = std::sqrt(a[j][j][t]);
+        }
+        for (size_t i = j + 1; i < n; ++i)
+        {
+            for (size_t k = 0; k < j; ++k)
+            {
+                for (size_t t = 0; t < matrix_tile; ++t)
+                {
+                    a[i][j][t] -= a[i][k][t] * a[j][k][t];
+                }
+            }
+            for (size_t t = 0; t < matrix_tile; ++t)
+            {
+                a[i][j][t] /= a[j][j][t];
+            }
+        }
+    });
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (size_t j = 0; j < i; ++j)
+        {
+            for (size_t t = 0; t < matrix_tile; ++t)
+            {
+                b[i][t] -= a[i][j][t] * b[j][t];
+            }
+        }
+        for (size_t t = 0; t < matrix_tile; ++t)
+        {
+            b[i][t] /= a[i][i][t];
+        }
+    }
+    for (size_t i = n; i-- > 0;)
+    {
+        for (size_t j = i + 1; j < n; ++j)
+        {
+            for (size_t t = 0; t < matrix_tile; ++t)
+            {
+                b[i][t] -= a[j][i][t] * b[j][t];
+            }
+        }
+        for (size_t t = 0; t < matrix_tile; ++t)
+        {
+            b[i][t] /= a[i][i][t];
+        }
+    }
+}
+
+/**
+ * Determinants of a tile of matrices, in closed form up to 3x3 and via
+ * elimination with branch free pivoting beyond. The elimination overwrites
+ * the tile.
+ */
+template<size_t n, typename T>
+void determinant_tile(MatrixTile<n, n, T> &tile, T (&det)[matrix_tile])
+{
+    auto &a = tile.m;
+    if constexpr (n == 1)
+    {
+        for (size_t t = 0; t < matrix_tile; ++t)
+        {
+            det[t] = a[0][0][t];
+        }
+    }
+    else if constexpr (n == 2)
+    {
+        for (size_t t = 0; t < matrix_tile; ++t)
+        {
+            det[t] = a[0][0][t] * a[1][1][t] - a[0][1][t] * a[1][0][t];
+        }
+    }
+    else if constexpr (n == 3)
+    {
+        for (size_t t = 0; t < matrix_tile; ++t)
+        {
+            det[t] = a[0][0][t]
+                         * (a[1][1][t] * a[2][2][t] - a[1][2][t] * a[2][1][t])
+                     - a[0][1][t]
+                           * (a[1][0][t] * a[2][2][t]
+                              - a[1][2][t] * a[2][0][t])
+                     + a[0][2][t]
+                           * (a[1][0][t] * a[2][1][t]
+                              - a[1][1][t] * a[2][0][t]);
+        }
+    }
+    else
+    {
+        for (size_t t = 0; t < matrix_tile; ++t)
+        {
+            det[t] = T {1};
+        }
+        unrolled_for<n>([&](const auto step) {
+            const size_t k = step;
+
+            for (size_t p = k + 1; p < n; ++p)
+            {
+                bool take[matrix_tile];
+                for (size_t t = 0; t < matrix_tile; ++t)
+                {
+                    take[t] = std::abs(a[p][k][t]) > std::abs(a[k][k][t]);
+                    det[t]  = take[t] ? -det[t] : det[t];
+                }
+                for (size_t j = k; j < n; ++j)
+                {
+                    for (size_t t = 0; t < matrix_tile; ++t)
+                    {
+                        const T upper = a[k][j][t];
+                        const T lower = a[p][j][t];
+                        a[k][j][t]    = take[t] ? lower : upper;
+                        a[p][j][t]    = take[t] ? upper : lower;
+                    }
+                }
+            }
+
+            for (size_t t = 0; t < matrix_tile; ++t)
+            {
+                det[t] *= a[k][k][t];
+            }
+            for (size_t i = k + 1; i < n; ++i)
+            {
+                T factor[matrix_tile];
+                for (size_t t = 0; t < matrix_tile; ++t)
+                {
+                    factor[t] = a[i][k][t] / a[k][k][t];
+                }
+                for (size_t j = k + 1; j < n; ++j)
+                {
+                    for (size_t t = 0; t < matrix_tile; ++t)
+                    {
+                        a[i][j][t] -= factor[t] * a[k][j][t];
+                    }
+                }
+            }
+        });
+    }
+}
+
+/**
+ * Inverts a tile of matrices into inv. Up to 3x3 via the adjugate, beyond
+ * via Gauss-Jordan elimination with the same branch free pivoting as
+ * lu_solve_tile, which overwrites the tile. Singular instances produce
+ * non-finite elements.
+ */
+template<size_t n, typename T>
+void inverse_tile(MatrixTile<n, n, T> &tile, MatrixTile<n, n, T> &inv)
+{
+    auto &a   = tile.m;
+    auto &out = inv.m;
+    // The closed forms read every element once into registers and reuse
+    // the cofactors of the first column for the determinant.
+    if constexpr (n == 1)
+    {
+        for (size_t t = 0; t < matrix_tile; ++t)
+        {
+            out[0][0][t] = T {1} / a[0][0][t];
+        }
+    }
+    else if constexpr (n == 2)
+    {
+        for (size_t t = 0; t < matrix_tile; ++t)
+        {
+            const T a00  = a[0][0][t];
+            const T a01  = a[0][1][t];
+            const T a10  = a[1][0][t];
+            const T a11  = a[1][1][t];
+            const T inv  = T {1} / (a00 * a11 - a01 * a10);
+            out[0][0][t] = a11 * inv;
+            out[0][1][t] = -a01 * inv;
+            out[1][0][t] = -a10 * inv;
+            out[1][1][t] = a00 * inv;
+        }
+    }
+    else if constexpr (n == 3)
+    {
+        for (size_t t = 0; t < matrix_tile; ++t)
+        {
+            const T a00  = a[0][0][t];
+            const T a01  = a[0][1][t];
+            const T a02  = a[0][2][t];
+            const T a10  = a[1][0][t];
+            const T a11  = a[1][1][t];
+            const T a12  = a[1][2][t];
+            const T a20  = a[2][0][t];
+            const T a21  = a[2][1][t];
+            const T a22  = a[2][2][t];
+            const T c00  = a11 * a22 - a12 * a21;
+            const T c01  = a12 * a20 - a10 * a22;
+            const T c02  = a10 * a21 - a11 * a20;
+            const T inv  = T {1} / (a00 * c00 + a01 * c01 + a02 * c02);
+            out[0][0][t] = c00 * inv;
+            out[0][1][t] = (a02 * a21 - a01 * a22) * inv;
+            out[0][2][t] = (a01 * a12 - a02 * a11) * inv;
+            out[1][0][t] = c01 * inv;
+            out[1][1][t] = (a00 * a22 - a02 * a20) * inv;
+            out[1][2][t] = (a02 * a10 - a00 * a12) * inv;
+            out[2][0][t] = c02 * inv;
+            out[2][1][t] = (a01 * a20 - a00 * a21) * inv;
+            out[2][2][t] = (a00 * a11 - a01 * a10) * inv;
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            for (size_t j = 0; j < n; ++j)
+            {
+                for (size_t t = 0; t < matrix_tile; ++t)
+                {
+                    out[i][j][t] = i == j ? T {1} : T {0};
+                }
+            }
+        }
+        unrolled_for<n>([&](const auto step) {
+            const size_t k = step;
+
+            for (size_t p = k + 1; p < n; ++p)
+            {
+                bool take[matrix_tile];
+                for (size_t t = 0; t < matrix_tile; ++t)
+                {
+                    take[t] = std::abs(a[p][k][t]) > std::abs(a[k][k][t]);
+                }
+                for (size_t j = 0; j < n; ++j)
+                {
+                    for (size_t t = 0; t < matrix_tile; ++t)
+                    {
+                        const T upper = a[k][j][t];
+                        const T lower = a[p][j][t];
+                        a[k][j][t]    = take[t] ? lower : upper;
+                        a[p][j][t]    = take[t] ? upper : lower;
+                        const T first = out[k][j][t];
+                        const T other = out[p][j][t];
+                        out[k][j][t]  = take[t] ? other : first;
+                        out[p][j][t]  = take[t] ? first : other;
+                    }
+                }
+            }
+
+            T pivot[matrix_tile];
+            for (size_t t = 0; t < matrix_tile; ++t)
+            {
+                pivot[t] = T {1} / a[k][k][t];
+            }
+            for (size_t j = 0; j < n; ++j)
+            {
+                for (size_t t = 0; t < matrix_tile; ++t)
+                {
+                    a[k][j][t]   *= pivot[t];
+                    out[k][j][t] *= pivot[t];
+                }
+            }
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (i == k)
+                {
+                    continue;
+                }
+                T factor[matrix_tile];
+                for (size_t t = 0; t < matrix_tile; ++t)
+                {
+                    factor[t] = a[i][k][t];
+                }
+                for (size_t j = 0; j < n; ++j)
+                {
+                    for (size_t t = 0; t < matrix_tile; ++t)
+                    {
+                        a[i][j][t]   -= factor[t] * a[k][j][t];
+                        out[i][j][t] -= factor[t] * out[k][j][t];
+                    }
+                }
+            }
+        });
+    }
+}
+
+/// out = a * b for a tile of matrix pairs. The element loops are inside
+/// the loop over instances and unroll completely, so every element of a
+/// and b is loaded once per instance.
+template<size_t r, size_t k, size_t c, typename T>
+void multiply_tile(const MatrixTile<r, k, T> &lhs,
+                   const MatrixTile<k, c, T> &rhs,
+                   MatrixTile<r, c, T> &      product)
+{
+    const auto &a   = lhs.m;
+    const auto &b   = rhs.m;
+    auto &      out = product.m;
+    for (size_t t = 0; t < matrix_tile; ++t)
+    {
+        for (size_t i = 0; i < r; ++i)
+        {
+            for (size_t j = 0; j < c; ++j)
+            {
+                T sum = a[i][0][t] * b[0][j][t];
+                for (size_t p = 1; p < k; ++p)
+                {
+                    sum += a[i][p][t] * b[p][j][t];
+                }
+                out[i][j][t] = sum;
+            }
+        }
+    }
+}
+
+/// out = a * v for a tile of matrices and Vectors, see multiply_tile.
+template<size_t r, size_t c, typename T>
+void transform_tile(const MatrixTile<r, c, T> &lhs,
+                    const VectorTile<c, T> &   rhs,
+                    VectorTile<r, T> &         product)
+{
+    const auto &a   = lhs.m;
+    const auto &v   = rhs.v;
+    auto &      out = product.v;
+    for (size_t t = 0; t < matrix_tile; ++t)
+    {
+        for (size_t i = 0; i < r; ++i)
+        {
+            T sum = a[i][0][t] * v[0][t];
+            for (size_t j = 1; j < c; ++j)
+            {
+                sum += a[i][j][t] * v[j][t];
+            }
+            out[i][t] = sum;
+        }
+    }
+}
+
+/**
+ * Split [0, size) into tiles and call fn(begin, count) for each, with the
+ * tiles distributed over threads according to policy.
+ */
+template<class Policy, class Fn>
+void for_each_tile(const Policy &policy, const size_t size, const Fn &fn)
+{
+    parallel_for(policy, size, [&](size_t begin, const size_t end) {
+        for (; begin < end; begin += matrix_tile)
+        {
+            fn(begin, std::min(matrix_tile, end - begin));
+        }
+    });
+}
+
+template<typename T>
+constexpr void require_floating_point_batch()
+{
+    static_assert(std::is_floating_point_v<T>,
+                  "Batched solves, inverses and determinants require "
+                  "floating-point matrices");
+}
+
+template<class Policy, size_t n, typename T, class Kernel>
+void solve_many(const Policy &                        policy,
+                const MatrixBatchView<n, n, const T> &a,
+                const BatchView<n, const T> &         b,
+                const BatchView<n, T> &               x,
+                const Kernel &                        kernel,
+                const char *                          what)
+{
+    require_floating_point_batch<T>();
+    if (b.size() != a.size() || x.size() < a.size())
+    {
+        throw std::invalid_argument(what);
+    }
+    for_each_tile(
+        policy, a.size(), [&](const size_t begin, const size_t count) {
+            SystemTile<n, T> tile;
+            tile.load(a, b, begin, count);
+            kernel(tile);
+            tile.store(x, begin, count);
+        });
+}
+
+template<class Policy, size_t n, typename T>
+void inverse_many(const Policy &                        policy,
+                  const MatrixBatchView<n, n, const T> &a,
+                  const MatrixBatchView<n, n, T> &      out)
+{
+    require_floating_point_batch<T>();
+    if (out.size() < a.size())
+    {
+        throw std::invalid_argument("colibra::inverse_many: size mismatch");
+    }
+    for_each_tile(
+        policy, a.size(), [&](const size_t begin, const size_t count) {
+            MatrixTile<n, n, T> tile;
+            MatrixTile<n, n, T> inv;
+            tile.load(a, begin, count);
+            inverse_tile(tile, inv);
+            inv.store(out, begin, count);
+        });
+}
+
+template<class Policy, size_t n, typename T>
+void determinant_many(const Policy &                        policy,
+                      const MatrixBatchView<n, n, const T> &a,
+                      const Span<T>                         out)
+{
+    require_floating_point_batch<T>();
+    if (out.size() < a.size())
+    {
+        throw std::invalid_argument(
+            "colibra::determinant_many: size mismatch");
+    }
+    for_each_tile(
+        policy, a.size(), [&](const size_t begin, const size_t count) {
+            MatrixTile<n, n, T> tile;
+            T                   det[matrix_tile];
+            tile.load(a, begin, count);
+            determinant_tile(tile, det);
+            store_lanes(out.data() + begin, det, count);
+        });
+}
+
+template<class Policy, size_t r, size_t k, size_t c, typename T>
+void multiply_many(const Policy &                        policy,
+                   const MatrixBatchView<r, k, const T> &a,
+                   const MatrixBatchView<k, c, const T> &b,
+                   const MatrixBatchView<r, c, T> &      out)
+{
+    if (b.size() != a.size() || out.size() < a.size())
+    {
+        throw std::invalid_argument("colibra::multiply_many: size mismatch");
+    }
+    for_each_tile(
+        policy, a.size(), [&](const size_t begin, const size_t count) {
+            MatrixTile<r, k, T> lhs;
+            MatrixTile<k, c, T> rhs;
+            MatrixTile<r, c, T> product;
+            lhs.load(a, begin, count);
+            rhs.load(b, begin, count);
+            multiply_tile(lhs, rhs, product);
+            product.store(out, begin, count);
+        });
+}
+
+template<class Policy, size_t r, size_t c, typename T>
+void transform_many(const Policy &                        policy,
+                    const MatrixBatchView<r, c, const T> &a,
+                    const BatchView<c, const T> &         v,
+                    const BatchView<r, T> &               out)
+{
+    if (v.size() != a.size() || out.size() < a.size())
+    {
+        throw std::invalid_argument("colibra::transform_many: size mismatch");
+    }
+    for_each_tile(
+        policy, a.size(), [&](const size_t begin, const size_t count) {
+            MatrixTile<r, c, T> lhs;
+            VectorTile<c, T>    rhs;
+            VectorTile<r, T>    product;
+            lhs.load(a, begin, count);
+            rhs.load(v, begin, count);
+            transform_tile(lhs, rhs, product);
+            product.store(out, begin, count);
+        });
+}
+
+} // namespace details
+} // namespace colibra
+
+#endif
@@ -0,0 +1,131 @@
+#ifndef COLIBRA_DETAILS_NEAREST_HPP
+#define COLIBRA_DETAILS_NEAREST_HPP
+
+#include "batch_ops.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace colibra {
+
+/**
+ * @brief: Result of a nearest neighbor query.
+ *
+ * @tparam D The distance type, see details::norm_type_t.
+ */
+template<typename D>
+struct Neighbor
+{
+    /// Index of the point in the set the index was built from.
+    size_t index;
+    /// Squared euclidean distance between query and point.
+    D distance_squared;
+
+    [[nodiscard]] constexpr bool operator<(const Neighbor &other) const
+    {
+        return distance_squared < other.distance_squared
+               || (distance_squared == other.distance_squared
+                   && index < other.index);
+    }
+};
+
+namespace details {
+
+/**
+ * Collects the k best neighbors in a max-heap, so the current pruning bound
+ * is always at the front.
+ */
+template<typename D>
+class KnnHeap
+{
+  public:
+    KnnHeap(const size_t k, std::vector<Neighbor<D>> &storage)
+        : m_k(k)
+        , m_heap(storage)
+    {
+        m_heap.clear();
+        m_heap.reserve(k);
+    }
+
+    [[nodiscard]] D bound() const
+    {
+        return m_heap.size() < m_k ? std::numeric_limits<D>::infinity()
+                                   : m_heap.front().distance_squared;
+    }
+
+    void push(const size_t index, const D distance_squared)
+    {
+        if (m_k == 0)
+        {
+            return;
+        }
+        const Neighbor<D> candidate {index, distance_squared};
+        if (m_heap.size() < m_k)
+        {
+            m_heap.push_back(candidate);
+            std::push_heap(m_heap.begin(), m_heap.end());
+        }
+        else if (candidate < m_heap.front())
+        {
+            std::pop_heap(m_heap.begin(), m_heap.end());
+            m_heap.back() = candidate;
+            std::push_heap(m_heap.begin(), m_heap.end());
+        }
+    }
+
+    /// Sorts the collected neighbors by ascending distance.
+    void finish()
+    {
+        std::sort_heap(m_heap.begin(), m_heap.end());
+    }
+
+  private:
+    size_t                    m_k;
+    std::vector<Neighbor<D>> &m_heap;
+};
+
+/**
+ * Accessor that shifts another accessor by a fixed offset, so kernels can run
+ * on a sub range while writing to the start of a scratch buffer.
+ */
+template<class Points>
+struct OffsetPoints
+{
+    const Points &points;
+    size_t        offset;
+
+    constexpr decltype(auto) operator()(const size_t d, const size_t i) const
+    {
+        return points(d, i + offset);
+    }
+};
+
+/**
+ * Squared distances between query and points [begin, end), written to
+ * out[0, end - begin).
+ */
+template<size_t l, typename T, class Points>
+void squared_distances(const colibra::Vector<l, T> &query,
+                       const Points &               points,
+                       const size_t                 begin,
+                       const size_t                 end,
+                       norm_type_t<T> *             out)
+{
+    using R = norm_type_t<T>;
+    reduce_points<l, R>(
+        OffsetPoints<Points> {points, begin},
+        out,
+        0,
+        end - begin,
+        [&query](size_t d, const auto &p) {
+            const R diff = static_cast<R>(p) - static_cast<R>(query[d]);
+            return diff * diff;
+        },
+        [](const R &acc) { return acc; });
+}
+
+} // namespace details
+} // namespace colibra
+
+#endif
@@ -0,0 +1,119 @@
+#ifndef COLIBRA_DETAILS_PARALLEL_HPP
+#define COLIBRA_DETAILS_PARALLEL_HPP
+
+#include "../execution.h"
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace colibra {
+namespace details {
+
+/**
+ * Call fn(begin, end) for consecutive chunks of [0, n), distributing the
+ * chunks over threads according to the policy. The calling thread processes
+ * the last chunk itself.
+ */
+template<class Fn>
+void parallel_for(const execution::sequenced_policy &, size_t n, Fn &&fn)
+{
+    if (n > 0)
+    {
+        fn(size_t {0}, n);
+    }
+}
+
+template<class Fn>
+void parallel_for(const execution::parallel_policy &policy, size_t n, Fn &&fn)
+{
+    size_t threads = policy.threads;
+    if (threads == 0)
+    {
+        threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    const size_t grain = std::max<size_t>(1, policy.grain);
+    threads            = std::min(threads, (n + grain - 1) / grain);
+
+    if (threads <= 1)
+    {
+        parallel_for(execution::seq, n, fn);
+        return;
+    }
+
+    // Rounding the chunk up can leave fewer chunks than threads, e.g. 17
+    // elements on 16 threads make 9 chunks of 2. Every chunk must be
+    // non-empty, so the thread count follows from the chunk size.
+    const size_t chunk = (n + threads - 1) / threads;
+    threads            = (n + chunk - 1) / chunk;
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (size_t t = 0; t + 1 < threads; ++t)
+    {
+        const size_t begin = t * chunk;
+        const size_t end   = std::min(n, begin + chunk);
+        workers.emplace_back([&fn, begin, end] { fn(begin, end); });
+    }
+    fn((threads - 1) * chunk, n);
+
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+/**
+ * Reduce [0, n) in parallel chunks. Each chunk accumulates into a local copy
+ * of Acc through chunk(begin, end, acc), which merge(total, acc) then adds to
+ * the result under a lock.
+ */
+template<class Acc, class Policy, class Chunk, class Merge>
+Acc parallel_reduce(const Policy &policy,
+                    const size_t  n,
+                    const Chunk & chunk,
+                    const Merge & merge)
+{
+    Acc total {};
+    if constexpr (std::is_same_v<Policy, execution::sequenced_policy>)
+    {
+        // A single chunk can accumulate into the result directly.
+        parallel_for(policy, n, [&](const size_t begin, const size_t end) {
+            chunk(begin, end, total);
+        });
+    }
+    else
+    {
+        std::mutex lock;
+        parallel_for(policy, n, [&](const size_t begin, const size_t end) {
+            Acc local {};
+            chunk(begin, end, local);
+            const std::lock_guard<std::mutex> guard(lock);
+            merge(total, local);
+        });
+    }
+    return total;
+}
+
+/// Convert a policy whose grain counts elementary operations into one whose
+/// grain counts rows, each row costing work operations.
+inline execution::sequenced_policy
+rows_policy(const execution::sequenced_policy &policy, size_t)
+{
+    return policy;
+}
+
+inline execution::parallel_policy
+rows_policy(const execution::parallel_policy &policy, const size_t work)
+{
+    const size_t grain = (policy.grain + work - 1) / std::max<size_t>(work, 1);
+    return execution::parallel_policy {policy.threads,
+                                       std::max<size_t>(grain, 1)};
+}
+
+} // namespace details
+} // namespace colibra
+
+#endif
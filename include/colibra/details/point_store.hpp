@@ -0,0 +1,139 @@
+#ifndef COLIBRA_DETAILS_POINT_STORE_HPP
+#define COLIBRA_DETAILS_POINT_STORE_HPP
+
+#include "../batch.h"
+#include "../span.h"
+#include "../vector.h"
+#include "kernels.hpp"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <type_traits>
+
+#include <sys/mman.h>
+
+namespace colibra {
+namespace details {
+
+/// Type centroids are summed in: double, or long double for long double
+/// input.
+template<typename T>
+using centroid_sum_t =
+    std::conditional_t<std::is_same_v<T, long double>, long double, double>;
+
+/// Default number of points per chunk of the streaming algorithms.
+inline constexpr size_t stream_chunk_size = size_t {1} << 20;
+
+/**
+ * Walk [0, count) in chunks. Before a chunk is processed the next one is
+ * prefetched with MADV_WILLNEED, after it is processed its pages are
+ * dropped from the resident set with MADV_DONTNEED, so the resident memory
+ * stays bounded by about two chunks no matter the file size.
+ *
+ * advise(begin, end, advice) applies a hint to the points [begin, end),
+ * process(begin, end) does the work.
+ */
+template<class Advise, class Process>
+void stream_chunks(const size_t count,
+                   const size_t chunk_size,
+                   Advise &&    advise,
+                   Process &&   process)
+{
+    if (chunk_size == 0)
+    {
+        throw std::invalid_argument("colibra: chunk size must not be 0");
+    }
+    advise(0, std::min(count, chunk_size), MADV_WILLNEED);
+    for (size_t begin = 0; begin < count; begin += chunk_size)
+    {
+        const size_t end = std::min(count, begin + chunk_size);
+        if (end < count)
+        {
+            advise(end, std::min(count, end + chunk_size), MADV_WILLNEED);
+        }
+        process(begin, end);
+        advise(begin, end, MADV_DONTNEED);
+    }
+}
+
+template<typename T>
+Span<T> slice(const Span<T> &span, const size_t offset, const size_t count)
+{
+    return span.subspan(offset, count);
+}
+
+template<size_t l, typename T>
+BatchView<l, T>
+slice(const BatchView<l, T> &batch, const size_t offset, const size_t count)
+{
+    return batch.subview(offset, count);
+}
+
+template<size_t l, typename T>
+void store_point(Span<colibra::Vector<l, T>>  vectors,
+                 const size_t                 i,
+                 const colibra::Vector<l, T> &vec)
+{
+    vectors[i] = vec;
+}
+
+template<size_t l, typename T>
+void store_point(const BatchView<l, T> &      batch,
+                 const size_t                 i,
+                 const colibra::Vector<l, T> &vec)
+{
+    for (size_t d = 0; d < l; ++d)
+    {
+        batch.component(d)[i] = vec[d];
+    }
+}
+
+/**
+ * Widen the running bounds lo and hi by the points [begin, end). The loop
+ * over i is innermost so it vectorizes for structure-of-arrays input.
+ */
+template<size_t l, typename T, class Points>
+void bounds_kernel(const Points &         points,
+                   const size_t           begin,
+                   const size_t           end,
+                   colibra::Vector<l, T> &lo,
+                   colibra::Vector<l, T> &hi)
+{
+    for (size_t d = 0; d < l; ++d)
+    {
+        T low  = lo[d];
+        T high = hi[d];
+        for (size_t i = begin; i < end; ++i)
+        {
+            const T value = points(d, i);
+            low           = value < low ? value : low;
+            high          = high < value ? value : high;
+        }
+        lo[d] = low;
+        hi[d] = high;
+    }
+}
+
+/// Add the components of the points [begin, end) to sums.
+template<size_t l, typename A, class Points>
+void sum_kernel(const Points &    points,
+                const size_t      begin,
+                const size_t      end,
+                std::array<A, l> &sums)
+{
+    for (size_t d = 0; d < l; ++d)
+    {
+        A acc {};
+        for (size_t i = begin; i < end; ++i)
+        {
+            acc += static_cast<A>(points(d, i));
+        }
+        sums[d] += acc;
+    }
+}
+
+} // namespace details
+} // namespace colibra
+
+#endif
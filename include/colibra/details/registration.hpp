@@ -0,0 +1,203 @@
+#ifndef COLIBRA_DETAILS_REGISTRATION_HPP
+#define COLIBRA_DETAILS_REGISTRATION_HPP
+
+#include "../decompositions.h"
+#include "../matrix.h"
+#include "../transform.h"
+#include "../vector.h"
+#include "parallel.hpp"
+
+#include <stdexcept>
+#include <type_traits>
+
+namespace colibra {
+namespace details {
+
+/// Point sums are accumulated in at least double precision, float sums over
+/// a million points would lose most of their digits.
+template<typename T>
+using moment_type_t = std::common_type_t<T, double>;
+
+/**
+ * Sums over corresponding point pairs (p, q) from which the best fitting
+ * transform follows: the centroids, the cross-covariance
+ * sum (p - p_mean) (q - q_mean)^T and the spread sum |p - p_mean|^2.
+ */
+template<typename A>
+struct PairMoments
+{
+    size_t       count = 0;
+    colibra::Vector<3, A> source_sum {};
+    colibra::Vector<3, A> target_sum {};
+    A            cross[3][3] {};
+    A            spread {};
+};
+
+/**
+ * Accumulate the moments of the pairs [0, n) in two passes, centroids first
+ * and the centered products second, which avoids the cancellation of the
+ * one-pass formula for clouds far from the origin.
+ *
+ * @param pair pair(k, p, q) stores pair k in p and q and returns false if it
+ * is to be skipped.
+ */
+template<typename T, class Policy, class Pair>
+PairMoments<moment_type_t<T>>
+pair_moments(const Policy &policy, const size_t n, const Pair &pair)
+{
+    using A = moment_type_t<T>;
+    using M = PairMoments<A>;
+
+    M moments = parallel_reduce<M>(
+        policy,
+        n,
+        [&pair](const size_t begin, const size_t end, M &local) {
+            colibra::Vector<3, T> p;
+            colibra::Vector<3, T> q;
+            for (size_t k = begin; k < end; ++k)
+            {
+                if (!pair(k, p, q))
+                {
+                    continue;
+                }
+                ++local.count;
+                for (size_t d = 0; d < 3; ++d)
+                {
+                    local.source_sum[d] += static_cast<A>(p[d]);
+                    local.target_sum[d] += static_cast<A>(q[d]);
+                }
+            }
+        },
+        [](M &total, const M &local) {
+            total.count += local.count;
+            for (size_t d = 0; d < 3; ++d)
+            {
+                total.source_sum[d] += local.source_sum[d];
+                total.target_sum[d] += local.target_sum[d];
+            }
+        });
+    if (moments.count == 0)
+    {
+        return moments;
+    }
+
+    const A    inverse_count = A {1} / static_cast<A>(moments.count);
+    const auto source_mean   = moments.source_sum * inverse_count;
+    const auto target_mean   = moments.target_sum * inverse_count;
+    const M    centered      = parallel_reduce<M>(
+        policy,
+        n,
+        [&](const size_t begin, const size_t end, M &local) {
+            colibra::Vector<3, T> p;
+            colibra::Vector<3, T> q;
+            for (size_t k = begin; k < end; ++k)
+            {
+                if (!pair(k, p, q))
+                {
+                    continue;
+                }
+                A dp[3];
+                A dq[3];
+                for (size_t d = 0; d < 3; ++d)
+                {
+                    dp[d] = static_cast<A>(p[d]) - source_mean[d];
+                    dq[d] = static_cast<A>(q[d]) - target_mean[d];
+                }
+                local.spread += dp[0] * dp[0] + dp[1] * dp[1] + dp[2] * dp[2];
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    for (size_t j = 0; j < 3; ++j)
+                    {
+                        local.cross[i][j] += dp[i] * dq[j];
+                    }
+                }
+            }
+        },
+        [](M &total, const M &local) {
+            total.spread += local.spread;
+            for (size_t i = 0; i < 3; ++i)
+            {
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    total.cross[i][j] += local.cross[i][j];
+                }
+            }
+        });
+
+    moments.spread = centered.spread;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        for (size_t j = 0; j < 3; ++j)
+        {
+            moments.cross[i][j] = centered.cross[i][j];
+        }
+    }
+    return moments;
+}
+
+/**
+ * The similarity transform q = scale * rotation * p + translation that best
+ * fits the pairs in the least squares sense (Umeyama 1991). The rotation
+ * comes from the SVD of the cross-covariance, with the sign of the smallest
+ * singular direction flipped where needed so reflections are never
+ * returned. With with_scale false the scale stays 1, which is Kabsch's
+ * algorithm.
+ */
+template<typename T, typename A>
+SimilarityTransform<T> fit_similarity(const PairMoments<A> &moments,
+                                      const bool            with_scale)
+{
+    if (moments.count == 0)
+    {
+        throw std::invalid_argument(
+            "colibra: registration needs at least one point pair");
+    }
+
+    Matrix<3, 3, A> cross;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        for (size_t j = 0; j < 3; ++j)
+        {
+            cross(i, j) = moments.cross[i][j];
+        }
+    }
+    const auto decomposition = svd(cross);
+    const auto unflipped     = decomposition.v * decomposition.u.transpose();
+    const A    sign          = determinant(unflipped) < A {0} ? A {-1} : A {1};
+
+    Matrix<3, 3, A> corrected = decomposition.v;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        corrected(i, 2) *= sign;
+    }
+    const Matrix<3, 3, A> rotation = corrected * decomposition.u.transpose();
+
+    A scale {1};
+    if (with_scale && moments.spread > A {0})
+    {
+        const auto &s = decomposition.singular_values;
+        scale         = (s[0] + s[1] + sign * s[2]) / moments.spread;
+    }
+
+    const A    inverse_count = A {1} / static_cast<A>(moments.count);
+    const auto source_mean   = moments.source_sum * inverse_count;
+    const auto target_mean   = moments.target_sum * inverse_count;
+    const auto translation   = target_mean - rotation * source_mean * scale;
+
+    SimilarityTransform<T> result;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        for (size_t j = 0; j < 3; ++j)
+        {
+            result.rotation(i, j) = static_cast<T>(rotation(i, j));
+        }
+        result.translation[i] = static_cast<T>(translation[i]);
+    }
+    result.scale = static_cast<T>(scale);
+    return result;
+}
+
+} // namespace details
+} // namespace colibra
+
+#endif
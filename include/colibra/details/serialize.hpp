@@ -0,0 +1,158 @@
+#ifndef COLIBRA_DETAILS_SERIALIZE_HPP
+#define COLIBRA_DETAILS_SERIALIZE_HPP
+
+#include "../fixed_point.h"
+#include "../half.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <complex>
+#include <cstdint>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace colibra {
+namespace details {
+
+enum class ElementKind : uint8_t
+{
+    signed_integer   = 1,
+    unsigned_integer = 2,
+    floating_point   = 3,
+    half             = 4,
+    bfloat16         = 5,
+    fixed_point      = 6,
+    complex          = 7,
+};
+
+/// Describes an element type in a file header.
+template<typename T, typename = void>
+struct element_code;
+
+template<typename T>
+struct element_code<T, std::enable_if_t<std::is_integral_v<T>>>
+{
+    static constexpr ElementKind kind = std::is_signed_v<T>
+                                            ? ElementKind::signed_integer
+                                            : ElementKind::unsigned_integer;
+    static constexpr uint16_t    fraction_bits = 0;
+};
+
+template<typename T>
+struct element_code<T, std::enable_if_t<std::is_floating_point_v<T>>>
+{
+    static constexpr ElementKind kind          = ElementKind::floating_point;
+    static constexpr uint16_t    fraction_bits = 0;
+};
+
+template<>
+struct element_code<colibra::half>
+{
+    static constexpr ElementKind kind          = ElementKind::half;
+    static constexpr uint16_t    fraction_bits = 0;
+};
+
+template<>
+struct element_code<colibra::bfloat16>
+{
+    static constexpr ElementKind kind          = ElementKind::bfloat16;
+    static constexpr uint16_t    fraction_bits = 0;
+};
+
+template<int Frac, typename Rep>
+struct element_code<colibra::Fixed<Frac, Rep>>
+{
+    static constexpr ElementKind kind          = ElementKind::fixed_point;
+    static constexpr uint16_t    fraction_bits = Frac;
+};
+
+template<typename T>
+struct element_code<std::complex<T>>
+{
+    static constexpr ElementKind kind          = ElementKind::complex;
+    static constexpr uint16_t    fraction_bits = 0;
+};
+
+inline constexpr uint8_t native_endianness =
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    2;
+#else
+    1;
+#endif
+
+/// Everything after the header starts at this alignment, and each SoA
+/// component is padded to it.
+inline constexpr size_t data_alignment = 64;
+
+constexpr size_t align_up(const size_t value, const size_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+/// Write all iovecs to fd, retrying on partial writes and EINTR.
+inline void write_all(const int fd, iovec *vecs, int count)
+{
+    while (count > 0)
+    {
+        const ssize_t written = ::writev(fd, vecs, std::min(count, IOV_MAX));
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw std::system_error(
+                errno, std::generic_category(), "colibra: writev");
+        }
+        auto remaining = static_cast<size_t>(written);
+        while (count > 0 && remaining >= vecs->iov_len)
+        {
+            remaining -= vecs->iov_len;
+            ++vecs;
+            --count;
+        }
+        if (count > 0)
+        {
+            vecs->iov_base = static_cast<char *>(vecs->iov_base) + remaining;
+            vecs->iov_len -= remaining;
+        }
+    }
+}
+
+/// Create or truncate path, pass the descriptor to write and close it.
+template<class Write>
+void with_output_file(const std::string &path, Write &&write)
+{
+    const int fd =
+        ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        throw std::system_error(
+            errno, std::generic_category(), "colibra: open " + path);
+    }
+    try
+    {
+        write(fd);
+    }
+    catch (...)
+    {
+        ::close(fd);
+        throw;
+    }
+    if (::close(fd) != 0)
+    {
+        throw std::system_error(
+            errno, std::generic_category(), "colibra: close " + path);
+    }
+}
+
+} // namespace details
+} // namespace colibra
+
+#endif
@@ -0,0 +1,272 @@
+#ifndef COLIBRA_DETAILS_SOLVERS_HPP
+#define COLIBRA_DETAILS_SOLVERS_HPP
+
+#include "../dmatrix.h"
+#include "../matrix.h"
+#include "../sparse.h"
+#include "../vector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace colibra {
+namespace details {
+
+/**
+ * Vector types the iterative solvers use for a matrix type: domain_type
+ * holds x, range_type holds A x. Fixed-size matrices work on Vectors, so
+ * their solves never allocate, dynamic ones on std::vector.
+ */
+template<class M>
+struct solver_traits;
+
+template<size_t r, size_t c, typename T>
+struct solver_traits<Matrix<r, c, T>>
+{
+    using value_type  = T;
+    using domain_type = colibra::Vector<c, T>;
+    using range_type  = colibra::Vector<r, T>;
+
+    static constexpr size_t rows(const Matrix<r, c, T> &)
+    {
+        return r;
+    }
+
+    static constexpr size_t cols(const Matrix<r, c, T> &)
+    {
+        return c;
+    }
+};
+
+template<typename T>
+struct dynamic_solver_traits
+{
+    using value_type  = T;
+    using domain_type = std::vector<T>;
+    using range_type  = std::vector<T>;
+
+    template<class M>
+    static size_t rows(const M &a)
+    {
+        return a.rows();
+    }
+
+    template<class M>
+    static size_t cols(const M &a)
+    {
+        return a.cols();
+    }
+};
+
+template<typename T>
+struct solver_traits<DMatrix<T>> : dynamic_solver_traits<T>
+{
+};
+
+template<typename T>
+struct solver_traits<CsrMatrix<T>> : dynamic_solver_traits<T>
+{
+};
+
+template<size_t l, typename T>
+constexpr void fit(colibra::Vector<l, T> &, const size_t)
+{
+}
+
+/// Resize a dynamic workspace vector, which only allocates while the
+/// capacity grows.
+template<typename T>
+void fit(std::vector<T> &vec, const size_t size)
+{
+    vec.resize(size);
+}
+
+template<size_t l, typename T>
+constexpr size_t length(const colibra::Vector<l, T> &)
+{
+    return l;
+}
+
+template<typename T>
+size_t length(const std::vector<T> &vec)
+{
+    return vec.size();
+}
+
+template<class V>
+auto dot(const V &a, const V &b)
+{
+    std::remove_const_t<std::remove_reference_t<decltype(a[0])>> sum {};
+    for (size_t i = 0; i < length(a); ++i)
+    {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+/// y += alpha * x
+template<class V, typename T>
+void axpy(const T alpha, const V &x, V &y)
+{
+    for (size_t i = 0; i < length(x); ++i)
+    {
+        y[i] += alpha * x[i];
+    }
+}
+
+/// y = x + beta * y
+template<class V, typename T>
+void xpby(const V &x, const T beta, V &y)
+{
+    for (size_t i = 0; i < length(x); ++i)
+    {
+        y[i] = x[i] + beta * y[i];
+    }
+}
+
+/// z = d .* r
+template<class V>
+void scale(const V &d, const V &r, V &z)
+{
+    for (size_t i = 0; i < length(r); ++i)
+    {
+        z[i] = d[i] * r[i];
+    }
+}
+
+/// y = a * x
+template<class Policy, size_t r, size_t c, typename T>
+void apply(const Policy &,
+           const Matrix<r, c, T> &      a,
+           const colibra::Vector<c, T> &x,
+           colibra::Vector<r, T> &      y)
+{
+    y = a * x;
+}
+
+template<class Policy, typename T>
+void apply(const Policy &         policy,
+           const DMatrix<T> &     a,
+           const std::vector<T> & x,
+           std::vector<T> &       y)
+{
+    gemv(policy, a, Span<const T>(x), Span<T>(y));
+}
+
+template<class Policy, typename T>
+void apply(const Policy &         policy,
+           const CsrMatrix<T> &   a,
+           const std::vector<T> & x,
+           std::vector<T> &       y)
+{
+    spmv(policy, a, Span<const T>(x), Span<T>(y));
+}
+
+/// y = transpose(a) * x
+template<class Policy, size_t r, size_t c, typename T>
+void apply_transpose(const Policy &,
+                     const Matrix<r, c, T> &      a,
+                     const colibra::Vector<r, T> &x,
+                     colibra::Vector<c, T> &      y)
+{
+    y = a.transpose() * x;
+}
+
+/// Row-major storage makes transpose(a) * x a sum of scaled rows, which
+/// runs on the calling thread.
+template<class Policy, typename T>
+void apply_transpose(const Policy &,
+                     const DMatrix<T> &     a,
+                     const std::vector<T> & x,
+                     std::vector<T> &       y)
+{
+    std::fill(y.begin(), y.end(), T {});
+    for (size_t i = 0; i < a.rows(); ++i)
+    {
+        const T *row = a.data() + i * a.cols();
+        for (size_t j = 0; j < a.cols(); ++j)
+        {
+            y[j] += row[j] * x[i];
+        }
+    }
+}
+
+template<class Policy, typename T>
+void apply_transpose(const Policy &         policy,
+                     const CsrMatrix<T> &   a,
+                     const std::vector<T> & x,
+                     std::vector<T> &       y)
+{
+    spmv_transpose(policy, a, Span<const T>(x), Span<T>(y));
+}
+
+/// Jacobi preconditioner of a square matrix: the inverse diagonal, with
+/// ones where the diagonal is not positive.
+template<class M, class V>
+void inverse_diagonal(const M &a, V &out)
+{
+    using T = typename solver_traits<M>::value_type;
+    for (size_t i = 0; i < length(out); ++i)
+    {
+        T diagonal {};
+        if constexpr (std::is_same_v<M, CsrMatrix<T>>)
+        {
+            diagonal = a.at(i, i);
+        }
+        else
+        {
+            diagonal = a(i, i);
+        }
+        out[i] = diagonal > T {0} ? T {1} / diagonal : T {1};
+    }
+}
+
+/// Jacobi preconditioner of the normal equations: the inverse squared
+/// column norms of a, with ones for zero columns.
+template<class M, class V>
+void inverse_column_norms(const M &a, V &out)
+{
+    using T = typename solver_traits<M>::value_type;
+    for (size_t j = 0; j < length(out); ++j)
+    {
+        out[j] = T {};
+    }
+    if constexpr (std::is_same_v<M, CsrMatrix<T>>)
+    {
+        const auto columns = a.columns();
+        const auto values  = a.values();
+        for (size_t k = 0; k < a.nonzeros(); ++k)
+        {
+            out[columns[k]] += values[k] * values[k];
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < solver_traits<M>::rows(a); ++i)
+        {
+            for (size_t j = 0; j < length(out); ++j)
+            {
+                out[j] += a(i, j) * a(i, j);
+            }
+        }
+    }
+    for (size_t j = 0; j < length(out); ++j)
+    {
+        out[j] = out[j] > T {0} ? T {1} / out[j] : T {1};
+    }
+}
+
+template<typename T>
+T default_tolerance(const double tolerance)
+{
+    return tolerance > 0 ? static_cast<T>(tolerance)
+                         : std::sqrt(std::numeric_limits<T>::epsilon());
+}
+
+} // namespace details
+} // namespace colibra
+
+#endif
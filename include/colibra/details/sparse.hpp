@@ -0,0 +1,64 @@
+#ifndef COLIBRA_DETAILS_SPARSE_HPP
+#define COLIBRA_DETAILS_SPARSE_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+namespace colibra {
+namespace details {
+
+/// Column indices are stored in 32 bits, which halves the index traffic of
+/// SpMV compared to size_t.
+using sparse_index = std::uint32_t;
+
+/**
+ * y[i] = sum_k values[k] * x[columns[k]] for the rows [begin, end), with k
+ * running over the nonzeros of row i.
+ */
+template<typename R, typename T, typename S>
+void spmv_rows(const size_t *      offsets,
+               const sparse_index *columns,
+               const T *           values,
+               const S *           x,
+               R *                 y,
+               const size_t        begin,
+               const size_t        end)
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        R sum {};
+        for (size_t k = offsets[i]; k < offsets[i + 1]; ++k)
+        {
+            sum += static_cast<R>(values[k]) * static_cast<R>(x[columns[k]]);
+        }
+        y[i] = sum;
+    }
+}
+
+/**
+ * y[columns[k]] += values[k] * x[i] for the rows [begin, end), scattering
+ * each row into y.
+ */
+template<typename R, typename T, typename S>
+void spmv_transpose_rows(const size_t *      offsets,
+                         const sparse_index *columns,
+                         const T *           values,
+                         const S *           x,
+                         R *                 y,
+                         const size_t        begin,
+                         const size_t        end)
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        const R scale = static_cast<R>(x[i]);
+        for (size_t k = offsets[i]; k < offsets[i + 1]; ++k)
+        {
+            y[columns[k]] += static_cast<R>(values[k]) * scale;
+        }
+    }
+}
+
+} // namespace details
+} // namespace colibra
+
+#endif
@@ -0,0 +1,132 @@
+#ifndef COLIBRA_DETAILS_TRANSFORM_BUFFER_HPP
+#define COLIBRA_DETAILS_TRANSFORM_BUFFER_HPP
+
+#include "../quaternion.h"
+#include "../transform.h"
+#include "../vector.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace colibra {
+namespace details {
+
+/// A transform as it is stored and interpolated: the rotation as a unit
+/// quaternion, which slerp needs, instead of a Matrix.
+template<typename T, typename Time>
+struct TimedPose
+{
+    Time                  time {};
+    Quaternion<T>         rotation;
+    colibra::Vector<3, T> translation {};
+};
+
+/**
+ * One entry of a transform ring. The producer guards every write with a
+ * sequence number: odd while the slot is written, 2 * entry + 2 once it holds
+ * entry. Readers copy the fields and check the number before and after, so
+ * they never write shared memory. The fields are atomics accessed with
+ * relaxed ordering, which makes the concurrent copy well defined and compiles
+ * to plain loads and stores.
+ */
+template<typename T, typename Time>
+struct TransformSlot
+{
+    std::atomic<uint64_t>         sequence {0};
+    std::atomic<Time>             time {};
+    std::array<std::atomic<T>, 7> values {};
+};
+
+template<typename T, typename Time>
+void write_slot(TransformSlot<T, Time>   &slot,
+                const uint64_t            entry,
+                const TimedPose<T, Time> &pose)
+{
+    slot.sequence.store(2 * entry + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const std::array<T, 7> values {pose.rotation.w,
+                                   pose.rotation.x,
+                                   pose.rotation.y,
+                                   pose.rotation.z,
+                                   pose.translation[0],
+                                   pose.translation[1],
+                                   pose.translation[2]};
+    slot.time.store(pose.time, std::memory_order_relaxed);
+    for (size_t k = 0; k < values.size(); ++k)
+    {
+        slot.values[k].store(values[k], std::memory_order_relaxed);
+    }
+
+    slot.sequence.store(2 * entry + 2, std::memory_order_release);
+}
+
+/// Copy entry out of its slot. False if the slot holds another entry or the
+/// producer overwrote it during the copy.
+template<typename T, typename Time>
+bool read_slot(const TransformSlot<T, Time> &slot,
+               const uint64_t                entry,
+               TimedPose<T, Time>           &pose)
+{
+    const uint64_t expected = 2 * entry + 2;
+    if (slot.sequence.load(std::memory_order_acquire) != expected)
+    {
+        return false;
+    }
+    std::array<T, 7> values;
+    pose.time = slot.time.load(std::memory_order_relaxed);
+    for (size_t k = 0; k < values.size(); ++k)
+    {
+        values[k] = slot.values[k].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != expected)
+    {
+        return false;
+    }
+    pose.rotation = Quaternion<T> {values[0], values[1], values[2], values[3]};
+    pose.translation =
+        colibra::Vector<3, T> {values[4], values[5], values[6]};
+    return true;
+}
+
+/// Only the time of entry, with the same checks as read_slot.
+template<typename T, typename Time>
+bool read_time(const TransformSlot<T, Time> &slot,
+               const uint64_t                entry,
+               Time                         &time)
+{
+    const uint64_t expected = 2 * entry + 2;
+    if (slot.sequence.load(std::memory_order_acquire) != expected)
+    {
+        return false;
+    }
+    time = slot.time.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.sequence.load(std::memory_order_relaxed) == expected;
+}
+
+/// Interpolate between two poses with before.time <= time <= after.time:
+/// slerp for the rotation, lerp for the translation.
+template<typename T, typename Time>
+RigidTransform<T> interpolate(const TimedPose<T, Time> &before,
+                              const TimedPose<T, Time> &after,
+                              const Time                time)
+{
+    if (!(before.time < after.time) || time == before.time)
+    {
+        return RigidTransform<T> {before.rotation.to_matrix(),
+                                  before.translation};
+    }
+    const T alpha = static_cast<T>(time - before.time)
+                    / static_cast<T>(after.time - before.time);
+    return RigidTransform<T> {
+        slerp(before.rotation, after.rotation, alpha).to_matrix(),
+        lerp(before.translation, after.translation, alpha)};
+}
+
+} // namespace details
+} // namespace colibra
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef COLIBRA_DETAILS_TRANSFORM_STORE_HPP
+#define COLIBRA_DETAILS_TRANSFORM_STORE_HPP
+
+#include "../transform.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace colibra {
+namespace details {
+
+/**
+ * One copy of a published transform, the rotation Matrix row by row and
+ * then the translation. Guarded like TransformSlot: the sequence number is
+ * odd while the copy is written and 2 * version + 2 once it holds version.
+ */
+template<typename T>
+struct TransformCopy
+{
+    std::atomic<uint64_t>          sequence {0};
+    std::array<std::atomic<T>, 12> values {};
+};
+
+/**
+ * The published transform of one frame. The writer alternates between the
+ * two copies, so the copy holding the current version is only overwritten
+ * by the publish after next. A reader retries only if it is preempted for a
+ * whole publish, never because a write is in progress. Every frame owns its
+ * cache lines, publishing one frame does not disturb readers of another.
+ */
+template<typename T>
+struct alignas(64) FrameSlot
+{
+    std::atomic<uint64_t>           version {0};
+    std::array<TransformCopy<T>, 2> copies;
+};
+
+template<typename T>
+void write_copy(TransformCopy<T>        &copy,
+                const uint64_t           version,
+                const RigidTransform<T> &transform)
+{
+    copy.sequence.store(2 * version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        for (size_t j = 0; j < 3; ++j)
+        {
+            copy.values[3 * i + j].store(transform.rotation(i, j),
+                                         std::memory_order_relaxed);
+        }
+        copy.values[9 + i].store(transform.translation[i],
+                                 std::memory_order_relaxed);
+    }
+
+    copy.sequence.store(2 * version + 2, std::memory_order_release);
+}
+
+/// Copy version out of copy. False if it holds another version or was
+/// overwritten during the read.
+template<typename T>
+bool read_copy(const TransformCopy<T> &copy,
+               const uint64_t          version,
+               RigidTransform<T>      &transform)
+{
+    const uint64_t expected = 2 * version + 2;
+    if (copy.sequence.load(std::memory_order_acquire) != expected)
+    {
+        return false;
+    }
+    std::array<T, 12> values;
+    for (size_t k = 0; k < values.size(); ++k)
+    {
+        values[k] = copy.values[k].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (copy.sequence.load(std::memory_order_relaxed) != expected)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < 3; ++i)
+    {
+        for (size_t j = 0; j < 3; ++j)
+        {
+            transform.rotation(i, j) = values[3 * i + j];
+        }
+        transform.translation[i] = values[9 + i];
+    }
+    return true;
+}
+
+} // namespace details
+} // namespace colibra
+
+#endif
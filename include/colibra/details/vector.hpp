@@ -1,25 +1,281 @@
 #ifndef COLIBRA_DETAILS_VECTOR_HPP
 #define COLIBRA_DETAILS_VECTOR_HPP
 
-#include <algorithm>
+#include "../concepts.h"
+#include "../promotion.h"
+#include "fixed_point.hpp"
+
 #include <array>
 #include <cmath>
-#include <functional>
-#include <numeric>
 #include <ostream>
 #include <type_traits>
+#include <utility>
 
 namespace colibra {
 template<size_t l, typename T>
 class Vector;
 
+/**
+ * @brief: Vectors with up to this many elements expand element-wise
+ * operations into a single expression over a std::index_sequence, which the
+ * compiler fully unrolls. Larger Vectors use loops instead, so compile time
+ * and code size stay linear in the size and reductions can keep several
+ * independent partial sums.
+ *
+ * Define COLIBRA_UNROLL_LIMIT before including any colibra header to change
+ * it for a whole build, e.g. -DCOLIBRA_UNROLL_LIMIT=32.
+ */
+#ifndef COLIBRA_UNROLL_LIMIT
+#define COLIBRA_UNROLL_LIMIT 16
+#endif
+
 namespace details {
 
+inline constexpr size_t unroll_limit = COLIBRA_UNROLL_LIMIT;
+
+/// Independent partial sums of reductions above unroll_limit. Four hide the
+/// latency of a floating-point add on current cores.
+inline constexpr size_t reduction_lanes = 4;
+
+template<typename T>
+struct identity
+{
+    using type = T;
+};
+
+/// Blocks template argument deduction so that implicit conversions apply.
+template<typename T>
+using identity_t = typename identity<T>::type;
+
+/**
+ * Sum term(i) for i in [first, first + count) as a balanced tree of adds,
+ * expanded at compile time. A left fold chains every add on the previous
+ * one; the tree has depth log2(count), so independent adds can overlap.
+ */
+template<size_t first, size_t count, class Term>
+constexpr auto tree_sum(const Term &term)
+{
+    if constexpr (count == 1)
+    {
+        return term(first);
+    }
+    else
+    {
+        constexpr size_t half = count / 2;
+        return tree_sum<first, half>(term)
+               + tree_sum<first + half, count - half>(term);
+    }
+}
+
 template<typename T, size_t... Idx>
 constexpr auto sum(const Vector<sizeof...(Idx), T> vec,
                    std::index_sequence<Idx...>)
 {
-    return (... + vec[Idx]);
+    return tree_sum<0, sizeof...(Idx)>(
+        [&vec](const size_t i) { return vec[i]; });
+}
+
+/**
+ * Sum term(i) for i in [0, l) with reduction_lanes interleaved accumulators,
+ * which breaks the dependency chain of a running sum so consecutive adds
+ * can be in flight at the same time.
+ */
+template<typename R, size_t l, class Term>
+constexpr R tiled_sum(const Term &term)
+{
+    R      lanes[reduction_lanes] {};
+    size_t i = 0;
+    for (; i + reduction_lanes <= l; i += reduction_lanes)
+    {
+        for (size_t k = 0; k < reduction_lanes; ++k)
+        {
+            lanes[k] = lanes[k] + term(i + k);
+        }
+    }
+    for (; i < l; ++i)
+    {
+        lanes[0] = lanes[0] + term(i);
+    }
+    for (size_t width = reduction_lanes / 2; width > 0; width /= 2)
+    {
+        for (size_t k = 0; k < width; ++k)
+        {
+            lanes[k] = lanes[k] + lanes[k + width];
+        }
+    }
+    return lanes[0];
+}
+
+template<typename R, size_t l, class Fn, size_t... Idx>
+constexpr std::array<R, l> generate(const Fn &fn, std::index_sequence<Idx...>)
+{
+    return {static_cast<R>(fn(Idx))...};
+}
+
+/// The array {fn(0), ..., fn(l - 1)}, as one expression up to unroll_limit
+/// and as a loop above.
+template<typename R, size_t l, class Fn>
+constexpr std::array<R, l> generate(const Fn &fn)
+{
+    if constexpr (l <= unroll_limit)
+    {
+        return generate<R, l>(fn, std::make_index_sequence<l> {});
+    }
+    else
+    {
+        std::array<R, l> out {};
+        for (size_t i = 0; i < l; ++i)
+        {
+            out[i] = static_cast<R>(fn(i));
+        }
+        return out;
+    }
+}
+
+/// Sum term(i) for i in [0, l) as R: a tree up to unroll_limit, interleaved
+/// partial sums above.
+template<typename R, size_t l, class Term>
+constexpr R reduce(const Term &term)
+{
+    if constexpr (l <= unroll_limit)
+    {
+        return static_cast<R>(tree_sum<0, l>(term));
+    }
+    else
+    {
+        return tiled_sum<R, l>(term);
+    }
+}
+
+/**
+ * a * b. Complex products use the textbook formula, which is constexpr and
+ * avoids the library call compilers emit to recover infinities from NaN
+ * results, so a product with an infinite component may differ from
+ * std::complex.
+ */
+template<typename R>
+constexpr R product(const R &a, const R &b)
+{
+    if constexpr (element_category_v<R> == ElementCategory::complex)
+    {
+        return R(a.real() * b.real() - a.imag() * b.imag(),
+                 a.real() * b.imag() + a.imag() * b.real());
+    }
+    else
+    {
+        return a * b;
+    }
+}
+
+/// a + b, a - b, -a and the complex conjugate of a. Complex values are
+/// combined per component, the std::complex operators are not constexpr
+/// before C++20.
+template<typename R>
+constexpr R plus(const R &a, const R &b)
+{
+    if constexpr (element_category_v<R> == ElementCategory::complex)
+    {
+        return R(a.real() + b.real(), a.imag() + b.imag());
+    }
+    else
+    {
+        return a + b;
+    }
+}
+
+template<typename R>
+constexpr R minus(const R &a, const R &b)
+{
+    if constexpr (element_category_v<R> == ElementCategory::complex)
+    {
+        return R(a.real() - b.real(), a.imag() - b.imag());
+    }
+    else
+    {
+        return a - b;
+    }
+}
+
+template<typename R>
+constexpr R negate(const R &a)
+{
+    if constexpr (element_category_v<R> == ElementCategory::complex)
+    {
+        return R(-a.real(), -a.imag());
+    }
+    else
+    {
+        return -a;
+    }
+}
+
+template<typename R>
+constexpr R conjugate(const R &a)
+{
+    if constexpr (element_category_v<R> == ElementCategory::complex)
+    {
+        return R(a.real(), -a.imag());
+    }
+    else
+    {
+        return a;
+    }
+}
+
+/// Whether l products of R can be accumulated exactly in int64_t.
+template<typename R, size_t l>
+struct has_wide_dot : std::false_type
+{
+};
+
+template<int Frac, typename Rep, size_t l>
+struct has_wide_dot<Fixed<Frac, Rep>, l>
+    : std::bool_constant<sizeof(Rep) <= sizeof(int32_t) && l <= dot_wide_terms>
+{
+};
+
+/**
+ * Sum of a(i) * b(i) for i in [0, l), where a and b return R. The kernel is
+ * selected by the element category of R:
+ *  - complex: real and imaginary parts are reduced separately as
+ *    R::value_type, which keeps the reduction constexpr.
+ *  - fixed_point up to 32 bit: products are accumulated exactly in int64_t
+ *    like dot_wide and rounded and saturated once, instead of per term.
+ *  - everything else: reduce over product(a(i), b(i)).
+ */
+template<typename R, size_t l, class A, class B>
+constexpr R dot(const A &a, const B &b)
+{
+    constexpr ElementCategory category = element_category_v<R>;
+    if constexpr (category == ElementCategory::complex)
+    {
+        using V      = typename R::value_type;
+        const V real = reduce<V, l>([&](const size_t i) {
+            const R x = a(i);
+            const R y = b(i);
+            return x.real() * y.real() - x.imag() * y.imag();
+        });
+        const V imag = reduce<V, l>([&](const size_t i) {
+            const R x = a(i);
+            const R y = b(i);
+            return x.real() * y.imag() + x.imag() * y.real();
+        });
+        return R(real, imag);
+    }
+    else if constexpr (has_wide_dot<R, l>::value)
+    {
+        using format      = dot_wide_format<R::fraction_bits, typename R::rep>;
+        const int64_t sum = reduce<int64_t, l>([&](const size_t i) {
+            const int64_t raw = static_cast<int64_t>(a(i).raw()) * b(i).raw();
+            return rounding_shift(raw, format::shift);
+        });
+        return R(Fixed<format::frac, int64_t>::from_raw(sum));
+    }
+    else
+    {
+        return reduce<R, l>(
+            [&](const size_t i) { return product<R>(a(i), b(i)); });
+    }
 }
 
 template<size_t l, typename T>
@@ -40,6 +296,11 @@ class Vector
         static_assert(l > 0, "Can not declare Vectors with 0 elements");
     }
 
+    explicit constexpr Vector(const array_type &array)
+        : m_array(array)
+    {
+    }
+
     auto begin() noexcept -> decltype(std::declval<array_type>().begin())
     {
         return m_array.begin();
@@ -85,59 +346,29 @@ class Vector
         return m_array[p];
     }
 
-    template<class S, typename R = std::common_type_t<T, S>>
-    [[nodiscard]] constexpr R operator*(const Vector<l, S> &other) const
-    {
-        return sum(apply_each(other,
-                              std::multiplies<R>(),
-                              std::make_index_sequence<l> {}),
-                   std::make_index_sequence<l> {});
-    }
-
-    template<class S, typename R = std::common_type_t<T, S>>
-    [[nodiscard]] constexpr auto operator*(const S &scalar) const
-    {
-
-        return apply_each(
-            scalar, std::multiplies<R>(), std::make_index_sequence<l> {});
-    }
-
-    template<class S, typename R = std::common_type_t<T, S>>
-    [[nodiscard]] constexpr auto operator+(const Vector<l, S> &other) const
-    {
-        return apply_each(
-            other, std::plus<R>(), std::make_index_sequence<l> {});
-    }
-
-    template<class S, typename R = std::common_type_t<T, S>>
-    [[nodiscard]] constexpr auto operator-(const Vector<l, S> &other) const
-    {
-        return apply_each(
-            other, std::minus<R>(), std::make_index_sequence<l> {});
-    }
-
-    [[nodiscard]] constexpr auto operator-()
-    {
-        return apply_each(std::negate<T>(), std::make_index_sequence<l> {});
-    }
-
     [[nodiscard]] constexpr bool operator==(Vector<l, T> const &other) const
     {
-        return m_array == other.m_array;
+        // std::array comparison is not constexpr before C++20.
+        for (size_t i = 0; i < l; ++i)
+        {
+            if (!(m_array[i] == other.m_array[i]))
+            {
+                return false;
+            }
+        }
+        return true;
     }
 
     [[nodiscard]] constexpr bool operator!=(Vector<l, T> const &other) const
     {
-        return m_array != other.m_array;
+        return !(*this == other);
     }
 
     [[nodiscard]] constexpr double norm() const
     {
-        double norm = 0;
-        for (const auto &i : m_array)
-        {
-            norm += i * i;
-        }
+        const double norm = reduce<double, l>([this](const size_t i) {
+            return static_cast<double>(m_array[i] * m_array[i]);
+        });
         return sqrt(norm);
     }
 
@@ -170,29 +401,6 @@ class Vector
 
   private:
     array_type m_array;
-
-    template<typename S, class Op, size_t... Idx>
-    constexpr auto
-    apply_each(const S &fac, const Op &op, std::index_sequence<Idx...>) const
-    {
-        return colibra::Vector<l, std::common_type_t<T, S>> {
-            op(m_array[Idx], fac)...};
-    }
-
-    template<typename O, class Op, size_t... Idx>
-    constexpr auto apply_each(const Vector<l, O> &other,
-                              const Op &          op,
-                              std::index_sequence<Idx...>) const
-    {
-        return colibra::Vector<l, std::common_type_t<T, O>> {
-            op(m_array[Idx], other[Idx])...};
-    }
-
-    template<class Op, size_t... Idx>
-    constexpr auto apply_each(const Op &op, std::index_sequence<Idx...>) const
-    {
-        return colibra::Vector {op(m_array[Idx])...};
-    }
 };
 
 } // namespace details
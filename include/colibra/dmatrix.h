@@ -0,0 +1,484 @@
+#ifndef COLIBRA_DMATRIX_H
+#define COLIBRA_DMATRIX_H
+
+#include "batch_ops.h"
+#include "details/gemm.hpp"
+#include "execution.h"
+#include "matrix.h"
+#include "promotion.h"
+#include "span.h"
+
+#include <initializer_list>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace colibra {
+
+/**
+ * @brief: A dense Matrix whose size is chosen at run time.
+ *
+ * Elements are stored row-major in a std::vector. Use Matrix for small
+ * sizes known at compile time, DMatrix for covariances, design matrices and
+ * other problems of hundreds to thousands of rows. Products go through the
+ * blocked gemm and gemv kernels below.
+ *
+ * @tparam T The data type of this DMatrix.
+ */
+template<typename T>
+class DMatrix
+{
+  public:
+    DMatrix() = default;
+
+    /**
+     * @brief: Create a rows x cols DMatrix of zeros.
+     */
+    DMatrix(const size_t rows, const size_t cols)
+        : m_rows(rows)
+        , m_cols(cols)
+        , m_data(rows * cols)
+    {
+    }
+
+    /**
+     * @brief: Create a rows x cols DMatrix from values in row-major order.
+     *
+     * @throws std::invalid_argument If values does not hold rows * cols
+     * elements.
+     */
+    DMatrix(const size_t             rows,
+            const size_t             cols,
+            std::initializer_list<T> values)
+        : m_rows(rows)
+        , m_cols(cols)
+        , m_data(values)
+    {
+        if (m_data.size() != rows * cols)
+        {
+            throw std::invalid_argument(
+                "colibra::DMatrix needs exactly rows * cols values");
+        }
+    }
+
+    /**
+     * @brief: Copy a fixed size Matrix.
+     */
+    template<size_t r, size_t c>
+    explicit DMatrix(const Matrix<r, c, T> &m)
+        : m_rows(r)
+        , m_cols(c)
+        , m_data(m.data(), m.data() + r * c)
+    {
+    }
+
+    /**
+     * @brief: Create an n x n DMatrix with ones on the diagonal.
+     */
+    [[nodiscard]] static DMatrix identity(const size_t n)
+    {
+        DMatrix m(n, n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            m(i, i) = T {1};
+        }
+        return m;
+    }
+
+    [[nodiscard]] size_t rows() const
+    {
+        return m_rows;
+    }
+
+    [[nodiscard]] size_t cols() const
+    {
+        return m_cols;
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return m_data.empty();
+    }
+
+    /**
+     * @brief: Change the shape, discarding the contents but keeping the
+     * allocation when it is large enough.
+     */
+    void resize(const size_t rows, const size_t cols)
+    {
+        m_rows = rows;
+        m_cols = cols;
+        m_data.assign(rows * cols, T {});
+    }
+
+    /**
+     * @brief: Access the element in row i and column j.
+     *
+     * @warning Does not perform range-checking.
+     */
+    [[nodiscard]] T &operator()(const size_t i, const size_t j)
+    {
+        return m_data[i * m_cols + j];
+    }
+
+    /**
+     * @brief: Access the element in row i and column j.
+     *
+     * @warning Does not perform range-checking.
+     */
+    [[nodiscard]] const T &operator()(const size_t i, const size_t j) const
+    {
+        return m_data[i * m_cols + j];
+    }
+
+    /**
+     * @brief: Access the element in row i and column j with range checking.
+     *
+     * @throws std::out_of_range When accessing elements out of range.
+     */
+    [[nodiscard]] T &at(const size_t i, const size_t j)
+    {
+        check_range(i, j);
+        return (*this)(i, j);
+    }
+
+    /**
+     * @brief: Access the element in row i and column j with range checking.
+     *
+     * @throws std::out_of_range When accessing elements out of range.
+     */
+    [[nodiscard]] const T &at(const size_t i, const size_t j) const
+    {
+        check_range(i, j);
+        return (*this)(i, j);
+    }
+
+    /**
+     * @brief: View row i.
+     *
+     * @warning Does not perform range-checking.
+     */
+    [[nodiscard]] Span<T> row(const size_t i)
+    {
+        return Span<T>(m_data.data() + i * m_cols, m_cols);
+    }
+
+    [[nodiscard]] Span<const T> row(const size_t i) const
+    {
+        return Span<const T>(m_data.data() + i * m_cols, m_cols);
+    }
+
+    [[nodiscard]] DMatrix transpose() const
+    {
+        DMatrix m(m_cols, m_rows);
+        for (size_t i = 0; i < m_rows; ++i)
+        {
+            for (size_t j = 0; j < m_cols; ++j)
+            {
+                m(j, i) = (*this)(i, j);
+            }
+        }
+        return m;
+    }
+
+    /**
+     * @brief: Matrix product, computed by gemm on the calling thread.
+     *
+     * The element type of the result follows the default promotion policy,
+     * see promotion.h.
+     *
+     * @throws std::invalid_argument If the inner dimensions differ.
+     */
+    template<class S, typename R = promoted_t<T, S>>
+    [[nodiscard]] DMatrix<R> operator*(const DMatrix<S> &other) const;
+
+    /**
+     * @brief: Multiply this DMatrix with a column vector, computed by gemv
+     * on the calling thread.
+     *
+     * The element type of the result follows the default promotion policy,
+     * see promotion.h.
+     *
+     * @throws std::invalid_argument If vec does not have cols() elements.
+     */
+    template<class S, typename R = promoted_t<T, S>>
+    [[nodiscard]] std::vector<R> operator*(Span<S> vec) const;
+
+    template<class S, typename A, typename R = promoted_t<T, S>>
+    [[nodiscard]] std::vector<R>
+    operator*(const std::vector<S, A> &vec) const
+    {
+        return *this * Span<const S>(vec);
+    }
+
+    /**
+     * @brief: Multiply this DMatrix with a scalar.
+     *
+     * The element type of the result follows the default promotion policy,
+     * see promotion.h.
+     */
+    template<class S, typename R = promoted_t<T, S>>
+    [[nodiscard]] DMatrix<R> operator*(const S &scalar) const
+    {
+        DMatrix<R> m(m_rows, m_cols);
+        for (size_t n = 0; n < m_data.size(); ++n)
+        {
+            m.m_data[n] = static_cast<R>(m_data[n]) * static_cast<R>(scalar);
+        }
+        return m;
+    }
+
+    /**
+     * @brief: DMatrix addition.
+     *
+     * The element type of the result follows the default promotion policy,
+     * see promotion.h.
+     *
+     * @throws std::invalid_argument If the shapes differ.
+     */
+    template<class S, typename R = promoted_t<T, S>>
+    [[nodiscard]] DMatrix<R> operator+(const DMatrix<S> &other) const
+    {
+        check_same_shape(other);
+        DMatrix<R> m(m_rows, m_cols);
+        for (size_t n = 0; n < m_data.size(); ++n)
+        {
+            m.m_data[n] =
+                static_cast<R>(m_data[n]) + static_cast<R>(other.m_data[n]);
+        }
+        return m;
+    }
+
+    /**
+     * @brief: DMatrix subtraction.
+     *
+     * The element type of the result follows the default promotion policy,
+     * see promotion.h.
+     *
+     * @throws std::invalid_argument If the shapes differ.
+     */
+    template<class S, typename R = promoted_t<T, S>>
+    [[nodiscard]] DMatrix<R> operator-(const DMatrix<S> &other) const
+    {
+        check_same_shape(other);
+        DMatrix<R> m(m_rows, m_cols);
+        for (size_t n = 0; n < m_data.size(); ++n)
+        {
+            m.m_data[n] =
+                static_cast<R>(m_data[n]) - static_cast<R>(other.m_data[n]);
+        }
+        return m;
+    }
+
+    /**
+     * @brief: Negate this DMatrix.
+     */
+    [[nodiscard]] DMatrix operator-() const
+    {
+        DMatrix m(m_rows, m_cols);
+        for (size_t n = 0; n < m_data.size(); ++n)
+        {
+            m.m_data[n] = -m_data[n];
+        }
+        return m;
+    }
+
+    /**
+     * @brief: Comparison operator.
+     *
+     * @return True if shape and elements are identical, false otherwise.
+     */
+    [[nodiscard]] bool operator==(const DMatrix &other) const
+    {
+        return m_rows == other.m_rows && m_cols == other.m_cols
+               && m_data == other.m_data;
+    }
+
+    /**
+     * @brief: Inverted comparison operator.
+     *
+     * @return True if DMatrices are different, false otherwise.
+     */
+    [[nodiscard]] bool operator!=(const DMatrix &other) const
+    {
+        return !(*this == other);
+    }
+
+    /**
+     * @brief: Get a ptr to the row-major elements of this DMatrix.
+     */
+    [[nodiscard]] const T *data() const
+    {
+        return m_data.data();
+    }
+
+    [[nodiscard]] T *data()
+    {
+        return m_data.data();
+    }
+
+    /**
+     * @brief: Ostream operator to pretty print DMatrices row by row, e.g.
+     * "{ { 1, 2 }, { 3, 4 } }".
+     */
+    friend std::ostream &operator<<(std::ostream &os, const DMatrix &m)
+    {
+        os << "{ ";
+        for (size_t i = 0; i < m.m_rows; ++i)
+        {
+            os << (i > 0 ? ", { " : "{ ");
+            for (size_t j = 0; j < m.m_cols; ++j)
+            {
+                os << (j > 0 ? ", " : "") << m(i, j);
+            }
+            os << " }";
+        }
+        return os << " }";
+    }
+
+  private:
+    template<typename>
+    friend class DMatrix;
+
+    size_t         m_rows = 0;
+    size_t         m_cols = 0;
+    std::vector<T> m_data;
+
+    void check_range(const size_t i, const size_t j) const
+    {
+        if (i >= m_rows || j >= m_cols)
+        {
+            throw std::out_of_range("colibra::DMatrix::at out of range");
+        }
+    }
+
+    template<typename S>
+    void check_same_shape(const DMatrix<S> &other) const
+    {
+        if (m_rows != other.m_rows || m_cols != other.m_cols)
+        {
+            throw std::invalid_argument("colibra::DMatrix: shape mismatch");
+        }
+    }
+};
+
+/**
+ * @brief: Compute the matrix product c = a * b.
+ *
+ * Uses a packed, cache-blocked kernel: blocks of a and b are copied into
+ * contiguous micro panels, converted to the element type of c on the way,
+ * and a register-blocked micro kernel accumulates small blocks of c. With
+ * execution::par the rows of c are split across threads, the grain of the
+ * policy counts multiply-adds.
+ *
+ * @param c Receives the product, resized to a.rows() x b.cols(). May be
+ * the same DMatrix as a or b, the product is then computed into a temporary
+ * and moved into c.
+ *
+ * @throws std::invalid_argument If a.cols() differs from b.rows().
+ */
+template<class Policy,
+         typename T,
+         typename S,
+         typename R,
+         typename = enable_if_execution_policy_t<Policy>>
+void gemm(const Policy &    policy,
+          const DMatrix<T> &a,
+          const DMatrix<S> &b,
+          DMatrix<R> &      c)
+{
+    if (a.cols() != b.rows())
+    {
+        throw std::invalid_argument("colibra::gemm: dimension mismatch");
+    }
+    // Resizing c zero-fills it, which would destroy an aliased input.
+    const void *const output = &c;
+    if (output == &a || output == &b)
+    {
+        DMatrix<R> product;
+        gemm(policy, a, b, product);
+        c = std::move(product);
+        return;
+    }
+    c.resize(a.rows(), b.cols());
+    if (a.cols() == 0)
+    {
+        return;
+    }
+    const size_t k = a.cols();
+    const size_t n = b.cols();
+    details::parallel_for(
+        details::rows_policy(policy, k * n),
+        a.rows(),
+        [&](const size_t begin, const size_t end) {
+            details::gemm_rows(a.data(), b.data(), c.data(), begin, end, k, n);
+        });
+}
+
+template<typename T, typename S, typename R>
+void gemm(const DMatrix<T> &a, const DMatrix<S> &b, DMatrix<R> &c)
+{
+    gemm(execution::seq, a, b, c);
+}
+
+/**
+ * @brief: Compute the matrix vector product y = a * x.
+ *
+ * Each row is reduced with independent partial sums, so the loop
+ * vectorizes. With execution::par the rows are split across threads, the
+ * grain of the policy counts multiply-adds.
+ *
+ * @throws std::invalid_argument If x does not have a.cols() elements or y
+ * has fewer than a.rows().
+ */
+template<class Policy,
+         typename T,
+         typename S,
+         typename R,
+         typename = enable_if_execution_policy_t<Policy>>
+void gemv(const Policy &    policy,
+          const DMatrix<T> &a,
+          Span<S>           x,
+          Span<R>           y)
+{
+    if (x.size() != a.cols() || y.size() < a.rows())
+    {
+        throw std::invalid_argument("colibra::gemv: dimension mismatch");
+    }
+    details::parallel_for(
+        details::rows_policy(policy, a.cols()),
+        a.rows(),
+        [&](const size_t begin, const size_t end) {
+            details::gemv_rows(
+                a.data(), x.data(), y.data(), begin, end, a.cols());
+        });
+}
+
+template<typename T, typename S, typename R>
+void gemv(const DMatrix<T> &a, Span<S> x, Span<R> y)
+{
+    gemv(execution::seq, a, x, y);
+}
+
+template<typename T>
+template<class S, typename R>
+DMatrix<R> DMatrix<T>::operator*(const DMatrix<S> &other) const
+{
+    DMatrix<R> product;
+    gemm(*this, other, product);
+    return product;
+}
+
+template<typename T>
+template<class S, typename R>
+std::vector<R> DMatrix<T>::operator*(Span<S> vec) const
+{
+    std::vector<R> out(m_rows);
+    gemv(*this, vec, Span<R>(out));
+    return out;
+}
+
+} // namespace colibra
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef COLIBRA_EXECUTION_H
+#define COLIBRA_EXECUTION_H
+
+#include <cstddef>
+#include <type_traits>
+
+namespace colibra {
+namespace execution {
+
+/**
+ * @brief: Execution policy requesting that a batch algorithm runs on the
+ * calling thread only.
+ */
+struct sequenced_policy
+{
+};
+
+/**
+ * @brief: Execution policy requesting that a batch algorithm splits its work
+ * across several threads.
+ *
+ * Small inputs are still processed on the calling thread, since spawning
+ * threads costs more than the work itself.
+ */
+struct parallel_policy
+{
+    /// Number of threads to use, 0 picks std::thread::hardware_concurrency().
+    size_t threads = 0;
+    /// Minimum number of elements each thread has to process.
+    size_t grain = 16384;
+};
+
+inline constexpr sequenced_policy seq {};
+inline constexpr parallel_policy  par {};
+
+/**
+ * @brief: Trait identifying the colibra execution policies.
+ */
+template<typename T>
+struct is_execution_policy : std::false_type
+{
+};
+
+template<>
+struct is_execution_policy<sequenced_policy> : std::true_type
+{
+};
+
+template<>
+struct is_execution_policy<parallel_policy> : std::true_type
+{
+};
+
+template<typename T>
+inline constexpr bool is_execution_policy_v =
+    is_execution_policy<std::decay_t<T>>::value;
+
+} // namespace execution
+} // namespace colibra
+
+#endif
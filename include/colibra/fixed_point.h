@@ -0,0 +1,503 @@
+#ifndef COLIBRA_FIXED_POINT_H
+#define COLIBRA_FIXED_POINT_H
+
+#include "details/fixed_point.hpp"
+#include "vector.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace colibra {
+
+namespace details {
+
+/// Declared for the common_type with half.h below.
+template<class Format>
+class Float16;
+
+} // namespace details
+
+/**
+ * @brief: A signed fixed-point number with Frac fractional bits stored in
+ * Rep.
+ *
+ * Addition, subtraction and negation saturate instead of wrapping around, as
+ * is common for DSP code. Multiplication and division compute in an integer
+ * twice as wide, round to nearest and saturate.
+ *
+ * Fixed converts implicitly to double so it works with Vector::norm() and
+ * mixed floating point expressions. Construction from floating point values
+ * and integers is explicit, rounds to nearest and saturates.
+ *
+ * @tparam Frac Number of fractional bits.
+ * @tparam Rep Signed integer type holding the raw value.
+ */
+template<int Frac, typename Rep>
+class Fixed
+{
+    static_assert(std::is_integral_v<Rep> && std::is_signed_v<Rep>,
+                  "Fixed needs a signed integer representation");
+    static_assert(Frac >= 0 && Frac <= details::value_bits<Rep>,
+                  "Fixed needs 0 <= Frac <= value bits of Rep");
+
+  public:
+    using rep                        = Rep;
+    static constexpr int fraction_bits = Frac;
+
+    constexpr Fixed() = default;
+
+    /**
+     * @brief: Round a floating point value to the nearest representable
+     * value, saturating at the range limits. NaN becomes 0.
+     */
+    explicit constexpr Fixed(const double value) noexcept
+        : m_raw(from_double(value))
+    {
+    }
+
+    /**
+     * @brief: Convert an integer, saturating at the range limits.
+     */
+    template<typename I, typename = std::enable_if_t<std::is_integral_v<I>>>
+    explicit constexpr Fixed(const I value) noexcept
+        : m_raw(from_double(static_cast<double>(value)))
+    {
+    }
+
+    /**
+     * @brief: Convert between fixed-point formats, rounding when fractional
+     * bits are dropped and saturating at the range limits.
+     */
+    template<int F, typename R>
+    explicit constexpr Fixed(const Fixed<F, R> other) noexcept
+        : m_raw(rescale(other.raw(), F))
+    {
+    }
+
+    [[nodiscard]] static constexpr Fixed from_raw(const Rep raw) noexcept
+    {
+        Fixed value;
+        value.m_raw = raw;
+        return value;
+    }
+
+    [[nodiscard]] static constexpr Fixed lowest() noexcept
+    {
+        return from_raw(std::numeric_limits<Rep>::min());
+    }
+
+    [[nodiscard]] static constexpr Fixed highest() noexcept
+    {
+        return from_raw(std::numeric_limits<Rep>::max());
+    }
+
+    [[nodiscard]] constexpr Rep raw() const noexcept
+    {
+        return m_raw;
+    }
+
+    constexpr operator double() const noexcept
+    {
+        return static_cast<double>(m_raw) / scale;
+    }
+
+    constexpr Fixed operator-() const noexcept
+    {
+        return from_raw(details::saturate<Rep>(-static_cast<W>(m_raw)));
+    }
+
+    friend constexpr Fixed operator+(const Fixed a, const Fixed b) noexcept
+    {
+        return from_raw(details::saturating_add(a.m_raw, b.m_raw));
+    }
+
+    friend constexpr Fixed operator-(const Fixed a, const Fixed b) noexcept
+    {
+        return from_raw(details::saturating_sub(a.m_raw, b.m_raw));
+    }
+
+    friend constexpr Fixed operator*(const Fixed a, const Fixed b) noexcept
+    {
+        const W product = static_cast<W>(a.m_raw) * b.m_raw;
+        return from_raw(
+            details::saturate<Rep>(details::rounding_shift(product, Frac)));
+    }
+
+    /**
+     * @brief: Division, rounded to nearest with ties away from zero.
+     * Dividing by zero saturates towards the sign of the dividend, 0 / 0 is
+     * 0.
+     */
+    friend constexpr Fixed operator/(const Fixed a, const Fixed b) noexcept
+    {
+        if (b.m_raw == 0)
+        {
+            return a.m_raw > 0 ? highest()
+                               : (a.m_raw < 0 ? lowest() : Fixed {});
+        }
+        const W dividend  = static_cast<W>(a.m_raw) * (W {1} << Frac);
+        const W divisor   = b.m_raw;
+        const W remainder = dividend % divisor;
+        W       quotient  = dividend / divisor;
+        if (2 * (remainder < 0 ? -remainder : remainder)
+            >= (divisor < 0 ? -divisor : divisor))
+        {
+            quotient += (dividend < 0) == (divisor < 0) ? 1 : -1;
+        }
+        return from_raw(details::saturate<Rep>(quotient));
+    }
+
+    constexpr Fixed &operator+=(const Fixed other) noexcept
+    {
+        return *this = *this + other;
+    }
+
+    constexpr Fixed &operator-=(const Fixed other) noexcept
+    {
+        return *this = *this - other;
+    }
+
+    constexpr Fixed &operator*=(const Fixed other) noexcept
+    {
+        return *this = *this * other;
+    }
+
+    constexpr Fixed &operator/=(const Fixed other) noexcept
+    {
+        return *this = *this / other;
+    }
+
+    friend constexpr bool operator==(const Fixed a, const Fixed b) noexcept
+    {
+        return a.m_raw == b.m_raw;
+    }
+
+    friend constexpr bool operator!=(const Fixed a, const Fixed b) noexcept
+    {
+        return a.m_raw != b.m_raw;
+    }
+
+    friend constexpr bool operator<(const Fixed a, const Fixed b) noexcept
+    {
+        return a.m_raw < b.m_raw;
+    }
+
+    friend constexpr bool operator<=(const Fixed a, const Fixed b) noexcept
+    {
+        return a.m_raw <= b.m_raw;
+    }
+
+    friend constexpr bool operator>(const Fixed a, const Fixed b) noexcept
+    {
+        return a.m_raw > b.m_raw;
+    }
+
+    friend constexpr bool operator>=(const Fixed a, const Fixed b) noexcept
+    {
+        return a.m_raw >= b.m_raw;
+    }
+
+  private:
+    using W = details::wide_t<Rep>;
+
+    static constexpr double scale =
+        static_cast<double>(uint64_t {1} << Frac);
+
+    Rep m_raw = 0;
+
+    static constexpr Rep from_double(const double value) noexcept
+    {
+        if (value != value)
+        {
+            return 0;
+        }
+        const double scaled  = value * scale;
+        const double rounded = scaled >= 0 ? scaled + 0.5 : scaled - 0.5;
+        if (rounded >= static_cast<double>(std::numeric_limits<Rep>::max()))
+        {
+            return std::numeric_limits<Rep>::max();
+        }
+        if (rounded <= static_cast<double>(std::numeric_limits<Rep>::min()))
+        {
+            return std::numeric_limits<Rep>::min();
+        }
+        return static_cast<Rep>(rounded);
+    }
+
+    template<typename R>
+    static constexpr Rep rescale(const R raw, const int frac) noexcept
+    {
+        // 128 bit where available so shifts by up to 63 bits can not
+        // overflow before saturation.
+#if defined(__SIZEOF_INT128__)
+        using I = details::int128_t;
+#else
+        using I = int64_t;
+#endif
+        const I value = raw;
+        if (frac > Frac)
+        {
+            return details::saturate<Rep>(
+                details::rounding_shift(value, frac - Frac));
+        }
+        return details::saturate<Rep>(value * (I {1} << (Frac - frac)));
+    }
+};
+
+/// Q15: 16 bit, range [-1, 1).
+using q15 = Fixed<15, int16_t>;
+
+/// Q31: 32 bit, range [-1, 1).
+using q31 = Fixed<31, int32_t>;
+
+template<typename T>
+struct is_fixed_point : std::false_type
+{
+};
+
+template<int Frac, typename Rep>
+struct is_fixed_point<Fixed<Frac, Rep>> : std::true_type
+{
+};
+
+template<typename T>
+inline constexpr bool is_fixed_point_v = is_fixed_point<T>::value;
+
+namespace details {
+
+template<typename T>
+struct dot_wide_type
+{
+    static_assert(std::is_integral_v<T> && sizeof(T) <= sizeof(int32_t),
+                  "dot_wide supports integers up to 32 bit and Fixed");
+    using type = std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>;
+};
+
+template<int Frac, typename Rep>
+struct dot_wide_type<Fixed<Frac, Rep>>
+{
+    static_assert(sizeof(Rep) <= sizeof(int32_t),
+                  "dot_wide supports Fixed with up to 32 bit");
+    using type = Fixed<dot_wide_format<Frac, Rep>::frac, int64_t>;
+};
+
+/// The type dot_wide multiplies and accumulates in: uint64_t for unsigned
+/// integers, whose products exceed int64_t, and int64_t otherwise.
+template<typename T>
+using wide_accumulator_t =
+    std::conditional_t<std::is_unsigned_v<T>, uint64_t, int64_t>;
+
+template<typename T>
+constexpr wide_accumulator_t<T> raw_value(const T value) noexcept
+{
+    return value;
+}
+
+template<int Frac, typename Rep>
+constexpr int64_t raw_value(const Fixed<Frac, Rep> value) noexcept
+{
+    return value.raw();
+}
+
+template<typename T>
+inline constexpr int dot_wide_shift = 0;
+
+template<int Frac, typename Rep>
+inline constexpr int dot_wide_shift<Fixed<Frac, Rep>> =
+    dot_wide_format<Frac, Rep>::shift;
+
+/// Exact product of two raw values, shifted for accumulation.
+template<typename T>
+constexpr wide_accumulator_t<T> wide_product(const T a, const T b) noexcept
+{
+    return rounding_shift(raw_value(a) * raw_value(b), dot_wide_shift<T>);
+}
+
+template<typename T>
+constexpr typename dot_wide_type<T>::type
+from_wide(const wide_accumulator_t<T> raw) noexcept
+{
+    if constexpr (is_fixed_point_v<T>)
+    {
+        return dot_wide_type<T>::type::from_raw(raw);
+    }
+    else
+    {
+        return static_cast<typename dot_wide_type<T>::type>(raw);
+    }
+}
+
+template<typename F, typename S, typename = void>
+struct fixed_common
+{
+};
+
+template<typename F, typename S>
+struct fixed_common<F, S, std::enable_if_t<std::is_floating_point_v<S>>>
+{
+    using type = S;
+};
+
+template<typename T>
+constexpr T saturating_add(const T a, const T b, std::true_type) noexcept
+{
+    return a + b;
+}
+
+template<typename T>
+constexpr T saturating_add(const T a, const T b, std::false_type) noexcept
+{
+    return saturating_add(a, b);
+}
+
+template<typename T>
+constexpr T saturating_sub(const T a, const T b, std::true_type) noexcept
+{
+    return a - b;
+}
+
+template<typename T>
+constexpr T saturating_sub(const T a, const T b, std::false_type) noexcept
+{
+    return saturating_sub(a, b);
+}
+
+} // namespace details
+
+/**
+ * @brief: The result type of dot_wide for element type T.
+ */
+template<typename T>
+using dot_wide_t = typename details::dot_wide_type<T>::type;
+
+/**
+ * @brief: Dot product without intermediate overflow or rounding.
+ *
+ * Products are formed and accumulated in 64 bit, in uint64_t for unsigned
+ * integers and in int64_t otherwise. For Q15 the result is exact in Q30,
+ * for Q31 each product is rounded to Q48 so that 2^15 - 1 terms fit without
+ * overflow. Integer Vectors up to 32 bit produce a 64 bit integer, exact for
+ * at least 2^32 terms of 8 and 16 bit integers, use dot_wide(v, v) for an
+ * exact squared norm. A single int32_t or uint32_t product can reach 2^62
+ * or nearly 2^64, so 32 bit sums are exact only while they fit into 64 bit.
+ */
+template<size_t l, typename T>
+[[nodiscard]] constexpr dot_wide_t<T> dot_wide(const Vector<l, T> &vec,
+                                               const Vector<l, T> &other)
+{
+    details::wide_accumulator_t<T> sum = 0;
+    for (size_t i = 0; i < l; ++i)
+    {
+        sum += details::wide_product(vec[i], other[i]);
+    }
+    return details::from_wide<T>(sum);
+}
+
+/**
+ * @brief: Element wise addition that saturates at the range limits of T
+ * instead of wrapping around.
+ *
+ * Works for signed integer and Fixed Vectors.
+ */
+template<size_t l, typename T>
+[[nodiscard]] constexpr Vector<l, T> saturating_add(const Vector<l, T> &vec,
+                                                    const Vector<l, T> &other)
+{
+    Vector<l, T> result;
+    for (size_t i = 0; i < l; ++i)
+    {
+        result[i] = details::saturating_add(
+            vec[i], other[i], is_fixed_point<T> {});
+    }
+    return result;
+}
+
+/**
+ * @brief: Element wise subtraction that saturates at the range limits of T
+ * instead of wrapping around.
+ *
+ * Works for signed integer and Fixed Vectors.
+ */
+template<size_t l, typename T>
+[[nodiscard]] constexpr Vector<l, T> saturating_sub(const Vector<l, T> &vec,
+                                                    const Vector<l, T> &other)
+{
+    Vector<l, T> result;
+    for (size_t i = 0; i < l; ++i)
+    {
+        result[i] = details::saturating_sub(
+            vec[i], other[i], is_fixed_point<T> {});
+    }
+    return result;
+}
+
+} // namespace colibra
+
+namespace std {
+
+/**
+ * @brief: Fixed combines with floating point types to the floating point
+ * type. There is deliberately no common type with integers, since scaling a
+ * Q15 Vector by 2 would saturate every entry.
+ */
+template<int Frac, typename Rep, typename S>
+struct common_type<colibra::Fixed<Frac, Rep>, S>
+    : colibra::details::fixed_common<colibra::Fixed<Frac, Rep>, S>
+{
+};
+
+template<typename S, int Frac, typename Rep>
+struct common_type<S, colibra::Fixed<Frac, Rep>>
+    : colibra::details::fixed_common<colibra::Fixed<Frac, Rep>, S>
+{
+};
+
+/**
+ * @brief: Fixed and the 16 bit floating point types of half.h combine to
+ * float. These are more specialized than the generic ones of both headers,
+ * which would otherwise be ambiguous for the pair.
+ */
+template<int Frac, typename Rep, class Format>
+struct common_type<colibra::Fixed<Frac, Rep>,
+                   colibra::details::Float16<Format>>
+{
+    using type = float;
+};
+
+template<class Format, int Frac, typename Rep>
+struct common_type<colibra::details::Float16<Format>,
+                   colibra::Fixed<Frac, Rep>>
+{
+    using type = float;
+};
+
+/**
+ * @brief: Two fixed-point formats combine to the wider representation,
+ * keeping all integer bits of both and as many fractional bits as fit.
+ */
+template<int F1, typename R1, int F2, typename R2>
+struct common_type<colibra::Fixed<F1, R1>, colibra::Fixed<F2, R2>>
+{
+  private:
+    using rep = conditional_t<(sizeof(R1) >= sizeof(R2)), R1, R2>;
+    static constexpr int integer_bits =
+        max(colibra::details::value_bits<R1> - F1,
+            colibra::details::value_bits<R2> - F2);
+    static constexpr int frac =
+        min(max(F1, F2), colibra::details::value_bits<rep> - integer_bits);
+
+  public:
+    using type = colibra::Fixed<frac, rep>;
+};
+
+template<int Frac, typename Rep>
+struct common_type<colibra::Fixed<Frac, Rep>, colibra::Fixed<Frac, Rep>>
+{
+    using type = colibra::Fixed<Frac, Rep>;
+};
+
+} // namespace std
+
+#endif
@@ -0,0 +1,203 @@
+#ifndef COLIBRA_FORMAT_H
+#define COLIBRA_FORMAT_H
+
+#include "batch.h"
+#include "details/format.hpp"
+#include "span.h"
+#include "vector.h"
+
+#include <charconv>
+#include <system_error>
+
+namespace colibra {
+
+/**
+ * @brief: Upper bound on the characters to_chars writes for one Vector,
+ * a buffer of this size never fails with value_too_large.
+ */
+template<size_t l, typename T>
+inline constexpr size_t max_chars_v =
+    l * details::max_element_chars<T>() + 2 * (l - 1) + 4;
+
+/**
+ * @brief: Format a Vector as "{ a, b, c }" into [first, last).
+ *
+ * Unlike operator<<, this neither allocates nor depends on the locale.
+ * Floating-point elements use the shortest representation that parses back
+ * to the same value, half and bfloat16 elements are printed as float and
+ * fixed-point elements as double.
+ *
+ * @return ptr one past the last written character, or ec ==
+ * std::errc::value_too_large and ptr == last if the buffer is too small,
+ * in which case the buffer content is unspecified.
+ */
+template<size_t l, typename T>
+std::to_chars_result
+to_chars(char *first, char *last, const Vector<l, T> &vec)
+{
+    std::to_chars_result result = details::put(first, last, "{ ", 2);
+    for (size_t i = 0; i < l && result.ec == std::errc {}; ++i)
+    {
+        if (i > 0)
+        {
+            result = details::put(result.ptr, last, ", ", 2);
+            if (result.ec != std::errc {})
+            {
+                break;
+            }
+        }
+        result = details::format_element(result.ptr, last, vec[i]);
+    }
+    if (result.ec != std::errc {})
+    {
+        return result;
+    }
+    return details::put(result.ptr, last, " }", 2);
+}
+
+/**
+ * @brief: Format Vectors one per line, each followed by '\n'.
+ *
+ * @return See the single Vector overload. On failure the Vectors that fit
+ * completely are written, ptr still equals last.
+ */
+template<size_t l, typename T>
+std::to_chars_result
+to_chars(char *first, char *last, Span<const Vector<l, T>> vectors)
+{
+    std::to_chars_result result {first, std::errc {}};
+    for (const Vector<l, T> &vec : vectors)
+    {
+        result = to_chars(result.ptr, last, vec);
+        if (result.ec == std::errc {})
+        {
+            result = details::put(result.ptr, last, "\n", 1);
+        }
+        if (result.ec != std::errc {})
+        {
+            return result;
+        }
+    }
+    return result;
+}
+
+template<size_t l, typename T>
+std::to_chars_result
+to_chars(char *first, char *last, const BatchView<l, T> &batch)
+{
+    std::to_chars_result result {first, std::errc {}};
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        result = to_chars(result.ptr, last, batch[i]);
+        if (result.ec == std::errc {})
+        {
+            result = details::put(result.ptr, last, "\n", 1);
+        }
+        if (result.ec != std::errc {})
+        {
+            return result;
+        }
+    }
+    return result;
+}
+
+template<size_t l, typename T>
+std::to_chars_result
+to_chars(char *first, char *last, const Batch<l, T> &batch)
+{
+    return to_chars(first, last, batch.view());
+}
+
+/**
+ * @brief: Parse a Vector in the format written by to_chars and operator<<.
+ *
+ * Whitespace around braces, commas and elements is optional, leading
+ * whitespace is skipped. Exactly l elements are expected.
+ *
+ * @return ptr one past the closing brace. On failure ec is
+ * std::errc::invalid_argument for malformed input, or
+ * std::errc::result_out_of_range if an element does not fit into T, and
+ * vec is left unchanged.
+ */
+template<size_t l, typename T>
+std::from_chars_result
+from_chars(const char *first, const char *last, Vector<l, T> &vec)
+{
+    const std::from_chars_result invalid {first, std::errc::invalid_argument};
+
+    const char *ptr = details::skip_space(first, last);
+    if (ptr == last || *ptr != '{')
+    {
+        return invalid;
+    }
+
+    Vector<l, T> parsed;
+    for (size_t i = 0; i < l; ++i)
+    {
+        ptr = details::skip_space(ptr + 1, last);
+        const std::from_chars_result result =
+            details::parse_element(ptr, last, parsed[i]);
+        if (result.ec != std::errc {})
+        {
+            return result;
+        }
+        ptr = details::skip_space(result.ptr, last);
+        if (ptr == last || *ptr != (i + 1 < l ? ',' : '}'))
+        {
+            return invalid;
+        }
+    }
+    vec = parsed;
+    return {ptr + 1, std::errc {}};
+}
+
+/**
+ * @brief: Parse exactly vectors.size() whitespace separated Vectors.
+ *
+ * @return See the single Vector overload. On failure the Vectors before the
+ * offending one have been overwritten.
+ */
+template<size_t l, typename T>
+std::from_chars_result
+from_chars(const char *first, const char *last, Span<Vector<l, T>> vectors)
+{
+    std::from_chars_result result {first, std::errc {}};
+    for (Vector<l, T> &vec : vectors)
+    {
+        result = from_chars(result.ptr, last, vec);
+        if (result.ec != std::errc {})
+        {
+            return result;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief: Parse exactly batch.size() whitespace separated Vectors into the
+ * components of a batch.
+ */
+template<size_t l, typename T>
+std::from_chars_result
+from_chars(const char *first, const char *last, const BatchView<l, T> &batch)
+{
+    std::from_chars_result result {first, std::errc {}};
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        Vector<l, T> vec;
+        result = from_chars(result.ptr, last, vec);
+        if (result.ec != std::errc {})
+        {
+            return result;
+        }
+        for (size_t d = 0; d < l; ++d)
+        {
+            batch.component(d)[i] = vec[d];
+        }
+    }
+    return result;
+}
+
+} // namespace colibra
+
+#endif
@@ -0,0 +1,173 @@
+#ifndef COLIBRA_HALF_H
+#define COLIBRA_HALF_H
+
+#include "details/half.hpp"
+#include "span.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+namespace colibra {
+
+/**
+ * @brief: IEEE 754 half precision storage type.
+ *
+ * Use as element type of Vectors and Batches to halve their memory
+ * footprint. Arithmetic on single values widens to float and rounds back,
+ * batch kernels widen whole chunks at once and compute in float.
+ *
+ * This is a library type since std::float16_t needs C++23.
+ */
+using half = details::Float16<details::binary16_format>;
+
+/**
+ * @brief: bfloat16 storage type, the upper 16 bits of a float. Keeps the
+ * range of float at 8 bits of precision.
+ */
+using bfloat16 = details::Float16<details::bfloat16_format>;
+
+namespace details {
+
+template<class Format>
+void widen(const Float16<Format> *in, const size_t n, float *out)
+{
+    size_t i = 0;
+#if defined(__F16C__)
+    if constexpr (std::is_same_v<Format, binary16_format>)
+    {
+        for (; i + 8 <= n; i += 8)
+        {
+            const __m128i bits =
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+            _mm256_storeu_ps(out + i, _mm256_cvtph_ps(bits));
+        }
+    }
+#endif
+    for (; i < n; ++i)
+    {
+        out[i] = static_cast<float>(in[i]);
+    }
+}
+
+template<class Format>
+void narrow(const float *in, const size_t n, Float16<Format> *out)
+{
+    size_t i = 0;
+#if defined(__F16C__)
+    if constexpr (std::is_same_v<Format, binary16_format>)
+    {
+        for (; i + 8 <= n; i += 8)
+        {
+            const __m128i bits = _mm256_cvtps_ph(_mm256_loadu_ps(in + i),
+                                                 _MM_FROUND_TO_NEAREST_INT);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), bits);
+        }
+    }
+#endif
+    for (; i < n; ++i)
+    {
+        out[i] = Float16<Format>(in[i]);
+    }
+}
+
+inline void check_convert_size(const size_t in, const size_t out)
+{
+    if (out < in)
+    {
+        throw std::invalid_argument("colibra::convert: output too small");
+    }
+}
+
+} // namespace details
+
+/**
+ * @brief: Widen half values to float.
+ *
+ * Uses the F16C instructions when compiled with -mf16c.
+ *
+ * @throws std::invalid_argument If out is smaller than in.
+ */
+inline void convert(Span<const half> in, Span<float> out)
+{
+    details::check_convert_size(in.size(), out.size());
+    details::widen(in.data(), in.size(), out.data());
+}
+
+/**
+ * @brief: Widen bfloat16 values to float.
+ *
+ * @throws std::invalid_argument If out is smaller than in.
+ */
+inline void convert(Span<const bfloat16> in, Span<float> out)
+{
+    details::check_convert_size(in.size(), out.size());
+    details::widen(in.data(), in.size(), out.data());
+}
+
+/**
+ * @brief: Round float values to half, to nearest even.
+ *
+ * Uses the F16C instructions when compiled with -mf16c.
+ *
+ * @throws std::invalid_argument If out is smaller than in.
+ */
+inline void convert(Span<const float> in, Span<half> out)
+{
+    details::check_convert_size(in.size(), out.size());
+    details::narrow(in.data(), in.size(), out.data());
+}
+
+/**
+ * @brief: Round float values to bfloat16, to nearest even.
+ *
+ * @throws std::invalid_argument If out is smaller than in.
+ */
+inline void convert(Span<const float> in, Span<bfloat16> out)
+{
+    details::check_convert_size(in.size(), out.size());
+    details::narrow(in.data(), in.size(), out.data());
+}
+
+} // namespace colibra
+
+namespace std {
+
+/**
+ * @brief: Integers combine to the 16 bit type, floating types to the wider
+ * floating type, so Vector<3, half> * 2 stays half and Vector<3, half> * 2.0
+ * becomes double.
+ */
+template<class Format, typename S>
+struct common_type<colibra::details::Float16<Format>, S>
+    : colibra::details::float16_common<colibra::details::Float16<Format>, S>
+{
+};
+
+template<typename S, class Format>
+struct common_type<S, colibra::details::Float16<Format>>
+    : colibra::details::float16_common<colibra::details::Float16<Format>, S>
+{
+};
+
+template<class Format, class Other>
+struct common_type<colibra::details::Float16<Format>,
+                   colibra::details::Float16<Other>>
+{
+    using type = float;
+};
+
+template<class Format>
+struct common_type<colibra::details::Float16<Format>,
+                   colibra::details::Float16<Format>>
+{
+    using type = colibra::details::Float16<Format>;
+};
+
+} // namespace std
+
+#endif
@@ -0,0 +1,403 @@
+#ifndef COLIBRA_INTERPOLATION_H
+#define COLIBRA_INTERPOLATION_H
+
+#include "batch.h"
+#include "batch_ops.h"
+#include "details/batch_ops.hpp"
+#include "details/interpolation.hpp"
+#include "details/parallel.hpp"
+#include "execution.h"
+#include "quaternion.h"
+#include "span.h"
+#include "vector.h"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace colibra {
+
+/**
+ * @brief: Cubic Hermite interpolation between p0 at t == 0 and p1 at
+ * t == 1, leaving p0 with tangent m0 and arriving at p1 with tangent m1.
+ */
+template<size_t l, typename T>
+[[nodiscard]] constexpr Vector<l, T> hermite(const Vector<l, T>          &p0,
+                                             const Vector<l, T>          &m0,
+                                             const Vector<l, T>          &p1,
+                                             const Vector<l, T>          &m1,
+                                             const details::identity_t<T> t)
+{
+    static_assert(std::is_floating_point_v<T>,
+                  "colibra::hermite requires a floating point type");
+    const T t2 = t * t;
+    const T t3 = t2 * t;
+    return p0 * (T {2} * t3 - T {3} * t2 + T {1}) + m0 * (t3 - T {2} * t2 + t)
+           + p1 * (T {3} * t2 - T {2} * t3) + m1 * (t3 - t2);
+}
+
+/**
+ * @brief: Uniform Catmull-Rom interpolation between p1 at t == 0 and p2 at
+ * t == 1, the Hermite curve with tangents (p2 - p0) / 2 and (p3 - p1) / 2.
+ */
+template<size_t l, typename T>
+[[nodiscard]] constexpr Vector<l, T>
+catmull_rom(const Vector<l, T>          &p0,
+            const Vector<l, T>          &p1,
+            const Vector<l, T>          &p2,
+            const Vector<l, T>          &p3,
+            const details::identity_t<T> t)
+{
+    constexpr T half = T {1} / T {2};
+    return hermite(p1, (p2 - p0) * half, p2, (p3 - p1) * half, t);
+}
+
+/**
+ * @brief: A piecewise cubic Hermite spline through a sequence of Vectors.
+ *
+ * Control point k sits at parameter k, so the spline is defined on
+ * [0, size() - 1] and parameters outside are clamped to it. Each segment is
+ * stored as the coefficients of a cubic polynomial, one array per
+ * component, which evaluate_many reads in batches.
+ *
+ * @tparam l The size of the Vectors.
+ * @tparam T The floating point data type of the Vectors.
+ */
+template<size_t l, typename T>
+class HermiteSpline
+{
+    static_assert(std::is_floating_point_v<T>,
+                  "colibra::HermiteSpline requires a floating point type");
+
+  public:
+    HermiteSpline() = default;
+
+    /**
+     * @brief: The spline through points with the given tangents.
+     *
+     * @throws std::invalid_argument If points and tangents differ in size or
+     * there are more points than an int32_t can index.
+     */
+    HermiteSpline(Span<const Vector<l, T>> points,
+                  Span<const Vector<l, T>> tangents)
+        : m_size(points.size())
+    {
+        if (points.size() != tangents.size())
+        {
+            throw std::invalid_argument(
+                "colibra::HermiteSpline: sizes of points and tangents differ");
+        }
+        if (points.size()
+            > static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+        {
+            throw std::invalid_argument(
+                "colibra::HermiteSpline: too many points");
+        }
+        if (points.empty()) return;
+
+        // A single point is a constant segment.
+        const size_t segments = std::max<size_t>(points.size() - 1, 1);
+        for (auto &coefficients : m_coefficients)
+        {
+            coefficients.assign(4 * segments, T {0});
+        }
+        if (points.size() == 1)
+        {
+            for (size_t d = 0; d < l; ++d)
+            {
+                m_coefficients[d][0] = points[0][d];
+            }
+            return;
+        }
+        for (size_t k = 0; k < segments; ++k)
+        {
+            const Vector<l, T> &p0 = points[k];
+            const Vector<l, T> &p1 = points[k + 1];
+            const Vector<l, T> &m0 = tangents[k];
+            const Vector<l, T> &m1 = tangents[k + 1];
+            for (size_t d = 0; d < l; ++d)
+            {
+                T *c = m_coefficients[d].data() + 4 * k;
+                c[0] = p0[d];
+                c[1] = m0[d];
+                c[2] = T {3} * (p1[d] - p0[d]) - T {2} * m0[d] - m1[d];
+                c[3] = T {2} * (p0[d] - p1[d]) + m0[d] + m1[d];
+            }
+        }
+    }
+
+    /**
+     * @brief: The uniform Catmull-Rom spline through points. The end points
+     * are repeated to give the first and last segment their outer tangents.
+     *
+     * @throws std::invalid_argument If there are more points than an int32_t
+     * can index.
+     */
+    [[nodiscard]] static HermiteSpline
+    catmull_rom(Span<const Vector<l, T>> points)
+    {
+        std::vector<Vector<l, T>> tangents(points.size());
+        for (size_t k = 0; k < points.size(); ++k)
+        {
+            const size_t previous = k == 0 ? 0 : k - 1;
+            const size_t next     = std::min(k + 1, points.size() - 1);
+            tangents[k] = (points[next] - points[previous]) * (T {1} / T {2});
+        }
+        return HermiteSpline(points, tangents);
+    }
+
+    /**
+     * @brief: The number of control points.
+     */
+    [[nodiscard]] size_t size() const
+    {
+        return m_size;
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /**
+     * @brief: The number of cubic segments, one for a single control point.
+     */
+    [[nodiscard]] size_t segments() const
+    {
+        return m_coefficients[0].size() / 4;
+    }
+
+    /**
+     * @brief: Evaluate the spline at parameter s.
+     *
+     * @throws std::out_of_range If the spline is empty.
+     */
+    [[nodiscard]] Vector<l, T> operator()(const T s) const
+    {
+        if (empty())
+        {
+            throw std::out_of_range("colibra::HermiteSpline: empty spline");
+        }
+        int32_t segment = 0;
+        T       local {};
+        details::spline_locate(
+            s, static_cast<int32_t>(segments()), segment, local);
+        Vector<l, T> result;
+        for (size_t d = 0; d < l; ++d)
+        {
+            result[d] = details::horner(
+                m_coefficients[d].data() + 4 * static_cast<size_t>(segment),
+                local);
+        }
+        return result;
+    }
+
+    /**
+     * @brief: The coefficient arrays, four per segment and component, from
+     * the constant to the cubic term.
+     */
+    [[nodiscard]] std::array<const T *, l> coefficients() const
+    {
+        std::array<const T *, l> result {};
+        for (size_t d = 0; d < l; ++d)
+        {
+            result[d] = m_coefficients[d].data();
+        }
+        return result;
+    }
+
+  private:
+    std::array<std::vector<T>, l> m_coefficients;
+    size_t                        m_size = 0;
+};
+
+/**
+ * @brief: Interpolate linearly between two Vectors at many parameters,
+ * out[i] = lerp(a, b, t[i]) up to rounding, since the compiler may contract
+ * either into fused multiply-adds.
+ *
+ * @throws std::invalid_argument If out is smaller than t.
+ */
+template<class Policy,
+         size_t l,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+void lerp_many(const Policy                      &policy,
+               const Vector<l, T>                &a,
+               const Vector<l, T>                &b,
+               details::identity_t<Span<const T>> t,
+               BatchView<l, T>                    out)
+{
+    details::check_output_size(
+        t.size(), out.size(), "colibra::lerp_many: output too small");
+    details::parallel_for(policy, t.size(), [&](size_t begin, size_t end) {
+        details::blend_kernel(
+            a, b, t.data(), out, begin, end, [](const T u, T &wa, T &wb) {
+                wa = T {1} - u;
+                wb = u;
+            });
+    });
+}
+
+template<size_t l, typename T>
+void lerp_many(const Vector<l, T>                &a,
+               const Vector<l, T>                &b,
+               details::identity_t<Span<const T>> t,
+               BatchView<l, T>                    out)
+{
+    lerp_many(execution::seq, a, b, t, out);
+}
+
+/**
+ * @brief: Normalized linear interpolation between two unit quaternions at
+ * many parameters, out[i] = nlerp(a, b, t[i]).
+ *
+ * @param out Receives the coefficients w, x, y, z as components 0 to 3.
+ *
+ * @throws std::invalid_argument If out is smaller than t.
+ */
+template<class Policy,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+void nlerp_many(const Policy                      &policy,
+                const Quaternion<T>               &a,
+                const Quaternion<T>               &b,
+                details::identity_t<Span<const T>> t,
+                BatchView<4, T>                    out)
+{
+    details::check_output_size(
+        t.size(), out.size(), "colibra::nlerp_many: output too small");
+    const Quaternion<T> target = a.dot(b) < T {0} ? -b : b;
+    const T             aa     = a.dot(a);
+    const T             ab     = a.dot(target);
+    const T             bb     = target.dot(target);
+    details::parallel_for(policy, t.size(), [&](size_t begin, size_t end) {
+        details::blend_kernel(a.coefficients(),
+                              target.coefficients(),
+                              t.data(),
+                              out,
+                              begin,
+                              end,
+                              [&](const T u, T &wa, T &wb) {
+                                  // The norm of the blend follows from the
+                                  // three dot products, no second pass.
+                                  const T s      = T {1} - u;
+                                  const T length = std::sqrt(
+                                      s * s * aa + T {2} * s * u * ab
+                                      + u * u * bb);
+                                  wa = s / length;
+                                  wb = u / length;
+                              });
+    });
+}
+
+template<typename T>
+void nlerp_many(const Quaternion<T>               &a,
+                const Quaternion<T>               &b,
+                details::identity_t<Span<const T>> t,
+                BatchView<4, T>                    out)
+{
+    nlerp_many(execution::seq, a, b, t, out);
+}
+
+/**
+ * @brief: Spherical linear interpolation between two unit quaternions at
+ * many parameters, out[i] = slerp(a, b, t[i]) up to rounding.
+ *
+ * The angle between a and b is computed once. The sines of the weights use
+ * details::sin_series instead of std::sin, so the loop over parameters
+ * vectorizes. It is accurate for t in [0, 1].
+ *
+ * @param out Receives the coefficients w, x, y, z as components 0 to 3.
+ *
+ * @throws std::invalid_argument If out is smaller than t.
+ */
+template<class Policy,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+void slerp_many(const Policy                      &policy,
+                const Quaternion<T>               &a,
+                const Quaternion<T>               &b,
+                details::identity_t<Span<const T>> t,
+                BatchView<4, T>                    out)
+{
+    details::check_output_size(
+        t.size(), out.size(), "colibra::slerp_many: output too small");
+    const Quaternion<T> target = a.dot(b) < T {0} ? -b : b;
+    const T             theta =
+        T {2} * std::atan2((a - target).norm(), (a + target).norm());
+    const T sin_theta = std::sin(theta);
+    if (!(sin_theta > T {0}))
+    {
+        lerp_many(policy, a.coefficients(), target.coefficients(), t, out);
+        return;
+    }
+    const T inverse = T {1} / sin_theta;
+    details::parallel_for(policy, t.size(), [&](size_t begin, size_t end) {
+        details::blend_kernel(
+            a.coefficients(),
+            target.coefficients(),
+            t.data(),
+            out,
+            begin,
+            end,
+            [&](const T u, T &wa, T &wb) {
+                wa = details::sin_series((T {1} - u) * theta) * inverse;
+                wb = details::sin_series(u * theta) * inverse;
+            });
+    });
+}
+
+template<typename T>
+void slerp_many(const Quaternion<T>               &a,
+                const Quaternion<T>               &b,
+                details::identity_t<Span<const T>> t,
+                BatchView<4, T>                    out)
+{
+    slerp_many(execution::seq, a, b, t, out);
+}
+
+/**
+ * @brief: Evaluate a spline at many parameters, out[i] = spline(s[i]).
+ *
+ * @throws std::out_of_range If the spline is empty and s is not.
+ * @throws std::invalid_argument If out is smaller than s.
+ */
+template<class Policy,
+         size_t l,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+void evaluate_many(const Policy                      &policy,
+                   const HermiteSpline<l, T>         &spline,
+                   details::identity_t<Span<const T>> s,
+                   BatchView<l, T>                    out)
+{
+    details::check_output_size(
+        s.size(), out.size(), "colibra::evaluate_many: output too small");
+    if (spline.empty() && !s.empty())
+    {
+        throw std::out_of_range("colibra::evaluate_many: empty spline");
+    }
+    const auto    coefficients = spline.coefficients();
+    const int32_t segments     = static_cast<int32_t>(spline.segments());
+    details::parallel_for(policy, s.size(), [&](size_t begin, size_t end) {
+        details::spline_kernel(
+            coefficients, segments, s.data(), out, begin, end);
+    });
+}
+
+template<size_t l, typename T>
+void evaluate_many(const HermiteSpline<l, T>         &spline,
+                   details::identity_t<Span<const T>> s,
+                   BatchView<l, T>                    out)
+{
+    evaluate_many(execution::seq, spline, s, out);
+}
+
+} // namespace colibra
+
+#endif
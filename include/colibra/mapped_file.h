@@ -0,0 +1,233 @@
+#ifndef COLIBRA_MAPPED_FILE_H
+#define COLIBRA_MAPPED_FILE_H
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace colibra {
+
+/**
+ * @brief: RAII wrapper around a memory mapped file (POSIX).
+ *
+ * The mapping stays valid for the lifetime of this object, views created
+ * from it must not outlive it.
+ */
+class MappedFile
+{
+  public:
+    enum class Access
+    {
+        read_only,
+        read_write,
+    };
+
+    MappedFile() = default;
+
+    /**
+     * @brief: Map an existing file, read-only unless read_write access is
+     * requested.
+     *
+     * @throws std::system_error If the file can not be opened or mapped.
+     */
+    explicit MappedFile(const std::string &path,
+                        const Access       access = Access::read_only)
+    {
+        const bool writable = access == Access::read_write;
+        const int  fd =
+            ::open(path.c_str(), (writable ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+        if (fd < 0)
+        {
+            throw_errno("open " + path);
+        }
+        struct stat info {};
+        if (::fstat(fd, &info) != 0)
+        {
+            close_and_throw(fd, "stat " + path);
+        }
+        m_size = static_cast<size_t>(info.st_size);
+        map(fd, writable ? PROT_READ | PROT_WRITE : PROT_READ, path);
+    }
+
+    /**
+     * @brief: Create or truncate a file of the given size and map it for
+     * reading and writing. The content starts out zero filled.
+     *
+     * @throws std::system_error If the file can not be created or mapped.
+     */
+    [[nodiscard]] static MappedFile create(const std::string &path,
+                                           const size_t       size)
+    {
+        const int fd =
+            ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0)
+        {
+            throw_errno("open " + path);
+        }
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+        {
+            close_and_throw(fd, "truncate " + path);
+        }
+        MappedFile file;
+        file.m_size = size;
+        file.map(fd, PROT_READ | PROT_WRITE, path);
+        return file;
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    MappedFile(MappedFile &&other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr))
+        , m_size(std::exchange(other.m_size, 0))
+        , m_writable(std::exchange(other.m_writable, false))
+    {
+    }
+
+    MappedFile &operator=(MappedFile &&other) noexcept
+    {
+        if (this != &other)
+        {
+            unmap();
+            m_data     = std::exchange(other.m_data, nullptr);
+            m_size     = std::exchange(other.m_size, 0);
+            m_writable = std::exchange(other.m_writable, false);
+        }
+        return *this;
+    }
+
+    ~MappedFile()
+    {
+        unmap();
+    }
+
+    [[nodiscard]] const std::byte *data() const noexcept
+    {
+        return m_data;
+    }
+
+    /**
+     * @brief: Writable access to the mapping.
+     *
+     * @throws std::logic_error If the file was mapped read-only.
+     */
+    [[nodiscard]] std::byte *mutable_data()
+    {
+        if (!m_writable)
+        {
+            throw std::logic_error("colibra: file is mapped read-only");
+        }
+        return m_data;
+    }
+
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    [[nodiscard]] bool writable() const noexcept
+    {
+        return m_writable;
+    }
+
+    /**
+     * @brief: Pass an access pattern hint for a byte range to the kernel,
+     * e.g. MADV_WILLNEED to prefetch or MADV_DONTNEED to drop the pages
+     * from the resident set. The range is widened to page boundaries and
+     * clamped to the mapping. Hints are best effort, failures are ignored.
+     */
+    void advise(const size_t offset, size_t length, const int advice) const
+        noexcept
+    {
+        if (m_data == nullptr || offset >= m_size)
+        {
+            return;
+        }
+        length = std::min(length, m_size - offset);
+
+        static const auto page  = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        const size_t      begin = offset / page * page;
+        ::madvise(m_data + begin, offset + length - begin, advice);
+    }
+
+    /**
+     * @brief: Flush modified pages of a writable mapping to the file.
+     *
+     * @throws std::system_error If msync fails.
+     */
+    void sync() const
+    {
+        if (m_writable && m_data != nullptr
+            && ::msync(m_data, m_size, MS_SYNC) != 0)
+        {
+            throw_errno("msync");
+        }
+    }
+
+  private:
+    std::byte *m_data     = nullptr;
+    size_t     m_size     = 0;
+    bool       m_writable = false;
+
+    [[noreturn]] static void throw_errno(const std::string &what)
+    {
+        throw std::system_error(
+            errno, std::generic_category(), "colibra: " + what);
+    }
+
+    [[noreturn]] static void close_and_throw(const int          fd,
+                                             const std::string &what)
+    {
+        const int error = errno;
+        ::close(fd);
+        errno = error;
+        throw_errno(what);
+    }
+
+    /// Maps fd and closes it, the mapping keeps the file alive.
+    void map(const int fd, const int protection, const std::string &path)
+    {
+        m_writable = (protection & PROT_WRITE) != 0;
+        if (m_size == 0)
+        {
+            ::close(fd);
+            return;
+        }
+        void *data = ::mmap(nullptr, m_size, protection, MAP_SHARED, fd, 0);
+
+        const int error = errno;
+        ::close(fd);
+        if (data == MAP_FAILED)
+        {
+            errno      = error;
+            m_size     = 0;
+            m_writable = false;
+            throw_errno("mmap " + path);
+        }
+        m_data = static_cast<std::byte *>(data);
+    }
+
+    void unmap() noexcept
+    {
+        if (m_data != nullptr)
+        {
+            ::munmap(m_data, m_size);
+            m_data     = nullptr;
+            m_size     = 0;
+            m_writable = false;
+        }
+    }
+};
+
+} // namespace colibra
+
+#endif
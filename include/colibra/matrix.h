@@ -0,0 +1,403 @@
+#ifndef COLIBRA_MATRIX_H
+#define COLIBRA_MATRIX_H
+
+#include "promotion.h"
+#include "vector.h"
+
+#include <array>
+#include <ostream>
+#include <stdexcept>
+
+namespace colibra {
+
+/**
+ * @brief: A dense Matrix class that is templated in its size and data type.
+ *
+ * Elements are stored row-major in a std::array, so a Matrix is trivially
+ * copyable and never allocates. Like Vector, distinct types are generated
+ * per size, which turns dimension mismatches into compile errors.
+ *
+ * @tparam r The number of rows.
+ * @tparam c The number of columns.
+ * @tparam T The data type of this Matrix.
+ */
+template<size_t r, size_t c, typename T>
+class Matrix
+{
+    static_assert(r > 0 && c > 0, "Can not declare Matrices with 0 elements");
+
+  public:
+    /**
+     * @brief: Create a new Matrix from r * c values in row-major order. The
+     * values are converted to T.
+     */
+    template<typename... P>
+    explicit constexpr Matrix(T const val1, P const... vals)
+        : m_data {val1, static_cast<T>(vals)...}
+    {
+        static_assert(1 + sizeof...(P) == r * c,
+                      "A Matrix needs exactly rows * columns values");
+    }
+
+    /**
+     * @brief: Create a new Matrix of zeros.
+     */
+    constexpr Matrix()
+        : m_data()
+    {
+    }
+
+    /**
+     * @brief: Create a Matrix with ones on the diagonal and zeros elsewhere.
+     */
+    [[nodiscard]] static constexpr Matrix identity()
+    {
+        Matrix m;
+        for (size_t i = 0; i < r && i < c; ++i)
+        {
+            m(i, i) = T {1};
+        }
+        return m;
+    }
+
+    /**
+     * @brief: Create a Matrix from r Vectors holding its rows.
+     */
+    template<typename... Rows>
+    [[nodiscard]] static constexpr Matrix from_rows(const Rows &... rows)
+    {
+        static_assert(sizeof...(Rows) == r, "A Matrix needs exactly r rows");
+        Matrix m;
+        size_t i = 0;
+        (m.set_row(i++, rows), ...);
+        return m;
+    }
+
+    /**
+     * @brief: Create a Matrix from c Vectors holding its columns.
+     */
+    template<typename... Cols>
+    [[nodiscard]] static constexpr Matrix from_cols(const Cols &... cols)
+    {
+        static_assert(sizeof...(Cols) == c, "A Matrix needs exactly c columns");
+        Matrix m;
+        size_t j = 0;
+        (m.set_col(j++, cols), ...);
+        return m;
+    }
+
+    [[nodiscard]] static constexpr size_t rows()
+    {
+        return r;
+    }
+
+    [[nodiscard]] static constexpr size_t cols()
+    {
+        return c;
+    }
+
+    /**
+     * @brief: Access the element in row i and column j.
+     *
+     * @warning Does not perform range-checking.
+     */
+    [[nodiscard]] constexpr T &operator()(const size_t i, const size_t j)
+    {
+        return m_data[i * c + j];
+    }
+
+    /**
+     * @brief: Access the element in row i and column j.
+     *
+     * @warning Does not perform range-checking.
+     */
+    [[nodiscard]] constexpr T const &operator()(const size_t i,
+                                                const size_t j) const
+    {
+        return m_data[i * c + j];
+    }
+
+    /**
+     * @brief: Access the element in row i and column j with range checking.
+     *
+     * @throws std::out_of_range When accessing elements out of range.
+     */
+    [[nodiscard]] constexpr T &at(const size_t i, const size_t j)
+    {
+        check_range(i, j);
+        return m_data[i * c + j];
+    }
+
+    /**
+     * @brief: Access the element in row i and column j with range checking.
+     *
+     * @throws std::out_of_range When accessing elements out of range.
+     */
+    [[nodiscard]] constexpr T const &at(const size_t i, const size_t j) const
+    {
+        check_range(i, j);
+        return m_data[i * c + j];
+    }
+
+    /**
+     * @brief: Copy row i into a Vector.
+     */
+    [[nodiscard]] constexpr Vector<c, T> row(const size_t i) const
+    {
+        Vector<c, T> vec;
+        for (size_t j = 0; j < c; ++j)
+        {
+            vec[j] = (*this)(i, j);
+        }
+        return vec;
+    }
+
+    /**
+     * @brief: Copy column j into a Vector.
+     */
+    [[nodiscard]] constexpr Vector<r, T> col(const size_t j) const
+    {
+        Vector<r, T> vec;
+        for (size_t i = 0; i < r; ++i)
+        {
+            vec[i] = (*this)(i, j);
+        }
+        return vec;
+    }
+
+    constexpr void set_row(const size_t i, const Vector<c, T> &vec)
+    {
+        for (size_t j = 0; j < c; ++j)
+        {
+            (*this)(i, j) = vec[j];
+        }
+    }
+
+    constexpr void set_col(const size_t j, const Vector<r, T> &vec)
+    {
+        for (size_t i = 0; i < r; ++i)
+        {
+            (*this)(i, j) = vec[i];
+        }
+    }
+
+    [[nodiscard]] constexpr Matrix<c, r, T> transpose() const
+    {
+        Matrix<c, r, T> m;
+        for (size_t i = 0; i < r; ++i)
+        {
+            for (size_t j = 0; j < c; ++j)
+            {
+                m(j, i) = (*this)(i, j);
+            }
+        }
+        return m;
+    }
+
+    /**
+     * @brief: Sum of the diagonal of a square Matrix.
+     */
+    [[nodiscard]] constexpr T trace() const
+    {
+        static_assert(r == c, "The trace is only defined for square matrices");
+        T sum {};
+        for (size_t i = 0; i < r; ++i)
+        {
+            sum += (*this)(i, i);
+        }
+        return sum;
+    }
+
+    /**
+     * @brief: Matrix product.
+     *
+     * The element type of the result follows the default promotion policy,
+     * see promotion.h.
+     */
+    template<size_t k, class S, typename R = promoted_t<T, S>>
+    [[nodiscard]] constexpr Matrix<r, k, R>
+    operator*(const Matrix<c, k, S> &other) const
+    {
+        Matrix<r, k, R> m;
+        for (size_t i = 0; i < r; ++i)
+        {
+            for (size_t p = 0; p < c; ++p)
+            {
+                const R a = static_cast<R>((*this)(i, p));
+                for (size_t j = 0; j < k; ++j)
+                {
+                    m(i, j) += a * static_cast<R>(other(p, j));
+                }
+            }
+        }
+        return m;
+    }
+
+    /**
+     * @brief: Multiply this Matrix with a column Vector.
+     *
+     * The element type of the result follows the default promotion policy,
+     * see promotion.h.
+     */
+    template<class S, typename R = promoted_t<T, S>>
+    [[nodiscard]] constexpr Vector<r, R>
+    operator*(const Vector<c, S> &vec) const
+    {
+        Vector<r, R> out;
+        for (size_t i = 0; i < r; ++i)
+        {
+            R sum {};
+            for (size_t j = 0; j < c; ++j)
+            {
+                sum += static_cast<R>((*this)(i, j)) * static_cast<R>(vec[j]);
+            }
+            out[i] = sum;
+        }
+        return out;
+    }
+
+    /**
+     * @brief: Multiply this Matrix with a scalar.
+     *
+     * The element type of the result follows the default promotion policy,
+     * see promotion.h.
+     */
+    template<class S, typename R = promoted_t<T, S>>
+    [[nodiscard]] constexpr Matrix<r, c, R> operator*(const S &scalar) const
+    {
+        Matrix<r, c, R> m;
+        for (size_t n = 0; n < r * c; ++n)
+        {
+            m.m_data[n] = static_cast<R>(m_data[n]) * static_cast<R>(scalar);
+        }
+        return m;
+    }
+
+    /**
+     * @brief: Matrix addition.
+     *
+     * The element type of the result follows the default promotion policy,
+     * see promotion.h.
+     */
+    template<class S, typename R = promoted_t<T, S>>
+    [[nodiscard]] constexpr Matrix<r, c, R>
+    operator+(const Matrix<r, c, S> &other) const
+    {
+        Matrix<r, c, R> m;
+        for (size_t n = 0; n < r * c; ++n)
+        {
+            m.m_data[n] =
+                static_cast<R>(m_data[n]) + static_cast<R>(other.m_data[n]);
+        }
+        return m;
+    }
+
+    /**
+     * @brief: Matrix subtraction.
+     *
+     * The element type of the result follows the default promotion policy,
+     * see promotion.h.
+     */
+    template<class S, typename R = promoted_t<T, S>>
+    [[nodiscard]] constexpr Matrix<r, c, R>
+    operator-(const Matrix<r, c, S> &other) const
+    {
+        Matrix<r, c, R> m;
+        for (size_t n = 0; n < r * c; ++n)
+        {
+            m.m_data[n] =
+                static_cast<R>(m_data[n]) - static_cast<R>(other.m_data[n]);
+        }
+        return m;
+    }
+
+    /**
+     * @brief: Negate this Matrix.
+     */
+    [[nodiscard]] constexpr Matrix operator-() const
+    {
+        Matrix m;
+        for (size_t n = 0; n < r * c; ++n)
+        {
+            m.m_data[n] = -m_data[n];
+        }
+        return m;
+    }
+
+    /**
+     * @brief: Comparison operator.
+     *
+     * @return True if Matrices are identical, false otherwise.
+     */
+    [[nodiscard]] constexpr bool operator==(const Matrix &other) const
+    {
+        for (size_t n = 0; n < r * c; ++n)
+        {
+            if (!(m_data[n] == other.m_data[n]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief: Inverted comparison operator.
+     *
+     * @return True if Matrices are different, false otherwise.
+     */
+    [[nodiscard]] constexpr bool operator!=(const Matrix &other) const
+    {
+        return !(*this == other);
+    }
+
+    /**
+     * @brief: Get a ptr to the row-major elements of this Matrix.
+     */
+    [[nodiscard]] constexpr const T *data() const
+    {
+        return m_data.data();
+    }
+
+    [[nodiscard]] constexpr T *data()
+    {
+        return m_data.data();
+    }
+
+    /**
+     * @brief: Ostream operator to pretty print Matrices row by row, e.g.
+     * "{ { 1, 2 }, { 3, 4 } }".
+     */
+    friend std::ostream &operator<<(std::ostream &os, const Matrix &m)
+    {
+        os << "{ ";
+        for (size_t i = 0; i < r; ++i)
+        {
+            os << (i > 0 ? ", { " : "{ ");
+            for (size_t j = 0; j < c; ++j)
+            {
+                os << (j > 0 ? ", " : "") << m(i, j);
+            }
+            os << " }";
+        }
+        return os << " }";
+    }
+
+  private:
+    template<size_t, size_t, typename>
+    friend class Matrix;
+
+    std::array<T, r * c> m_data;
+
+    constexpr void check_range(const size_t i, const size_t j) const
+    {
+        if (i >= r || j >= c)
+        {
+            throw std::out_of_range("colibra::Matrix::at out of range");
+        }
+    }
+};
+
+} // namespace colibra
+
+#endif
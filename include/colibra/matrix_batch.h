@@ -0,0 +1,219 @@
+#ifndef COLIBRA_MATRIX_BATCH_H
+#define COLIBRA_MATRIX_BATCH_H
+
+#include "batch.h"
+#include "matrix.h"
+
+#include <stdexcept>
+#include <type_traits>
+
+namespace colibra {
+
+/**
+ * @brief: A non-owning structure-of-arrays view onto a batch of Matrices.
+ *
+ * Element (i, j) of the Matrix with index k lives at element(i, j)[k], so
+ * the same element of consecutive Matrices maps to consecutive SIMD lanes.
+ * This is a BatchView of r * c components in row-major order.
+ *
+ * @tparam T The data type of the Matrices, const qualified for read-only
+ * views.
+ */
+template<size_t r, size_t c, typename T>
+class MatrixBatchView
+{
+    using value_type_ = std::remove_const_t<T>;
+
+  public:
+    constexpr MatrixBatchView() = default;
+
+    constexpr explicit MatrixBatchView(const BatchView<r * c, T> &elements)
+        : m_elements(elements)
+    {
+    }
+
+    /**
+     * @brief: Allow implicit conversion from mutable to read-only views.
+     */
+    template<typename U,
+             typename = std::enable_if_t<!std::is_same_v<U, T>
+                                         && std::is_convertible_v<U *, T *>>>
+    constexpr MatrixBatchView(const MatrixBatchView<r, c, U> &other)
+        : m_elements(other.elements())
+    {
+    }
+
+    [[nodiscard]] constexpr size_t size() const
+    {
+        return m_elements.size();
+    }
+
+    [[nodiscard]] constexpr bool empty() const
+    {
+        return m_elements.empty();
+    }
+
+    /**
+     * @brief: Get the contiguous array holding element (i, j) of all
+     * Matrices.
+     */
+    [[nodiscard]] constexpr T *element(const size_t i, const size_t j) const
+    {
+        return m_elements.component(i * c + j);
+    }
+
+    /**
+     * @brief: Gather the Matrix with the given index.
+     *
+     * @warning Does not perform range-checking.
+     */
+    [[nodiscard]] constexpr Matrix<r, c, value_type_>
+    operator[](const size_t k) const
+    {
+        Matrix<r, c, value_type_> m;
+        for (size_t n = 0; n < r * c; ++n)
+        {
+            m.data()[n] = m_elements.component(n)[k];
+        }
+        return m;
+    }
+
+    /**
+     * @brief: Create a view onto count Matrices starting at offset.
+     *
+     * @throws std::out_of_range When the requested range exceeds this view.
+     */
+    [[nodiscard]] constexpr MatrixBatchView subview(const size_t offset,
+                                                    const size_t count) const
+    {
+        return MatrixBatchView(m_elements.subview(offset, count));
+    }
+
+    /**
+     * @brief: The underlying view with one component per element.
+     */
+    [[nodiscard]] constexpr const BatchView<r * c, T> &elements() const
+    {
+        return m_elements;
+    }
+
+  private:
+    BatchView<r * c, T> m_elements;
+};
+
+/**
+ * @brief: An owning structure-of-arrays container of Matrices, see
+ * MatrixBatchView for the layout.
+ */
+template<size_t r, size_t c, typename T>
+class MatrixBatch
+{
+  public:
+    MatrixBatch() = default;
+
+    /**
+     * @brief: Create a batch of size zero Matrices.
+     */
+    explicit MatrixBatch(const size_t size)
+        : m_elements(size)
+    {
+    }
+
+    /**
+     * @brief: Transpose an array of Matrices into a new batch.
+     */
+    explicit MatrixBatch(Span<const Matrix<r, c, T>> matrices)
+        : m_elements(matrices.size())
+    {
+        for (size_t k = 0; k < matrices.size(); ++k)
+        {
+            set(k, matrices[k]);
+        }
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return m_elements.size();
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return m_elements.empty();
+    }
+
+    void reserve(const size_t capacity)
+    {
+        m_elements.reserve(capacity);
+    }
+
+    void resize(const size_t size)
+    {
+        m_elements.resize(size);
+    }
+
+    void clear()
+    {
+        m_elements.clear();
+    }
+
+    void push_back(const Matrix<r, c, T> &m)
+    {
+        m_elements.resize(size() + 1);
+        set(size() - 1, m);
+    }
+
+    /**
+     * @brief: Scatter m into the slot with the given index.
+     *
+     * @warning Does not perform range-checking.
+     */
+    void set(const size_t k, const Matrix<r, c, T> &m)
+    {
+        for (size_t n = 0; n < r * c; ++n)
+        {
+            m_elements.component(n)[k] = m.data()[n];
+        }
+    }
+
+    /**
+     * @brief: Gather the Matrix with the given index.
+     *
+     * @warning Does not perform range-checking.
+     */
+    [[nodiscard]] Matrix<r, c, T> operator[](const size_t k) const
+    {
+        return view()[k];
+    }
+
+    [[nodiscard]] T *element(const size_t i, const size_t j)
+    {
+        return m_elements.component(i * c + j);
+    }
+
+    [[nodiscard]] const T *element(const size_t i, const size_t j) const
+    {
+        return m_elements.component(i * c + j);
+    }
+
+    [[nodiscard]] MatrixBatchView<r, c, T> view()
+    {
+        return MatrixBatchView<r, c, T>(m_elements.view());
+    }
+
+    [[nodiscard]] MatrixBatchView<r, c, const T> view() const
+    {
+        return MatrixBatchView<r, c, const T>(m_elements.view());
+    }
+
+    operator MatrixBatchView<r, c, const T>() const
+    {
+        return view();
+    }
+
+  private:
+    Batch<r * c, T> m_elements;
+};
+
+} // namespace colibra
+
+#endif
@@ -0,0 +1,225 @@
+#ifndef COLIBRA_MATRIX_BATCH_OPS_H
+#define COLIBRA_MATRIX_BATCH_OPS_H
+
+#include "batch.h"
+#include "batch_ops.h"
+#include "details/matrix_batch_ops.hpp"
+#include "execution.h"
+#include "matrix_batch.h"
+
+namespace colibra {
+
+/**
+ * @brief: Solve many small linear systems a[k] * x[k] = b[k] at once.
+ *
+ * Uses Gaussian elimination with partial pivoting. Each SIMD lane works on
+ * a different system, and pivoting is done with per-lane selects instead of
+ * branches, so a batch of 3x3 float systems runs 8 per AVX register.
+ * Singular systems produce non-finite solutions without affecting the
+ * other instances.
+ *
+ * @param policy execution::seq or execution::par.
+ * @param a The coefficient matrices.
+ * @param b The right-hand sides, one per matrix.
+ * @param x Receives the solutions, may alias b.
+ *
+ * @throws std::invalid_argument If b differs in size from a or x is too
+ * small.
+ */
+template<class Policy,
+         size_t n,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+void solve_many(const Policy &                                      policy,
+                details::identity_t<MatrixBatchView<n, n, const T>> a,
+                details::identity_t<BatchView<n, const T>>          b,
+                BatchView<n, T>                                     x)
+{
+    details::solve_many(
+        policy,
+        a,
+        b,
+        x,
+        [](auto &tile) { details::lu_solve_tile(tile); },
+        "colibra::solve_many: size mismatch");
+}
+
+template<size_t n, typename T>
+void solve_many(details::identity_t<MatrixBatchView<n, n, const T>> a,
+                details::identity_t<BatchView<n, const T>>          b,
+                BatchView<n, T>                                     x)
+{
+    solve_many(execution::seq, a, b, x);
+}
+
+/**
+ * @brief: Solve many small symmetric positive definite systems
+ * a[k] * x[k] = b[k] at once using Cholesky factorization.
+ *
+ * About twice as fast as solve_many. Only the lower triangles of a are
+ * read. Systems that are not positive definite produce NaN solutions.
+ *
+ * @throws std::invalid_argument If b differs in size from a or x is too
+ * small.
+ */
+template<class Policy,
+         size_t n,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+void cholesky_solve_many(
+    const Policy &                                       policy,
+    details::identity_t<MatrixBatchView<n, n, const T>> a,
+    details::identity_t<BatchView<n, const T>>          b,
+    BatchView<n, T>                                     x)
+{
+    details::solve_many(
+        policy,
+        a,
+        b,
+        x,
+        [](auto &tile) { details::cholesky_solve_tile(tile); },
+        "colibra::cholesky_solve_many: size mismatch");
+}
+
+template<size_t n, typename T>
+void cholesky_solve_many(
+    details::identity_t<MatrixBatchView<n, n, const T>> a,
+    details::identity_t<BatchView<n, const T>>          b,
+    BatchView<n, T>                                     x)
+{
+    cholesky_solve_many(execution::seq, a, b, x);
+}
+
+/**
+ * @brief: Invert many small square matrices at once.
+ *
+ * Each SIMD lane works on a different instance, so eight 3x3 float
+ * inverses run in one AVX register. Up to 3x3 the adjugate is used, larger
+ * matrices are inverted by Gauss-Jordan elimination with branch free
+ * partial pivoting. Singular matrices produce non-finite elements without
+ * affecting the other instances.
+ *
+ * @param policy execution::seq or execution::par.
+ * @param a The matrices to invert.
+ * @param out Receives the inverses, may alias a.
+ *
+ * @throws std::invalid_argument If out is smaller than a.
+ */
+template<class Policy,
+         size_t n,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+void inverse_many(const Policy &                                      policy,
+                  details::identity_t<MatrixBatchView<n, n, const T>> a,
+                  MatrixBatchView<n, n, T>                            out)
+{
+    details::inverse_many(policy, a, out);
+}
+
+template<size_t n, typename T>
+void inverse_many(details::identity_t<MatrixBatchView<n, n, const T>> a,
+                  MatrixBatchView<n, n, T>                            out)
+{
+    inverse_many(execution::seq, a, out);
+}
+
+/**
+ * @brief: Compute the determinants of many small square matrices at once.
+ *
+ * @throws std::invalid_argument If out is smaller than a.
+ */
+template<class Policy,
+         size_t n,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+void determinant_many(const Policy &                        policy,
+                      const MatrixBatchView<n, n, const T> &a,
+                      details::identity_t<Span<T>>          out)
+{
+    details::determinant_many(policy, a, out);
+}
+
+template<class Policy,
+         size_t n,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+void determinant_many(const Policy &               policy,
+                      const MatrixBatch<n, n, T> & a,
+                      details::identity_t<Span<T>> out)
+{
+    details::determinant_many(policy, a.view(), out);
+}
+
+template<size_t n, typename T>
+void determinant_many(const MatrixBatchView<n, n, const T> &a,
+                      details::identity_t<Span<T>>          out)
+{
+    determinant_many(execution::seq, a, out);
+}
+
+template<size_t n, typename T>
+void determinant_many(const MatrixBatch<n, n, T> & a,
+                      details::identity_t<Span<T>> out)
+{
+    determinant_many(execution::seq, a, out);
+}
+
+/**
+ * @brief: Multiply many pairs of small square matrices at once, computing
+ * out[k] = a[k] * b[k].
+ *
+ * @throws std::invalid_argument If b differs in size from a or out is too
+ * small.
+ */
+template<class Policy,
+         size_t n,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+void multiply_many(const Policy &                                      policy,
+                   details::identity_t<MatrixBatchView<n, n, const T>> a,
+                   details::identity_t<MatrixBatchView<n, n, const T>> b,
+                   MatrixBatchView<n, n, T>                            out)
+{
+    details::multiply_many(policy, a, b, out);
+}
+
+template<size_t n, typename T>
+void multiply_many(details::identity_t<MatrixBatchView<n, n, const T>> a,
+                   details::identity_t<MatrixBatchView<n, n, const T>> b,
+                   MatrixBatchView<n, n, T>                            out)
+{
+    multiply_many(execution::seq, a, b, out);
+}
+
+/**
+ * @brief: Multiply many small square matrices with one Vector each,
+ * computing out[k] = a[k] * v[k].
+ *
+ * @param out Receives the transformed Vectors, may alias v.
+ *
+ * @throws std::invalid_argument If v differs in size from a or out is too
+ * small.
+ */
+template<class Policy,
+         size_t n,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+void transform_many(const Policy &                                      policy,
+                    details::identity_t<MatrixBatchView<n, n, const T>> a,
+                    details::identity_t<BatchView<n, const T>>          v,
+                    BatchView<n, T>                                     out)
+{
+    details::transform_many(policy, a, v, out);
+}
+
+template<size_t n, typename T>
+void transform_many(details::identity_t<MatrixBatchView<n, n, const T>> a,
+                    details::identity_t<BatchView<n, const T>>          v,
+                    BatchView<n, T>                                     out)
+{
+    transform_many(execution::seq, a, v, out);
+}
+
+} // namespace colibra
+
+#endif
@@ -0,0 +1,411 @@
+#ifndef COLIBRA_NEAREST_H
+#define COLIBRA_NEAREST_H
+
+#include "batch.h"
+#include "details/nearest.hpp"
+#include "span.h"
+#include "vector.h"
+
+#include <array>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace colibra {
+
+/**
+ * @brief: Nearest neighbor search by scanning all points.
+ *
+ * The points are kept in structure-of-arrays layout and the distances are
+ * computed with the vectorized batch kernel in blocks on the stack, so
+ * queries only allocate for their results. For small sets this beats any
+ * tree, see bench/bench_nearest.cpp for the crossover point.
+ *
+ * @tparam l The size of the Vectors.
+ * @tparam T The data type of the Vectors.
+ */
+template<size_t l, typename T>
+class BruteForceIndex
+{
+  public:
+    using distance_type = details::norm_type_t<T>;
+    using neighbor_type = Neighbor<distance_type>;
+
+    BruteForceIndex() = default;
+
+    /**
+     * @brief: Build the index from the given points. Neighbor indices refer
+     * to positions in this span.
+     */
+    explicit BruteForceIndex(Span<const Vector<l, T>> points)
+        : m_points(points)
+    {
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return m_points.size();
+    }
+
+    /**
+     * @brief: Find the point closest to query.
+     *
+     * @throws std::out_of_range If the index is empty.
+     */
+    [[nodiscard]] neighbor_type nearest(const Vector<l, T> &query) const
+    {
+        std::vector<neighbor_type> result;
+        knn(query, 1, result);
+        if (result.empty())
+        {
+            throw std::out_of_range("colibra::BruteForceIndex is empty");
+        }
+        return result.front();
+    }
+
+    /**
+     * @brief: Find the k points closest to query, sorted by ascending
+     * distance. Fewer are returned if the index holds less than k points.
+     *
+     * @param out Receives the neighbors, its capacity is reused.
+     */
+    void knn(const Vector<l, T> &        query,
+             const size_t                k,
+             std::vector<neighbor_type> &out) const
+    {
+        details::KnnHeap<distance_type> heap(k, out);
+        scan(query, [&heap](size_t index, distance_type distance) {
+            heap.push(index, distance);
+        });
+        heap.finish();
+    }
+
+    [[nodiscard]] std::vector<neighbor_type> knn(const Vector<l, T> &query,
+                                                 const size_t        k) const
+    {
+        std::vector<neighbor_type> out;
+        knn(query, k, out);
+        return out;
+    }
+
+    /**
+     * @brief: Find all points within radius of query, sorted by ascending
+     * distance.
+     *
+     * @param out Receives the neighbors, its capacity is reused.
+     */
+    void radius(const Vector<l, T> &        query,
+                const distance_type         radius,
+                std::vector<neighbor_type> &out) const
+    {
+        const distance_type bound = radius * radius;
+        out.clear();
+        scan(query, [&out, bound](size_t index, distance_type distance) {
+            if (distance <= bound)
+            {
+                out.push_back({index, distance});
+            }
+        });
+        std::sort(out.begin(), out.end());
+    }
+
+    [[nodiscard]] std::vector<neighbor_type>
+    radius(const Vector<l, T> &query, const distance_type radius) const
+    {
+        std::vector<neighbor_type> out;
+        this->radius(query, radius, out);
+        return out;
+    }
+
+  private:
+    /// Number of distances computed per kernel call, kept on the stack.
+    static constexpr size_t block_size = 256;
+
+    Batch<l, T> m_points;
+
+    /// Call visit with the index and squared distance of every point.
+    template<class Visit>
+    void scan(const Vector<l, T> &query, const Visit &visit) const
+    {
+        std::array<distance_type, block_size> distances;
+        for (size_t begin = 0; begin < m_points.size(); begin += block_size)
+        {
+            const size_t end = std::min(begin + block_size, m_points.size());
+            details::squared_distances(query,
+                                       details::make_points(m_points.view()),
+                                       begin,
+                                       end,
+                                       distances.data());
+            for (size_t i = begin; i < end; ++i)
+            {
+                visit(i, distances[i - begin]);
+            }
+        }
+    }
+};
+
+/**
+ * @brief: A k-d tree for nearest neighbor and radius queries.
+ *
+ * The tree is built once from a set of points by splitting at the median of
+ * the dimension with the largest spread. Points are then stored leaf by leaf
+ * in structure-of-arrays layout, so each visited leaf is scanned with the
+ * same vectorized kernel BruteForceIndex uses.
+ *
+ * Queries are const and may run concurrently.
+ *
+ * @tparam l The size of the Vectors.
+ * @tparam T The data type of the Vectors.
+ */
+template<size_t l, typename T>
+class KdTree
+{
+  public:
+    using distance_type = details::norm_type_t<T>;
+    using neighbor_type = Neighbor<distance_type>;
+
+    /// Largest supported number of points per leaf.
+    static constexpr size_t max_leaf_size = 64;
+
+    KdTree() = default;
+
+    /**
+     * @brief: Build the tree from the given points. Neighbor indices refer to
+     * positions in this span.
+     *
+     * @param leaf_size Maximum number of points stored in one leaf.
+     *
+     * @throws std::invalid_argument If leaf_size is 0 or above max_leaf_size.
+     */
+    explicit KdTree(Span<const Vector<l, T>> points,
+                    const size_t             leaf_size = 16)
+        : m_leaf_size(leaf_size)
+    {
+        if (leaf_size == 0 || leaf_size > max_leaf_size)
+        {
+            throw std::invalid_argument("colibra::KdTree: invalid leaf size");
+        }
+
+        m_indices.resize(points.size());
+        std::iota(m_indices.begin(), m_indices.end(), size_t {0});
+        if (!points.empty())
+        {
+            m_nodes.reserve(2 * (points.size() / leaf_size + 1));
+            build(points, 0, points.size());
+        }
+
+        m_points.resize(points.size());
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            m_points.set(i, points[m_indices[i]]);
+        }
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return m_indices.size();
+    }
+
+    /**
+     * @brief: Find the point closest to query.
+     *
+     * @throws std::out_of_range If the tree is empty.
+     */
+    [[nodiscard]] neighbor_type nearest(const Vector<l, T> &query) const
+    {
+        if (m_nodes.empty())
+        {
+            throw std::out_of_range("colibra::KdTree is empty");
+        }
+        neighbor_type best {0, std::numeric_limits<distance_type>::infinity()};
+        search(
+            0,
+            query,
+            [&best] { return best.distance_squared; },
+            [&best](size_t index, distance_type distance) {
+                const neighbor_type candidate {index, distance};
+                if (candidate < best)
+                {
+                    best = candidate;
+                }
+            });
+        return best;
+    }
+
+    /**
+     * @brief: Find the k points closest to query, sorted by ascending
+     * distance. Fewer are returned if the tree holds less than k points.
+     *
+     * @param out Receives the neighbors, its capacity is reused.
+     */
+    void knn(const Vector<l, T> &        query,
+             const size_t                k,
+             std::vector<neighbor_type> &out) const
+    {
+        details::KnnHeap<distance_type> heap(k, out);
+        if (!m_nodes.empty() && k > 0)
+        {
+            search(
+                0,
+                query,
+                [&heap] { return heap.bound(); },
+                [&heap](size_t index, distance_type distance) {
+                    heap.push(index, distance);
+                });
+        }
+        heap.finish();
+    }
+
+    [[nodiscard]] std::vector<neighbor_type> knn(const Vector<l, T> &query,
+                                                 const size_t        k) const
+    {
+        std::vector<neighbor_type> out;
+        knn(query, k, out);
+        return out;
+    }
+
+    /**
+     * @brief: Find all points within radius of query, sorted by ascending
+     * distance.
+     *
+     * @param out Receives the neighbors, its capacity is reused.
+     */
+    void radius(const Vector<l, T> &        query,
+                const distance_type         radius,
+                std::vector<neighbor_type> &out) const
+    {
+        out.clear();
+        if (m_nodes.empty())
+        {
+            return;
+        }
+        // Comparing with <= on the bound keeps points exactly on the sphere.
+        const distance_type bound = radius * radius;
+        search(
+            0,
+            query,
+            [bound] { return bound; },
+            [&out, bound](size_t index, distance_type distance) {
+                if (distance <= bound)
+                {
+                    out.push_back({index, distance});
+                }
+            });
+        std::sort(out.begin(), out.end());
+    }
+
+    [[nodiscard]] std::vector<neighbor_type>
+    radius(const Vector<l, T> &query, const distance_type radius) const
+    {
+        std::vector<neighbor_type> out;
+        this->radius(query, radius, out);
+        return out;
+    }
+
+  private:
+    static constexpr size_t no_child = std::numeric_limits<size_t>::max();
+
+    struct Node
+    {
+        size_t begin;
+        size_t end;
+        size_t left  = no_child;
+        size_t right = no_child;
+        size_t dim   = 0;
+        T      split {};
+    };
+
+    size_t              m_leaf_size = 16;
+    std::vector<Node>   m_nodes;
+    std::vector<size_t> m_indices;
+    Batch<l, T>         m_points;
+
+    size_t build(Span<const Vector<l, T>> points,
+                 const size_t             begin,
+                 const size_t             end)
+    {
+        const size_t node = m_nodes.size();
+        m_nodes.push_back(Node {begin, end});
+        if (end - begin <= m_leaf_size)
+        {
+            return node;
+        }
+
+        std::array<T, l> lower {};
+        std::array<T, l> upper {};
+        for (size_t d = 0; d < l; ++d)
+        {
+            lower[d] = upper[d] = points[m_indices[begin]][d];
+        }
+        for (size_t i = begin + 1; i < end; ++i)
+        {
+            for (size_t d = 0; d < l; ++d)
+            {
+                lower[d] = std::min(lower[d], points[m_indices[i]][d]);
+                upper[d] = std::max(upper[d], points[m_indices[i]][d]);
+            }
+        }
+        size_t dim = 0;
+        for (size_t d = 1; d < l; ++d)
+        {
+            if (upper[d] - lower[d] > upper[dim] - lower[dim])
+            {
+                dim = d;
+            }
+        }
+
+        const size_t mid = begin + (end - begin) / 2;
+        std::nth_element(m_indices.begin() + begin,
+                         m_indices.begin() + mid,
+                         m_indices.begin() + end,
+                         [&points, dim](size_t a, size_t b) {
+                             return points[a][dim] < points[b][dim];
+                         });
+
+        m_nodes[node].dim   = dim;
+        m_nodes[node].split = points[m_indices[mid]][dim];
+        const size_t left   = build(points, begin, mid);
+        const size_t right  = build(points, mid, end);
+        m_nodes[node].left  = left;
+        m_nodes[node].right = right;
+        return node;
+    }
+
+    template<class Bound, class Visit>
+    void search(const size_t        node_index,
+                const Vector<l, T> &query,
+                const Bound &       bound,
+                const Visit &       visit) const
+    {
+        const Node &node = m_nodes[node_index];
+        if (node.left == no_child)
+        {
+            std::array<distance_type, max_leaf_size> distances;
+            details::squared_distances(query,
+                                       details::make_points(m_points.view()),
+                                       node.begin,
+                                       node.end,
+                                       distances.data());
+            for (size_t i = node.begin; i < node.end; ++i)
+            {
+                visit(m_indices[i], distances[i - node.begin]);
+            }
+            return;
+        }
+
+        const distance_type offset =
+            static_cast<distance_type>(query[node.dim]) - node.split;
+        const size_t near = offset < 0 ? node.left : node.right;
+        const size_t far  = offset < 0 ? node.right : node.left;
+
+        search(near, query, bound, visit);
+        if (offset * offset <= bound())
+        {
+            search(far, query, bound, visit);
+        }
+    }
+};
+
+} // namespace colibra
+
+#endif
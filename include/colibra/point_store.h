@@ -0,0 +1,515 @@
+#ifndef COLIBRA_POINT_STORE_H
+#define COLIBRA_POINT_STORE_H
+
+#include "batch.h"
+#include "batch_ops.h"
+#include "details/parallel.hpp"
+#include "details/point_store.hpp"
+#include "execution.h"
+#include "mapped_file.h"
+#include "serialize.h"
+#include "span.h"
+#include "vector.h"
+
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace colibra {
+
+/**
+ * @brief: A point cloud of Vectors living in a memory mapped colibra binary
+ * file, in either array-of-structures or structure-of-arrays layout.
+ *
+ * Only the pages that are touched are loaded, so stores may be far larger
+ * than the available memory. The algorithms below (bounding_box, centroid,
+ * transform, for_each_chunk) stream through the store chunk by chunk and
+ * release each chunk after use, keeping the resident memory bounded.
+ */
+template<size_t l, typename T>
+class PointStore
+{
+  public:
+    /// Points processed per chunk by the streaming algorithms.
+    static constexpr size_t default_chunk_size = details::stream_chunk_size;
+
+    /**
+     * @brief: Open an existing file written by write_binary or create.
+     *
+     * @throws std::system_error If the file can not be opened or mapped.
+     * @throws FormatError If the file does not hold Vector<l, T>.
+     */
+    explicit PointStore(
+        const std::string &      path,
+        const MappedFile::Access access = MappedFile::Access::read_only)
+        : m_file(path, access)
+    {
+        const Layout layout = read_header(m_file).layout;
+        m_header            = details::check_header<l, T>(m_file, layout);
+        m_file.advise(0, m_file.size(), MADV_SEQUENTIAL);
+    }
+
+    /**
+     * @brief: Create a writable store of count zero-initialized Vectors,
+     * replacing any existing file.
+     *
+     * @throws std::system_error If the file can not be created or mapped.
+     */
+    [[nodiscard]] static PointStore create(const std::string &path,
+                                           const Layout       layout,
+                                           const size_t       count)
+    {
+        const FileHeader header = make_header<l, T>(layout, count);
+        MappedFile       file   = MappedFile::create(
+            path, header.data_offset + payload_size(header));
+        std::memcpy(file.mutable_data(), &header, sizeof(header));
+        return PointStore(std::move(file), header);
+    }
+
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return m_header.count;
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return m_header.count == 0;
+    }
+
+    [[nodiscard]] Layout layout() const noexcept
+    {
+        return m_header.layout;
+    }
+
+    [[nodiscard]] bool writable() const noexcept
+    {
+        return m_file.writable();
+    }
+
+    /**
+     * @brief: Gather the Vector with the given index.
+     *
+     * @warning Does not perform range-checking.
+     */
+    [[nodiscard]] Vector<l, T> operator[](const size_t i) const
+    {
+        return visit([i](const auto &points) { return points[i]; });
+    }
+
+    /**
+     * @brief: View an array-of-structures store.
+     *
+     * @throws std::logic_error If the store has structure-of-arrays layout.
+     */
+    [[nodiscard]] Span<const Vector<l, T>> vectors() const
+    {
+        check_layout(Layout::array_of_structures);
+        return Span<const Vector<l, T>>(
+            reinterpret_cast<const Vector<l, T> *>(payload()), size());
+    }
+
+    /**
+     * @throws std::logic_error If the store has structure-of-arrays layout
+     * or was opened read-only.
+     */
+    [[nodiscard]] Span<Vector<l, T>> vectors()
+    {
+        check_layout(Layout::array_of_structures);
+        return Span<Vector<l, T>>(
+            reinterpret_cast<Vector<l, T> *>(mutable_payload()), size());
+    }
+
+    /**
+     * @brief: View a structure-of-arrays store.
+     *
+     * @throws std::logic_error If the store has array-of-structures layout.
+     */
+    [[nodiscard]] BatchView<l, const T> batch() const
+    {
+        check_layout(Layout::structure_of_arrays);
+        return make_batch<const T>(payload());
+    }
+
+    /**
+     * @throws std::logic_error If the store has array-of-structures layout
+     * or was opened read-only.
+     */
+    [[nodiscard]] BatchView<l, T> batch()
+    {
+        check_layout(Layout::structure_of_arrays);
+        return make_batch<T>(mutable_payload());
+    }
+
+    /**
+     * @brief: Call fn with vectors() or batch(), whichever matches the
+     * layout, so fn is instantiated once per layout instead of branching
+     * per point.
+     */
+    template<class Fn>
+    decltype(auto) visit(Fn &&fn) const
+    {
+        if (layout() == Layout::structure_of_arrays)
+        {
+            return fn(batch());
+        }
+        return fn(vectors());
+    }
+
+    template<class Fn>
+    decltype(auto) visit(Fn &&fn)
+    {
+        if (layout() == Layout::structure_of_arrays)
+        {
+            return fn(batch());
+        }
+        return fn(vectors());
+    }
+
+    /**
+     * @brief: Apply a madvise hint to the pages holding the points
+     * [begin, end).
+     */
+    void advise(const size_t begin, const size_t end, const int advice) const
+    {
+        if (begin >= end)
+        {
+            return;
+        }
+        if (layout() == Layout::array_of_structures)
+        {
+            m_file.advise(m_header.data_offset + begin * sizeof(Vector<l, T>),
+                          (end - begin) * sizeof(Vector<l, T>),
+                          advice);
+            return;
+        }
+        for (size_t d = 0; d < l; ++d)
+        {
+            m_file.advise(m_header.data_offset + d * m_header.component_stride
+                              + begin * sizeof(T),
+                          (end - begin) * sizeof(T),
+                          advice);
+        }
+    }
+
+    /**
+     * @brief: Flush modified points to the file.
+     *
+     * @throws std::system_error If flushing fails.
+     */
+    void sync() const
+    {
+        m_file.sync();
+    }
+
+  private:
+    MappedFile m_file;
+    FileHeader m_header {};
+
+    PointStore(MappedFile file, const FileHeader &header)
+        : m_file(std::move(file))
+        , m_header(header)
+    {
+    }
+
+    void check_layout(const Layout expected) const
+    {
+        if (layout() != expected)
+        {
+            throw std::logic_error("colibra: point store has another layout");
+        }
+    }
+
+    const std::byte *payload() const
+    {
+        return m_file.data() + m_header.data_offset;
+    }
+
+    std::byte *mutable_payload()
+    {
+        return m_file.mutable_data() + m_header.data_offset;
+    }
+
+    template<typename U, typename Byte>
+    BatchView<l, U> make_batch(Byte *data) const
+    {
+        std::array<U *, l> components {};
+        for (size_t d = 0; d < l; ++d)
+        {
+            components[d] =
+                reinterpret_cast<U *>(data + d * m_header.component_stride);
+        }
+        return BatchView<l, U>(components, size());
+    }
+};
+
+/**
+ * @brief: Call fn(begin, chunk) for consecutive chunks of a store, where
+ * chunk is a Span<const Vector<l, T>> or BatchView<l, const T> onto the
+ * points [begin, begin + chunk.size()). Chunks are prefetched ahead and
+ * released after fn returns.
+ *
+ * @throws std::invalid_argument If chunk_size is 0.
+ */
+template<size_t l, typename T, class Fn>
+void for_each_chunk(const PointStore<l, T> &store,
+                    Fn &&                   fn,
+                    const size_t chunk_size = details::stream_chunk_size)
+{
+    store.visit([&](const auto &points) {
+        details::stream_chunks(
+            store.size(),
+            chunk_size,
+            [&](size_t begin, size_t end, int advice) {
+                store.advise(begin, end, advice);
+            },
+            [&](size_t begin, size_t end) {
+                fn(begin, details::slice(points, begin, end - begin));
+            });
+    });
+}
+
+/**
+ * @brief: Component-wise minimum and maximum of all points of a store.
+ *
+ * @param policy execution::seq or execution::par, par splits each chunk
+ * across threads.
+ *
+ * @throws std::invalid_argument If the store is empty or chunk_size is 0.
+ */
+template<class Policy,
+         size_t l,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+[[nodiscard]] std::pair<Vector<l, T>, Vector<l, T>> bounding_box(
+    const Policy &          policy,
+    const PointStore<l, T> &store,
+    const size_t            chunk_size = details::stream_chunk_size)
+{
+    if (store.empty())
+    {
+        throw std::invalid_argument("colibra: bounding box of empty store");
+    }
+    const Vector<l, T> first = store[0];
+    Vector<l, T>       lo    = first;
+    Vector<l, T>       hi    = first;
+
+    std::mutex mutex;
+    store.visit([&](const auto &view) {
+        const auto points = details::make_points(view);
+        details::stream_chunks(
+            store.size(),
+            chunk_size,
+            [&](size_t begin, size_t end, int advice) {
+                store.advise(begin, end, advice);
+            },
+            [&](size_t begin, size_t end) {
+                details::parallel_for(
+                    policy, end - begin, [&](size_t from, size_t to) {
+                        Vector<l, T> low  = first;
+                        Vector<l, T> high = first;
+                        details::bounds_kernel(
+                            points, begin + from, begin + to, low, high);
+
+                        const std::lock_guard<std::mutex> lock(mutex);
+                        for (size_t d = 0; d < l; ++d)
+                        {
+                            lo[d] = low[d] < lo[d] ? low[d] : lo[d];
+                            hi[d] = hi[d] < high[d] ? high[d] : hi[d];
+                        }
+                    });
+            });
+    });
+    return {lo, hi};
+}
+
+template<size_t l, typename T>
+[[nodiscard]] std::pair<Vector<l, T>, Vector<l, T>> bounding_box(
+    const PointStore<l, T> &store,
+    const size_t            chunk_size = details::stream_chunk_size)
+{
+    return bounding_box(execution::seq, store, chunk_size);
+}
+
+/**
+ * @brief: Mean of all points of a store.
+ *
+ * Each chunk is summed in double (long double for long double stores), the
+ * chunk sums are combined with Kahan summation so the error does not grow
+ * with the number of chunks.
+ *
+ * @throws std::invalid_argument If the store is empty or chunk_size is 0.
+ */
+template<class Policy,
+         size_t l,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+[[nodiscard]] Vector<l, details::norm_type_t<T>> centroid(
+    const Policy &          policy,
+    const PointStore<l, T> &store,
+    const size_t            chunk_size = details::stream_chunk_size)
+{
+    using A = details::centroid_sum_t<details::norm_type_t<T>>;
+    if (store.empty())
+    {
+        throw std::invalid_argument("colibra: centroid of empty store");
+    }
+
+    std::array<A, l> total {};
+    std::array<A, l> compensation {};
+    std::mutex       mutex;
+    store.visit([&](const auto &view) {
+        const auto points = details::make_points(view);
+        details::stream_chunks(
+            store.size(),
+            chunk_size,
+            [&](size_t begin, size_t end, int advice) {
+                store.advise(begin, end, advice);
+            },
+            [&](size_t begin, size_t end) {
+                std::array<A, l> chunk {};
+                details::parallel_for(
+                    policy, end - begin, [&](size_t first, size_t last) {
+                        std::array<A, l> sums {};
+                        details::sum_kernel(
+                            points, begin + first, begin + last, sums);
+
+                        const std::lock_guard<std::mutex> lock(mutex);
+                        for (size_t d = 0; d < l; ++d)
+                        {
+                            chunk[d] += sums[d];
+                        }
+                    });
+                for (size_t d = 0; d < l; ++d)
+                {
+                    const A y       = chunk[d] - compensation[d];
+                    const A t       = total[d] + y;
+                    compensation[d] = (t - total[d]) - y;
+                    total[d]        = t;
+                }
+            });
+    });
+
+    Vector<l, details::norm_type_t<T>> mean;
+    for (size_t d = 0; d < l; ++d)
+    {
+        mean[d] = static_cast<details::norm_type_t<T>>(
+            total[d] / static_cast<A>(store.size()));
+    }
+    return mean;
+}
+
+template<size_t l, typename T>
+[[nodiscard]] Vector<l, details::norm_type_t<T>> centroid(
+    const PointStore<l, T> &store,
+    const size_t            chunk_size = details::stream_chunk_size)
+{
+    return centroid(execution::seq, store, chunk_size);
+}
+
+/**
+ * @brief: Stream every point of source through fn and write the results to
+ * destination, e.g. to move a cloud into another frame. Source and
+ * destination may have different layouts and element types.
+ *
+ * @param fn Callable mapping Vector<l, T> to Vector<m, U>.
+ *
+ * @throws std::invalid_argument If the stores differ in size or chunk_size
+ * is 0.
+ * @throws std::logic_error If destination is not writable.
+ */
+template<class Policy,
+         size_t l,
+         typename T,
+         size_t m,
+         typename U,
+         class Fn,
+         typename = enable_if_execution_policy_t<Policy>>
+void transform(const Policy &          policy,
+               const PointStore<l, T> &source,
+               PointStore<m, U> &      destination,
+               Fn &&                   fn,
+               const size_t            chunk_size = details::stream_chunk_size)
+{
+    if (source.size() != destination.size())
+    {
+        throw std::invalid_argument("colibra: transform size mismatch");
+    }
+    source.visit([&](const auto &in) {
+        destination.visit([&](const auto &out) {
+            details::stream_chunks(
+                source.size(),
+                chunk_size,
+                [&](size_t begin, size_t end, int advice) {
+                    source.advise(begin, end, advice);
+                    destination.advise(begin, end, advice);
+                },
+                [&](size_t begin, size_t end) {
+                    details::parallel_for(
+                        policy, end - begin, [&](size_t first, size_t last) {
+                            for (size_t i = begin + first; i < begin + last;
+                                 ++i)
+                            {
+                                details::store_point(out, i, fn(in[i]));
+                            }
+                        });
+                });
+        });
+    });
+}
+
+template<size_t l, typename T, size_t m, typename U, class Fn>
+void transform(const PointStore<l, T> &source,
+               PointStore<m, U> &      destination,
+               Fn &&                   fn,
+               const size_t            chunk_size = details::stream_chunk_size)
+{
+    transform(execution::seq, source, destination, fn, chunk_size);
+}
+
+/**
+ * @brief: Replace every point of a writable store by fn(point).
+ *
+ * @throws std::logic_error If the store is not writable.
+ */
+template<class Policy,
+         size_t l,
+         typename T,
+         class Fn,
+         typename = enable_if_execution_policy_t<Policy>>
+void transform(const Policy &    policy,
+               PointStore<l, T> &store,
+               Fn &&             fn,
+               const size_t      chunk_size = details::stream_chunk_size)
+{
+    store.visit([&](const auto &points) {
+        details::stream_chunks(
+            store.size(),
+            chunk_size,
+            [&](size_t begin, size_t end, int advice) {
+                store.advise(begin, end, advice);
+            },
+            [&](size_t begin, size_t end) {
+                details::parallel_for(
+                    policy, end - begin, [&](size_t first, size_t last) {
+                        for (size_t i = begin + first; i < begin + last; ++i)
+                        {
+                            details::store_point(points, i, fn(points[i]));
+                        }
+                    });
+            });
+    });
+}
+
+template<size_t l, typename T, class Fn>
+void transform(PointStore<l, T> &store,
+               Fn &&             fn,
+               const size_t      chunk_size = details::stream_chunk_size)
+{
+    transform(execution::seq, store, fn, chunk_size);
+}
+
+} // namespace colibra
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef COLIBRA_PROMOTION_H
+#define COLIBRA_PROMOTION_H
+
+#include <type_traits>
+
+namespace colibra {
+
+namespace details {
+
+/// Detects whether T and S have a common type at all. Policies only define a
+/// result type if they do, which keeps operator overloads SFINAE friendly.
+template<typename T, typename S, typename = void>
+struct has_common_type : std::false_type
+{
+};
+
+template<typename T, typename S>
+struct has_common_type<T, S, std::void_t<std::common_type_t<T, S>>>
+    : std::true_type
+{
+};
+
+template<typename T, bool valid>
+struct result_if
+{
+};
+
+template<typename T>
+struct result_if<T, true>
+{
+    using type = T;
+};
+
+} // namespace details
+
+/**
+ * @brief: Promotion policies decide the element type of the result when
+ * Vectors or scalars of different types are combined.
+ *
+ * A policy is a type with a nested template result<T, S> whose member type is
+ * the result type for a left operand with element type T and a right operand
+ * of element type S. Like std::common_type, result<T, S> has no member type if
+ * T and S can not be combined.
+ */
+namespace promotion {
+
+/**
+ * @brief: Promote to std::common_type_t<T, S>. This is the default, and
+ * turns Vector<3, float> * double into a Vector<3, double>.
+ */
+struct promote
+{
+    template<typename T, typename S>
+    struct result : std::common_type<T, S>
+    {
+    };
+};
+
+/**
+ * @brief: Keep the element type of the left operand, converting the right
+ * operand before the operation. Vector<3, float> * double stays float.
+ */
+struct keep_left
+{
+    template<typename T, typename S>
+    struct result
+        : details::result_if<T, details::has_common_type<T, S>::value>
+    {
+    };
+};
+
+/**
+ * @brief: Refuse to compile operations that would change the element type of
+ * the left operand.
+ *
+ * Use this in hot single precision pipelines to catch accidental double
+ * literals at compile time.
+ */
+struct error_on_widening
+{
+    template<typename T, typename S, typename = void>
+    struct result
+    {
+    };
+
+    template<typename T, typename S>
+    struct result<T, S, std::void_t<std::common_type_t<T, S>>>
+    {
+        static_assert(std::is_same_v<std::common_type_t<T, S>, T>,
+                      "colibra: operation would widen the element type of "
+                      "the left operand, convert the right operand "
+                      "explicitly or use promotion::keep_left");
+        using type = T;
+    };
+};
+
+} // namespace promotion
+
+/**
+ * @brief: The promotion policy used by all Vector operators.
+ *
+ * Defaults to promotion::promote, define COLIBRA_DEFAULT_PROMOTION before
+ * including any colibra header to change it for a whole build, e.g.
+ * -DCOLIBRA_DEFAULT_PROMOTION=colibra::promotion::error_on_widening.
+ */
+#ifndef COLIBRA_DEFAULT_PROMOTION
+#define COLIBRA_DEFAULT_PROMOTION ::colibra::promotion::promote
+#endif
+
+using default_promotion = COLIBRA_DEFAULT_PROMOTION;
+
+/**
+ * @brief: The result element type of combining T with S under Policy.
+ */
+template<typename T, typename S, class Policy = default_promotion>
+using promoted_t = typename Policy::template result<T, S>::type;
+
+} // namespace colibra
+
+#endif
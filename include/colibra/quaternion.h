@@ -0,0 +1,243 @@
+#ifndef COLIBRA_QUATERNION_H
+#define COLIBRA_QUATERNION_H
+
+#include "details/math.hpp"
+#include "matrix.h"
+#include "vector.h"
+
+#include <cmath>
+#include <type_traits>
+
+namespace colibra {
+
+/**
+ * @brief: A quaternion w + x i + y j + z k. Unit quaternions represent
+ * rotations in 3D, q and -q the same one.
+ *
+ * The default value is the identity rotation.
+ *
+ * @tparam T The floating point data type of the coefficients.
+ */
+template<typename T>
+struct Quaternion
+{
+    static_assert(std::is_floating_point_v<T>,
+                  "colibra::Quaternion requires a floating point type");
+
+    T w {1};
+    T x {};
+    T y {};
+    T z {};
+
+    [[nodiscard]] static constexpr Quaternion identity()
+    {
+        return Quaternion {};
+    }
+
+    /**
+     * @brief: The rotation by angle radians around axis, which must not be
+     * the null Vector.
+     */
+    [[nodiscard]] static Quaternion from_axis_angle(const Vector<3, T> &axis,
+                                                    const T             angle)
+    {
+        const T half  = angle / T {2};
+        const T scale = std::sin(half) / static_cast<T>(axis.norm());
+        return Quaternion {
+            std::cos(half), axis[0] * scale, axis[1] * scale, axis[2] * scale};
+    }
+
+    /**
+     * @brief: The unit quaternion of a rotation Matrix, following Shepperd:
+     * the largest of the four coefficients is computed from the diagonal and
+     * the others from it, which keeps the division well conditioned.
+     */
+    [[nodiscard]] static constexpr Quaternion
+    from_matrix(const Matrix<3, 3, T> &m)
+    {
+        const T trace = m(0, 0) + m(1, 1) + m(2, 2);
+        if (trace > T {0})
+        {
+            const T s = details::sqrt(trace + T {1}) * T {2};
+            return Quaternion {s / T {4},
+                               (m(2, 1) - m(1, 2)) / s,
+                               (m(0, 2) - m(2, 0)) / s,
+                               (m(1, 0) - m(0, 1)) / s};
+        }
+        if (m(0, 0) > m(1, 1) && m(0, 0) > m(2, 2))
+        {
+            const T s =
+                details::sqrt(T {1} + m(0, 0) - m(1, 1) - m(2, 2)) * T {2};
+            return Quaternion {(m(2, 1) - m(1, 2)) / s,
+                               s / T {4},
+                               (m(0, 1) + m(1, 0)) / s,
+                               (m(0, 2) + m(2, 0)) / s};
+        }
+        if (m(1, 1) > m(2, 2))
+        {
+            const T s =
+                details::sqrt(T {1} + m(1, 1) - m(0, 0) - m(2, 2)) * T {2};
+            return Quaternion {(m(0, 2) - m(2, 0)) / s,
+                               (m(0, 1) + m(1, 0)) / s,
+                               s / T {4},
+                               (m(1, 2) + m(2, 1)) / s};
+        }
+        const T s = details::sqrt(T {1} + m(2, 2) - m(0, 0) - m(1, 1)) * T {2};
+        return Quaternion {(m(1, 0) - m(0, 1)) / s,
+                           (m(0, 2) + m(2, 0)) / s,
+                           (m(1, 2) + m(2, 1)) / s,
+                           s / T {4}};
+    }
+
+    /**
+     * @brief: The rotation Matrix of this unit quaternion.
+     */
+    [[nodiscard]] constexpr Matrix<3, 3, T> to_matrix() const
+    {
+        const T xx = x * x;
+        const T yy = y * y;
+        const T zz = z * z;
+        const T xy = x * y;
+        const T xz = x * z;
+        const T yz = y * z;
+        const T wx = w * x;
+        const T wy = w * y;
+        const T wz = w * z;
+        return Matrix<3, 3, T> {T {1} - T {2} * (yy + zz),
+                                T {2} * (xy - wz),
+                                T {2} * (xz + wy),
+                                T {2} * (xy + wz),
+                                T {1} - T {2} * (xx + zz),
+                                T {2} * (yz - wx),
+                                T {2} * (xz - wy),
+                                T {2} * (yz + wx),
+                                T {1} - T {2} * (xx + yy)};
+    }
+
+    /**
+     * @brief: Rotate a point by this unit quaternion, without building the
+     * rotation Matrix.
+     */
+    [[nodiscard]] constexpr Vector<3, T>
+    operator()(const Vector<3, T> &point) const
+    {
+        const Vector<3, T> axis {x, y, z};
+        const Vector<3, T> t = cross(axis, point) * T {2};
+        return point + t * w + cross(axis, t);
+    }
+
+    /**
+     * @brief: The Hamilton product, (a * b)(p) == a(b(p)) for unit
+     * quaternions.
+     */
+    [[nodiscard]] constexpr Quaternion operator*(const Quaternion &q) const
+    {
+        return Quaternion {w * q.w - x * q.x - y * q.y - z * q.z,
+                           w * q.x + x * q.w + y * q.z - z * q.y,
+                           w * q.y - x * q.z + y * q.w + z * q.x,
+                           w * q.z + x * q.y - y * q.x + z * q.w};
+    }
+
+    [[nodiscard]] constexpr Quaternion operator*(const T scalar) const
+    {
+        return Quaternion {w * scalar, x * scalar, y * scalar, z * scalar};
+    }
+
+    [[nodiscard]] constexpr Quaternion operator+(const Quaternion &other) const
+    {
+        return Quaternion {w + other.w, x + other.x, y + other.y, z + other.z};
+    }
+
+    [[nodiscard]] constexpr Quaternion operator-(const Quaternion &other) const
+    {
+        return Quaternion {w - other.w, x - other.x, y - other.y, z - other.z};
+    }
+
+    [[nodiscard]] constexpr Quaternion operator-() const
+    {
+        return Quaternion {-w, -x, -y, -z};
+    }
+
+    /**
+     * @brief: The conjugate, which is the inverse of a unit quaternion.
+     */
+    [[nodiscard]] constexpr Quaternion conjugate() const
+    {
+        return Quaternion {w, -x, -y, -z};
+    }
+
+    [[nodiscard]] constexpr T dot(const Quaternion &other) const
+    {
+        return w * other.w + x * other.x + y * other.y + z * other.z;
+    }
+
+    [[nodiscard]] constexpr T norm() const
+    {
+        return details::sqrt(dot(*this));
+    }
+
+    [[nodiscard]] constexpr Quaternion normalized() const
+    {
+        return *this * (T {1} / norm());
+    }
+
+    /**
+     * @brief: The coefficients as a Vector {w, x, y, z}.
+     */
+    [[nodiscard]] constexpr Vector<4, T> coefficients() const
+    {
+        return Vector<4, T> {w, x, y, z};
+    }
+
+    [[nodiscard]] constexpr bool operator==(const Quaternion &other) const
+    {
+        return w == other.w && x == other.x && y == other.y && z == other.z;
+    }
+
+    [[nodiscard]] constexpr bool operator!=(const Quaternion &other) const
+    {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @brief: Normalized linear interpolation between two unit quaternions
+ * along the shorter arc. Faster than slerp, but the angular velocity is
+ * not constant over t.
+ */
+template<typename T>
+[[nodiscard]] constexpr Quaternion<T> nlerp(const Quaternion<T>         &a,
+                                            const Quaternion<T>         &b,
+                                            const details::identity_t<T> t)
+{
+    const Quaternion<T> target = a.dot(b) < T {0} ? -b : b;
+    return (a * (T {1} - t) + target * t).normalized();
+}
+
+/**
+ * @brief: Spherical linear interpolation between two unit quaternions along
+ * the shorter arc, a at t == 0 and b or -b at t == 1, with constant angular
+ * velocity.
+ */
+template<typename T>
+[[nodiscard]] Quaternion<T> slerp(const Quaternion<T>         &a,
+                                  const Quaternion<T>         &b,
+                                  const details::identity_t<T> t)
+{
+    const Quaternion<T> target = a.dot(b) < T {0} ? -b : b;
+    // The angle from the chord lengths stays accurate for nearly equal
+    // quaternions, where acos(a.dot(b)) loses half the digits.
+    const T theta =
+        T {2} * std::atan2((a - target).norm(), (a + target).norm());
+    const T sin_theta = std::sin(theta);
+    if (!(sin_theta > T {0}))
+    {
+        return a * (T {1} - t) + target * t;
+    }
+    return a * (std::sin((T {1} - t) * theta) / sin_theta)
+           + target * (std::sin(t * theta) / sin_theta);
+}
+
+} // namespace colibra
+
+#endif
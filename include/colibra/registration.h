@@ -0,0 +1,334 @@
+#ifndef COLIBRA_REGISTRATION_H
+#define COLIBRA_REGISTRATION_H
+
+#include "batch_ops.h"
+#include "details/parallel.hpp"
+#include "details/registration.hpp"
+#include "execution.h"
+#include "nearest.h"
+#include "span.h"
+#include "transform.h"
+#include "vector.h"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace colibra {
+
+/**
+ * @brief: Find the similarity transform, rotation, translation and uniform
+ * scale, that best maps source[i] onto target[i] in the least squares sense
+ * (Umeyama's method).
+ *
+ * @param with_scale Estimate the scale, with false it is fixed to 1 and the
+ * result equals kabsch.
+ *
+ * @throws std::invalid_argument If the spans differ in size or are empty.
+ */
+template<class Policy,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+SimilarityTransform<T>
+umeyama(const Policy &                                policy,
+        Span<const Vector<3, T>>                      source,
+        details::identity_t<Span<const Vector<3, T>>> target,
+        const bool                                    with_scale = true)
+{
+    static_assert(std::is_floating_point_v<T>,
+                  "Registration requires floating-point Vectors");
+    if (source.size() != target.size())
+    {
+        throw std::invalid_argument(
+            "colibra::umeyama: source and target differ in size");
+    }
+    const auto moments = details::pair_moments<T>(
+        policy,
+        source.size(),
+        [&](const size_t k, Vector<3, T> &p, Vector<3, T> &q) {
+            p = source[k];
+            q = target[k];
+            return true;
+        });
+    return details::fit_similarity<T>(moments, with_scale);
+}
+
+template<class Policy,
+         typename T,
+         typename A,
+         typename = enable_if_execution_policy_t<Policy>>
+SimilarityTransform<T>
+umeyama(const Policy &                                policy,
+        const std::vector<Vector<3, T>, A> &          source,
+        details::identity_t<Span<const Vector<3, T>>> target,
+        const bool                                    with_scale = true)
+{
+    return umeyama(
+        policy, Span<const Vector<3, T>>(source), target, with_scale);
+}
+
+template<typename T>
+SimilarityTransform<T>
+umeyama(Span<const Vector<3, T>>                      source,
+        details::identity_t<Span<const Vector<3, T>>> target,
+        const bool                                    with_scale = true)
+{
+    return umeyama(execution::seq, source, target, with_scale);
+}
+
+template<typename T, typename A>
+SimilarityTransform<T>
+umeyama(const std::vector<Vector<3, T>, A> &          source,
+        details::identity_t<Span<const Vector<3, T>>> target,
+        const bool                                    with_scale = true)
+{
+    return umeyama(
+        execution::seq, Span<const Vector<3, T>>(source), target, with_scale);
+}
+
+/**
+ * @brief: Find the rigid transform that best maps source[i] onto target[i]
+ * in the least squares sense (Kabsch algorithm).
+ *
+ * Centroids and cross-covariance are reduced in parallel chunks, the
+ * rotation follows from the 3x3 svd. Reflections are never returned.
+ *
+ * @throws std::invalid_argument If the spans differ in size or are empty.
+ */
+template<class Policy,
+         typename T,
+         typename = enable_if_execution_policy_t<Policy>>
+RigidTransform<T> kabsch(const Policy &                                policy,
+                         Span<const Vector<3, T>>                      source,
+                         details::identity_t<Span<const Vector<3, T>>> target)
+{
+    return umeyama(policy, source, target, false).rigid();
+}
+
+template<class Policy,
+         typename T,
+         typename A,
+         typename = enable_if_execution_policy_t<Policy>>
+RigidTransform<T> kabsch(const Policy &                                policy,
+                         const std::vector<Vector<3, T>, A> &          source,
+                         details::identity_t<Span<const Vector<3, T>>> target)
+{
+    return kabsch(policy, Span<const Vector<3, T>>(source), target);
+}
+
+template<typename T>
+RigidTransform<T> kabsch(Span<const Vector<3, T>>                      source,
+                         details::identity_t<Span<const Vector<3, T>>> target)
+{
+    return kabsch(execution::seq, source, target);
+}
+
+template<typename T, typename A>
+RigidTransform<T> kabsch(const std::vector<Vector<3, T>, A> &          source,
+                         details::identity_t<Span<const Vector<3, T>>> target)
+{
+    return kabsch(execution::seq, Span<const Vector<3, T>>(source), target);
+}
+
+/**
+ * @brief: Stopping and outlier criteria of IcpRegistration.
+ */
+struct IcpOptions
+{
+    size_t max_iterations = 30;
+    /// Correspondences further apart than this are rejected as outliers.
+    double max_distance = std::numeric_limits<double>::infinity();
+    /// Stop once an iteration lowers the mean squared distance by less than
+    /// this fraction.
+    double tolerance = 1e-6;
+};
+
+/**
+ * @brief: Outcome of an ICP alignment.
+ */
+template<typename T>
+struct IcpResult
+{
+    /// Maps the source points onto the target cloud.
+    RigidTransform<T> transform;
+    /// Number of transform updates.
+    size_t iterations = 0;
+    /// Correspondences within max_distance in the last iteration.
+    size_t inliers = 0;
+    /// Root mean square distance of those correspondences.
+    double rms       = 0;
+    bool   converged = false;
+};
+
+/**
+ * @brief: Point-to-point iterative closest point registration against a
+ * fixed target cloud.
+ *
+ * The target is indexed once in a KdTree, after which any number of source
+ * clouds can be aligned to it. Every iteration matches each transformed
+ * source point to its nearest target point, in parallel with
+ * execution::par, and refits the transform to the matches with kabsch.
+ *
+ * align() reuses the correspondence buffers of the instance, so one
+ * instance must not align several clouds concurrently.
+ *
+ * @tparam T The data type of the Vectors.
+ */
+template<typename T>
+class IcpRegistration
+{
+  public:
+    IcpRegistration() = default;
+
+    /**
+     * @brief: Index the target cloud. The points are not copied and must
+     * outlive the instance.
+     */
+    explicit IcpRegistration(Span<const Vector<3, T>> target,
+                             const size_t             leaf_size = 16)
+        : m_target(target)
+        , m_tree(target, leaf_size)
+    {
+    }
+
+    [[nodiscard]] const KdTree<3, T> &tree() const
+    {
+        return m_tree;
+    }
+
+    /**
+     * @brief: Align source to the target cloud.
+     *
+     * @param initial The starting estimate, ICP only finds the nearest local
+     * minimum.
+     *
+     * @throws std::invalid_argument If source or target are empty.
+     */
+    template<class Policy, typename = enable_if_execution_policy_t<Policy>>
+    IcpResult<T> align(const Policy &           policy,
+                       Span<const Vector<3, T>> source,
+                       const RigidTransform<T> &initial = {},
+                       const IcpOptions &       options = {})
+    {
+        static_assert(std::is_floating_point_v<T>,
+                      "Registration requires floating-point Vectors");
+        if (source.empty() || m_target.empty())
+        {
+            throw std::invalid_argument(
+                "colibra::IcpRegistration: empty point cloud");
+        }
+
+        using A = details::moment_type_t<T>;
+
+        const A max_squared = static_cast<A>(options.max_distance)
+                              * static_cast<A>(options.max_distance);
+        A       previous    = 0;
+        m_matches.resize(source.size());
+
+        IcpResult<T> result;
+        result.transform = initial;
+
+        while (true)
+        {
+            const Correspondences found =
+                match(policy, source, result.transform, max_squared);
+            result.inliers = found.inliers;
+            if (found.inliers == 0)
+            {
+                break;
+            }
+            const A mean_squared = found.squared_sum
+                                   / static_cast<A>(found.inliers);
+            result.rms = static_cast<double>(std::sqrt(mean_squared));
+            if (result.iterations > 0
+                && previous - mean_squared
+                       <= static_cast<A>(options.tolerance) * previous)
+            {
+                result.converged = true;
+                break;
+            }
+            if (result.iterations == options.max_iterations)
+            {
+                break;
+            }
+            previous = mean_squared;
+
+            const auto moments = details::pair_moments<T>(
+                policy,
+                source.size(),
+                [&](const size_t k, Vector<3, T> &p, Vector<3, T> &q) {
+                    if (m_matches[k] == no_match)
+                    {
+                        return false;
+                    }
+                    p = source[k];
+                    q = m_target[m_matches[k]];
+                    return true;
+                });
+            result.transform =
+                details::fit_similarity<T>(moments, false).rigid();
+            ++result.iterations;
+        }
+        return result;
+    }
+
+    IcpResult<T> align(Span<const Vector<3, T>> source,
+                       const RigidTransform<T> &initial = {},
+                       const IcpOptions &       options = {})
+    {
+        return align(execution::seq, source, initial, options);
+    }
+
+  private:
+    static constexpr size_t no_match = std::numeric_limits<size_t>::max();
+
+    struct Correspondences
+    {
+        size_t                    inliers = 0;
+        details::moment_type_t<T> squared_sum {};
+    };
+
+    Span<const Vector<3, T>> m_target;
+    KdTree<3, T>             m_tree;
+    std::vector<size_t>      m_matches;
+
+    /// Match every transformed source point to its nearest target point,
+    /// recording no_match for pairs further apart than max_squared.
+    template<class Policy>
+    Correspondences match(const Policy &                  policy,
+                          Span<const Vector<3, T>>        source,
+                          const RigidTransform<T> &       transform,
+                          const details::moment_type_t<T> max_squared)
+    {
+        using A = details::moment_type_t<T>;
+        // A query visits a few leaves of up to 16 points each.
+        return details::parallel_reduce<Correspondences>(
+            details::rows_policy(policy, 64),
+            source.size(),
+            [&](const size_t begin, const size_t end, Correspondences &local) {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    const auto neighbor = m_tree.nearest(transform(source[i]));
+                    const A    squared =
+                        static_cast<A>(neighbor.distance_squared);
+                    if (squared > max_squared)
+                    {
+                        m_matches[i] = no_match;
+                        continue;
+                    }
+                    m_matches[i] = neighbor.index;
+                    ++local.inliers;
+                    local.squared_sum += squared;
+                }
+            },
+            [](Correspondences &total, const Correspondences &local) {
+                total.inliers     += local.inliers;
+                total.squared_sum += local.squared_sum;
+            });
+    }
+};
+
+} // namespace colibra
+
+#endif
@@ -0,0 +1,318 @@
+#ifndef COLIBRA_SERIALIZE_H
+#define COLIBRA_SERIALIZE_H
+
+#include "batch.h"
+#include "details/serialize.hpp"
+#include "mapped_file.h"
+#include "span.h"
+#include "vector.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace colibra {
+
+/**
+ * @brief: Memory layout of the Vectors in a binary file.
+ */
+enum class Layout : uint8_t
+{
+    /// Vectors one after another, viewable as Span<const Vector<l, T>>.
+    array_of_structures = 0,
+    /// One array per component, viewable as BatchView<l, const T>.
+    structure_of_arrays = 1,
+};
+
+/**
+ * @brief: The 64 byte header at the start of every colibra binary file.
+ *
+ * The payload follows at data_offset. Integers are stored in the byte order
+ * of the writer, readers on a machine of different byte order reject the
+ * file, since the payload can not be viewed without conversion.
+ */
+struct FileHeader
+{
+    std::array<char, 8> magic;
+    uint16_t            version;
+    /// 1 for little endian, 2 for big endian.
+    uint8_t endianness;
+    Layout  layout;
+    /// See details::ElementKind.
+    uint8_t  element_kind;
+    uint8_t  element_size;
+    uint16_t fraction_bits;
+    /// The size l of each Vector.
+    uint32_t length;
+    uint32_t reserved;
+    /// The number of Vectors.
+    uint64_t count;
+    uint64_t data_offset;
+    /// Bytes from one component array to the next, 0 for AoS files.
+    uint64_t component_stride;
+    uint8_t  padding[16];
+};
+
+static_assert(sizeof(FileHeader) == 64, "FileHeader must be 64 bytes");
+
+/**
+ * @brief: Thrown when a file is not a colibra binary file, or does not
+ * contain the requested Vector type or layout.
+ */
+class FormatError : public std::runtime_error
+{
+  public:
+    using std::runtime_error::runtime_error;
+};
+
+inline constexpr std::array<char, 8> file_magic {
+    'C', 'O', 'L', 'I', 'B', 'R', 'A', '\0'};
+inline constexpr uint16_t file_version = 1;
+
+/**
+ * @brief: Create the header describing count Vectors<l, T> in the given
+ * layout.
+ */
+template<size_t l, typename T>
+[[nodiscard]] FileHeader make_header(const Layout layout, const uint64_t count)
+{
+    static_assert(std::is_trivially_copyable_v<Vector<l, T>>,
+                  "only trivially copyable Vectors can be stored");
+    static_assert(sizeof(Vector<l, T>) == l * sizeof(T),
+                  "Vectors must not contain padding");
+
+    using code = details::element_code<T>;
+
+    FileHeader header {};
+    header.magic         = file_magic;
+    header.version       = file_version;
+    header.endianness    = details::native_endianness;
+    header.layout        = layout;
+    header.element_kind  = static_cast<uint8_t>(code::kind);
+    header.element_size  = static_cast<uint8_t>(sizeof(T));
+    header.fraction_bits = code::fraction_bits;
+    header.length        = static_cast<uint32_t>(l);
+    header.count         = count;
+    header.data_offset   = details::data_alignment;
+    header.component_stride =
+        layout == Layout::structure_of_arrays
+            ? details::align_up(count * sizeof(T), details::data_alignment)
+            : 0;
+    return header;
+}
+
+/**
+ * @brief: Write Vectors in array-of-structures layout to a file descriptor.
+ *
+ * Header and payload go out in a single writev call where the kernel
+ * accepts it.
+ *
+ * @throws std::system_error If writing fails.
+ */
+template<size_t l, typename T>
+void write_binary(const int fd, Span<const Vector<l, T>> vectors)
+{
+    const FileHeader header =
+        make_header<l, T>(Layout::array_of_structures, vectors.size());
+    iovec parts[2] = {
+        {const_cast<FileHeader *>(&header), sizeof(header)},
+        {const_cast<Vector<l, T> *>(vectors.data()), vectors.size_bytes()}};
+    details::write_all(fd, parts, 2);
+}
+
+/**
+ * @brief: Write a Batch in structure-of-arrays layout to a file descriptor.
+ *
+ * Each component array is padded to 64 bytes, so all of them are aligned
+ * when the file is mapped.
+ *
+ * @throws std::system_error If writing fails.
+ */
+template<size_t l, typename T>
+void write_binary(const int fd, BatchView<l, const T> batch)
+{
+    static const std::array<std::byte, details::data_alignment> zeros {};
+
+    const FileHeader header =
+        make_header<l, T>(Layout::structure_of_arrays, batch.size());
+    const size_t bytes   = batch.size() * sizeof(T);
+    const size_t padding = header.component_stride - bytes;
+
+    std::vector<iovec> parts;
+    parts.reserve(1 + 2 * l);
+    parts.push_back({const_cast<FileHeader *>(&header), sizeof(header)});
+    for (size_t d = 0; d < l; ++d)
+    {
+        parts.push_back({const_cast<T *>(batch.component(d)), bytes});
+        if (padding > 0)
+        {
+            parts.push_back({const_cast<std::byte *>(zeros.data()), padding});
+        }
+    }
+    details::write_all(fd, parts.data(), static_cast<int>(parts.size()));
+}
+
+template<size_t l, typename T>
+void write_binary(const int fd, const Batch<l, T> &batch)
+{
+    write_binary(fd, batch.view());
+}
+
+/**
+ * @brief: Write Vectors or a Batch to a new file, replacing existing ones.
+ *
+ * @throws std::system_error If the file can not be created or written.
+ */
+template<size_t l, typename T>
+void write_binary(const std::string &path, Span<const Vector<l, T>> vectors)
+{
+    details::with_output_file(
+        path, [&](const int fd) { write_binary(fd, vectors); });
+}
+
+template<size_t l, typename T>
+void write_binary(const std::string &path, BatchView<l, const T> batch)
+{
+    details::with_output_file(
+        path, [&](const int fd) { write_binary(fd, batch); });
+}
+
+template<size_t l, typename T>
+void write_binary(const std::string &path, const Batch<l, T> &batch)
+{
+    write_binary(path, batch.view());
+}
+
+/**
+ * @brief: Number of payload bytes following the header. The header must
+ * come from make_header or read_header, for other headers the product may
+ * wrap around.
+ */
+[[nodiscard]] constexpr uint64_t payload_size(const FileHeader &header)
+{
+    return header.layout == Layout::structure_of_arrays
+               ? header.component_stride * header.length
+               : header.count * header.length * header.element_size;
+}
+
+/**
+ * @brief: Read and validate the header of a mapped colibra binary file.
+ *
+ * @throws FormatError If the file is truncated, not a colibra file, or was
+ * written on a machine of different byte order.
+ */
+[[nodiscard]] inline FileHeader read_header(const MappedFile &file)
+{
+    FileHeader header {};
+    if (file.size() < sizeof(header))
+    {
+        throw FormatError("colibra: file too small for a header");
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (header.magic != file_magic || header.version != file_version)
+    {
+        throw FormatError("colibra: not a colibra binary file");
+    }
+    if (header.endianness != details::native_endianness)
+    {
+        throw FormatError("colibra: file has foreign byte order");
+    }
+
+    if (header.data_offset > file.size())
+    {
+        throw FormatError("colibra: file is truncated");
+    }
+    // The payload holds count Vectors of length elements, or length
+    // component arrays of component_stride bytes. Dividing the available
+    // bytes instead of multiplying the header fields keeps a corrupt count
+    // or stride from wrapping the payload size around.
+    const bool     soa       = header.layout == Layout::structure_of_arrays;
+    const uint64_t available = file.size() - header.data_offset;
+    const uint64_t items     = soa ? header.length : header.count;
+    const uint64_t item_size = soa ? header.component_stride
+                                   : uint64_t {header.length}
+                                         * header.element_size;
+    if (item_size > 0 && items > available / item_size)
+    {
+        throw FormatError("colibra: file is truncated");
+    }
+    return header;
+}
+
+namespace details {
+
+template<size_t l, typename T>
+FileHeader check_header(const MappedFile &file, const Layout layout)
+{
+    const FileHeader header   = read_header(file);
+    const FileHeader expected = make_header<l, T>(layout, header.count);
+    if (header.layout != layout)
+    {
+        throw FormatError("colibra: file has a different layout");
+    }
+    if (header.length != expected.length
+        || header.element_kind != expected.element_kind
+        || header.element_size != expected.element_size
+        || header.fraction_bits != expected.fraction_bits)
+    {
+        throw FormatError("colibra: file holds a different Vector type");
+    }
+    // The count is checked against the stride before the expected stride,
+    // which is computed from the count, is compared.
+    if ((layout == Layout::structure_of_arrays
+         && header.count > header.component_stride / sizeof(T))
+        || header.component_stride < expected.component_stride
+        || header.data_offset % alignof(T) != 0
+        || header.component_stride % alignof(T) != 0)
+    {
+        throw FormatError("colibra: file has an invalid data layout");
+    }
+    return header;
+}
+
+} // namespace details
+
+/**
+ * @brief: View the Vectors in a mapped array-of-structures file without
+ * copying or parsing.
+ *
+ * @throws FormatError If the file does not hold Vector<l, T> in
+ * array-of-structures layout.
+ */
+template<size_t l, typename T>
+[[nodiscard]] Span<const Vector<l, T>> view_vectors(const MappedFile &file)
+{
+    const FileHeader header =
+        details::check_header<l, T>(file, Layout::array_of_structures);
+    const std::byte *data = file.data() + header.data_offset;
+    return Span<const Vector<l, T>>(
+        reinterpret_cast<const Vector<l, T> *>(data), header.count);
+}
+
+/**
+ * @brief: View a mapped structure-of-arrays file as a batch without copying
+ * or parsing.
+ *
+ * @throws FormatError If the file does not hold Vector<l, T> in
+ * structure-of-arrays layout.
+ */
+template<size_t l, typename T>
+[[nodiscard]] BatchView<l, const T> view_batch(const MappedFile &file)
+{
+    const FileHeader header =
+        details::check_header<l, T>(file, Layout::structure_of_arrays);
+    std::array<const T *, l> components {};
+    for (size_t d = 0; d < l; ++d)
+    {
+        components[d] = reinterpret_cast<const T *>(
+            file.data() + header.data_offset + d * header.component_stride);
+    }
+    return BatchView<l, const T>(components, header.count);
+}
+
+} // namespace colibra
+
+#endif
@@ -0,0 +1,392 @@
+#ifndef COLIBRA_SOLVERS_H
+#define COLIBRA_SOLVERS_H
+
+#include "batch_ops.h"
+#include "details/solvers.hpp"
+#include "dmatrix.h"
+#include "execution.h"
+#include "matrix.h"
+#include "sparse.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+
+namespace colibra {
+
+/**
+ * @brief: The preconditioner applied by the iterative solvers.
+ */
+enum class Preconditioner
+{
+    none,
+    /// Scale by the inverse diagonal of the system, which is the diagonal
+    /// of transpose(A) * A for least squares.
+    jacobi,
+};
+
+/**
+ * @brief: Stopping criteria of the iterative solvers.
+ */
+struct SolverOptions
+{
+    /// Iteration limit, 0 picks twice the number of unknowns.
+    size_t max_iterations = 0;
+    /// Relative residual to reach, 0 picks the square root of the machine
+    /// epsilon of the element type.
+    double         tolerance      = 0;
+    Preconditioner preconditioner = Preconditioner::jacobi;
+};
+
+/**
+ * @brief: Outcome of an iterative solve.
+ */
+struct SolverResult
+{
+    size_t iterations = 0;
+    /// The final residual relative to the right-hand side: |b - A x| / |b|
+    /// for conjugate_gradient and |A^T (b - A x)| / |A^T b| for
+    /// least_squares.
+    double residual  = 0;
+    bool   converged = false;
+};
+
+/// The vector type holding the unknowns of solves with matrix type M:
+/// Vector<c, T> for Matrix<r, c, T>, std::vector<T> for DMatrix and
+/// CsrMatrix.
+template<class M>
+using domain_vector_t = typename details::solver_traits<M>::domain_type;
+
+/// The vector type holding right-hand sides of solves with matrix type M.
+template<class M>
+using range_vector_t = typename details::solver_traits<M>::range_type;
+
+/**
+ * @brief: Scratch vectors of conjugate_gradient. Reusing one workspace for
+ * repeated solves of the same size avoids all allocations with
+ * execution::seq. With execution::par every matrix vector product of a
+ * dynamic matrix starts its threads anew.
+ */
+template<class M>
+struct CgWorkspace
+{
+    domain_vector_t<M> residual;
+    domain_vector_t<M> preconditioned;
+    domain_vector_t<M> direction;
+    domain_vector_t<M> product;
+    domain_vector_t<M> inverse_diagonal;
+};
+
+/**
+ * @brief: Scratch vectors of least_squares. Reusing one workspace for
+ * repeated solves of the same size avoids all allocations with
+ * execution::seq. With execution::par every matrix vector product of a
+ * dynamic matrix starts its threads anew, and the transposed products of a
+ * CsrMatrix allocate partial sums per thread.
+ */
+template<class M>
+struct LeastSquaresWorkspace
+{
+    range_vector_t<M>  residual;
+    range_vector_t<M>  product;
+    domain_vector_t<M> gradient;
+    domain_vector_t<M> preconditioned;
+    domain_vector_t<M> direction;
+    domain_vector_t<M> inverse_norms;
+};
+
+/**
+ * @brief: Solve the symmetric positive definite system a * x = b with the
+ * preconditioned conjugate gradient method.
+ *
+ * Works for Matrix, DMatrix and CsrMatrix alike. With execution::par the
+ * matrix vector products of dynamic matrices run multi-threaded.
+ *
+ * @param policy execution::seq or execution::par.
+ * @param a A symmetric positive definite matrix.
+ * @param b The right-hand side.
+ * @param x The initial guess on input, the solution on output.
+ * @param workspace Scratch storage, resized as needed.
+ *
+ * @return Iterations and final relative residual. Stops early, reporting no
+ * convergence, when a turns out not to be positive definite.
+ *
+ * @throws std::invalid_argument If a is not square or b or x do not match
+ * its size.
+ */
+template<class Policy,
+         class M,
+         typename = enable_if_execution_policy_t<Policy>>
+SolverResult conjugate_gradient(const Policy &            policy,
+                                const M &                 a,
+                                const range_vector_t<M> & b,
+                                domain_vector_t<M> &      x,
+                                CgWorkspace<M> &          workspace,
+                                const SolverOptions &     options = {})
+{
+    using T      = typename details::solver_traits<M>::value_type;
+    using traits = details::solver_traits<M>;
+    static_assert(std::is_floating_point_v<T>,
+                  "The iterative solvers require floating-point matrices");
+
+    const size_t n = traits::cols(a);
+    if (traits::rows(a) != n || details::length(b) != n
+        || details::length(x) != n)
+    {
+        throw std::invalid_argument(
+            "colibra::conjugate_gradient: dimension mismatch");
+    }
+
+    auto &r = workspace.residual;
+    auto &z = workspace.preconditioned;
+    auto &p = workspace.direction;
+    auto &q = workspace.product;
+    auto &d = workspace.inverse_diagonal;
+    details::fit(r, n);
+    details::fit(z, n);
+    details::fit(p, n);
+    details::fit(q, n);
+    details::fit(d, n);
+    if (options.preconditioner == Preconditioner::jacobi)
+    {
+        details::inverse_diagonal(a, d);
+    }
+    else
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            d[i] = T {1};
+        }
+    }
+
+    SolverResult result;
+    const T      tolerance = details::default_tolerance<T>(options.tolerance);
+    const size_t max_iterations =
+        options.max_iterations > 0 ? options.max_iterations : 2 * n;
+    const T b_norm = std::sqrt(details::dot(b, b));
+    if (b_norm == T {0})
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            x[i] = T {0};
+        }
+        result.converged = true;
+        return result;
+    }
+
+    details::apply(policy, a, x, q);
+    for (size_t i = 0; i < n; ++i)
+    {
+        r[i] = b[i] - q[i];
+    }
+    details::scale(d, r, z);
+    p    = z;
+    T rz = details::dot(r, z);
+
+    while (true)
+    {
+        const T relative = std::sqrt(details::dot(r, r)) / b_norm;
+        result.residual  = static_cast<double>(relative);
+        if (relative <= tolerance)
+        {
+            result.converged = true;
+            break;
+        }
+        if (result.iterations == max_iterations)
+        {
+            break;
+        }
+        ++result.iterations;
+
+        details::apply(policy, a, p, q);
+        const T curvature = details::dot(p, q);
+        if (!(curvature > T {0}))
+        {
+            break;
+        }
+        const T alpha = rz / curvature;
+        details::axpy(alpha, p, x);
+        details::axpy(-alpha, q, r);
+
+        details::scale(d, r, z);
+        const T rz_next = details::dot(r, z);
+        details::xpby(z, rz_next / rz, p);
+        rz = rz_next;
+    }
+    return result;
+}
+
+template<class M>
+SolverResult conjugate_gradient(const M &                 a,
+                                const range_vector_t<M> & b,
+                                domain_vector_t<M> &      x,
+                                CgWorkspace<M> &          workspace,
+                                const SolverOptions &     options = {})
+{
+    return conjugate_gradient(execution::seq, a, b, x, workspace, options);
+}
+
+/**
+ * @brief: Solve a * x = b with conjugate gradients, using a temporary
+ * workspace.
+ */
+template<class M>
+SolverResult conjugate_gradient(const M &                 a,
+                                const range_vector_t<M> & b,
+                                domain_vector_t<M> &      x,
+                                const SolverOptions &     options = {})
+{
+    CgWorkspace<M> workspace;
+    return conjugate_gradient(execution::seq, a, b, x, workspace, options);
+}
+
+/**
+ * @brief: Minimize |a * x - b| with the conjugate gradient method applied to
+ * the normal equations (CGLS).
+ *
+ * transpose(a) * a is never formed, every iteration multiplies with a and
+ * its transpose once, so this works for tall dense and sparse systems such
+ * as Jacobians. Works for Matrix, DMatrix and CsrMatrix alike.
+ *
+ * @param policy execution::seq or execution::par.
+ * @param a The r x c system matrix, usually with r >= c.
+ * @param b The r observations.
+ * @param x The initial guess on input, the solution on output.
+ * @param workspace Scratch storage, resized as needed.
+ *
+ * @throws std::invalid_argument If b or x do not match the size of a.
+ */
+template<class Policy,
+         class M,
+         typename = enable_if_execution_policy_t<Policy>>
+SolverResult least_squares(const Policy &             policy,
+                           const M &                  a,
+                           const range_vector_t<M> &  b,
+                           domain_vector_t<M> &       x,
+                           LeastSquaresWorkspace<M> & workspace,
+                           const SolverOptions &      options = {})
+{
+    using T      = typename details::solver_traits<M>::value_type;
+    using traits = details::solver_traits<M>;
+    static_assert(std::is_floating_point_v<T>,
+                  "The iterative solvers require floating-point matrices");
+
+    const size_t rows = traits::rows(a);
+    const size_t cols = traits::cols(a);
+    if (details::length(b) != rows || details::length(x) != cols)
+    {
+        throw std::invalid_argument(
+            "colibra::least_squares: dimension mismatch");
+    }
+
+    auto &r = workspace.residual;
+    auto &q = workspace.product;
+    auto &s = workspace.gradient;
+    auto &z = workspace.preconditioned;
+    auto &p = workspace.direction;
+    auto &d = workspace.inverse_norms;
+    details::fit(r, rows);
+    details::fit(q, rows);
+    details::fit(s, cols);
+    details::fit(z, cols);
+    details::fit(p, cols);
+    details::fit(d, cols);
+    if (options.preconditioner == Preconditioner::jacobi)
+    {
+        details::inverse_column_norms(a, d);
+    }
+    else
+    {
+        for (size_t j = 0; j < cols; ++j)
+        {
+            d[j] = T {1};
+        }
+    }
+
+    SolverResult result;
+    const T      tolerance = details::default_tolerance<T>(options.tolerance);
+    const size_t max_iterations =
+        options.max_iterations > 0 ? options.max_iterations : 2 * cols;
+
+    details::apply_transpose(policy, a, b, s);
+    const T reference = std::sqrt(details::dot(s, s));
+    if (reference == T {0})
+    {
+        for (size_t j = 0; j < cols; ++j)
+        {
+            x[j] = T {0};
+        }
+        result.converged = true;
+        return result;
+    }
+
+    details::apply(policy, a, x, q);
+    for (size_t i = 0; i < rows; ++i)
+    {
+        r[i] = b[i] - q[i];
+    }
+    details::apply_transpose(policy, a, r, s);
+    details::scale(d, s, z);
+    p       = z;
+    T gamma = details::dot(s, z);
+
+    while (true)
+    {
+        const T relative = std::sqrt(details::dot(s, s)) / reference;
+        result.residual  = static_cast<double>(relative);
+        if (relative <= tolerance)
+        {
+            result.converged = true;
+            break;
+        }
+        if (result.iterations == max_iterations)
+        {
+            break;
+        }
+        ++result.iterations;
+
+        details::apply(policy, a, p, q);
+        const T curvature = details::dot(q, q);
+        if (!(curvature > T {0}))
+        {
+            break;
+        }
+        const T alpha = gamma / curvature;
+        details::axpy(alpha, p, x);
+        details::axpy(-alpha, q, r);
+
+        details::apply_transpose(policy, a, r, s);
+        details::scale(d, s, z);
+        const T gamma_next = details::dot(s, z);
+        details::xpby(z, gamma_next / gamma, p);
+        gamma = gamma_next;
+    }
+    return result;
+}
+
+template<class M>
+SolverResult least_squares(const M &                  a,
+                           const range_vector_t<M> &  b,
+                           domain_vector_t<M> &       x,
+                           LeastSquaresWorkspace<M> & workspace,
+                           const SolverOptions &      options = {})
+{
+    return least_squares(execution::seq, a, b, x, workspace, options);
+}
+
+/**
+ * @brief: Minimize |a * x - b| with CGLS, using a temporary workspace.
+ */
+template<class M>
+SolverResult least_squares(const M &                 a,
+                           const range_vector_t<M> & b,
+                           domain_vector_t<M> &      x,
+                           const SolverOptions &     options = {})
+{
+    LeastSquaresWorkspace<M> workspace;
+    return least_squares(execution::seq, a, b, x, workspace, options);
+}
+
+} // namespace colibra
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef COLIBRA_SPAN_H
+#define COLIBRA_SPAN_H
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace colibra {
+
+/**
+ * @brief: A non-owning view onto a contiguous sequence of elements.
+ *
+ * This is a minimal stand-in for C++20's std::span, used by the batch APIs to
+ * accept and produce contiguous data without copying.
+ *
+ * @tparam T The element type. May be const qualified for read-only views.
+ */
+template<typename T>
+class Span
+{
+  public:
+    using element_type = T;
+    using value_type   = std::remove_cv_t<T>;
+    using pointer      = T *;
+    using iterator     = T *;
+
+    constexpr Span() noexcept = default;
+
+    /**
+     * @brief: View size elements starting at data.
+     */
+    constexpr Span(T *data, size_t size) noexcept
+        : m_data(data)
+        , m_size(size)
+    {
+    }
+
+    /**
+     * @brief: View a C style array.
+     */
+    template<size_t N>
+    constexpr Span(T (&array)[N]) noexcept
+        : m_data(array)
+        , m_size(N)
+    {
+    }
+
+    /**
+     * @brief: View any contiguous container providing data() and size(), for
+     * example std::vector or std::array.
+     */
+    template<typename C,
+             typename = std::enable_if_t<
+                 !std::is_same_v<std::remove_cv_t<C>, Span>
+                 && std::is_convertible_v<decltype(std::declval<C &>().data()),
+                                          T *>>>
+    constexpr Span(C &container) noexcept
+        : m_data(container.data())
+        , m_size(container.size())
+    {
+    }
+
+    /**
+     * @brief: Allow implicit conversion from Span<T> to Span<const T>.
+     */
+    template<typename U,
+             typename = std::enable_if_t<!std::is_same_v<U, T>
+                                         && std::is_convertible_v<U *, T *>>>
+    constexpr Span(const Span<U> &other) noexcept
+        : m_data(other.data())
+        , m_size(other.size())
+    {
+    }
+
+    [[nodiscard]] constexpr T *data() const noexcept
+    {
+        return m_data;
+    }
+
+    [[nodiscard]] constexpr size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    [[nodiscard]] constexpr size_t size_bytes() const noexcept
+    {
+        return m_size * sizeof(T);
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    [[nodiscard]] constexpr iterator begin() const noexcept
+    {
+        return m_data;
+    }
+
+    [[nodiscard]] constexpr iterator end() const noexcept
+    {
+        return m_data + m_size;
+    }
+
+    /**
+     * @brief: Access the element at the given index.
+     *
+     * @warning Does not perform range-checking.
+     */
+    [[nodiscard]] constexpr T &operator[](const size_t p) const
+    {
+        return m_data[p];
+    }
+
+    /**
+     * @brief: Create a view onto count elements starting at offset.
+     *
+     * @throws std::out_of_range When the requested range exceeds this Span.
+     */
+    [[nodiscard]] constexpr Span subspan(const size_t offset,
+                                         const size_t count) const
+    {
+        if (offset > m_size || count > m_size - offset)
+        {
+            throw std::out_of_range("colibra::Span::subspan out of range");
+        }
+        return Span(m_data + offset, count);
+    }
+
+  private:
+    T *    m_data = nullptr;
+    size_t m_size = 0;
+};
+
+/**
+ * @brief: Template deduction guides so that Span(container) picks up the
+ * element type and constness of the container.
+ */
+template<typename T, size_t N>
+Span(T (&)[N])->Span<T>;
+
+template<typename T, typename A>
+Span(std::vector<T, A> &)->Span<T>;
+
+template<typename T, typename A>
+Span(const std::vector<T, A> &)->Span<const T>;
+
+template<typename T, size_t N>
+Span(std::array<T, N> &)->Span<T>;
+
+template<typename T, size_t N>
+Span(const std::array<T, N> &)->Span<const T>;
+
+} // namespace colibra
+
+#endif
@@ -0,0 +1,526 @@
+#ifndef COLIBRA_SPARSE_H
+#define COLIBRA_SPARSE_H
+
+#include "batch_ops.h"
+#include "details/parallel.hpp"
+#include "details/sparse.hpp"
+#include "dmatrix.h"
+#include "execution.h"
+#include "matrix.h"
+#include "promotion.h"
+#include "span.h"
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace colibra {
+
+template<typename T>
+class SparseBuilder;
+
+/**
+ * @brief: A sparse Matrix in compressed sparse row (CSR) format.
+ *
+ * The nonzeros of row i are stored at [offsets()[i], offsets()[i + 1]) of
+ * columns() and values(), sorted by column. Instances are assembled with a
+ * SparseBuilder. Once built, the sparsity pattern is fixed, but the values
+ * may be overwritten in place, e.g. when a Jacobian is re-evaluated.
+ *
+ * @tparam T The data type of the nonzeros.
+ */
+template<typename T>
+class CsrMatrix
+{
+  public:
+    using index_type = details::sparse_index;
+
+    /**
+     * @brief: Create an empty 0 x 0 CsrMatrix.
+     */
+    CsrMatrix()
+        : m_offsets(1, 0)
+    {
+    }
+
+    [[nodiscard]] size_t rows() const
+    {
+        return m_rows;
+    }
+
+    [[nodiscard]] size_t cols() const
+    {
+        return m_cols;
+    }
+
+    [[nodiscard]] size_t nonzeros() const
+    {
+        return m_values.size();
+    }
+
+    /**
+     * @brief: rows() + 1 offsets into columns() and values().
+     */
+    [[nodiscard]] Span<const size_t> offsets() const
+    {
+        return Span<const size_t>(m_offsets.data(), m_offsets.size());
+    }
+
+    [[nodiscard]] Span<const index_type> columns() const
+    {
+        return Span<const index_type>(m_columns.data(), m_columns.size());
+    }
+
+    [[nodiscard]] Span<const T> values() const
+    {
+        return Span<const T>(m_values.data(), m_values.size());
+    }
+
+    [[nodiscard]] Span<T> values()
+    {
+        return Span<T>(m_values.data(), m_values.size());
+    }
+
+    /**
+     * @brief: Look up the element in row i and column j, zero if it is not
+     * stored.
+     *
+     * @throws std::out_of_range When accessing elements out of range.
+     */
+    [[nodiscard]] T at(const size_t i, const size_t j) const
+    {
+        if (i >= m_rows || j >= m_cols)
+        {
+            throw std::out_of_range("colibra::CsrMatrix::at out of range");
+        }
+        const auto first = m_columns.begin() + m_offsets[i];
+        const auto last  = m_columns.begin() + m_offsets[i + 1];
+        const auto found = std::lower_bound(first, last, j);
+        if (found == last || *found != j)
+        {
+            return T {};
+        }
+        return m_values[found - m_columns.begin()];
+    }
+
+    /**
+     * @brief: Expand into a dense DMatrix.
+     */
+    [[nodiscard]] DMatrix<T> to_dense() const
+    {
+        DMatrix<T> dense(m_rows, m_cols);
+        for (size_t i = 0; i < m_rows; ++i)
+        {
+            for (size_t k = m_offsets[i]; k < m_offsets[i + 1]; ++k)
+            {
+                dense(i, m_columns[k]) = m_values[k];
+            }
+        }
+        return dense;
+    }
+
+    /**
+     * @brief: Create the transposed CsrMatrix.
+     *
+     * Prefer spmv_transpose to multiply with the transpose only once.
+     */
+    [[nodiscard]] CsrMatrix transpose() const
+    {
+        CsrMatrix result;
+        result.m_rows = m_cols;
+        result.m_cols = m_rows;
+        result.m_offsets.assign(m_cols + 1, 0);
+        result.m_columns.resize(m_columns.size());
+        result.m_values.resize(m_values.size());
+        for (const index_type j : m_columns)
+        {
+            ++result.m_offsets[j + 1];
+        }
+        for (size_t j = 0; j < m_cols; ++j)
+        {
+            result.m_offsets[j + 1] += result.m_offsets[j];
+        }
+        // Rows are visited in order, so every transposed row ends up
+        // sorted by column.
+        std::vector<size_t> next(result.m_offsets.begin(),
+                                 result.m_offsets.end() - 1);
+        for (size_t i = 0; i < m_rows; ++i)
+        {
+            for (size_t k = m_offsets[i]; k < m_offsets[i + 1]; ++k)
+            {
+                const size_t slot      = next[m_columns[k]]++;
+                result.m_columns[slot] = static_cast<index_type>(i);
+                result.m_values[slot]  = m_values[k];
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief: Multiply this CsrMatrix with a column vector, computed by
+     * spmv on the calling thread.
+     *
+     * The element type of the result follows the default promotion policy,
+     * see promotion.h.
+     *
+     * @throws std::invalid_argument If vec does not have cols() elements.
+     */
+    template<class S, typename R = promoted_t<T, S>>
+    [[nodiscard]] std::vector<R> operator*(Span<S> vec) const;
+
+    template<class S, typename A, typename R = promoted_t<T, S>>
+    [[nodiscard]] std::vector<R>
+    operator*(const std::vector<S, A> &vec) const
+    {
+        return *this * Span<const S>(vec);
+    }
+
+  private:
+    friend class SparseBuilder<T>;
+
+    size_t                  m_rows = 0;
+    size_t                  m_cols = 0;
+    std::vector<size_t>     m_offsets;
+    std::vector<index_type> m_columns;
+    std::vector<T>          m_values;
+};
+
+/**
+ * @brief: Assembles a CsrMatrix from (row, column, value) triplets added in
+ * any order. Duplicate entries are summed, as is usual when assembling
+ * Jacobians and normal equations.
+ *
+ * The builder and the target CsrMatrix keep their storage across reset()
+ * and build(), so assembling a matrix of the same shape every frame does
+ * not allocate once capacities have grown.
+ */
+template<typename T>
+class SparseBuilder
+{
+  public:
+    SparseBuilder() = default;
+
+    /**
+     * @throws std::length_error If cols does not fit the 32 bit column
+     * indices.
+     */
+    SparseBuilder(const size_t rows, const size_t cols)
+    {
+        reset(rows, cols);
+    }
+
+    /**
+     * @brief: Drop all entries and change the shape, keeping the storage.
+     *
+     * @throws std::length_error If cols does not fit the 32 bit column
+     * indices.
+     */
+    void reset(const size_t rows, const size_t cols)
+    {
+        if (cols > std::numeric_limits<details::sparse_index>::max())
+        {
+            throw std::length_error(
+                "colibra::SparseBuilder: too many columns");
+        }
+        m_rows = rows;
+        m_cols = cols;
+        m_row_indices.clear();
+        m_columns.clear();
+        m_values.clear();
+    }
+
+    /**
+     * @brief: Reserve storage for the given number of entries.
+     */
+    void reserve(const size_t entries)
+    {
+        m_row_indices.reserve(entries);
+        m_columns.reserve(entries);
+        m_values.reserve(entries);
+    }
+
+    [[nodiscard]] size_t rows() const
+    {
+        return m_rows;
+    }
+
+    [[nodiscard]] size_t cols() const
+    {
+        return m_cols;
+    }
+
+    /**
+     * @brief: The number of entries added so far, counting duplicates.
+     */
+    [[nodiscard]] size_t entries() const
+    {
+        return m_values.size();
+    }
+
+    /**
+     * @brief: Add value to the element in row i and column j.
+     *
+     * @throws std::out_of_range If (i, j) lies outside the matrix.
+     */
+    void add(const size_t i, const size_t j, const T &value)
+    {
+        if (i >= m_rows || j >= m_cols)
+        {
+            throw std::out_of_range("colibra::SparseBuilder::add out of range");
+        }
+        m_row_indices.push_back(i);
+        m_columns.push_back(static_cast<details::sparse_index>(j));
+        m_values.push_back(value);
+    }
+
+    /**
+     * @brief: Add a dense block with its top left corner at row i and
+     * column j, e.g. the Jacobian of one residual with respect to one
+     * pose.
+     *
+     * @throws std::out_of_range If the block does not fit the matrix.
+     */
+    template<size_t r, size_t c>
+    void add_block(const size_t i, const size_t j, const Matrix<r, c, T> &block)
+    {
+        if (i + r > m_rows || j + c > m_cols)
+        {
+            throw std::out_of_range(
+                "colibra::SparseBuilder::add_block out of range");
+        }
+        for (size_t bi = 0; bi < r; ++bi)
+        {
+            for (size_t bj = 0; bj < c; ++bj)
+            {
+                add(i + bi, j + bj, block(bi, bj));
+            }
+        }
+    }
+
+    [[nodiscard]] CsrMatrix<T> build() const
+    {
+        CsrMatrix<T> matrix;
+        build(matrix);
+        return matrix;
+    }
+
+    /**
+     * @brief: Assemble the entries into out, reusing its storage.
+     *
+     * Entries are bucketed by row with a counting sort, then every row is
+     * sorted by column and duplicates are summed.
+     */
+    void build(CsrMatrix<T> &out) const
+    {
+        out.m_rows    = m_rows;
+        out.m_cols    = m_cols;
+        auto &offsets = out.m_offsets;
+        auto &columns = out.m_columns;
+        auto &values  = out.m_values;
+
+        offsets.assign(m_rows + 1, 0);
+        for (const size_t i : m_row_indices)
+        {
+            ++offsets[i + 1];
+        }
+        for (size_t i = 0; i < m_rows; ++i)
+        {
+            offsets[i + 1] += offsets[i];
+        }
+
+        // Scatter the entries into their rows, using the row starts as
+        // insertion cursors and shifting them back afterwards.
+        columns.resize(m_values.size());
+        values.resize(m_values.size());
+        for (size_t n = 0; n < m_values.size(); ++n)
+        {
+            const size_t slot = offsets[m_row_indices[n]]++;
+            columns[slot]     = m_columns[n];
+            values[slot]      = m_values[n];
+        }
+        for (size_t i = m_rows; i > 0; --i)
+        {
+            offsets[i] = offsets[i - 1];
+        }
+        offsets[0] = 0;
+
+        size_t out_end = 0;
+        for (size_t i = 0; i < m_rows; ++i)
+        {
+            const size_t begin = offsets[i];
+            const size_t end   = offsets[i + 1];
+            sort_row(columns, values, begin, end);
+
+            offsets[i] = out_end;
+            for (size_t k = begin; k < end; ++k)
+            {
+                if (out_end > offsets[i] && columns[out_end - 1] == columns[k])
+                {
+                    values[out_end - 1] += values[k];
+                    continue;
+                }
+                columns[out_end] = columns[k];
+                values[out_end]  = values[k];
+                ++out_end;
+            }
+        }
+        offsets[m_rows] = out_end;
+        columns.resize(out_end);
+        values.resize(out_end);
+    }
+
+  private:
+    size_t                             m_rows = 0;
+    size_t                             m_cols = 0;
+    std::vector<size_t>                m_row_indices;
+    std::vector<details::sparse_index> m_columns;
+    std::vector<T>                     m_values;
+
+    /// Insertion sort, rows of sparse matrices are short and often
+    /// already sorted when assembled block by block.
+    static void sort_row(std::vector<details::sparse_index> &columns,
+                         std::vector<T> &                    values,
+                         const size_t                        begin,
+                         const size_t                        end)
+    {
+        for (size_t k = begin + 1; k < end; ++k)
+        {
+            const details::sparse_index column = columns[k];
+            const T                     value  = values[k];
+            size_t                      n      = k;
+            for (; n > begin && columns[n - 1] > column; --n)
+            {
+                columns[n] = columns[n - 1];
+                values[n]  = values[n - 1];
+            }
+            columns[n] = column;
+            values[n]  = value;
+        }
+    }
+};
+
+/**
+ * @brief: Compute the sparse matrix vector product y = a * x.
+ *
+ * With execution::par the rows are split across threads, the grain of the
+ * policy counts nonzeros.
+ *
+ * @throws std::invalid_argument If x does not have a.cols() elements or y
+ * has fewer than a.rows().
+ */
+template<class Policy,
+         typename T,
+         typename S,
+         typename R,
+         typename = enable_if_execution_policy_t<Policy>>
+void spmv(const Policy &      policy,
+          const CsrMatrix<T> &a,
+          Span<S>             x,
+          Span<R>             y)
+{
+    if (x.size() != a.cols() || y.size() < a.rows())
+    {
+        throw std::invalid_argument("colibra::spmv: dimension mismatch");
+    }
+    const size_t per_row = a.nonzeros() / std::max<size_t>(a.rows(), 1);
+    details::parallel_for(
+        details::rows_policy(policy, std::max<size_t>(per_row, 1)),
+        a.rows(),
+        [&](const size_t begin, const size_t end) {
+            details::spmv_rows(a.offsets().data(),
+                               a.columns().data(),
+                               a.values().data(),
+                               x.data(),
+                               y.data(),
+                               begin,
+                               end);
+        });
+}
+
+template<typename T, typename S, typename R>
+void spmv(const CsrMatrix<T> &a, Span<S> x, Span<R> y)
+{
+    spmv(execution::seq, a, x, y);
+}
+
+/**
+ * @brief: Compute y = transpose(a) * x without forming the transpose.
+ *
+ * Every row of a scatters into y. With execution::par each thread scatters
+ * into its own buffer of a.cols() elements, and the buffers are summed
+ * afterwards, so this pays off for matrices with many more nonzeros than
+ * columns.
+ *
+ * @throws std::invalid_argument If x does not have a.rows() elements or y
+ * has fewer than a.cols().
+ */
+template<class Policy,
+         typename T,
+         typename S,
+         typename R,
+         typename = enable_if_execution_policy_t<Policy>>
+void spmv_transpose(const Policy &      policy,
+                    const CsrMatrix<T> &a,
+                    Span<S>             x,
+                    Span<R>             y)
+{
+    if (x.size() != a.rows() || y.size() < a.cols())
+    {
+        throw std::invalid_argument(
+            "colibra::spmv_transpose: dimension mismatch");
+    }
+    std::fill(y.data(), y.data() + a.cols(), R {});
+
+    const size_t per_row = a.nonzeros() / std::max<size_t>(a.rows(), 1);
+    std::mutex   merge;
+    details::parallel_for(
+        details::rows_policy(policy, std::max<size_t>(per_row, 1)),
+        a.rows(),
+        [&](const size_t begin, const size_t end) {
+            if (begin == 0 && end == a.rows())
+            {
+                details::spmv_transpose_rows(a.offsets().data(),
+                                             a.columns().data(),
+                                             a.values().data(),
+                                             x.data(),
+                                             y.data(),
+                                             begin,
+                                             end);
+                return;
+            }
+            std::vector<R> partial(a.cols());
+            details::spmv_transpose_rows(a.offsets().data(),
+                                         a.columns().data(),
+                                         a.values().data(),
+                                         x.data(),
+                                         partial.data(),
+                                         begin,
+                                         end);
+            const std::lock_guard<std::mutex> lock(merge);
+            for (size_t j = 0; j < a.cols(); ++j)
+            {
+                y[j] += partial[j];
+            }
+        });
+}
+
+template<typename T, typename S, typename R>
+void spmv_transpose(const CsrMatrix<T> &a, Span<S> x, Span<R> y)
+{
+    spmv_transpose(execution::seq, a, x, y);
+}
+
+template<typename T>
+template<class S, typename R>
+std::vector<R> CsrMatrix<T>::operator*(Span<S> vec) const
+{
+    std::vector<R> out(m_rows);
+    spmv(*this, vec, Span<R>(out));
+    return out;
+}
+
+} // namespace colibra
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef COLIBRA_TRANSFORM_H
+#define COLIBRA_TRANSFORM_H
+
+#include "matrix.h"
+#include "vector.h"
+
+namespace colibra {
+
+/**
+ * @brief: A rigid body transform in 3D, a rotation followed by a
+ * translation: p' = rotation * p + translation.
+ *
+ * The default value is the identity transform.
+ *
+ * @tparam T The data type of the transform.
+ */
+template<typename T>
+struct RigidTransform
+{
+    /// An orthonormal Matrix with determinant +1.
+    Matrix<3, 3, T> rotation = Matrix<3, 3, T>::identity();
+    Vector<3, T>    translation {};
+
+    [[nodiscard]] static constexpr RigidTransform identity()
+    {
+        return RigidTransform {};
+    }
+
+    /**
+     * @brief: Transform a point.
+     */
+    [[nodiscard]] constexpr Vector<3, T>
+    operator()(const Vector<3, T> &point) const
+    {
+        return rotation * point + translation;
+    }
+
+    /**
+     * @brief: Compose two transforms, (a * b)(p) == a(b(p)).
+     */
+    [[nodiscard]] constexpr RigidTransform
+    operator*(const RigidTransform &other) const
+    {
+        return RigidTransform {rotation * other.rotation,
+                               rotation * other.translation + translation};
+    }
+
+    /**
+     * @brief: The inverse transform, using that the inverse of a rotation is
+     * its transpose.
+     */
+    [[nodiscard]] constexpr RigidTransform inverse() const
+    {
+        const Matrix<3, 3, T> transposed = rotation.transpose();
+        return RigidTransform {transposed, -(transposed * translation)};
+    }
+};
+
+/**
+ * @brief: A rigid body transform with an additional uniform scale:
+ * p' = scale * rotation * p + translation.
+ *
+ * @tparam T The data type of the transform.
+ */
+template<typename T>
+struct SimilarityTransform
+{
+    /// An orthonormal Matrix with determinant +1.
+    Matrix<3, 3, T> rotation = Matrix<3, 3, T>::identity();
+    Vector<3, T>    translation {};
+    T               scale {1};
+
+    /**
+     * @brief: Transform a point.
+     */
+    [[nodiscard]] constexpr Vector<3, T>
+    operator()(const Vector<3, T> &point) const
+    {
+        return rotation * point * scale + translation;
+    }
+
+    /**
+     * @brief: The rotation and translation without the scale.
+     */
+    [[nodiscard]] constexpr RigidTransform<T> rigid() const
+    {
+        return RigidTransform<T> {rotation, translation};
+    }
+};
+
+} // namespace colibra
+
+#endif
@@ -0,0 +1,298 @@
+#ifndef COLIBRA_TRANSFORM_BUFFER_H
+#define COLIBRA_TRANSFORM_BUFFER_H
+
+#include "details/transform_buffer.hpp"
+#include "quaternion.h"
+#include "transform.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+namespace colibra {
+
+/**
+ * @brief: The recent history of a moving frame transform, a ring buffer of
+ * timestamped RigidTransforms that is interpolated at arbitrary times.
+ *
+ * One producer thread appends transforms with increasing timestamps while
+ * any number of threads look them up. Lookups are lock-free and only read
+ * shared memory: each entry is guarded by a sequence number, and a lookup
+ * that races with the producer overwriting its entries retries.
+ *
+ * lookup(time) binary searches the history in O(log n). A Cursor remembers
+ * where the previous lookup ended, so a reader whose query times increase
+ * finds each one in amortized O(1).
+ *
+ * The buffer is neither copyable nor movable, readers hold references to it.
+ *
+ * @tparam T The data type of the transforms.
+ * @tparam Time The type of the timestamps, a floating point or integer type.
+ */
+template<typename T, typename Time = double>
+class TransformBuffer
+{
+    static_assert(std::is_floating_point_v<T>,
+                  "colibra::TransformBuffer requires a floating point type");
+    static_assert(std::is_arithmetic_v<Time>,
+                  "colibra::TransformBuffer requires arithmetic timestamps");
+
+    using Pose = details::TimedPose<T, Time>;
+    using Slot = details::TransformSlot<T, Time>;
+
+  public:
+    /**
+     * @brief: Where a reader's previous lookup ended. Each reader thread
+     * keeps its own.
+     */
+    struct Cursor
+    {
+        uint64_t entry = 0;
+    };
+
+    /**
+     * @brief: Create an empty buffer holding the latest capacity transforms,
+     * rounded up to a power of two.
+     *
+     * @throws std::invalid_argument If capacity is smaller than two.
+     */
+    explicit TransformBuffer(const size_t capacity)
+    {
+        if (capacity < 2)
+        {
+            throw std::invalid_argument(
+                "colibra::TransformBuffer: capacity must be at least two");
+        }
+        size_t rounded = 2;
+        while (rounded < capacity)
+        {
+            rounded *= 2;
+        }
+        m_slots    = std::make_unique<Slot[]>(rounded);
+        m_capacity = rounded;
+    }
+
+    TransformBuffer(const TransformBuffer &)            = delete;
+    TransformBuffer &operator=(const TransformBuffer &) = delete;
+
+    [[nodiscard]] size_t capacity() const
+    {
+        return m_capacity;
+    }
+
+    /**
+     * @brief: The number of transforms held, at most capacity(). May grow
+     * concurrently.
+     */
+    [[nodiscard]] size_t size() const
+    {
+        const uint64_t count = m_count.load(std::memory_order_acquire);
+        return static_cast<size_t>(count < m_capacity ? count : m_capacity);
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return m_count.load(std::memory_order_acquire) == 0;
+    }
+
+    /**
+     * @brief: Append the transform at time, replacing the oldest one when
+     * the buffer is full. Only one thread may push.
+     *
+     * @throws std::invalid_argument If time is not later than the newest
+     * transform.
+     */
+    void push(const Time time, const RigidTransform<T> &transform)
+    {
+        const uint64_t count = m_count.load(std::memory_order_relaxed);
+        if (count > 0 && !(m_newest < time))
+        {
+            throw std::invalid_argument(
+                "colibra::TransformBuffer::push: timestamps must increase");
+        }
+        details::write_slot(
+            slot(count),
+            count,
+            Pose {time,
+                  Quaternion<T>::from_matrix(transform.rotation),
+                  transform.translation});
+        m_newest = time;
+        m_count.store(count + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief: The transform at time, interpolated between the two entries
+     * around it.
+     *
+     * @throws std::out_of_range If time is before the oldest or after the
+     * newest transform held.
+     */
+    [[nodiscard]] RigidTransform<T> lookup(const Time time) const
+    {
+        Cursor cursor;
+        return lookup(time, cursor);
+    }
+
+    /**
+     * @brief: The transform at time, starting the search where cursor
+     * points and leaving it at the entry found. Amortized O(1) when time
+     * increases from call to call.
+     *
+     * @throws std::out_of_range If time is before the oldest or after the
+     * newest transform held.
+     */
+    [[nodiscard]] RigidTransform<T> lookup(const Time time,
+                                           Cursor    &cursor) const
+    {
+        while (true)
+        {
+            const uint64_t count = m_count.load(std::memory_order_acquire);
+            if (count == 0)
+            {
+                throw std::out_of_range(
+                    "colibra::TransformBuffer::lookup: buffer is empty");
+            }
+            const uint64_t oldest = count > m_capacity ? count - m_capacity : 0;
+            const uint64_t newest = count - 1;
+
+            uint64_t entry = 0;
+            Pose     before;
+            Pose     after;
+            if (!find(time, oldest, newest, cursor.entry, entry)
+                || !details::read_slot(slot(entry), entry, before))
+            {
+                continue;
+            }
+            if (time < before.time)
+            {
+                throw std::out_of_range("colibra::TransformBuffer::lookup: "
+                                        "time is before the oldest transform");
+            }
+            cursor.entry = entry;
+            if (entry == newest)
+            {
+                if (time == before.time)
+                {
+                    return RigidTransform<T> {before.rotation.to_matrix(),
+                                              before.translation};
+                }
+                throw std::out_of_range("colibra::TransformBuffer::lookup: "
+                                        "time is after the newest transform");
+            }
+            if (!details::read_slot(slot(entry + 1), entry + 1, after))
+            {
+                continue;
+            }
+            return details::interpolate(before, after, time);
+        }
+    }
+
+  private:
+    std::unique_ptr<Slot[]> m_slots;
+    size_t                  m_capacity = 0;
+    /// Entries pushed so far. It starts a new cache line, so pushes do not
+    /// invalidate the line holding the members above.
+    alignas(64) std::atomic<uint64_t> m_count {0};
+    /// Producer only, the time of the newest entry.
+    Time m_newest {};
+
+    [[nodiscard]] Slot &slot(const uint64_t entry)
+    {
+        return m_slots[static_cast<size_t>(entry & (m_capacity - 1))];
+    }
+
+    [[nodiscard]] const Slot &slot(const uint64_t entry) const
+    {
+        return m_slots[static_cast<size_t>(entry & (m_capacity - 1))];
+    }
+
+    /// The time of entry, false if it was overwritten.
+    [[nodiscard]] bool time_of(const uint64_t entry, Time &time) const
+    {
+        return details::read_time(slot(entry), entry, time);
+    }
+
+    /**
+     * Find the last entry in [low, high] at or before time, or low if there
+     * is none. Starts at hint when it lies in the range and before time,
+     * probing hint + 1, hint + 2, hint + 4, ... before the binary search.
+     * False if an entry was overwritten during the search.
+     */
+    [[nodiscard]] bool find(const Time     time,
+                            uint64_t       low,
+                            uint64_t       high,
+                            const uint64_t hint,
+                            uint64_t      &entry) const
+    {
+        Time probe {};
+        if (hint > low && hint < high)
+        {
+            if (!time_of(hint, probe)) return false;
+            if (!(time < probe))
+            {
+                low = hint;
+                for (uint64_t step = 1; low < high; step *= 2)
+                {
+                    const uint64_t next = low + step < high ? low + step : high;
+                    if (!time_of(next, probe)) return false;
+                    if (time < probe)
+                    {
+                        high = next - 1;
+                        break;
+                    }
+                    low = next;
+                }
+            }
+            else
+            {
+                high = hint - 1;
+            }
+        }
+        // Invariant: time(low) <= time, or low is the oldest entry, and
+        // every entry after high is later than time.
+        while (low < high)
+        {
+            const uint64_t mid = low + (high - low + 1) / 2;
+            if (!time_of(mid, probe)) return false;
+            if (time < probe)
+            {
+                high = mid - 1;
+            }
+            else
+            {
+                low = mid;
+            }
+        }
+        entry = low;
+        return true;
+    }
+};
+
+/**
+ * @brief: The composition of several frame transforms at the same time,
+ * first.lookup(time) * ... * last.lookup(time). For buffers holding
+ * world <- base and base <- sensor this maps sensor points to the world.
+ *
+ * @throws std::out_of_range If any buffer can not be looked up at time.
+ */
+template<typename T, typename Time, class... Rest>
+[[nodiscard]] RigidTransform<T>
+lookup_composed(const details::identity_t<Time> time,
+                const TransformBuffer<T, Time> &first,
+                const Rest &...rest)
+{
+    if constexpr (sizeof...(Rest) == 0)
+    {
+        return first.lookup(time);
+    }
+    else
+    {
+        return first.lookup(time) * lookup_composed<T, Time>(time, rest...);
+    }
+}
+
+} // namespace colibra
+
+#endif
@@ -0,0 +1,140 @@
+#ifndef COLIBRA_TRANSFORM_STORE_H
+#define COLIBRA_TRANSFORM_STORE_H
+
+#include "details/transform_store.hpp"
+#include "transform.h"
+#include "vector.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+namespace colibra {
+
+/**
+ * @brief: The current transform of a fixed set of frames, published by
+ * writer threads and read by any number of threads without locks.
+ *
+ * Reads never block and never write shared memory, so readers do not take
+ * ownership of cache lines away from each other or from the writer. Each
+ * frame keeps two seqlocked copies of its transform and publish() writes
+ * the one not holding the current version: a read only retries when the
+ * reader is preempted while two publishes of its frame complete.
+ *
+ * Different frames may be published from different threads concurrently,
+ * but each frame must have at most one writer at a time.
+ *
+ * The store is neither copyable nor movable, readers hold references to it.
+ *
+ * @tparam T The floating point data type of the transforms.
+ */
+template<typename T>
+class TransformStore
+{
+    static_assert(std::is_floating_point_v<T>,
+                  "colibra::TransformStore requires a floating point type");
+
+    using Slot = details::FrameSlot<T>;
+
+  public:
+    /**
+     * @brief: Create a store of frames, all holding the identity transform.
+     */
+    explicit TransformStore(const size_t frames)
+      : m_slots(std::make_unique<Slot[]>(frames)), m_size(frames)
+    {
+        for (size_t f = 0; f < frames; ++f)
+        {
+            details::write_copy(
+                m_slots[f].copies[0], 0, RigidTransform<T>::identity());
+        }
+    }
+
+    TransformStore(const TransformStore &)            = delete;
+    TransformStore &operator=(const TransformStore &) = delete;
+
+    [[nodiscard]] size_t size() const
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief: Replace the transform of frame. Readers see either the
+     * previous or the new transform, never a mix of both.
+     *
+     * @throws std::out_of_range If frame is not smaller than size().
+     */
+    void publish(const size_t frame, const RigidTransform<T> &transform)
+    {
+        check(frame);
+        Slot          &slot    = m_slots[frame];
+        const uint64_t version =
+            slot.version.load(std::memory_order_relaxed) + 1;
+        details::write_copy(slot.copies[version & 1], version, transform);
+        slot.version.store(version, std::memory_order_release);
+    }
+
+    /**
+     * @brief: The number of transforms published for frame so far, which
+     * lets a reader skip work when a frame did not change.
+     *
+     * @throws std::out_of_range If frame is not smaller than size().
+     */
+    [[nodiscard]] uint64_t version(const size_t frame) const
+    {
+        check(frame);
+        return m_slots[frame].version.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief: The latest transform published for frame.
+     *
+     * @throws std::out_of_range If frame is not smaller than size().
+     */
+    [[nodiscard]] RigidTransform<T> load(const size_t frame) const
+    {
+        check(frame);
+        const Slot       &slot = m_slots[frame];
+        RigidTransform<T> transform;
+        while (true)
+        {
+            const uint64_t version =
+                slot.version.load(std::memory_order_acquire);
+            if (details::read_copy(
+                    slot.copies[version & 1], version, transform))
+            {
+                return transform;
+            }
+        }
+    }
+
+    /**
+     * @brief: Map point with the latest transform of frame.
+     *
+     * @throws std::out_of_range If frame is not smaller than size().
+     */
+    [[nodiscard]] Vector<3, T> operator()(const size_t        frame,
+                                          const Vector<3, T> &point) const
+    {
+        return load(frame)(point);
+    }
+
+  private:
+    std::unique_ptr<Slot[]> m_slots;
+    size_t                  m_size = 0;
+
+    void check(const size_t frame) const
+    {
+        if (frame >= m_size)
+        {
+            throw std::out_of_range(
+                "colibra::TransformStore: frame out of range");
+        }
+    }
+};
+
+} // namespace colibra
+
+#endif
@@ -131,67 +131,89 @@ class Vector : details::Vector<l, T>
      * @brief: Dot multiply this Vector with another.
      *
      * This automatically adjuncts one of the Vectors from column-major to
-     * row-major. This function also automatically promotes the return type
-     * if necessary.
+     * row-major. The return type follows the default promotion policy, see
+     * promotion.h.
      *
      * @param other The other Vector.
      *
      * @return The possibly promoted scalar multiplication result of this
      * transposed Vector with another of the same rank.
      */
-    template<class S, typename R = std::common_type_t<T, S>>
+    template<class S, typename R = promoted_t<T, S>>
     [[nodiscard]] constexpr R operator*(const Vector<l, S> &other) const
     {
-        return Impl_::operator*(other);
+        return dot<S, R>(other);
     }
 
 
     /**
      * @brief: Multiply this Vector with a scalar.
      *
-     * This call promotes return type if necessary.
+     * The element type of the result follows the default promotion policy,
+     * see promotion.h. Vector operands are rejected before the policy is
+     * consulted, so this never competes with the dot product.
      *
      * @param scalar The scalar value to multiply with.
      *
      * @return The resulting Vector, possibly promoted to a different data
      * type that can best support the arithmetic operation.
      */
-    template<class S, typename R = std::common_type_t<T, S>>
+    // The default of R rejects Vectors before the promotion policy is
+    // instantiated for them. Compilers check the concept only after default
+    // template arguments are substituted, it names the constraint in errors.
+#if COLIBRA_CONCEPTS
+    template<scalar_operand S,
+             typename R = promoted_t<T, details::scalar_operand_t<S>>>
+#else
+    template<class S,
+             typename R = promoted_t<T, details::scalar_operand_t<S>>>
+#endif
     [[nodiscard]] constexpr Vector<l, R> operator*(const S &scalar) const
     {
-        return Impl_::operator*(scalar);
+        const R factor = static_cast<R>(scalar);
+        return Vector<l, R>(details::generate<R, l>([&](const size_t i) {
+            return details::product<R>(static_cast<R>((*this)[i]), factor);
+        }));
     }
 
     /**
      * @brief: Vector addition.
      *
-     * This call promotes return type if necessary.
+     * The element type of the result follows the default promotion policy,
+     * see promotion.h.
      *
      * @param other The other vector to add to this one.
      *
      * @return The resulting Vector, possibly promoted to a different data
      * type that can best support the arithmetic operation.
      */
-    template<class S, typename R = std::common_type_t<T, S>>
+    template<class S, typename R = promoted_t<T, S>>
     [[nodiscard]] constexpr auto operator+(const Vector<l, S> &other) const
     {
-        return Impl_::operator+(other);
+        return Vector<l, R>(details::generate<R, l>([&](const size_t i) {
+            return details::plus<R>(static_cast<R>((*this)[i]),
+                                    static_cast<R>(other[i]));
+        }));
     }
 
     /**
      * @brief: Vector subtraction.
      *
-     * This call promotes return type if necessary.
+     * The element type of the result follows the default promotion policy,
+     * see promotion.h.
      *
      * @param other The other Vector to subtract from this one.
      *
      * @return The resulting Vector, possibly promoted to a different data
      * type that can best support the arithmetic operation.
      */
-    template<class S, typename R = std::common_type_t<T, S>>
+    template<class S, typename R = promoted_t<T, S>>
     [[nodiscard]] constexpr auto operator-(const Vector<l, S> &other) const
     {
-        return Impl_::operator-(other);
+        return Vector<l, R>(details::generate<R, l>([&](const size_t i) {
+            return details::minus<R>(static_cast<R>((*this)[i]),
+                                     static_cast<R>(other[i]));
+        }));
     }
 
     /**
@@ -199,9 +221,10 @@ class Vector : details::Vector<l, T>
      *
      * @returns The result of this Vector * -1.
      */
-    [[nodiscard]] constexpr auto operator-()
+    [[nodiscard]] constexpr auto operator-() const
     {
-        return Impl_::operator-();
+        return Vector(details::generate<T, l>(
+            [this](const size_t i) { return details::negate((*this)[i]); }));
     }
 
     /**
@@ -237,16 +260,20 @@ class Vector : details::Vector<l, T>
     /**
      * @brief: Calculate the dot product between this and another Vector.
      *
-     * This function automatically promotes the result type if necessary.
+     * The result type follows the default promotion policy, see
+     * promotion.h. Fixed-point results are accumulated exactly and rounded
+     * once, complex results are constexpr, see details::dot.
      *
      * @param other The other Vector
      *
      * @return The dot product.
      */
-    template<class S, typename R = std::common_type_t<T, S>>
-    [[nodiscard]] constexpr R dot(Vector<l, S> &other) const
+    template<class S, typename R = promoted_t<T, S>>
+    [[nodiscard]] constexpr R dot(const Vector<l, S> &other) const
     {
-        return Impl_::operator*(other);
+        return details::dot<R, l>(
+            [this](const size_t i) { return static_cast<R>((*this)[i]); },
+            [&other](const size_t i) { return static_cast<R>(other[i]); });
     }
 
     /**
@@ -266,6 +293,17 @@ class Vector : details::Vector<l, T>
     {
         return os << static_cast<Impl_>(vec);
     }
+
+  private:
+    template<size_t, typename>
+    friend class Vector;
+
+    /// The operators build their results from an array, which avoids
+    /// instantiating the variadic constructor for every result type.
+    explicit constexpr Vector(const array_type &array)
+        : Impl_(array)
+    {
+    }
 };
 
 /**
@@ -275,6 +313,85 @@ class Vector : details::Vector<l, T>
 template<typename R, typename... D>
 Vector(R val1, D... vals)->Vector<1 + sizeof...(D), R>;
 
+/**
+ * @brief: Multiply a Vector with a scalar, choosing the promotion policy for
+ * this operation only.
+ *
+ * @tparam Policy One of the policies in promotion.h.
+ */
+template<class Policy, size_t l, typename T, typename S>
+[[nodiscard]] constexpr auto multiply(const Vector<l, T> &vec, const S &scalar)
+{
+    return vec.template operator*<S, promoted_t<T, S, Policy>>(scalar);
+}
+
+/**
+ * @brief: Dot multiply two Vectors, choosing the promotion policy for this
+ * operation only.
+ *
+ * @tparam Policy One of the policies in promotion.h.
+ */
+template<class Policy, size_t l, typename T, typename S>
+[[nodiscard]] constexpr auto multiply(const Vector<l, T> &vec,
+                                      const Vector<l, S> &other)
+{
+    return vec.template operator*<S, promoted_t<T, S, Policy>>(other);
+}
+
+/**
+ * @brief: Add two Vectors, choosing the promotion policy for this operation
+ * only.
+ *
+ * @tparam Policy One of the policies in promotion.h.
+ */
+template<class Policy, size_t l, typename T, typename S>
+[[nodiscard]] constexpr auto add(const Vector<l, T> &vec,
+                                 const Vector<l, S> &other)
+{
+    return vec.template operator+<S, promoted_t<T, S, Policy>>(other);
+}
+
+/**
+ * @brief: Subtract two Vectors, choosing the promotion policy for this
+ * operation only.
+ *
+ * @tparam Policy One of the policies in promotion.h.
+ */
+template<class Policy, size_t l, typename T, typename S>
+[[nodiscard]] constexpr auto subtract(const Vector<l, T> &vec,
+                                      const Vector<l, S> &other)
+{
+    return vec.template operator-<S, promoted_t<T, S, Policy>>(other);
+}
+
+/**
+ * @brief: The cross product of two 3D Vectors. The result type follows the
+ * default promotion policy, see promotion.h.
+ */
+template<typename T, typename S, typename R = promoted_t<T, S>>
+[[nodiscard]] constexpr Vector<3, R> cross(const Vector<3, T> &vec,
+                                           const Vector<3, S> &other)
+{
+    const auto at = [](const auto &v, const size_t i) {
+        return static_cast<R>(v[i]);
+    };
+    return Vector<3, R> {at(vec, 1) * at(other, 2) - at(vec, 2) * at(other, 1),
+                         at(vec, 2) * at(other, 0) - at(vec, 0) * at(other, 2),
+                         at(vec, 0) * at(other, 1) - at(vec, 1) * at(other, 0)};
+}
+
+/**
+ * @brief: Linear interpolation between two Vectors, a at t == 0 and b at
+ * t == 1. Both end points are reproduced exactly.
+ */
+template<size_t l, typename T>
+[[nodiscard]] constexpr Vector<l, T> lerp(const Vector<l, T>          &a,
+                                          const Vector<l, T>          &b,
+                                          const details::identity_t<T> t)
+{
+    return a * (T {1} - t) + b * t;
+}
+
 } // namespace colibra
 
 #endif
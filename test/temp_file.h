@@ -0,0 +1,35 @@
+#ifndef COLIBRA_TEST_TEMP_FILE_H
+#define COLIBRA_TEST_TEMP_FILE_H
+
+#include "doctest.h"
+
+#include <cstdlib>
+#include <string>
+
+#include <unistd.h>
+
+/// A file in the temporary directory, removed again on destruction.
+struct TempFile
+{
+    std::string path;
+
+    TempFile()
+    {
+        const char *dir = std::getenv("TMPDIR");
+        path = std::string(dir != nullptr ? dir : "/tmp") + "/colibra_XXXXXX";
+
+        const int fd = ::mkstemp(path.data());
+        REQUIRE(fd >= 0);
+        ::close(fd);
+    }
+
+    TempFile(const TempFile &)            = delete;
+    TempFile &operator=(const TempFile &) = delete;
+
+    ~TempFile()
+    {
+        ::unlink(path.c_str());
+    }
+};
+
+#endif
@@ -0,0 +1,68 @@
+#include "colibra/accumulate.h"
+#include "doctest.h"
+
+#include <type_traits>
+
+using namespace colibra;
+using doctest::Approx;
+
+TEST_CASE("Accumulation control")
+{
+    constexpr Vector a {1.0f, 2.0f, 3.0f};
+    constexpr Vector b {4.0f, -5.0f, 6.0f};
+
+    SUBCASE("Defaults match the operators")
+    {
+        constexpr auto d = dot(a, b);
+        CHECK(std::is_same_v<std::decay_t<decltype(d)>, float>);
+        CHECK(d == Approx(a * b));
+        CHECK(sum(a) == Approx(6.0));
+        CHECK(norm(a) == Approx(a.norm()));
+        CHECK(std::is_same_v<decltype(norm(a)), double>);
+    }
+
+    SUBCASE("Accumulator type")
+    {
+        constexpr auto d = dot<double>(a, b);
+        CHECK(std::is_same_v<std::decay_t<decltype(d)>, double>);
+        CHECK(d == Approx(12.0));
+        CHECK(std::is_same_v<decltype(norm<float>(a)), float>);
+        CHECK(norm<float>(a) == Approx(a.norm()));
+        constexpr auto root = norm<float>(Vector {3.0f, 4.0f});
+        CHECK(root == 5.0f);
+        CHECK(sum<long>(Vector {1, 2, 3}) == 6);
+    }
+
+    SUBCASE("Summation modes")
+    {
+        // One large entry followed by many small ones. Every single 1.0f is
+        // below half an ulp of 1e8f and vanishes in naive float summation.
+        Vector<64, float> v;
+        v[0] = 1e8f;
+        for (size_t i = 1; i < v.rank(); ++i)
+        {
+            v[i] = 1.0f;
+        }
+        const double exact = 1e8 + 63.0;
+
+        const double naive = sum<float, summation::naive>(v);
+        const double kahan = sum<float, summation::kahan>(v);
+        const double pairw = sum<float, summation::pairwise>(v);
+
+        CHECK(naive == 1e8);
+        CHECK(std::abs(kahan - exact) <= 8.0);
+        CHECK(std::abs(pairw - exact) < std::abs(naive - exact));
+        CHECK(sum<double>(v) == exact);
+
+        CHECK(dot<float, summation::kahan>(v, Vector<64, float> {})
+              == Approx(0.0));
+    }
+
+    SUBCASE("Constexpr")
+    {
+        constexpr Vector i {1, 2, 3, 4};
+        static_assert(sum<int, summation::pairwise>(i) == 10);
+        static_assert(dot<long, summation::kahan>(i, i) == 30);
+        CHECK(sum(i) == 10);
+    }
+}
@@ -0,0 +1,125 @@
+#include "colibra/batch.h"
+#include "colibra/batch_ops.h"
+#include "doctest.h"
+
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+using namespace colibra;
+using doctest::Approx;
+
+TEST_CASE("Batch")
+{
+    const std::vector<Vector<3, float>> points {Vector {1.0f, 2.0f, 3.0f},
+                                                Vector {-1.0f, 0.5f, 2.0f},
+                                                Vector {0.0f, 0.0f, 0.0f},
+                                                Vector {4.0f, -3.0f, 1.0f}};
+
+    Batch<3, float> batch {Span(points)};
+
+    SUBCASE("Layout")
+    {
+        CHECK(batch.size() == points.size());
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            CHECK(batch[i] == points[i]);
+            CHECK(batch.component(1)[i] == points[i][1]);
+        }
+        CHECK_THROWS(batch.at(points.size()));
+
+        batch.push_back(Vector {7.0f, 8.0f, 9.0f});
+        CHECK(batch.size() == points.size() + 1);
+        CHECK(batch[points.size()][2] == Approx(9.0));
+
+        auto sub = batch.view().subview(1, 2);
+        CHECK(sub.size() == 2);
+        CHECK(sub[0] == points[1]);
+        CHECK_THROWS(batch.view().subview(3, 5));
+    }
+
+    const Vector query {0.5f, -1.0f, 2.0f};
+
+    SUBCASE("dot_many")
+    {
+        std::vector<float> soa(points.size());
+        std::vector<float> aos(points.size());
+        dot_many(query, batch, soa);
+        dot_many(query, Span(points), aos);
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            CHECK(soa[i] == Approx(query * points[i]));
+            CHECK(aos[i] == Approx(query * points[i]));
+        }
+
+        std::vector<float> too_small(points.size() - 1);
+        CHECK_THROWS_AS(dot_many(query, batch, too_small),
+                        std::invalid_argument);
+    }
+
+    SUBCASE("norm_many and distance_many")
+    {
+        std::vector<float> norms(points.size());
+        std::vector<float> distances(points.size());
+        norm_many(batch, norms);
+        distance_many(query, points, distances);
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            CHECK(norms[i] == Approx(points[i].norm()));
+            CHECK(distances[i] == Approx((points[i] - query).norm()));
+        }
+
+        const std::vector<Vector<2, int>> ints {Vector {3, 4}, Vector {6, 8}};
+        std::vector<double>               int_norms(ints.size());
+        norm_many(ints, int_norms);
+        CHECK(int_norms[0] == Approx(5.0));
+        CHECK(int_norms[1] == Approx(10.0));
+    }
+
+    SUBCASE("Parallel")
+    {
+        Batch<3, double> large;
+        for (int i = 0; i < 10000; ++i)
+        {
+            large.push_back(Vector {i * 0.5, -i * 0.25, 1.0});
+        }
+        const Vector        q {1.0, 2.0, 3.0};
+        std::vector<double> seq_out(large.size());
+        std::vector<double> par_out(large.size());
+        distance_many(execution::seq, q, large, seq_out);
+        distance_many(execution::parallel_policy {4, 128}, q, large, par_out);
+        CHECK(seq_out == par_out);
+    }
+
+    SUBCASE("Parallel with more threads than chunks")
+    {
+        // 17 points on 16 threads round up to chunks of two, which only
+        // fill nine threads.
+        Batch<3, double> small;
+        for (int i = 0; i < 17; ++i)
+        {
+            small.push_back(Vector {i * 0.5, -i * 0.25, 1.0});
+        }
+        const Vector        q {1.0, 2.0, 3.0};
+        std::vector<double> seq_out(small.size());
+        std::vector<double> par_out(small.size(), -1.0);
+        distance_many(execution::seq, q, small, seq_out);
+        distance_many(execution::parallel_policy {16, 1}, q, small, par_out);
+        CHECK(seq_out == par_out);
+
+        std::atomic<size_t> covered {0};
+        std::atomic<size_t> invalid {0};
+        details::parallel_for(execution::parallel_policy {16, 1},
+                              17,
+                              [&](const size_t begin, const size_t end) {
+                                  if (!(begin < end && end <= 17))
+                                  {
+                                      ++invalid;
+                                      return;
+                                  }
+                                  covered += end - begin;
+                              });
+        CHECK(invalid == 0);
+        CHECK(covered == 17);
+    }
+}
@@ -0,0 +1,278 @@
+#include "colibra/bounds.h"
+#include "doctest.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace colibra;
+
+namespace {
+
+Matrix<3, 3, double> rotation_about_z(const double angle)
+{
+    return Matrix<3, 3, double> {std::cos(angle),
+                                 -std::sin(angle),
+                                 0.0,
+                                 std::sin(angle),
+                                 std::cos(angle),
+                                 0.0,
+                                 0.0,
+                                 0.0,
+                                 1.0};
+}
+
+template<size_t l, typename T>
+Batch<l, T> random_points(const size_t n, std::mt19937 &rng, const T range)
+{
+    std::uniform_real_distribution<T> dist(-range, range);
+    Batch<l, T>                       batch;
+    for (size_t i = 0; i < n; ++i)
+    {
+        Vector<l, T> point;
+        for (size_t d = 0; d < l; ++d)
+        {
+            point[d] = dist(rng);
+        }
+        batch.push_back(point);
+    }
+    return batch;
+}
+
+} // namespace
+
+TEST_CASE("Aabb")
+{
+    constexpr Aabb box {Vector {-1.0, 0.0, 2.0}, Vector {1.0, 3.0, 4.0}};
+    static_assert(box.contains(Vector {0.0, 3.0, 2.5}));
+    static_assert(!box.contains(Vector {0.0, 3.5, 2.5}));
+    static_assert(box.center() == Vector {0.0, 1.5, 3.0});
+    static_assert(box.extent() == Vector {2.0, 3.0, 2.0});
+    static_assert(!box.is_empty());
+    static_assert(Aabb<3, double>::empty().is_empty());
+
+    constexpr Aabb touching {Vector {1.0, 3.0, 4.0}, Vector {2.0, 5.0, 6.0}};
+    constexpr Aabb apart {Vector {1.5, 0.0, 2.0}, Vector {2.0, 3.0, 4.0}};
+    static_assert(box.overlaps(touching));
+    static_assert(!box.overlaps(apart));
+
+    const std::vector<Vector<2, int>> points {
+        Vector {3, -1}, Vector {-2, 4}, Vector {0, 0}};
+    const auto bounds = Aabb<2, int>::from_points(points);
+    CHECK(bounds.lower == Vector {-2, -1});
+    CHECK(bounds.upper == Vector {3, 4});
+
+    auto merged = Aabb<2, int>::empty();
+    merged.merge(bounds).expand(Vector {5, 5});
+    CHECK(merged == Aabb {Vector {-2, -1}, Vector {5, 5}});
+}
+
+TEST_CASE("Sphere")
+{
+    constexpr Sphere sphere {Vector {0.0, 0.0}, 2.0};
+    static_assert(sphere.contains(Vector {2.0, 0.0}));
+    static_assert(!sphere.contains(Vector {1.5, 1.5}));
+    static_assert(sphere.overlaps(Sphere {Vector {3.0, 0.0}, 1.0}));
+    static_assert(!sphere.overlaps(Sphere {Vector {3.0, 0.5}, 1.0}));
+
+    // The corner of the box is sqrt(2) * 1.5 > 2 away.
+    constexpr Aabb crossing {Vector {1.0, -1.0}, Vector {3.0, 1.0}};
+    constexpr Aabb diagonal {Vector {1.5, 1.5}, Vector {3.0, 3.0}};
+    constexpr Aabb around {Vector {-5.0, -5.0}, Vector {5.0, 5.0}};
+    static_assert(sphere.overlaps(crossing));
+    static_assert(!sphere.overlaps(diagonal));
+    static_assert(sphere.overlaps(around));
+}
+
+TEST_CASE("Obb")
+{
+    Obb<double> box;
+    box.center       = Vector {1.0, 1.0, 0.0};
+    box.rotation     = rotation_about_z(M_PI / 4);
+    box.half_extents = Vector {2.0, 0.5, 1.0};
+
+    // Along the first axis of the box, the diagonal (1, 1) in world space.
+    CHECK(box.contains(Vector {2.3, 2.3, 0.0}));
+    CHECK(!box.contains(Vector {2.5, 2.5, 0.0}));
+    CHECK(!box.contains(Vector {2.0, 0.0, 0.0}));
+    CHECK(!box.contains(Vector {1.0, 1.0, 1.5}));
+
+    constexpr auto aligned =
+        Obb<double>::from_aabb(Aabb {Vector {-1.0, -1.0, -1.0},
+                                     Vector {1.0, 3.0, 1.0}});
+    static_assert(aligned.center == Vector {0.0, 1.0, 0.0});
+    static_assert(aligned.contains(Vector {1.0, 3.0, -1.0}));
+    static_assert(!aligned.contains(Vector {1.0, 3.5, 0.0}));
+
+    SUBCASE("Overlap")
+    {
+        Obb<double> other = box;
+        CHECK(box.overlaps(other));
+
+        // Separated along the second axis of box only.
+        other.center = box.center + box.rotation.col(1) * 1.2;
+        CHECK(!box.overlaps(other));
+        other.center = box.center + box.rotation.col(1) * 0.9;
+        CHECK(box.overlaps(other));
+
+        // Two crosses at right angles, separated only by an edge-edge axis.
+        Obb<double> a;
+        a.half_extents = Vector {3.0, 0.1, 0.1};
+        Obb<double> b;
+        b.half_extents = Vector {0.1, 3.0, 0.1};
+        b.center       = Vector {0.0, 0.0, 0.25};
+        CHECK(!a.overlaps(b));
+        b.center = Vector {0.0, 0.0, 0.15};
+        CHECK(a.overlaps(b));
+        b.rotation = rotation_about_z(M_PI / 3);
+        CHECK(a.overlaps(b));
+
+        CHECK(aligned.overlaps(Aabb {Vector {0.5, 2.5, 0.5},
+                                     Vector {4.0, 4.0, 4.0}}));
+        CHECK(!aligned.overlaps(Aabb {Vector {1.5, 2.5, 0.5},
+                                      Vector {4.0, 4.0, 4.0}}));
+    }
+}
+
+TEST_CASE("Ray")
+{
+    constexpr Aabb box {Vector {1.0, -1.0}, Vector {3.0, 1.0}};
+    constexpr auto inf = std::numeric_limits<double>::infinity();
+
+    static_assert(Ray {Vector {0.0, 0.0}, Vector {1.0, 0.0}}.intersect(box)
+                  == 1.0);
+    static_assert(Ray {Vector {0.0, 0.0}, Vector {2.0, 0.0}}.intersect(box)
+                  == 0.5);
+    static_assert(Ray {Vector {2.0, 0.0}, Vector {1.0, 0.0}}.intersect(box)
+                  == 0.0);
+    static_assert(Ray {Vector {4.0, 0.0}, Vector {1.0, 0.0}}.intersect(box)
+                  == inf);
+    static_assert(Ray {Vector {0.0, 2.0}, Vector {1.0, 0.0}}.intersect(box)
+                  == inf);
+    static_assert(Ray {Vector {0.0, -2.0}, Vector {1.0, 1.0}}.intersect(box)
+                  == 1.0);
+
+    // Parallel to a face and exactly on its plane.
+    static_assert(Ray {Vector {0.0, 1.0}, Vector {1.0, 0.0}}.intersect(box)
+                  == 1.0);
+    static_assert(Ray {Vector {1.0, 0.0}, Vector {0.0, -1.0}}.intersect(box)
+                  == 0.0);
+
+    constexpr Ray ray {Vector {0.0, -2.0}, Vector {1.0, 1.0}};
+    static_assert(ray.at(2.0) == Vector {2.0, 0.0});
+}
+
+TEST_CASE("Batched bounds")
+{
+    std::mt19937 rng(5);
+    // Not a multiple of any SIMD width, so the tails are exercised.
+    const size_t                     n = 1003;
+    const Batch<3, float>            points = random_points<3>(n, rng, 3.0f);
+    const execution::parallel_policy policy {4, 100};
+
+    std::vector<uint8_t> seq(n);
+    std::vector<uint8_t> par(n);
+
+    SUBCASE("contains_many")
+    {
+        const Aabb box {Vector {-1.0f, -2.0f, 0.0f}, Vector {2.0f, 1.0f, 3.0f}};
+        const Sphere sphere {Vector {0.5f, 0.0f, -1.0f}, 2.0f};
+
+        Obb<float> obb;
+        obb.center       = Vector {0.5f, 0.5f, 0.0f};
+        obb.rotation     = Matrix<3, 3, float> {0.6f,
+                                            -0.8f,
+                                            0.0f,
+                                            0.8f,
+                                            0.6f,
+                                            0.0f,
+                                            0.0f,
+                                            0.0f,
+                                            1.0f};
+        obb.half_extents = Vector {2.0f, 1.0f, 0.5f};
+
+        const auto check = [&](const auto &volume) {
+            size_t inside = 0;
+            contains_many(volume, points, seq);
+            contains_many(policy, volume, points, par);
+            for (size_t i = 0; i < n; ++i)
+            {
+                CHECK(bool(seq[i]) == volume.contains(points[i]));
+                CHECK(par[i] == seq[i]);
+                inside += seq[i];
+            }
+            CHECK(inside > 0);
+            CHECK(inside < n);
+        };
+        check(box);
+        check(sphere);
+        check(obb);
+
+        std::vector<uint8_t> too_small(n - 1);
+        CHECK_THROWS_AS(contains_many(box, points, too_small),
+                        std::invalid_argument);
+    }
+
+    SUBCASE("overlaps_many")
+    {
+        const Batch<3, float> extents = random_points<3>(n, rng, 1.0f);
+        Batch<3, float>       lower;
+        Batch<3, float>       upper;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const Vector<3, float> half {std::abs(extents[i][0]),
+                                         std::abs(extents[i][1]),
+                                         std::abs(extents[i][2])};
+            lower.push_back(points[i] - half);
+            upper.push_back(points[i] + half);
+        }
+
+        const Aabb box {Vector {-1.0f, -1.0f, -1.0f},
+                        Vector {1.0f, 0.0f, 1.0f}};
+        overlaps_many(box, lower, upper, seq);
+        overlaps_many(policy, box, lower, upper, par);
+        for (size_t i = 0; i < n; ++i)
+        {
+            CHECK(bool(seq[i]) == box.overlaps(Aabb {lower[i], upper[i]}));
+            CHECK(par[i] == seq[i]);
+        }
+
+        const auto short_upper = upper.view().subview(0, 3);
+        CHECK_THROWS_AS(overlaps_many(box, lower, short_upper, seq),
+                        std::invalid_argument);
+    }
+
+    SUBCASE("intersect_many")
+    {
+        Batch<3, float> directions = random_points<3>(n, rng, 1.0f);
+        // Some rays parallel to the faces.
+        for (size_t i = 0; i < n; i += 7)
+        {
+            directions.view().component(i % 3)[i] = 0.0f;
+        }
+
+        const Aabb box {Vector {-1.0f, -1.0f, -1.0f},
+                        Vector {1.0f, 2.0f, 1.0f}};
+        std::vector<float> entry(n);
+        std::vector<float> par_entry(n);
+        intersect_many(box, points, directions, entry);
+        intersect_many(policy, box, points, directions, par_entry);
+
+        size_t hits = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const Ray ray {points[i], directions[i]};
+            CHECK(entry[i] == ray.intersect(box));
+            CHECK(par_entry[i] == entry[i]);
+            if (entry[i] != std::numeric_limits<float>::infinity())
+            {
+                ++hits;
+                CHECK(box.contains(ray.at(entry[i]) * 0.999f));
+            }
+        }
+        CHECK(hits > 0);
+        CHECK(hits < n);
+    }
+}
@@ -0,0 +1,249 @@
+#include "colibra/bvh.h"
+#include "doctest.h"
+
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace colibra;
+
+namespace {
+
+using Vec3 = Vector<3, float>;
+
+std::vector<Triangle<float>> random_triangles(const size_t  n,
+                                              std::mt19937 &rng)
+{
+    std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+    std::vector<Triangle<float>>          triangles(n);
+    for (auto &triangle : triangles)
+    {
+        const Vec3 a {position(rng), position(rng), position(rng)};
+        triangle.a = a;
+        triangle.b = a + Vec3 {offset(rng), offset(rng), offset(rng)};
+        triangle.c = a + Vec3 {offset(rng), offset(rng), offset(rng)};
+    }
+    return triangles;
+}
+
+Ray<3, float> random_ray(std::mt19937 &rng)
+{
+    std::uniform_real_distribution<float> position(-12.0f, 12.0f);
+    std::uniform_real_distribution<float> target(-8.0f, 8.0f);
+    const Vec3    origin {position(rng), position(rng), position(rng)};
+    Ray<3, float> ray {origin,
+                       Vec3 {target(rng), target(rng), target(rng)} - origin};
+    // Some rays run parallel to the axis planes.
+    if (rng() % 4 == 0)
+    {
+        ray.direction[rng() % 3] = 0.0f;
+    }
+    return ray;
+}
+
+RayHit<float> brute_force_hit(const std::vector<Triangle<float>> &triangles,
+                              const Ray<3, float>                &ray)
+{
+    RayHit<float> best;
+    for (size_t i = 0; i < triangles.size(); ++i)
+    {
+        const float t = triangles[i].intersect(ray);
+        if (t < best.t)
+        {
+            best.index = i;
+            best.t     = t;
+        }
+    }
+    return best;
+}
+
+float brute_force_distance(const std::vector<Triangle<float>> &triangles,
+                           const Vec3                         &query)
+{
+    float best = std::numeric_limits<float>::infinity();
+    for (const auto &triangle : triangles)
+    {
+        const Vec3 diff = triangle.closest_point(query) - query;
+        best            = std::min(best, diff * diff);
+    }
+    return best;
+}
+
+/// Compare 500 random queries with brute force, return the number of hits.
+size_t check_queries(const Bvh<float>                   &bvh,
+                     const std::vector<Triangle<float>> &triangles,
+                     std::mt19937                       &rng)
+{
+    size_t hits = 0;
+    for (size_t r = 0; r < 500; ++r)
+    {
+        const Ray<3, float> ray      = random_ray(rng);
+        const RayHit<float> expected = brute_force_hit(triangles, ray);
+        const RayHit<float> actual   = bvh.intersect(ray);
+        REQUIRE(actual.hit() == expected.hit());
+        if (expected.hit())
+        {
+            ++hits;
+            CHECK(actual.t == expected.t);
+            CHECK(triangles[actual.index].intersect(ray) == actual.t);
+
+            const Triangle<float> &triangle = triangles[actual.index];
+            const Vec3 point = triangle.a * (1.0f - actual.u - actual.v)
+                               + triangle.b * actual.u + triangle.c * actual.v;
+            const Vec3 diff  = point - ray.at(actual.t);
+            CHECK(diff * diff < 1e-6f);
+
+            CHECK(bvh.occluded(ray));
+            CHECK(bvh.occluded(ray, actual.t * 1.01f));
+            CHECK(!bvh.occluded(ray, actual.t * 0.99f));
+        }
+        else
+        {
+            CHECK(!bvh.occluded(ray));
+        }
+
+        const ClosestPoint<float> closest = bvh.nearest(ray.origin);
+        CHECK(closest.distance_squared
+              == brute_force_distance(triangles, ray.origin));
+        CHECK(closest.point
+              == triangles[closest.index].closest_point(ray.origin));
+    }
+    return hits;
+}
+
+} // namespace
+
+TEST_CASE("Triangle")
+{
+    constexpr Triangle<double> triangle {Vector {0.0, 0.0, 0.0},
+                                         Vector {2.0, 0.0, 0.0},
+                                         Vector {0.0, 2.0, 0.0}};
+    constexpr auto             inf = std::numeric_limits<double>::infinity();
+
+    static_assert(triangle.intersect(Ray {Vector {0.5, 0.5, 3.0},
+                                          Vector {0.0, 0.0, -1.0}})
+                  == 3.0);
+    // Back faces count as well.
+    static_assert(triangle.intersect(Ray {Vector {0.5, 0.5, -1.0},
+                                          Vector {0.0, 0.0, 2.0}})
+                  == 0.5);
+    static_assert(triangle.intersect(Ray {Vector {1.5, 1.5, 3.0},
+                                          Vector {0.0, 0.0, -1.0}})
+                  == inf);
+    static_assert(triangle.intersect(Ray {Vector {0.5, 0.5, 3.0},
+                                          Vector {0.0, 0.0, 1.0}})
+                  == inf);
+    static_assert(triangle.intersect(Ray {Vector {0.5, 0.5, 0.0},
+                                          Vector {1.0, 0.0, 0.0}})
+                  == inf);
+
+    // Closest points in the face, on an edge and at a corner.
+    static_assert(triangle.closest_point(Vector {0.5, 0.5, 4.0})
+                  == Vector {0.5, 0.5, 0.0});
+    static_assert(triangle.closest_point(Vector {2.0, 2.0, 1.0})
+                  == Vector {1.0, 1.0, 0.0});
+    static_assert(triangle.closest_point(Vector {1.0, -1.0, 0.0})
+                  == Vector {1.0, 0.0, 0.0});
+    static_assert(triangle.closest_point(Vector {-1.0, -1.0, -1.0})
+                  == Vector {0.0, 0.0, 0.0});
+    static_assert(triangle.closest_point(Vector {3.0, -1.0, 0.0})
+                  == Vector {2.0, 0.0, 0.0});
+
+    static_assert(triangle.bounds()
+                  == Aabb {Vector {0.0, 0.0, 0.0}, Vector {2.0, 2.0, 0.0}});
+}
+
+TEST_CASE("Bvh")
+{
+    std::mt19937 rng(11);
+    const auto   triangles = random_triangles(3000, rng);
+
+    SUBCASE("Sequential build")
+    {
+        for (const size_t leaf_size : {size_t {1}, size_t {4}, size_t {16}})
+        {
+            const Bvh<float> bvh(triangles, leaf_size);
+            CHECK(bvh.size() == triangles.size());
+            CHECK(bvh.node_count() > 0);
+            CHECK(check_queries(bvh, triangles, rng) > 50);
+        }
+    }
+
+    SUBCASE("Parallel build")
+    {
+        const execution::parallel_policy policy {4, 64};
+        const Bvh<float>                 bvh(policy, triangles);
+        CHECK(bvh.bounds() == Bvh<float>(triangles).bounds());
+        CHECK(check_queries(bvh, triangles, rng) > 50);
+    }
+
+    SUBCASE("Parallel build of a few triangles")
+    {
+        // More threads than triangles and a grain of one, so the chunks of
+        // the parallel passes hold one or two triangles each.
+        const std::vector<Triangle<float>> few(triangles.begin(),
+                                               triangles.begin() + 17);
+        const Bvh<float> bvh(execution::parallel_policy {16, 1}, few);
+        CHECK(bvh.size() == few.size());
+        CHECK(bvh.bounds() == Bvh<float>(few).bounds());
+        check_queries(bvh, few, rng);
+    }
+
+    SUBCASE("Coincident triangles")
+    {
+        // All centroids are equal, the SAH finds no split and the builder
+        // falls back to median splits.
+        std::vector<Triangle<float>> stack(100, triangles.front());
+        stack.push_back(triangles.back());
+        const Bvh<float> bvh(stack);
+        check_queries(bvh, stack, rng);
+    }
+
+    SUBCASE("Batched rays")
+    {
+        const Bvh<float> bvh(triangles);
+        Batch<3, float>  origins;
+        Batch<3, float>  directions;
+        for (size_t i = 0; i < 301; ++i)
+        {
+            const Ray<3, float> ray = random_ray(rng);
+            origins.push_back(ray.origin);
+            directions.push_back(ray.direction);
+        }
+
+        std::vector<RayHit<float>> seq(origins.size());
+        std::vector<RayHit<float>> par(origins.size());
+        intersect_many(bvh, origins, directions, seq);
+        intersect_many(execution::parallel_policy {4, 1},
+                       bvh,
+                       origins,
+                       directions,
+                       par);
+        for (size_t i = 0; i < origins.size(); ++i)
+        {
+            const RayHit<float> expected =
+                bvh.intersect(Ray {origins[i], directions[i]});
+            CHECK(seq[i].t == expected.t);
+            CHECK(seq[i].index == expected.index);
+            CHECK(par[i].t == expected.t);
+        }
+
+        std::vector<RayHit<float>> too_small(origins.size() - 1);
+        CHECK_THROWS_AS(intersect_many(bvh, origins, directions, too_small),
+                        std::invalid_argument);
+    }
+
+    SUBCASE("Empty")
+    {
+        const Bvh<float> bvh;
+        CHECK(bvh.empty());
+        CHECK(bvh.bounds().is_empty());
+        CHECK(!bvh.intersect(random_ray(rng)).hit());
+        CHECK_THROWS_AS((void)bvh.nearest(Vec3 {}), std::out_of_range);
+
+        CHECK_THROWS_AS(Bvh<float>(triangles, 0), std::invalid_argument);
+        CHECK_THROWS_AS(Bvh<float>(triangles, Bvh<float>::max_leaf_size + 1),
+                        std::invalid_argument);
+    }
+}
@@ -0,0 +1,173 @@
+#include "colibra/complex.h"
+#include "doctest.h"
+
+#include <complex>
+#include <random>
+#include <vector>
+
+using namespace colibra;
+using doctest::Approx;
+
+namespace {
+
+template<typename T>
+std::vector<std::complex<T>> random_signal(const size_t n, std::mt19937 &rng)
+{
+    std::uniform_real_distribution<T> dist(-1, 1);
+    std::vector<std::complex<T>>      signal(n);
+    for (auto &value : signal)
+    {
+        value = std::complex<T>(dist(rng), dist(rng));
+    }
+    return signal;
+}
+
+template<typename T>
+void check_close(const std::complex<T> actual,
+                 const std::complex<T> expected,
+                 const double          epsilon)
+{
+    CHECK(actual.real() == Approx(expected.real()).epsilon(epsilon));
+    CHECK(actual.imag() == Approx(expected.imag()).epsilon(epsilon));
+}
+
+template<typename T>
+void check_signals(const double epsilon)
+{
+    std::mt19937 rng(3);
+    // Not a multiple of any SIMD width, so the tails are exercised.
+    const size_t n = 1003;
+    const auto   a = random_signal<T>(n, rng);
+    const auto   b = random_signal<T>(n, rng);
+
+    std::complex<double> expected_dot {};
+    for (size_t i = 0; i < n; ++i)
+    {
+        expected_dot += std::conj(std::complex<double>(a[i]))
+                        * std::complex<double>(b[i]);
+    }
+    const std::complex<T> expected(static_cast<T>(expected_dot.real()),
+                                   static_cast<T>(expected_dot.imag()));
+
+    const SplitComplex<T>            split_a {Span(a)};
+    const SplitComplex<T>            split_b {Span(b)};
+    const execution::parallel_policy policy {4, 100};
+
+    SUBCASE("Interleaved")
+    {
+        std::vector<std::complex<T>> out(n);
+        complex_multiply(Span(a), Span(b), Span(out));
+        for (size_t i = 0; i < n; ++i)
+        {
+            check_close(out[i], a[i] * b[i], epsilon);
+        }
+
+        std::vector<std::complex<T>> par(n);
+        complex_multiply(policy, Span(a), Span(b), Span(par));
+        for (size_t i = 0; i < n; ++i)
+        {
+            check_close(par[i], out[i], epsilon);
+        }
+
+        check_close(conjugate_dot(a, Span(b)), expected, epsilon);
+        check_close(conjugate_dot(policy, a, Span(b)), expected, epsilon);
+    }
+
+    SUBCASE("Split")
+    {
+        SplitComplex<T> out(n);
+        complex_multiply(split_a, split_b, out.view());
+        for (size_t i = 0; i < n; ++i)
+        {
+            check_close(out[i], a[i] * b[i], epsilon);
+        }
+
+        // In place.
+        SplitComplex<T> in_place {Span(a)};
+        complex_multiply(policy, in_place, split_b, in_place.view());
+        for (size_t i = 0; i < n; ++i)
+        {
+            check_close(in_place[i], out[i], epsilon);
+        }
+
+        check_close(conjugate_dot(split_a, split_b), expected, epsilon);
+        check_close(conjugate_dot(policy, split_a, split_b), expected, epsilon);
+    }
+}
+
+} // namespace
+
+TEST_CASE("Complex Vectors")
+{
+    using c = std::complex<double>;
+    constexpr Vector a {c(1.0, 2.0), c(-0.5, 1.0)};
+    constexpr Vector b {c(3.0, -1.0), c(2.0, 0.25)};
+
+    // All of these are constexpr, std::complex arithmetic is not in C++17.
+    constexpr auto sum        = a + b;
+    constexpr auto difference = a - b;
+    constexpr auto negated    = -a;
+    constexpr auto scaled     = a * c(0.0, 2.0);
+    constexpr auto conjugated = conjugate(a);
+    constexpr c    inner      = conjugate_dot(a, b);
+
+    for (size_t i = 0; i < a.rank(); ++i)
+    {
+        CHECK(sum[i] == a[i] + b[i]);
+        CHECK(difference[i] == a[i] - b[i]);
+        CHECK(negated[i] == -a[i]);
+        CHECK(scaled[i] == a[i] * c(0.0, 2.0));
+        CHECK(conjugated[i] == std::conj(a[i]));
+    }
+    const c expected = std::conj(a[0]) * b[0] + std::conj(a[1]) * b[1];
+    CHECK(inner == expected);
+    CHECK(conjugate_dot(a, a).imag() == 0.0);
+
+    // Real Vectors are their own conjugate.
+    constexpr Vector real {1.0, -2.0};
+    static_assert(conjugate(real) == real);
+    static_assert(conjugate_dot(real, real) == 5.0);
+}
+
+TEST_CASE("SplitComplex")
+{
+    const std::vector<std::complex<float>> values {
+        {1.0f, 2.0f}, {3.0f, -4.0f}, {-5.0f, 0.5f}};
+    SplitComplex<float> split {Span(values)};
+    CHECK(split.size() == 3);
+    CHECK(split.real()[1] == 3.0f);
+    CHECK(split.imag()[1] == -4.0f);
+    CHECK(split[2] == values[2]);
+    CHECK_THROWS_AS(split.at(3), std::out_of_range);
+
+    split.push_back({7.0f, 8.0f});
+    split.set(0, {0.0f, -1.0f});
+    std::vector<std::complex<float>> interleaved(split.size());
+    split.interleave(Span(interleaved));
+    CHECK(interleaved[0] == std::complex<float>(0.0f, -1.0f));
+    CHECK(interleaved[3] == std::complex<float>(7.0f, 8.0f));
+
+    const SplitComplexView<const float> view = split.view().subview(1, 2);
+    CHECK(view.size() == 2);
+    CHECK(view[0] == values[1]);
+    CHECK_THROWS_AS(view.subview(1, 2), std::out_of_range);
+
+    std::vector<std::complex<float>> small(2);
+    CHECK_THROWS_AS(split.interleave(Span(small)), std::invalid_argument);
+    CHECK_THROWS_AS(conjugate_dot(split, view), std::invalid_argument);
+    SplitComplex<float> short_out(2);
+    CHECK_THROWS_AS(complex_multiply(split, split, short_out.view()),
+                    std::invalid_argument);
+}
+
+TEST_CASE("Complex signals")
+{
+    SUBCASE("float")
+    {
+        check_signals<float>(1e-4);
+    }
+    SUBCASE("double")
+    {
+        check_signals<double>(1e-12);
+    }
+}
@@ -0,0 +1,127 @@
+#include "colibra/fixed_point.h"
+#include "colibra/half.h"
+#include "colibra/vector.h"
+#include "doctest.h"
+
+#include <complex>
+#include <type_traits>
+
+using namespace colibra;
+using doctest::Approx;
+
+namespace {
+
+/// Detects whether the scalar overload of Vector<3, float>::operator* is
+/// viable for S.
+template<typename S, typename = void>
+struct scales : std::false_type
+{
+};
+
+template<typename S>
+struct scales<S,
+              std::void_t<decltype(std::declval<const Vector<3, float> &>()
+                                       .template operator*<S>(
+                                           std::declval<const S &>()))>>
+    : std::true_type
+{
+};
+
+} // namespace
+
+TEST_CASE("Element categories")
+{
+    CHECK(element_category_v<int> == ElementCategory::arithmetic);
+    CHECK(element_category_v<double> == ElementCategory::arithmetic);
+    CHECK(element_category_v<std::complex<float>> == ElementCategory::complex);
+    CHECK(element_category_v<q15> == ElementCategory::fixed_point);
+    CHECK(element_category_v<half> == ElementCategory::other);
+
+    CHECK(is_vector_v<Vector<2, int>>);
+    CHECK_FALSE(is_vector_v<int>);
+    CHECK_FALSE(is_vector_v<std::complex<double>>);
+
+#if COLIBRA_CONCEPTS
+    CHECK(scalar_operand<std::complex<double>>);
+    CHECK_FALSE(scalar_operand<Vector<3, float>>);
+#endif
+}
+
+TEST_CASE("Scalar and Vector operands")
+{
+    // The scalar overload of operator* is not viable for Vector operands.
+    CHECK(scales<double>::value);
+    CHECK_FALSE(scales<Vector<3, float>>::value);
+    CHECK_FALSE(scales<Vector<3, double>>::value);
+
+    constexpr Vector a {1.0f, 2.0f, 3.0f};
+    CHECK(std::is_same_v<decltype(a * a), float>);
+    CHECK(std::is_same_v<decltype(a * 2.0), Vector<3, double>>);
+}
+
+TEST_CASE("Kernel dispatch")
+{
+    SUBCASE("Complex")
+    {
+        using c = std::complex<double>;
+        constexpr Vector a {c(1.0, 2.0), c(0.0, 1.0), c(-1.0, 0.5)};
+        constexpr Vector b {c(3.0, -1.0), c(2.0, 0.0), c(1.0, 1.0)};
+
+        // Constexpr even though std::complex arithmetic is not in C++17.
+        constexpr c dot = a * b;
+        c           expected {};
+        for (size_t i = 0; i < a.rank(); ++i)
+        {
+            expected += a[i] * b[i];
+        }
+        CHECK(dot.real() == Approx(expected.real()));
+        CHECK(dot.imag() == Approx(expected.imag()));
+
+        const auto scaled = a * c(0.0, 1.0);
+        for (size_t i = 0; i < a.rank(); ++i)
+        {
+            CHECK(scaled[i] == a[i] * c(0.0, 1.0));
+        }
+    }
+
+    SUBCASE("Fixed point")
+    {
+        constexpr Vector a {q15(0.5), q15(-0.25), q15(0.125)};
+        constexpr Vector b {q15(0.75), q15(0.75), q15(-0.5)};
+        constexpr q15    dot = a * b;
+        CHECK(static_cast<double>(dot) == 0.375 - 0.1875 - 0.0625);
+
+        // Rounding each product to Q15 loses the low bits of every term,
+        // the exact accumulation only rounds the final sum.
+        constexpr q15 tiny     = q15::from_raw(1);
+        constexpr q15 one_half = q15(0.5);
+        CHECK((tiny * one_half).raw() == 1);
+
+        constexpr Vector small {tiny, tiny, tiny, tiny};
+        constexpr Vector halves {one_half, one_half, one_half, one_half};
+        CHECK((small * halves).raw() == 2);
+
+        // Intermediate sums may leave the range of Q15 as long as the result
+        // is back in it.
+        constexpr q15    one = q15::highest();
+        constexpr Vector up {q15(-0.75), q15(0.75), q15(0.75)};
+        constexpr Vector ones {one, one, one};
+        CHECK(static_cast<double>(up * ones) == Approx(0.75).epsilon(1e-4));
+
+        // Results out of range saturate.
+        CHECK(ones * ones == q15::highest());
+    }
+
+    SUBCASE("Large Vectors")
+    {
+        Vector<64, q15> a;
+        Vector<64, q15> b;
+        for (size_t i = 0; i < a.rank(); ++i)
+        {
+            a[i] = q15(0.125);
+            b[i] = q15(i % 2 == 0 ? 0.0625 : -0.03125);
+        }
+        CHECK(static_cast<double>(a * b)
+              == 32 * 0.125 * 0.0625 - 32 * 0.125 * 0.03125);
+    }
+}
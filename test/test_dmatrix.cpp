@@ -0,0 +1,174 @@
+#include "colibra/dmatrix.h"
+#include "doctest.h"
+
+#include <random>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+using namespace colibra;
+using doctest::Approx;
+
+namespace {
+
+template<typename T>
+DMatrix<T>
+random_dmatrix(std::mt19937 &rng, const size_t rows, const size_t cols)
+{
+    std::uniform_int_distribution<int> dist(-8, 8);
+    DMatrix<T>                         m(rows, cols);
+    for (size_t i = 0; i < rows; ++i)
+    {
+        for (size_t j = 0; j < cols; ++j)
+        {
+            m(i, j) = static_cast<T>(dist(rng));
+        }
+    }
+    return m;
+}
+
+template<typename R, typename T, typename S>
+DMatrix<R> naive_product(const DMatrix<T> &a, const DMatrix<S> &b)
+{
+    DMatrix<R> c(a.rows(), b.cols());
+    for (size_t i = 0; i < a.rows(); ++i)
+    {
+        for (size_t j = 0; j < b.cols(); ++j)
+        {
+            R sum {};
+            for (size_t p = 0; p < a.cols(); ++p)
+            {
+                sum += static_cast<R>(a(i, p)) * static_cast<R>(b(p, j));
+            }
+            c(i, j) = sum;
+        }
+    }
+    return c;
+}
+
+} // namespace
+
+TEST_CASE("DMatrix")
+{
+    SUBCASE("access")
+    {
+        DMatrix<int> m(2, 3, {1, 2, 3, 4, 5, 6});
+        CHECK(m.rows() == 2);
+        CHECK(m.cols() == 3);
+        CHECK(m(1, 0) == 4);
+        CHECK(m.row(1)[2] == 6);
+        CHECK(m.transpose()(2, 1) == 6);
+        CHECK_THROWS_AS((void)m.at(2, 0), std::out_of_range);
+        CHECK_THROWS_AS(DMatrix<int>(2, 2, {1, 2, 3}), std::invalid_argument);
+
+        std::ostringstream os;
+        os << m;
+        CHECK(os.str() == "{ { 1, 2, 3 }, { 4, 5, 6 } }");
+
+        const DMatrix<int> fixed(Matrix<2, 3, int> {1, 2, 3, 4, 5, 6});
+        CHECK(fixed == m);
+        CHECK(DMatrix<int>::identity(3)(1, 1) == 1);
+    }
+
+    SUBCASE("arithmetic and promotion")
+    {
+        const DMatrix<float>  a(2, 2, {1, 2, 3, 4});
+        const DMatrix<double> b(2, 2, {0.5, 0, 0, 0.5});
+        const auto            sum = a + b;
+        static_assert(std::is_same_v<decltype(sum), const DMatrix<double>>);
+        CHECK(sum(0, 0) == 1.5);
+        CHECK((a - a) == DMatrix<float>(2, 2));
+        CHECK((-a)(1, 1) == -4.0f);
+        CHECK((a * 2.0)(1, 0) == 6.0);
+
+        const auto product = a * b;
+        static_assert(
+            std::is_same_v<decltype(product), const DMatrix<double>>);
+        CHECK(product == DMatrix<double>(2, 2, {0.5, 1, 1.5, 2}));
+
+        const std::vector<double> x {1, -1};
+        const auto                y = a * x;
+        static_assert(std::is_same_v<decltype(y), const std::vector<double>>);
+        CHECK(y == std::vector<double> {-1, -1});
+
+        CHECK_THROWS_AS((void)(a + DMatrix<float>(2, 3)),
+                        std::invalid_argument);
+        CHECK_THROWS_AS((void)(a * DMatrix<float>(3, 2)),
+                        std::invalid_argument);
+        CHECK_THROWS_AS((void)(a * std::vector<float>(3)),
+                        std::invalid_argument);
+    }
+
+    SUBCASE("gemm")
+    {
+        // Small integers keep every partial sum exact, so the blocked kernel
+        // must match the naive loop bit for bit. The sizes cross the block
+        // and micro panel boundaries.
+        std::mt19937 rng(5);
+        const size_t shapes[][3] = {
+            {1, 1, 1}, {3, 5, 7}, {17, 33, 9}, {130, 300, 70}, {65, 257, 40}};
+        for (const auto &shape : shapes)
+        {
+            const auto a = random_dmatrix<float>(rng, shape[0], shape[1]);
+            const auto b = random_dmatrix<float>(rng, shape[1], shape[2]);
+
+            DMatrix<float> c;
+            gemm(a, b, c);
+            CHECK(c == naive_product<float>(a, b));
+
+            DMatrix<float> parallel;
+            gemm(execution::parallel_policy {4, 1}, a, b, parallel);
+            CHECK(parallel == c);
+
+            const auto ints = random_dmatrix<int>(rng, shape[1], shape[2]);
+
+            DMatrix<double> mixed;
+            gemm(a, ints, mixed);
+            CHECK(mixed == naive_product<double>(a, ints));
+        }
+
+        DMatrix<double> empty;
+        gemm(DMatrix<double>(3, 0), DMatrix<double>(0, 4), empty);
+        CHECK(empty == DMatrix<double>(3, 4));
+    }
+
+    SUBCASE("gemm with aliased output")
+    {
+        std::mt19937   rng(7);
+        const auto     a        = random_dmatrix<float>(rng, 20, 20);
+        const auto     b        = random_dmatrix<float>(rng, 20, 20);
+        const auto     expected = naive_product<float>(a, b);
+        DMatrix<float> left     = a;
+        gemm(left, b, left);
+        CHECK(left == expected);
+
+        DMatrix<float> right = b;
+        gemm(execution::parallel_policy {4, 1}, a, right, right);
+        CHECK(right == expected);
+
+        DMatrix<float> square = a;
+        gemm(square, DMatrix<float>::identity(20), square);
+        CHECK(square == a);
+    }
+
+    SUBCASE("gemv")
+    {
+        std::mt19937 rng(6);
+        for (const size_t cols : {1, 15, 16, 100})
+        {
+            const auto a = random_dmatrix<double>(rng, 37, cols);
+            const auto x = random_dmatrix<double>(rng, cols, 1);
+
+            std::vector<double> y(a.rows());
+            gemv(execution::parallel_policy {3, 1},
+                 a,
+                 Span<const double>(x.data(), cols),
+                 Span(y));
+            const auto expected = naive_product<double>(a, x);
+            for (size_t i = 0; i < a.rows(); ++i)
+            {
+                CHECK(y[i] == Approx(expected(i, 0)));
+            }
+        }
+    }
+}
@@ -0,0 +1,149 @@
+#include "colibra/batch_ops.h"
+#include "colibra/fixed_point.h"
+#include "colibra/half.h"
+#include "doctest.h"
+
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+using namespace colibra;
+using doctest::Approx;
+
+TEST_CASE("Fixed point")
+{
+    SUBCASE("Conversion")
+    {
+        static_assert(q15(0.5).raw() == 16384);
+        static_assert(q15(1.0).raw() == INT16_MAX);
+        static_assert(q15(-1.0).raw() == INT16_MIN);
+        static_assert(q15(-2.0).raw() == INT16_MIN);
+        CHECK(static_cast<double>(q15(0.25)) == 0.25);
+        CHECK(q31(0.1) == Approx(0.1));
+        CHECK(q15(1.0 / 65536.0).raw() == 1);
+        CHECK(Fixed<8, int16_t>(3).raw() == 3 * 256);
+        CHECK(Fixed<8, int16_t>(1000).raw() == INT16_MAX);
+
+        // Changing the format rounds and saturates.
+        CHECK(q15(q31(0.5)).raw() == 16384);
+        CHECK(q31(q15(0.5)).raw() == (int32_t {1} << 30));
+        CHECK(Fixed<8, int16_t>(q15(-0.5)).raw() == -128);
+    }
+
+    SUBCASE("Saturating arithmetic")
+    {
+        constexpr q15 a(0.75);
+        constexpr q15 b(0.5);
+        static_assert((a + b) == q15::highest());
+        static_assert((-a - b) == q15::lowest());
+        static_assert(-q15::lowest() == q15::highest());
+        CHECK(static_cast<double>(a - b) == 0.25);
+        CHECK(static_cast<double>(a * b) == 0.375);
+        CHECK(static_cast<double>(b / a) == Approx(2.0 / 3.0).epsilon(1e-4));
+        CHECK((q15::from_raw(1) / q15::from_raw(3)).raw() == 10923);
+        CHECK((q15::from_raw(-1) / q15::from_raw(3)).raw() == -10923);
+        CHECK((q15::from_raw(1) / q15::from_raw(-5)).raw() == -6554);
+        CHECK((q15::from_raw(2) / q15::from_raw(5)).raw() == 13107);
+        CHECK(a / q15 {} == q15::highest());
+        CHECK(q15 {} / q15 {} == q15 {});
+        CHECK((q15::lowest() * q15::lowest()) == q15::highest());
+
+        const Vector<2, int16_t> big {int16_t {30000}, int16_t {-30000}};
+        const auto               sum  = saturating_add(big, big);
+        const auto               diff = saturating_sub(big, -big);
+        CHECK(sum[0] == INT16_MAX);
+        CHECK(sum[1] == INT16_MIN);
+        CHECK(diff[0] == INT16_MAX);
+        CHECK(diff[1] == INT16_MIN);
+    }
+
+    SUBCASE("Vectors")
+    {
+        constexpr Vector a {q15(0.5), q15(-0.25), q15(0.125)};
+        constexpr Vector b {q15(0.75), q15(0.75), q15(-0.5)};
+
+        constexpr auto sum = a + b;
+        CHECK(std::is_same_v<std::decay_t<decltype(sum)>, Vector<3, q15>>);
+        CHECK(sum[0] == q15::highest());
+        CHECK(static_cast<double>(sum[1]) == 0.5);
+
+        CHECK(std::is_same_v<std::common_type_t<q15, double>, double>);
+        CHECK(std::is_same_v<std::common_type_t<q15, q31>, q31>);
+        CHECK(std::is_same_v<std::common_type_t<q15, Fixed<8, int16_t>>,
+                             Fixed<8, int16_t>>);
+        CHECK(std::is_same_v<std::common_type_t<Fixed<8, int16_t>, q31>,
+                             Fixed<24, int32_t>>);
+
+        CHECK(std::is_same_v<std::common_type_t<q15, half>, float>);
+        CHECK(std::is_same_v<std::common_type_t<bfloat16, q31>, float>);
+        const auto mixed = a + Vector {half(1.0f), half(0.5f), half(0.0f)};
+        CHECK(std::is_same_v<std::decay_t<decltype(mixed)>, Vector<3, float>>);
+        CHECK(mixed[1] == 0.25f);
+
+        const auto scaled = a * 2.0;
+        CHECK(std::is_same_v<std::decay_t<decltype(scaled)>, Vector<3, double>>);
+        CHECK(scaled[0] == 1.0);
+        CHECK(a.norm() == Approx(std::sqrt(0.25 + 0.0625 + 0.015625)));
+
+        constexpr auto dot = dot_wide(a, b);
+        CHECK(std::is_same_v<std::decay_t<decltype(dot)>, Fixed<30, int64_t>>);
+        CHECK(static_cast<double>(dot) == 0.375 - 0.1875 - 0.0625);
+
+        const Vector full {q31::highest(), q31::highest()};
+        CHECK(std::is_same_v<dot_wide_t<q31>, Fixed<48, int64_t>>);
+        CHECK(dot_wide(full, full) == Approx(2.0));
+
+        const Vector<3, int32_t> i {2000000000, -2000000000, 7};
+        CHECK(dot_wide(i, i) == 8000000000000000049LL);
+
+        // Products of unsigned 32 bit integers exceed int64_t.
+        const Vector<2, uint32_t> u {4000000000u, 1u};
+        CHECK(std::is_same_v<dot_wide_t<uint32_t>, uint64_t>);
+        CHECK(dot_wide(u, u) == 16000000000000000001ULL);
+    }
+
+    SUBCASE("Batched Q15 dot products")
+    {
+        std::mt19937                       rng(3);
+        std::uniform_int_distribution<int> raw(-32768, 32767);
+        auto random_q15 = [&] { return q15::from_raw(raw(rng)); };
+
+        // Every seventh point is all -1.0, whose products with a query of
+        // -1.0 fill a 32 bit pair sum of pmaddwd exactly.
+        const q15                   m = q15::lowest();
+        const Vector                lowest {m, m, m, m, m};
+        Batch<5, q15>               points;
+        std::vector<Vector<5, q15>> reference;
+        for (int i = 0; i < 203; ++i)
+        {
+            const Vector p = i % 7 == 0 ? lowest
+                                        : Vector {random_q15(),
+                                                  random_q15(),
+                                                  random_q15(),
+                                                  random_q15(),
+                                                  random_q15()};
+            points.push_back(p);
+            reference.push_back(p);
+        }
+        const Vector random_query {random_q15(),
+                                   random_q15(),
+                                   random_q15(),
+                                   random_q15(),
+                                   random_q15()};
+
+        for (const auto &query : {random_query, lowest})
+        {
+            std::vector<dot_wide_t<q15>> soa(points.size());
+            std::vector<dot_wide_t<q15>> aos(points.size());
+            dot_many(query, points, soa);
+            dot_many(query, Span(reference), aos);
+            for (size_t i = 0; i < points.size(); ++i)
+            {
+                CHECK(soa[i] == dot_wide(query, reference[i]));
+                CHECK(aos[i] == dot_wide(query, reference[i]));
+            }
+        }
+        CHECK(static_cast<double>(dot_wide(lowest, lowest)) == 5.0);
+    }
+}
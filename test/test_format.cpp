@@ -0,0 +1,164 @@
+#include "colibra/fixed_point.h"
+#include "colibra/format.h"
+#include "colibra/half.h"
+#include "colibra/vector.h"
+#include "doctest.h"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace colibra;
+
+namespace {
+
+template<size_t l, typename T>
+std::string format(const Vector<l, T> &vec)
+{
+    std::array<char, max_chars_v<l, T>> buffer {};
+    const auto result =
+        to_chars(buffer.data(), buffer.data() + buffer.size(), vec);
+    REQUIRE(result.ec == std::errc {});
+    return std::string(buffer.data(), result.ptr);
+}
+
+template<size_t l, typename T>
+std::errc parse(const std::string_view text, Vector<l, T> &vec)
+{
+    return from_chars(text.data(), text.data() + text.size(), vec).ec;
+}
+
+} // namespace
+
+TEST_CASE("Formatting and parsing")
+{
+    SUBCASE("format matches operator<<")
+    {
+        const Vector a {1, -2, 30};
+        const Vector b {0.5, -1.25, 1e10};
+
+        std::ostringstream os;
+        os << a << b;
+        CHECK(format(a) + format(b) == os.str());
+        CHECK(format(Vector {-7}) == "{ -7 }");
+    }
+
+    SUBCASE("floats round trip exactly")
+    {
+        std::mt19937                          rng(7);
+        std::uniform_real_distribution<float> dist(-1e6f, 1e6f);
+        for (int n = 0; n < 1000; ++n)
+        {
+            const Vector v {dist(rng), dist(rng) * 1e-30f, dist(rng) * 1e30f};
+            Vector<3, float> parsed;
+            REQUIRE(parse(format(v), parsed) == std::errc {});
+            CHECK(parsed == v);
+        }
+
+        const Vector extremes {std::numeric_limits<double>::lowest(),
+                               std::numeric_limits<double>::denorm_min(),
+                               -std::numeric_limits<double>::max()};
+        CHECK(format(extremes).size() <= max_chars_v<3, double>);
+        Vector<3, double> parsed;
+        REQUIRE(parse(format(extremes), parsed) == std::errc {});
+        CHECK(parsed == extremes);
+    }
+
+    SUBCASE("integers, half and fixed point")
+    {
+        const Vector i {std::numeric_limits<int64_t>::min(), int64_t {0}};
+        Vector<2, int64_t> parsed_i;
+        REQUIRE(parse(format(i), parsed_i) == std::errc {});
+        CHECK(parsed_i == i);
+
+        const Vector h {half(1.5f), half(-0.0009765625f)};
+        CHECK(format(h) == "{ 1.5, -0.0009765625 }");
+        Vector<2, half> parsed_h;
+        REQUIRE(parse(format(h), parsed_h) == std::errc {});
+        CHECK(parsed_h == h);
+
+        const Vector q {q15(0.5), q15::lowest(), q15::highest()};
+        Vector<3, q15> parsed_q;
+        REQUIRE(parse(format(q), parsed_q) == std::errc {});
+        CHECK(parsed_q == q);
+        CHECK(parse("{ 0.5, 1.5, 0 }", parsed_q)
+              == std::errc::result_out_of_range);
+    }
+
+    SUBCASE("parsing is lenient about whitespace")
+    {
+        Vector<3, int> v;
+        const std::string_view text = " \n{1,2 ,\t3}rest";
+        const auto result =
+            from_chars(text.data(), text.data() + text.size(), v);
+        REQUIRE(result.ec == std::errc {});
+        CHECK(std::string_view(result.ptr) == "rest");
+        CHECK(v == Vector {1, 2, 3});
+    }
+
+    SUBCASE("malformed input is rejected")
+    {
+        Vector<3, int> v {7, 8, 9};
+        for (const char *text : {"", "{ 1, 2 }", "{ 1, 2, 3, 4 }", "1, 2, 3",
+                                 "{ 1, 2, 3", "{ 1 2 3 }", "{ 1, x, 3 }"})
+        {
+            CHECK(parse(text, v) == std::errc::invalid_argument);
+        }
+        CHECK(parse("{ 1, 99999999999, 3 }", v)
+              == std::errc::result_out_of_range);
+        CHECK(v == Vector {7, 8, 9});
+    }
+
+    SUBCASE("small buffers fail")
+    {
+        const Vector v {1.0f, 2.0f};
+        std::array<char, 7> buffer {};
+        const auto          result =
+            to_chars(buffer.data(), buffer.data() + buffer.size(), v);
+        CHECK(result.ec == std::errc::value_too_large);
+        CHECK(result.ptr == buffer.data() + buffer.size());
+    }
+
+    SUBCASE("batches")
+    {
+        const std::vector<Vector<2, float>> vectors {
+            Vector {1.0f, 2.0f}, Vector {-3.5f, 4.0f}, Vector {0.0f, 1e-3f}};
+        const Batch<2, float> batch {Span(vectors)};
+
+        std::string buffer(3 * max_chars_v<2, float> + 3, '\0');
+        char *const first = buffer.data();
+        char *const last  = first + buffer.size();
+
+        auto result = to_chars(first, last, Span(vectors));
+        REQUIRE(result.ec == std::errc {});
+        const std::string text(first, result.ptr);
+        CHECK(text == "{ 1, 2 }\n{ -3.5, 4 }\n{ 0, 0.001 }\n");
+
+        result = to_chars(first, last, batch);
+        REQUIRE(result.ec == std::errc {});
+        CHECK(std::string(first, result.ptr) == text);
+
+        std::vector<Vector<2, float>> parsed(3);
+        CHECK(from_chars(text.data(), text.data() + text.size(), Span(parsed))
+                  .ec
+              == std::errc {});
+        CHECK(parsed == vectors);
+
+        Batch<2, float> parsed_batch(3);
+        const char *const end = text.data() + text.size();
+        CHECK(from_chars(text.data(), end, parsed_batch.view()).ec
+              == std::errc {});
+        CHECK(parsed_batch[1] == vectors[1]);
+
+        std::vector<Vector<2, float>> too_many(4);
+        CHECK(from_chars(text.data(), text.data() + text.size(), Span(too_many))
+                  .ec
+              == std::errc::invalid_argument);
+    }
+}
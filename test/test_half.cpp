@@ -0,0 +1,142 @@
+#include "colibra/batch_ops.h"
+#include "colibra/half.h"
+#include "colibra/vector.h"
+#include "doctest.h"
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+using namespace colibra;
+using doctest::Approx;
+
+TEST_CASE("Half precision")
+{
+    SUBCASE("half conversion")
+    {
+        static_assert(half(1.0f).bits() == 0x3c00);
+        static_assert(half(-2.0f).bits() == 0xc000);
+
+        CHECK(static_cast<float>(half(1.0f)) == 1.0f);
+        CHECK(static_cast<float>(half(-2.5f)) == -2.5f);
+        CHECK(static_cast<float>(half(65504.0f)) == 65504.0f);
+        CHECK(std::isinf(static_cast<float>(half(1e6f))));
+        CHECK(std::isnan(static_cast<float>(
+            half(std::numeric_limits<float>::quiet_NaN()))));
+
+        // Smallest subnormal and values below half of it.
+        CHECK(half(std::ldexp(1.0f, -24)).bits() == 0x0001);
+        CHECK(half(std::ldexp(1.0f, -26)).bits() == 0x0000);
+        CHECK(static_cast<float>(half::from_bits(0x0001))
+              == std::ldexp(1.0f, -24));
+        CHECK(static_cast<float>(half::from_bits(0x03ff))
+              == std::ldexp(1023.0f, -24));
+
+        // 1 + 2^-11 lies exactly between two halves and rounds to even.
+        CHECK(half(1.0f + std::ldexp(1.0f, -11)).bits() == 0x3c00);
+        CHECK(half(1.0f + 3 * std::ldexp(1.0f, -11)).bits() == 0x3c02);
+
+        // All finite halves survive a round trip through float.
+        for (uint32_t bits = 0; bits < 0x7c00; ++bits)
+        {
+            const auto h = half::from_bits(static_cast<uint16_t>(bits));
+            REQUIRE(half(static_cast<float>(h)).bits() == bits);
+        }
+    }
+
+    SUBCASE("bfloat16 conversion")
+    {
+        static_assert(bfloat16(1.0f).bits() == 0x3f80);
+        CHECK(static_cast<float>(bfloat16(3.0e38f))
+              == Approx(3.0e38f).epsilon(0.01));
+        CHECK(static_cast<float>(bfloat16(1.0f + std::ldexp(1.0f, -8)))
+              == 1.0f);
+        CHECK(std::isnan(static_cast<float>(
+            bfloat16(std::numeric_limits<float>::quiet_NaN()))));
+    }
+
+    SUBCASE("Arithmetic")
+    {
+        constexpr half a(1.5f);
+        constexpr half b(0.25f);
+        CHECK(static_cast<float>(a + b) == 1.75f);
+        CHECK(static_cast<float>(a - b) == 1.25f);
+        CHECK(static_cast<float>(a * b) == 0.375f);
+        CHECK(static_cast<float>(a / b) == 6.0f);
+        CHECK(static_cast<float>(-a) == -1.5f);
+        CHECK(std::is_same_v<decltype(a + b), half>);
+        CHECK(std::is_same_v<decltype(a + 1.0f), float>);
+    }
+
+    SUBCASE("Vector of half")
+    {
+        CHECK(sizeof(Vector<3, half>) == 3 * sizeof(uint16_t));
+        CHECK(std::is_same_v<std::common_type_t<half, int>, half>);
+        CHECK(std::is_same_v<std::common_type_t<half, float>, float>);
+        CHECK(std::is_same_v<std::common_type_t<half, double>, double>);
+        CHECK(std::is_same_v<std::common_type_t<half, bfloat16>, float>);
+
+        const Vector v {half(1.0f), half(2.0f), half(2.0f)};
+        const auto   doubled = v * 2;
+        CHECK(std::is_same_v<std::decay_t<decltype(doubled)>, Vector<3, half>>);
+        CHECK(static_cast<float>(doubled[2]) == 4.0f);
+
+        const auto widened = v * 0.5f;
+        CHECK(std::is_same_v<std::decay_t<decltype(widened)>,
+                             Vector<3, float>>);
+        CHECK(v.norm() == Approx(3.0));
+        CHECK(static_cast<float>((v + v)[1]) == 4.0f);
+    }
+
+    SUBCASE("Span conversion")
+    {
+        std::vector<float> floats(37);
+        for (size_t i = 0; i < floats.size(); ++i)
+        {
+            floats[i] = 0.125f * i - 2.0f;
+        }
+        std::vector<half>  halves(floats.size());
+        std::vector<float> back(floats.size());
+        convert(floats, halves);
+        convert(halves, back);
+        CHECK(back == floats);
+
+        std::vector<bfloat16> brains(floats.size());
+        convert(floats, brains);
+        convert(brains, back);
+        CHECK(back == floats);
+
+        CHECK_THROWS_AS(convert(floats, Span<half>(halves.data(), 3)),
+                        std::invalid_argument);
+    }
+
+    SUBCASE("Batch kernels widen to float")
+    {
+        Batch<3, half>                points;
+        std::vector<Vector<3, float>> reference;
+        for (int i = 0; i < 1000; ++i)
+        {
+            const Vector p {half(0.01f * i), half(-0.5f), half(1.0f + i % 7)};
+            points.push_back(p);
+            reference.push_back(Vector {static_cast<float>(p[0]),
+                                        static_cast<float>(p[1]),
+                                        static_cast<float>(p[2])});
+        }
+        const Vector query {half(1.0f), half(2.0f), half(-0.5f)};
+        const Vector query_f {1.0f, 2.0f, -0.5f};
+
+        std::vector<float> dots(points.size());
+        std::vector<float> norms(points.size());
+        std::vector<float> distances(points.size());
+        dot_many(query, points, dots);
+        norm_many(points, norms);
+        distance_many(execution::par, query, points, distances);
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            CHECK(dots[i] == Approx(query_f * reference[i]));
+            CHECK(norms[i] == Approx(reference[i].norm()));
+            CHECK(distances[i] == Approx((reference[i] - query_f).norm()));
+        }
+    }
+}
@@ -0,0 +1,301 @@
+#include "colibra/interpolation.h"
+#include "doctest.h"
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace colibra;
+using doctest::Approx;
+
+namespace {
+
+void check_quaternion(const Quaternion<double> &actual,
+                      const Quaternion<double> &expected,
+                      const double              epsilon = 1e-12)
+{
+    CHECK(actual.w == Approx(expected.w).epsilon(epsilon));
+    CHECK(actual.x == Approx(expected.x).epsilon(epsilon));
+    CHECK(actual.y == Approx(expected.y).epsilon(epsilon));
+    CHECK(actual.z == Approx(expected.z).epsilon(epsilon));
+}
+
+/// The angle of the rotation taking a to b.
+double angle_between(const Quaternion<double> &a, const Quaternion<double> &b)
+{
+    const double w = std::abs((a.conjugate() * b).w);
+    return 2.0 * std::acos(std::min(w, 1.0));
+}
+
+} // namespace
+
+TEST_CASE("Quaternion")
+{
+    constexpr double pi = 3.14159265358979323846;
+
+    // A quarter turn around z, exactly representable.
+    constexpr double               h = 0.70710678118654752440;
+    constexpr Quaternion<double>   q {h, 0.0, 0.0, h};
+    constexpr Matrix<3, 3, double> m = q.to_matrix();
+    static_assert(m(2, 2) == 1.0);
+    static_assert(Quaternion<double>::identity().to_matrix()
+                  == Matrix<3, 3, double>::identity());
+    static_assert(Quaternion<double> {} * q == q);
+    static_assert(q * q.conjugate() == Quaternion<double> {h * h + h * h});
+
+    const Vector<3, double> rotated = q(Vector {1.0, 0.0, 0.0});
+    CHECK(rotated[0] == Approx(0.0));
+    CHECK(rotated[1] == Approx(1.0));
+    CHECK(rotated[2] == Approx(0.0));
+
+    SUBCASE("axis angle and matrices")
+    {
+        std::mt19937                           rng(3);
+        std::uniform_real_distribution<double> unit(-1.0, 1.0);
+        for (int k = 0; k < 100; ++k)
+        {
+            const Vector<3, double> axis {unit(rng), unit(rng), unit(rng)};
+            const Quaternion<double> a =
+                Quaternion<double>::from_axis_angle(axis, pi * unit(rng));
+            CHECK(a.norm() == Approx(1.0));
+
+            // The quaternion from the matrix is a or -a.
+            const Quaternion<double> back =
+                Quaternion<double>::from_matrix(a.to_matrix());
+            check_quaternion(back.w * a.w < 0.0 ? -back : back, a);
+
+            const Vector<3, double> p {unit(rng), unit(rng), unit(rng)};
+            const Vector<3, double> expected = a.to_matrix() * p;
+            const Vector<3, double> actual   = a(p);
+            for (size_t d = 0; d < 3; ++d)
+            {
+                CHECK(actual[d] == Approx(expected[d]));
+            }
+
+            // Composition matches applying one after the other.
+            const Vector<3, double> composed = (q * a)(p);
+            const Vector<3, double> chained  = q(a(p));
+            for (size_t d = 0; d < 3; ++d)
+            {
+                CHECK(composed[d] == Approx(chained[d]));
+            }
+        }
+
+        // Each branch of the Shepperd selection.
+        for (const Vector<3, double> &axis : {Vector {1.0, 0.0, 0.0},
+                                              Vector {0.0, 1.0, 0.0},
+                                              Vector {0.0, 0.0, 1.0}})
+        {
+            const auto a = Quaternion<double>::from_axis_angle(axis, 3.0);
+            const auto b = Quaternion<double>::from_matrix(a.to_matrix());
+            check_quaternion(b.w * a.w < 0.0 ? -b : b, a);
+        }
+    }
+
+    SUBCASE("slerp and nlerp")
+    {
+        const auto a = Quaternion<double>::from_axis_angle(
+            Vector {0.0, 0.0, 1.0}, 0.2);
+        const auto b = Quaternion<double>::from_axis_angle(
+            Vector {1.0, 1.0, 0.0}, 2.0);
+        const double total = angle_between(a, b);
+
+        check_quaternion(slerp(a, b, 0.0), a);
+        check_quaternion(slerp(a, b, 1.0), b);
+        check_quaternion(nlerp(a, b, 0.0), a);
+        check_quaternion(nlerp(a, b, 1.0), b);
+        for (const double t : {0.1, 0.25, 0.5, 0.9})
+        {
+            // Constant angular velocity for slerp, not for nlerp.
+            CHECK(angle_between(a, slerp(a, b, t)) == Approx(t * total));
+            CHECK(slerp(a, b, t).norm() == Approx(1.0));
+            CHECK(nlerp(a, b, t).norm() == Approx(1.0));
+        }
+        check_quaternion(nlerp(a, b, 0.5), slerp(a, b, 0.5));
+        CHECK(angle_between(a, nlerp(a, b, 0.25))
+              != Approx(0.25 * total).epsilon(1e-6));
+
+        // -b is the same rotation, both take the shorter arc.
+        check_quaternion(slerp(a, -b, 0.3), slerp(a, b, 0.3));
+        check_quaternion(nlerp(a, -b, 0.3), nlerp(a, b, 0.3));
+
+        // Equal inputs, where the angle is zero.
+        check_quaternion(slerp(a, a, 0.7), a);
+    }
+}
+
+TEST_CASE("Splines")
+{
+    static_assert(hermite(Vector {0.0, 1.0},
+                          Vector {1.0, 0.0},
+                          Vector {2.0, 3.0},
+                          Vector {0.0, 0.0},
+                          1.0)
+                  == Vector {2.0, 3.0});
+    static_assert(hermite(Vector {0.0}, Vector {0.0}, Vector {1.0},
+                          Vector {0.0}, 0.5)
+                  == Vector {0.5});
+    // On a line with uniform spacing Catmull-Rom is linear.
+    static_assert(catmull_rom(Vector {0.0}, Vector {1.0}, Vector {2.0},
+                              Vector {3.0}, 0.25)
+                  == Vector {1.25});
+
+    const std::vector<Vector<2, double>> points {Vector {0.0, 0.0},
+                                                 Vector {1.0, 2.0},
+                                                 Vector {3.0, 1.0},
+                                                 Vector {4.0, 4.0},
+                                                 Vector {2.0, 5.0}};
+    const auto spline = HermiteSpline<2, double>::catmull_rom(points);
+    CHECK(spline.size() == points.size());
+    CHECK(spline.segments() == points.size() - 1);
+
+    for (size_t k = 0; k < points.size(); ++k)
+    {
+        const Vector<2, double> p = spline(static_cast<double>(k));
+        CHECK(p[0] == Approx(points[k][0]));
+        CHECK(p[1] == Approx(points[k][1]));
+    }
+    // Inner segments match the four point form, the outer ones repeat the
+    // end points.
+    const Vector<2, double> inner =
+        catmull_rom(points[0], points[1], points[2], points[3], 0.3);
+    CHECK(spline(1.3)[0] == Approx(inner[0]));
+    CHECK(spline(1.3)[1] == Approx(inner[1]));
+    const Vector<2, double> first =
+        catmull_rom(points[0], points[0], points[1], points[2], 0.6);
+    CHECK(spline(0.6)[1] == Approx(first[1]));
+
+    // Parameters outside are clamped to the ends.
+    CHECK(spline(-2.0) == spline(0.0));
+    CHECK(spline(10.0) == spline(4.0));
+    CHECK(spline(std::numeric_limits<double>::quiet_NaN()) == spline(4.0));
+
+    const Span<const Vector<2, double>> all(points);
+    const HermiteSpline<2, double>      single(all.subspan(0, 1),
+                                          all.subspan(1, 1));
+    CHECK(single.segments() == 1);
+    CHECK(single(0.5) == points[0]);
+
+    const HermiteSpline<2, double> empty;
+    CHECK_THROWS_AS((void)empty(0.0), std::out_of_range);
+    CHECK_THROWS_AS((HermiteSpline<2, double>(points, all.subspan(1, 4))),
+                    std::invalid_argument);
+}
+
+TEST_CASE("Batched interpolation")
+{
+    std::mt19937 rng(9);
+    // Not a multiple of the chunk size, so the tails are exercised.
+    const size_t                          n = 1003;
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<float>                    t(n);
+    for (auto &value : t)
+    {
+        value = unit(rng);
+    }
+    t[0] = 0.0f;
+    t[1] = 1.0f;
+    const execution::parallel_policy policy {4, 100};
+
+    SUBCASE("sin_series")
+    {
+        for (double x = -1.6; x < 1.6; x += 0.01)
+        {
+            CHECK(details::sin_series(x) == Approx(std::sin(x)).epsilon(1e-15));
+        }
+        static_assert(details::sin_series(0.0) == 0.0);
+    }
+
+    SUBCASE("lerp_many")
+    {
+        const Vector a {1.0f, -2.0f, 0.5f};
+        const Vector b {3.0f, 4.0f, -1.5f};
+        Batch<3, float> out(n);
+        lerp_many(a, b, t, out.view());
+        for (size_t i = 0; i < n; ++i)
+        {
+            const Vector<3, float> expected = lerp(a, b, t[i]);
+            for (size_t d = 0; d < 3; ++d)
+            {
+                CHECK(out[i][d] == Approx(expected[d]));
+            }
+        }
+        CHECK_THROWS_AS(lerp_many(a, b, t, out.view().subview(0, 3)),
+                        std::invalid_argument);
+    }
+
+    SUBCASE("slerp_many and nlerp_many")
+    {
+        const auto a = Quaternion<float>::from_axis_angle(
+            Vector {0.0f, 1.0f, 1.0f}, 0.5f);
+        const auto b = Quaternion<float>::from_axis_angle(
+            Vector {1.0f, -1.0f, 0.0f}, -2.5f);
+
+        Batch<4, float> seq(n);
+        Batch<4, float> par(n);
+        slerp_many(a, b, t, seq.view());
+        slerp_many(policy, a, b, t, par.view());
+        for (size_t i = 0; i < n; ++i)
+        {
+            const Vector<4, float> expected = slerp(a, b, t[i]).coefficients();
+            for (size_t d = 0; d < 4; ++d)
+            {
+                CHECK(seq[i][d] == Approx(expected[d]).epsilon(1e-5));
+            }
+            CHECK(par[i] == seq[i]);
+        }
+
+        nlerp_many(a, b, t, seq.view());
+        nlerp_many(policy, a, b, t, par.view());
+        for (size_t i = 0; i < n; ++i)
+        {
+            const Vector<4, float> expected = nlerp(a, b, t[i]).coefficients();
+            for (size_t d = 0; d < 4; ++d)
+            {
+                CHECK(seq[i][d] == Approx(expected[d]).epsilon(1e-5));
+            }
+            CHECK(par[i] == seq[i]);
+        }
+
+        // Equal quaternions fall back to linear weights.
+        slerp_many(a, a, t, seq.view());
+        for (size_t d = 0; d < 4; ++d)
+        {
+            CHECK(seq[17][d] == Approx(a.coefficients()[d]).epsilon(1e-6));
+        }
+    }
+
+    SUBCASE("evaluate_many")
+    {
+        std::vector<Vector<3, float>> points(50);
+        for (auto &point : points)
+        {
+            point = Vector {unit(rng), unit(rng), unit(rng)};
+        }
+        const auto spline = HermiteSpline<3, float>::catmull_rom(points);
+
+        std::vector<float> s(n);
+        for (auto &value : s)
+        {
+            value = 52.0f * unit(rng) - 1.0f;
+        }
+        s[2] = 49.0f;
+
+        Batch<3, float> seq(n);
+        Batch<3, float> par(n);
+        evaluate_many(spline, s, seq.view());
+        evaluate_many(policy, spline, s, par.view());
+        for (size_t i = 0; i < n; ++i)
+        {
+            CHECK(seq[i] == spline(s[i]));
+            CHECK(par[i] == seq[i]);
+        }
+
+        CHECK_THROWS_AS(
+            evaluate_many(HermiteSpline<3, float> {}, s, seq.view()),
+            std::out_of_range);
+        CHECK_THROWS_AS(evaluate_many(spline, s, seq.view().subview(0, 1)),
+                        std::invalid_argument);
+    }
+}
@@ -0,0 +1,325 @@
+#include "colibra/decompositions.h"
+#include "colibra/matrix.h"
+#include "colibra/matrix_batch.h"
+#include "colibra/matrix_batch_ops.h"
+#include "doctest.h"
+
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <vector>
+
+using namespace colibra;
+using doctest::Approx;
+
+namespace {
+
+template<size_t r, size_t c, typename T>
+void check_close(const Matrix<r, c, T> &a,
+                 const Matrix<r, c, T> &b,
+                 const double           eps = 1e-9)
+{
+    for (size_t i = 0; i < r; ++i)
+    {
+        for (size_t j = 0; j < c; ++j)
+        {
+            CHECK(a(i, j) == Approx(b(i, j)).epsilon(eps).scale(1.0));
+        }
+    }
+}
+
+template<size_t r, size_t c>
+Matrix<r, c, double> random_matrix(std::mt19937 &rng)
+{
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    Matrix<r, c, double>                   m;
+    for (size_t i = 0; i < r; ++i)
+    {
+        for (size_t j = 0; j < c; ++j)
+        {
+            m(i, j) = dist(rng);
+        }
+    }
+    return m;
+}
+
+template<size_t n>
+void check_decompositions(std::mt19937 &rng)
+{
+    const auto a = random_matrix<n, n>(rng);
+    const auto x = random_matrix<n, 1>(rng).col(0);
+    const auto b = a * x;
+
+    const auto lu_a = lu(a);
+    REQUIRE_FALSE(lu_a.singular());
+    check_close(Matrix<n, 1, double>::from_cols(lu_a.solve(b)),
+                Matrix<n, 1, double>::from_cols(x));
+    check_close(a * inverse(a), Matrix<n, n, double>::identity());
+    CHECK(determinant(a) == Approx(lu_a.determinant()));
+
+    const auto spd  = a * a.transpose() + Matrix<n, n, double>::identity();
+    const auto chol = cholesky(spd);
+    REQUIRE(chol.positive_definite);
+    check_close(chol.l * chol.l.transpose(), spd);
+    check_close(Matrix<n, 1, double>::from_cols(chol.solve(spd * x)),
+                Matrix<n, 1, double>::from_cols(x));
+
+    const auto qr_a = qr(a);
+    check_close(qr_a.q * qr_a.r, a);
+    check_close(qr_a.q.transpose() * qr_a.q, Matrix<n, n, double>::identity());
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (size_t j = 0; j < i; ++j)
+        {
+            CHECK(qr_a.r(i, j) == 0.0);
+        }
+    }
+
+    const auto eig = eigen_symmetric(spd);
+    Matrix<n, n, double> diagonal;
+    for (size_t i = 0; i < n; ++i)
+    {
+        diagonal(i, i) = eig.values[i];
+        if (i > 0)
+        {
+            CHECK(eig.values[i - 1] <= eig.values[i]);
+        }
+    }
+    check_close(eig.vectors * diagonal * eig.vectors.transpose(), spd);
+
+    const auto s = svd(a);
+    Matrix<n, n, double> sigma;
+    for (size_t i = 0; i < n; ++i)
+    {
+        sigma(i, i) = s.singular_values[i];
+    }
+    check_close(s.u * sigma * s.v.transpose(), a);
+    check_close(s.u.transpose() * s.u, Matrix<n, n, double>::identity());
+    check_close(s.v.transpose() * s.v, Matrix<n, n, double>::identity());
+}
+
+template<size_t n>
+void check_batched(std::mt19937 &rng)
+{
+    constexpr size_t                  count = 300;
+    std::vector<Matrix<n, n, double>> lhs;
+    std::vector<Matrix<n, n, double>> rhs;
+    std::vector<Vector<n, double>>    vectors;
+    for (size_t k = 0; k < count; ++k)
+    {
+        lhs.push_back(random_matrix<n, n>(rng));
+        rhs.push_back(random_matrix<n, n>(rng));
+        vectors.push_back(random_matrix<n, 1>(rng).col(0));
+    }
+    const MatrixBatch<n, n, double> a {Span(lhs)};
+    const MatrixBatch<n, n, double> b {Span(rhs)};
+    const Batch<n, double>          v {Span(vectors)};
+
+    const execution::parallel_policy policy {3, 100};
+    MatrixBatch<n, n, double>        inv(count);
+    MatrixBatch<n, n, double>        product(count);
+    Batch<n, double>                 transformed(count);
+    std::vector<double>              det(count);
+    inverse_many(policy, a, inv.view());
+    multiply_many(policy, a, b, product.view());
+    transform_many(a, v, transformed.view());
+    determinant_many(policy, a, Span(det));
+    for (size_t k = 0; k < count; ++k)
+    {
+        check_close(inv[k], inverse(lhs[k]), 1e-6);
+        check_close(product[k], lhs[k] * rhs[k]);
+        const auto expected = lhs[k] * vectors[k];
+        for (size_t i = 0; i < n; ++i)
+        {
+            CHECK(transformed[k][i] == Approx(expected[i]));
+        }
+        CHECK(det[k] == Approx(determinant(lhs[k])));
+    }
+
+    // In place: the output may alias the input.
+    MatrixBatch<n, n, double> in_place {Span(lhs)};
+    inverse_many(in_place, in_place.view());
+    check_close(in_place[count - 1], inv[count - 1]);
+}
+
+} // namespace
+
+TEST_CASE("Matrix")
+{
+    constexpr Matrix<2, 3, int> a {1, 2, 3, 4, 5, 6};
+    constexpr Matrix<3, 2, int> b {7, 8, 9, 10, 11, 12};
+
+    SUBCASE("access")
+    {
+        static_assert(a(1, 2) == 6);
+        static_assert(a.rows() == 2 && a.cols() == 3);
+        CHECK(a.row(1) == Vector {4, 5, 6});
+        CHECK(a.col(0) == Vector {1, 4});
+        CHECK(a.transpose() == Matrix<3, 2, int> {1, 4, 2, 5, 3, 6});
+        CHECK(Matrix<2, 3, int>::from_rows(Vector {1, 2, 3}, Vector {4, 5, 6})
+              == a);
+        CHECK(Matrix<2, 3, int>::from_cols(
+                  Vector {1, 4}, Vector {2, 5}, Vector {3, 6})
+              == a);
+        CHECK_THROWS_AS((void)a.at(2, 0), std::out_of_range);
+
+        std::stringstream ss;
+        ss << a;
+        CHECK(ss.str() == "{ { 1, 2, 3 }, { 4, 5, 6 } }");
+    }
+
+    SUBCASE("arithmetic")
+    {
+        constexpr auto product = a * b;
+        static_assert(product == Matrix<2, 2, int> {58, 64, 139, 154});
+        static_assert(a * Vector {1, 0, -1} == Vector {-2, -2});
+        static_assert((a + a) == a * 2);
+        static_assert((a - a) == Matrix<2, 3, int> {});
+        static_assert(-a == a * -1);
+        static_assert(Matrix<3, 3, int>::identity().trace() == 3);
+
+        const auto promoted = a * 0.5;
+        CHECK(std::is_same_v<decltype(promoted), const Matrix<2, 3, double>>);
+        CHECK(promoted(1, 1) == 2.5);
+    }
+
+    SUBCASE("compile time decompositions")
+    {
+        constexpr Matrix<3, 3, double> m {
+            4, 12, -16, 12, 37, -43, -16, -43, 98};
+        static_assert(determinant(m) == 36.0);
+        constexpr auto chol = cholesky(m);
+        static_assert(chol.positive_definite);
+        static_assert(
+            chol.l == Matrix<3, 3, double> {2, 0, 0, 6, 1, 0, -8, 5, 3});
+        constexpr auto x = lu(m).solve(Vector {1.0, 2.0, 3.0});
+        CHECK((m * x)[2] == Approx(3.0));
+        constexpr auto s = svd(Matrix<2, 2, double> {3, 0, 0, -4});
+        static_assert(s.singular_values == Vector {4.0, 3.0});
+    }
+
+    SUBCASE("random decompositions 2x2 to 6x6")
+    {
+        std::mt19937 rng(3);
+        for (int n = 0; n < 20; ++n)
+        {
+            check_decompositions<2>(rng);
+            check_decompositions<3>(rng);
+            check_decompositions<4>(rng);
+            check_decompositions<5>(rng);
+            check_decompositions<6>(rng);
+        }
+        check_decompositions<8>(rng);
+    }
+
+    SUBCASE("degenerate input")
+    {
+        constexpr Matrix<3, 3, double> singular {1, 2, 3, 2, 4, 6, 1, 0, 1};
+        CHECK(lu(singular).singular());
+        CHECK(determinant(singular) == 0.0);
+        CHECK_THROWS_AS((void)inverse(singular), std::domain_error);
+        CHECK_THROWS_AS((void)lu(singular).solve(Vector {1.0, 1.0, 1.0}),
+                        std::domain_error);
+        const auto negative = -Matrix<2, 2, double>::identity();
+        CHECK_FALSE(cholesky(negative).positive_definite);
+
+        // Rank one: the SVD still returns orthonormal singular vectors.
+        const auto s = svd(Matrix<3, 3, double> {1, 2, 3, 2, 4, 6, 3, 6, 9});
+        CHECK(s.singular_values[0] == Approx(14.0));
+        CHECK(s.singular_values[1] == Approx(0.0).scale(1.0));
+        check_close(s.u.transpose() * s.u, Matrix<3, 3, double>::identity());
+    }
+
+    SUBCASE("least squares")
+    {
+        // Fit y = 1 + 2 t through noiseless samples.
+        Matrix<5, 2, double> design;
+        Vector<5, double>    y;
+        for (size_t i = 0; i < 5; ++i)
+        {
+            design(i, 0) = 1;
+            design(i, 1) = static_cast<double>(i);
+            y[i]         = 1.0 + 2.0 * static_cast<double>(i);
+        }
+        const auto x = qr(design).solve(y);
+        CHECK(x[0] == Approx(1.0));
+        CHECK(x[1] == Approx(2.0));
+
+        const auto s = svd(design);
+        check_close(s.u.transpose() * s.u, Matrix<2, 2, double>::identity());
+    }
+
+    SUBCASE("batched solves")
+    {
+        std::mt19937                      rng(11);
+        constexpr size_t                  count = 1000;
+        std::vector<Matrix<4, 4, double>> matrices;
+        std::vector<Vector<4, double>>    rhs;
+        for (size_t k = 0; k < count; ++k)
+        {
+            auto m = random_matrix<4, 4>(rng);
+            if (k % 2 == 0)
+            {
+                m = m * m.transpose() + Matrix<4, 4, double>::identity();
+            }
+            matrices.push_back(m);
+            rhs.push_back(random_matrix<4, 1>(rng).col(0));
+        }
+        const MatrixBatch<4, 4, double> a {Span(matrices)};
+        const Batch<4, double>          b {Span(rhs)};
+        Batch<4, double>                x(count);
+
+        solve_many(execution::parallel_policy {3, 100}, a, b, x.view());
+        for (size_t k = 0; k < count; ++k)
+        {
+            const auto expected = lu(matrices[k]).solve(rhs[k]);
+            for (size_t i = 0; i < 4; ++i)
+            {
+                CHECK(x[k][i] == Approx(expected[i]));
+            }
+        }
+
+        // Every other matrix is symmetric positive definite.
+        MatrixBatch<4, 4, double> spd;
+        Batch<4, double>          spd_rhs;
+        for (size_t k = 0; k < count; k += 2)
+        {
+            spd.push_back(matrices[k]);
+            spd_rhs.push_back(rhs[k]);
+        }
+        Batch<4, double> y(spd.size());
+        cholesky_solve_many(spd, spd_rhs, y.view());
+        for (size_t k = 0; k < spd.size(); ++k)
+        {
+            const auto expected = cholesky(spd[k]).solve(spd_rhs[k]);
+            for (size_t i = 0; i < 4; ++i)
+            {
+                CHECK(y[k][i] == Approx(expected[i]));
+            }
+        }
+
+        CHECK_THROWS_AS(solve_many(a, spd_rhs, x.view()),
+                        std::invalid_argument);
+    }
+
+    SUBCASE("batched inverses and products")
+    {
+        std::mt19937 rng(13);
+        check_batched<2>(rng);
+        check_batched<3>(rng);
+        check_batched<4>(rng);
+        check_batched<6>(rng);
+
+        // A singular instance does not disturb its neighbours.
+        MatrixBatch<3, 3, double> a;
+        a.push_back(Matrix<3, 3, double> {1, 2, 3, 2, 4, 6, 0, 0, 1});
+        a.push_back(Matrix<3, 3, double>::identity() * 2.0);
+        MatrixBatch<3, 3, double> inv(a.size());
+        inverse_many(a, inv.view());
+        CHECK_FALSE(std::isfinite(inv[0](0, 0)));
+        check_close(inv[1], Matrix<3, 3, double>::identity() * 0.5);
+
+        std::vector<double> det(1);
+        CHECK_THROWS_AS(determinant_many(a, Span(det)), std::invalid_argument);
+    }
+}
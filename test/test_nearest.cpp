@@ -0,0 +1,89 @@
+#include "colibra/nearest.h"
+#include "doctest.h"
+
+#include <random>
+#include <vector>
+
+using namespace colibra;
+using doctest::Approx;
+
+TEST_CASE("Nearest neighbors")
+{
+    std::mt19937                           rng(7);
+    std::uniform_real_distribution<double> dist(-10.0, 10.0);
+
+    std::vector<Vector<3, double>> points(500);
+    for (auto &p : points)
+    {
+        p = Vector {dist(rng), dist(rng), dist(rng)};
+    }
+
+    const BruteForceIndex<3, double> brute {Span(points)};
+    const KdTree<3, double>          tree {Span(points), 8};
+    CHECK(tree.size() == points.size());
+
+    SUBCASE("Nearest")
+    {
+        for (int q = 0; q < 50; ++q)
+        {
+            const Vector query {dist(rng), dist(rng), dist(rng)};
+            const auto   expected = brute.nearest(query);
+            const auto   found    = tree.nearest(query);
+            CHECK(found.index == expected.index);
+            CHECK(found.distance_squared == Approx(expected.distance_squared));
+            CHECK(std::sqrt(found.distance_squared)
+                  == Approx((points[found.index] - query).norm()));
+        }
+        CHECK(tree.nearest(points[42]).index == 42);
+        CHECK(brute.nearest(points[42]).index == 42);
+        CHECK(brute.nearest(points.back()).index == points.size() - 1);
+    }
+
+    SUBCASE("k nearest")
+    {
+        const Vector query {1.0, -2.0, 0.5};
+        const auto   expected = brute.knn(query, 10);
+        const auto   found    = tree.knn(query, 10);
+        REQUIRE(found.size() == 10);
+        REQUIRE(expected.size() == 10);
+        for (size_t i = 0; i < found.size(); ++i)
+        {
+            CHECK(found[i].index == expected[i].index);
+            if (i > 0)
+            {
+                CHECK(found[i - 1].distance_squared
+                      <= found[i].distance_squared);
+            }
+        }
+        CHECK(tree.knn(query, points.size() + 10).size() == points.size());
+        CHECK(tree.knn(query, 0).empty());
+    }
+
+    SUBCASE("Radius")
+    {
+        const Vector query {0.0, 0.0, 0.0};
+        const auto   expected = brute.radius(query, 3.0);
+        const auto   found    = tree.radius(query, 3.0);
+        REQUIRE(found.size() == expected.size());
+        for (size_t i = 0; i < found.size(); ++i)
+        {
+            CHECK(found[i].index == expected[i].index);
+            CHECK(found[i].distance_squared <= 9.0);
+        }
+    }
+
+    SUBCASE("Degenerate sets")
+    {
+        const std::vector<Vector<2, float>> same(100, Vector {1.0f, 1.0f});
+        const KdTree<2, float>              same_tree {Span(same), 4};
+        CHECK(same_tree.knn(Vector {0.0f, 0.0f}, 5).size() == 5);
+        CHECK(same_tree.radius(Vector {1.0f, 1.0f}, 0.0f).size()
+              == same.size());
+
+        const KdTree<2, float> empty;
+        CHECK_THROWS_AS(empty.nearest(Vector {0.0f, 0.0f}), std::out_of_range);
+        CHECK(empty.knn(Vector {0.0f, 0.0f}, 3).empty());
+        CHECK_THROWS_AS((KdTree<2, float> {Span(same), 0}),
+                        std::invalid_argument);
+    }
+}
@@ -0,0 +1,181 @@
+#include "colibra/point_store.h"
+#include "colibra/vector.h"
+#include "doctest.h"
+#include "temp_file.h"
+
+#include <string>
+#include <vector>
+
+using namespace colibra;
+using doctest::Approx;
+
+TEST_CASE("Point store")
+{
+    const TempFile     file;
+    const TempFile     file2;
+    const std::string &path  = file.path;
+    const std::string &path2 = file2.path;
+
+    std::vector<Vector<3, float>> points;
+    for (int i = 0; i < 5000; ++i)
+    {
+        points.push_back(
+            Vector {float(i % 97), float(-(i % 13)), float(i) * 0.5f});
+    }
+
+    const auto write = [&](const Layout layout) {
+        if (layout == Layout::array_of_structures)
+        {
+            write_binary(path, Span<const Vector<3, float>>(points));
+        }
+        else
+        {
+            write_binary(path, Batch<3, float> {Span(points)});
+        }
+    };
+    const Layout layouts[] = {Layout::array_of_structures,
+                              Layout::structure_of_arrays};
+
+    SUBCASE("open")
+    {
+        for (const Layout layout : layouts)
+        {
+            write(layout);
+            const PointStore<3, float> store(path);
+            REQUIRE(store.size() == points.size());
+            CHECK(store.layout() == layout);
+            CHECK_FALSE(store.writable());
+            CHECK(store[1234] == points[1234]);
+        }
+    }
+
+    SUBCASE("chunks cover the store in order")
+    {
+        for (const Layout layout : layouts)
+        {
+            write(layout);
+            const PointStore<3, float> store(path);
+
+            size_t next = 0;
+            for_each_chunk(
+                store,
+                [&](size_t begin, const auto &chunk) {
+                    CHECK(begin == next);
+                    for (size_t i = 0; i < chunk.size(); ++i)
+                    {
+                        CHECK(chunk[i] == points[begin + i]);
+                    }
+                    next += chunk.size();
+                },
+                1000 - 7);
+            CHECK(next == points.size());
+        }
+    }
+
+    SUBCASE("bounding box")
+    {
+        for (const Layout layout : layouts)
+        {
+            write(layout);
+            const PointStore<3, float> store(path);
+
+            const auto expected = std::pair {Vector {0.0f, -12.0f, 0.0f},
+                                             Vector {96.0f, 0.0f, 2499.5f}};
+            CHECK(bounding_box(store, 333) == expected);
+            CHECK(bounding_box(execution::parallel_policy {4, 16}, store, 999)
+                  == expected);
+        }
+    }
+
+    SUBCASE("centroid")
+    {
+        for (const Layout layout : layouts)
+        {
+            write(layout);
+            const PointStore<3, float> store(path);
+
+            Vector<3, double> expected;
+            for (const auto &p : points)
+            {
+                for (size_t d = 0; d < 3; ++d)
+                {
+                    expected[d] += p[d];
+                }
+            }
+            for (const auto &c :
+                 {centroid(store, 500),
+                  centroid(execution::parallel_policy {3, 8}, store, 777)})
+            {
+                for (size_t d = 0; d < 3; ++d)
+                {
+                    CHECK(c[d] == Approx(expected[d] / points.size()));
+                }
+            }
+        }
+    }
+
+    SUBCASE("transform into another store")
+    {
+        for (const Layout layout : layouts)
+        {
+            write(layout);
+            const PointStore<3, float> store(path);
+
+            auto out = PointStore<2, double>::create(
+                path2, Layout::structure_of_arrays, store.size());
+            transform(execution::parallel_policy {2, 64},
+                      store,
+                      out,
+                      [](const Vector<3, float> &p) {
+                          return Vector<2, double> {p[0] + 1.0, p[2] * 2.0};
+                      },
+                      1024);
+            out.sync();
+
+            const PointStore<2, double> reopened(path2);
+            for (size_t i = 0; i < points.size(); ++i)
+            {
+                CHECK(reopened[i][0] == points[i][0] + 1.0);
+                CHECK(reopened[i][1] == points[i][2] * 2.0);
+            }
+        }
+    }
+
+    SUBCASE("transform in place")
+    {
+        for (const Layout layout : layouts)
+        {
+            write(layout);
+
+            PointStore<3, float> read_only(path);
+            CHECK_THROWS_AS(transform(read_only, [](auto p) { return p; }),
+                            std::logic_error);
+
+            PointStore<3, float> store(path, MappedFile::Access::read_write);
+            transform(
+                store, [](const Vector<3, float> &p) { return -p; }, 100);
+            store.sync();
+
+            const PointStore<3, float> reopened(path);
+            CHECK(reopened[4321] == -points[4321]);
+        }
+    }
+
+    SUBCASE("errors")
+    {
+        for (const Layout layout : layouts)
+        {
+            write(layout);
+            const PointStore<3, float> store(path);
+
+            CHECK_THROWS_AS((PointStore<3, double>(path)), FormatError);
+            CHECK_THROWS_AS(for_each_chunk(store, [](size_t, auto) {}, 0),
+                            std::invalid_argument);
+
+            auto empty = PointStore<3, float>::create(path2, layout, 0);
+            CHECK(empty.empty());
+            CHECK_THROWS_AS(centroid(empty), std::invalid_argument);
+            CHECK_THROWS_AS(bounding_box(empty), std::invalid_argument);
+        }
+    }
+}
@@ -0,0 +1,60 @@
+#include "colibra/vector.h"
+#include "doctest.h"
+
+#include <type_traits>
+
+using namespace colibra;
+using doctest::Approx;
+
+TEST_CASE("Promotion policies")
+{
+    constexpr Vector f {1.5f, 2.0f, -3.0f};
+    constexpr Vector d {0.5, 1.0, 2.0};
+
+    SUBCASE("Policy results")
+    {
+        CHECK(std::is_same_v<promoted_t<float, double>, double>);
+        CHECK(std::is_same_v<promoted_t<float, double, promotion::keep_left>,
+                             float>);
+        CHECK(std::is_same_v<
+              promoted_t<float, int, promotion::error_on_widening>,
+              float>);
+    }
+
+    SUBCASE("Default promotes")
+    {
+        constexpr auto scaled = f * 2.0;
+        CHECK(std::is_same_v<std::decay_t<decltype(scaled[0])>, double>);
+        CHECK(std::is_same_v<decltype(f * d), double>);
+    }
+
+    SUBCASE("Keep left")
+    {
+        constexpr auto scaled = multiply<promotion::keep_left>(f, 2.0);
+        CHECK(std::is_same_v<std::decay_t<decltype(scaled)>, Vector<3, float>>);
+        CHECK(scaled[0] == Approx(3.0));
+
+        constexpr auto dot = multiply<promotion::keep_left>(f, d);
+        CHECK(std::is_same_v<std::decay_t<decltype(dot)>, float>);
+        CHECK(dot == Approx(f * d));
+
+        constexpr auto sum = add<promotion::keep_left>(f, d);
+        constexpr auto diff = subtract<promotion::keep_left>(f, d);
+        CHECK(std::is_same_v<std::decay_t<decltype(sum)>, Vector<3, float>>);
+        CHECK(std::is_same_v<std::decay_t<decltype(diff)>, Vector<3, float>>);
+        CHECK(sum[2] == Approx(-1.0));
+        CHECK(diff[2] == Approx(-5.0));
+
+        constexpr Vector i {1, 2, 3};
+        // The scalar is converted to int before multiplying.
+        constexpr auto truncated = multiply<promotion::keep_left>(i, 1.5);
+        CHECK(truncated == i);
+    }
+
+    SUBCASE("Error on widening accepts non-widening operations")
+    {
+        constexpr auto scaled = multiply<promotion::error_on_widening>(f, 2);
+        CHECK(std::is_same_v<std::decay_t<decltype(scaled)>, Vector<3, float>>);
+        CHECK(scaled[1] == Approx(4.0));
+    }
+}
@@ -0,0 +1,180 @@
+#include "colibra/registration.h"
+#include "doctest.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace colibra;
+using doctest::Approx;
+
+namespace {
+
+/// Rotation about a unit axis by angle radians (Rodrigues' formula).
+Matrix<3, 3, double> rotation(const Vector<3, double> &axis, const double angle)
+{
+    const double c = std::cos(angle);
+    const double s = std::sin(angle);
+    const double t = 1.0 - c;
+    const double x = axis[0];
+    const double y = axis[1];
+    const double z = axis[2];
+    return Matrix<3, 3, double> {t * x * x + c,
+                                 t * x * y - s * z,
+                                 t * x * z + s * y,
+                                 t * x * y + s * z,
+                                 t * y * y + c,
+                                 t * y * z - s * x,
+                                 t * x * z - s * y,
+                                 t * y * z + s * x,
+                                 t * z * z + c};
+}
+
+std::vector<Vector<3, double>> random_cloud(const size_t n, std::mt19937 &rng)
+{
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<Vector<3, double>>         points(n);
+    for (auto &p : points)
+    {
+        // An anisotropic box, so the rotation is well determined.
+        p = Vector {4.0 * dist(rng), 2.0 * dist(rng), dist(rng)};
+    }
+    return points;
+}
+
+void check_transform(const RigidTransform<double> &actual,
+                     const RigidTransform<double> &expected,
+                     const double                  epsilon)
+{
+    for (size_t i = 0; i < 3; ++i)
+    {
+        for (size_t j = 0; j < 3; ++j)
+        {
+            CHECK(actual.rotation(i, j)
+                  == Approx(expected.rotation(i, j)).epsilon(epsilon));
+        }
+        CHECK(actual.translation[i]
+              == Approx(expected.translation[i]).epsilon(epsilon));
+    }
+}
+
+} // namespace
+
+TEST_CASE("RigidTransform")
+{
+    const RigidTransform<double> a {rotation(Vector {0.0, 0.0, 1.0}, 0.5),
+                                    Vector {1.0, 2.0, 3.0}};
+    const RigidTransform<double> b {rotation(Vector {1.0, 0.0, 0.0}, -0.3),
+                                    Vector {0.0, -1.0, 0.5}};
+    const Vector<3, double>      p {0.25, -2.0, 4.0};
+
+    const auto composed = (a * b)(p);
+    const auto chained  = a(b(p));
+    const auto back     = a.inverse()(a(p));
+    for (size_t i = 0; i < 3; ++i)
+    {
+        CHECK(composed[i] == Approx(chained[i]));
+        CHECK(back[i] == Approx(p[i]));
+    }
+    check_transform(a * a.inverse(), RigidTransform<double>::identity(), 1e-12);
+}
+
+TEST_CASE("kabsch and umeyama")
+{
+    std::mt19937 rng(5);
+    const auto   source = random_cloud(1000, rng);
+
+    const RigidTransform<double> expected {
+        rotation(Vector {2.0, -1.0, 2.0} * (1.0 / 3.0), 2.5),
+        Vector {10.0, -3.0, 0.5}};
+    std::vector<Vector<3, double>> target(source.size());
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        target[i] = expected(source[i]);
+    }
+
+    SUBCASE("exact correspondences")
+    {
+        check_transform(kabsch(source, Span(target)), expected, 1e-9);
+        const execution::parallel_policy policy {4, 64};
+        check_transform(kabsch(policy, source, Span(target)), expected, 1e-9);
+    }
+
+    SUBCASE("scale")
+    {
+        std::vector<Vector<3, double>> scaled(source.size());
+        for (size_t i = 0; i < source.size(); ++i)
+        {
+            scaled[i] = expected.rotation * source[i] * 0.5
+                        + expected.translation;
+        }
+        const auto similarity = umeyama(source, Span(scaled));
+        CHECK(similarity.scale == Approx(0.5));
+        check_transform(similarity.rigid(), expected, 1e-9);
+        CHECK(umeyama(source, Span(scaled), false).scale == 1.0);
+    }
+
+    SUBCASE("no reflections")
+    {
+        // A mirrored planar cloud is best fit by a reflection, which must be
+        // replaced by the closest proper rotation.
+        std::vector<Vector<3, double>> mirrored(source.size());
+        for (size_t i = 0; i < source.size(); ++i)
+        {
+            mirrored[i] = Vector {-source[i][0], source[i][1], source[i][2]};
+        }
+        const auto fit = kabsch(source, Span(mirrored));
+        CHECK(determinant(fit.rotation) == Approx(1.0));
+    }
+
+    SUBCASE("errors")
+    {
+        const std::vector<Vector<3, double>> empty;
+        CHECK_THROWS_AS(kabsch(empty, Span(empty)), std::invalid_argument);
+        CHECK_THROWS_AS(kabsch(source, Span(target).subspan(1, 10)),
+                        std::invalid_argument);
+    }
+}
+
+TEST_CASE("IcpRegistration")
+{
+    std::mt19937 rng(9);
+    const auto   target = random_cloud(5000, rng);
+
+    const RigidTransform<double> expected {
+        rotation(Vector {0.0, 0.6, 0.8}, 0.1), Vector {0.1, -0.05, 0.02}};
+    const RigidTransform<double> inverse = expected.inverse();
+
+    // The source is the target seen from a displaced frame, with a few
+    // points missing, so not every target point has a partner.
+    std::vector<Vector<3, double>> source;
+    for (size_t i = 0; i < target.size(); i += 2)
+    {
+        source.push_back(inverse(target[i]));
+    }
+
+    IcpRegistration<double> icp {Span(target)};
+    CHECK(icp.tree().size() == target.size());
+
+    const execution::parallel_policy policy {4, 256};
+    const auto result = icp.align(policy, Span(source));
+    CHECK(result.converged);
+    CHECK(result.iterations > 0);
+    CHECK(result.inliers == source.size());
+    CHECK(result.rms < 1e-6);
+    check_transform(result.transform, expected, 1e-6);
+
+    // Starting at the solution converges immediately.
+    const auto warm = icp.align(Span(source), result.transform);
+    CHECK(warm.converged);
+    CHECK(warm.iterations <= 1);
+
+    IcpOptions options;
+    options.max_distance = 1e-9;
+    const auto rejected  = icp.align(Span(source), {}, options);
+    CHECK_FALSE(rejected.converged);
+    CHECK(rejected.inliers == 0);
+
+    CHECK_THROWS_AS(icp.align(Span<const Vector<3, double>>()),
+                    std::invalid_argument);
+}
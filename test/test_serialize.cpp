@@ -0,0 +1,153 @@
+#include "colibra/serialize.h"
+#include "colibra/fixed_point.h"
+#include "colibra/vector.h"
+#include "doctest.h"
+#include "temp_file.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace colibra;
+
+namespace {
+
+/// Overwrite a header field, as in a corrupt or crafted file.
+void patch_header(const std::string &path,
+                  const size_t       offset,
+                  const uint64_t     value)
+{
+    const int fd = ::open(path.c_str(), O_WRONLY);
+    REQUIRE(fd >= 0);
+    CHECK(::pwrite(fd, &value, sizeof(value), static_cast<off_t>(offset))
+          == static_cast<ssize_t>(sizeof(value)));
+    ::close(fd);
+}
+
+} // namespace
+
+TEST_CASE("Binary serialization")
+{
+    std::vector<Vector<3, float>> points;
+    for (int i = 0; i < 1000; ++i)
+    {
+        points.push_back(Vector {i * 1.0f, i * 2.0f, i * -0.5f});
+    }
+    TempFile file;
+
+    SUBCASE("array of structures round trip")
+    {
+        write_binary(file.path, Span<const Vector<3, float>>(points));
+
+        const MappedFile mapped(file.path);
+        const FileHeader header = read_header(mapped);
+        CHECK(header.layout == Layout::array_of_structures);
+        CHECK(header.length == 3);
+        CHECK(header.count == points.size());
+        CHECK(mapped.size() == 64 + points.size() * sizeof(points[0]));
+
+        const auto view = view_vectors<3, float>(mapped);
+        REQUIRE(view.size() == points.size());
+        CHECK(reinterpret_cast<uintptr_t>(view.data()) % 64 == 0);
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            CHECK(view[i] == points[i]);
+        }
+    }
+
+    SUBCASE("structure of arrays round trip")
+    {
+        const Batch<3, float> batch {Span<const Vector<3, float>>(points)};
+        write_binary(file.path, batch);
+
+        const MappedFile mapped(file.path);
+        const auto view = view_batch<3, float>(mapped);
+        REQUIRE(view.size() == points.size());
+        for (size_t d = 0; d < 3; ++d)
+        {
+            CHECK(reinterpret_cast<uintptr_t>(view.component(d)) % 64 == 0);
+        }
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            CHECK(view[i] == points[i]);
+        }
+    }
+
+    SUBCASE("empty data")
+    {
+        write_binary(file.path, Span<const Vector<3, float>>());
+        const MappedFile mapped(file.path);
+        CHECK(view_vectors<3, float>(mapped).size() == 0);
+    }
+
+    SUBCASE("fixed point elements")
+    {
+        const std::vector<Vector<2, q15>> values {
+            Vector {q15(0.5), q15(-0.25)}, Vector {q15(0.125), q15(0.75)}};
+        write_binary(file.path, Span<const Vector<2, q15>>(values));
+
+        const MappedFile mapped(file.path);
+        const auto view = view_vectors<2, q15>(mapped);
+        REQUIRE(view.size() == 2);
+        CHECK(view[1][1] == q15(0.75));
+        CHECK_THROWS_AS((view_vectors<2, int16_t>(mapped)), FormatError);
+    }
+
+    SUBCASE("mismatches are rejected")
+    {
+        write_binary(file.path, Span<const Vector<3, float>>(points));
+        const MappedFile mapped(file.path);
+
+        CHECK_THROWS_AS((view_vectors<2, float>(mapped)), FormatError);
+        CHECK_THROWS_AS((view_vectors<3, double>(mapped)), FormatError);
+        CHECK_THROWS_AS((view_vectors<3, int32_t>(mapped)), FormatError);
+        CHECK_THROWS_AS((view_batch<3, float>(mapped)), FormatError);
+    }
+
+    SUBCASE("truncated and foreign files are rejected")
+    {
+        write_binary(file.path, Span<const Vector<3, float>>(points));
+        REQUIRE(::truncate(file.path.c_str(), 1000) == 0);
+        CHECK_THROWS_AS((view_vectors<3, float>(MappedFile(file.path))),
+                        FormatError);
+
+        REQUIRE(::truncate(file.path.c_str(), 10) == 0);
+        CHECK_THROWS_AS(read_header(MappedFile(file.path)), FormatError);
+    }
+
+    SUBCASE("sizes that overflow are rejected")
+    {
+        // 2^61 Vectors of 3 doubles are 3 * 2^64 bytes, which wraps to 0.
+        const std::vector<Vector<3, double>> doubles(4);
+        write_binary(file.path, Span<const Vector<3, double>>(doubles));
+        const uint64_t huge = uint64_t {1} << 61;
+        patch_header(file.path, offsetof(FileHeader, count), huge);
+        CHECK_THROWS_AS(read_header(MappedFile(file.path)), FormatError);
+        CHECK_THROWS_AS((view_vectors<3, double>(MappedFile(file.path))),
+                        FormatError);
+
+        // Four component arrays of 2^62 bytes.
+        const Batch<4, float> batch(8);
+        write_binary(file.path, batch);
+        patch_header(
+            file.path, offsetof(FileHeader, component_stride), 2 * huge);
+        CHECK_THROWS_AS((view_batch<4, float>(MappedFile(file.path))),
+                        FormatError);
+
+        // A count of 2^62 floats, 2^64 bytes, in arrays of the original
+        // stride.
+        write_binary(file.path, batch);
+        patch_header(file.path, offsetof(FileHeader, count), 2 * huge);
+        CHECK_THROWS_AS((view_batch<4, float>(MappedFile(file.path))),
+                        FormatError);
+    }
+
+    SUBCASE("missing files throw")
+    {
+        CHECK_THROWS_AS(MappedFile(file.path + ".missing"), std::system_error);
+    }
+}
@@ -0,0 +1,218 @@
+#include "colibra/decompositions.h"
+#include "colibra/solvers.h"
+#include "doctest.h"
+
+#include <random>
+#include <vector>
+
+using namespace colibra;
+using doctest::Approx;
+
+namespace {
+
+/// Tridiagonal discrete Laplacian plus a varying diagonal shift: symmetric,
+/// positive definite and badly scaled, so Jacobi preconditioning pays off.
+CsrMatrix<double> laplacian(const size_t n)
+{
+    SparseBuilder<double> builder(n, n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        builder.add(i, i, 2.0 + static_cast<double>(i % 10));
+        if (i > 0)
+        {
+            builder.add(i, i - 1, -1.0);
+            builder.add(i - 1, i, -1.0);
+        }
+    }
+    return builder.build();
+}
+
+std::vector<double> ramp(const size_t n)
+{
+    std::vector<double> v(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        v[i] = static_cast<double>(i % 7) - 3.0;
+    }
+    return v;
+}
+
+} // namespace
+
+TEST_CASE("conjugate_gradient")
+{
+    SUBCASE("fixed size")
+    {
+        const Matrix<3, 3, double> a {
+            4.0, 1.0, 0.0, 1.0, 3.0, 1.0, 0.0, 1.0, 2.0};
+        const Vector<3, double>    b {1.0, 2.0, 3.0};
+        Vector<3, double>          x {};
+
+        const auto result = conjugate_gradient(a, b, x);
+        CHECK(result.converged);
+        CHECK(result.iterations <= 3);
+        const auto expected = cholesky(a).solve(b);
+        for (size_t i = 0; i < 3; ++i)
+        {
+            CHECK(x[i] == Approx(expected[i]));
+        }
+    }
+
+    SUBCASE("sparse and dense agree")
+    {
+        const size_t n = 500;
+        const auto   a = laplacian(n);
+        const auto   b = ramp(n);
+
+        std::vector<double>            x(n);
+        CgWorkspace<CsrMatrix<double>> workspace;
+        const auto                     result =
+            conjugate_gradient(execution::par, a, b, x, workspace);
+        CHECK(result.converged);
+        CHECK(result.residual <= 1e-7);
+
+        const auto residual = a * x;
+        for (size_t i = 0; i < n; ++i)
+        {
+            CHECK(residual[i] == Approx(b[i]).epsilon(1e-6));
+        }
+
+        const auto          dense = a.to_dense();
+        std::vector<double> y(n);
+        CHECK(conjugate_gradient(dense, b, y).converged);
+        for (size_t i = 0; i < n; ++i)
+        {
+            CHECK(y[i] == Approx(x[i]).epsilon(1e-6));
+        }
+
+        // Without preconditioning the same system needs more iterations.
+        SolverOptions options;
+        options.preconditioner = Preconditioner::none;
+        std::fill(y.begin(), y.end(), 0.0);
+        const auto plain = conjugate_gradient(a, b, y, options);
+        CHECK(plain.converged);
+        CHECK(plain.iterations > result.iterations);
+    }
+
+    SUBCASE("workspace reuse")
+    {
+        const auto a = laplacian(100);
+        auto       b = ramp(100);
+
+        std::vector<double>            x(100);
+        CgWorkspace<CsrMatrix<double>> workspace;
+        conjugate_gradient(a, b, x, workspace);
+
+        const double *const residual  = workspace.residual.data();
+        const double *const direction = workspace.direction.data();
+
+        b[3] = 10.0;
+
+        const auto result = conjugate_gradient(a, b, x, workspace);
+        CHECK(result.converged);
+        CHECK(workspace.residual.data() == residual);
+        CHECK(workspace.direction.data() == direction);
+    }
+
+    SUBCASE("edge cases")
+    {
+        const auto          a = laplacian(10);
+        std::vector<double> x(10, 1.0);
+
+        const auto result = conjugate_gradient(a, std::vector<double>(10), x);
+        CHECK(result.converged);
+        CHECK(result.iterations == 0);
+        CHECK(x == std::vector<double>(10));
+
+        SolverOptions options;
+        options.max_iterations = 2;
+        const auto limited     = conjugate_gradient(a, ramp(10), x, options);
+        CHECK_FALSE(limited.converged);
+        CHECK(limited.iterations == 2);
+
+        // Negative definite systems are detected instead of diverging.
+        const Matrix<2, 2, double> negative {-1.0, 0.0, 0.0, -2.0};
+        Vector<2, double>          y {};
+        const Vector<2, double>    ones {1.0, 1.0};
+        CHECK_FALSE(conjugate_gradient(negative, ones, y).converged);
+
+        std::vector<double> small(5);
+        CHECK_THROWS_AS(conjugate_gradient(a, ramp(10), small),
+                        std::invalid_argument);
+        CHECK_THROWS_AS(conjugate_gradient(DMatrix<double>(3, 4),
+                                           std::vector<double>(3),
+                                           small),
+                        std::invalid_argument);
+    }
+}
+
+TEST_CASE("least_squares")
+{
+    SUBCASE("fixed size matches qr")
+    {
+        const Matrix<4, 2, double> a {1.0, 1.0, 1.0, 2.0, 1.0, 3.0, 1.0, 4.0};
+        const Vector<4, double>    b {6.0, 5.0, 7.0, 10.0};
+        Vector<2, double>          x {};
+
+        const auto result = least_squares(a, b, x);
+        CHECK(result.converged);
+        const auto expected = qr(a).solve(b);
+        CHECK(x[0] == Approx(expected[0]));
+        CHECK(x[1] == Approx(expected[1]));
+    }
+
+    SUBCASE("sparse and dense")
+    {
+        // A tall system: the Laplacian stacked on a scaled identity.
+        const size_t          n = 200;
+        SparseBuilder<double> builder(2 * n, n);
+        const auto            top = laplacian(n).to_dense();
+        for (size_t i = 0; i < n; ++i)
+        {
+            for (size_t j = 0; j < n; ++j)
+            {
+                if (top(i, j) != 0.0)
+                {
+                    builder.add(i, j, top(i, j));
+                }
+            }
+            builder.add(n + i, i, 0.5);
+        }
+        const auto a = builder.build();
+        const auto b = ramp(2 * n);
+
+        std::vector<double>                      x(n);
+        LeastSquaresWorkspace<CsrMatrix<double>> workspace;
+        const auto result = least_squares(execution::par, a, b, x, workspace);
+        CHECK(result.converged);
+
+        // At the minimum the residual is orthogonal to the columns of a.
+        std::vector<double> r = a * x;
+        for (size_t i = 0; i < r.size(); ++i)
+        {
+            r[i] = b[i] - r[i];
+        }
+        const auto gradient = a.transpose() * r;
+        for (const double g : gradient)
+        {
+            CHECK(g == Approx(0.0).epsilon(1e-6));
+        }
+
+        const auto          dense = a.to_dense();
+        std::vector<double> y(n);
+        CHECK(least_squares(dense, b, y).converged);
+        for (size_t j = 0; j < n; ++j)
+        {
+            CHECK(y[j] == Approx(x[j]).epsilon(1e-6));
+        }
+
+        const double *const gradient_data = workspace.gradient.data();
+        const double *const residual_data = workspace.residual.data();
+        least_squares(a, b, x, workspace);
+        CHECK(workspace.gradient.data() == gradient_data);
+        CHECK(workspace.residual.data() == residual_data);
+
+        std::vector<double> wrong(n + 1);
+        CHECK_THROWS_AS(least_squares(a, b, wrong), std::invalid_argument);
+    }
+}
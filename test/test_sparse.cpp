@@ -0,0 +1,138 @@
+#include "colibra/sparse.h"
+#include "doctest.h"
+
+#include <random>
+#include <type_traits>
+#include <vector>
+
+using namespace colibra;
+
+namespace {
+
+/// Random matrix with small integer values, so sums are exact regardless of
+/// the order they are computed in.
+CsrMatrix<double> random_sparse(std::mt19937 &rng,
+                                const size_t  rows,
+                                const size_t  cols,
+                                const size_t  entries)
+{
+    std::uniform_int_distribution<size_t> row(0, rows - 1);
+    std::uniform_int_distribution<size_t> col(0, cols - 1);
+    std::uniform_int_distribution<int>    value(-4, 4);
+    SparseBuilder<double>                 builder(rows, cols);
+    for (size_t n = 0; n < entries; ++n)
+    {
+        builder.add(row(rng), col(rng), value(rng));
+    }
+    return builder.build();
+}
+
+} // namespace
+
+TEST_CASE("CsrMatrix")
+{
+    SUBCASE("build")
+    {
+        SparseBuilder<double> builder(3, 4);
+        builder.add(2, 3, 1.0);
+        builder.add(0, 2, 2.0);
+        builder.add(2, 0, 3.0);
+        builder.add(0, 2, 0.5);
+        builder.add(0, 0, 4.0);
+        CHECK(builder.entries() == 5);
+
+        const auto a = builder.build();
+        CHECK(a.rows() == 3);
+        CHECK(a.cols() == 4);
+        CHECK(a.nonzeros() == 4);
+        CHECK(a.offsets()[0] == 0);
+        CHECK(a.offsets()[1] == 2);
+        CHECK(a.offsets()[2] == 2);
+        CHECK(a.offsets()[3] == 4);
+        CHECK(a.columns()[0] == 0);
+        CHECK(a.columns()[1] == 2);
+        CHECK(a.at(0, 2) == 2.5);
+        CHECK(a.at(1, 1) == 0.0);
+        CHECK(a.at(2, 0) == 3.0);
+        CHECK_THROWS_AS((void)a.at(3, 0), std::out_of_range);
+        CHECK_THROWS_AS(builder.add(0, 4, 1.0), std::out_of_range);
+        CHECK_THROWS_AS(builder.add_block(2, 3, Matrix<2, 1, double> {}),
+                        std::out_of_range);
+
+        const auto dense = a.to_dense();
+        CHECK(dense
+              == DMatrix<double>(3, 4, {4, 0, 2.5, 0, 0, 0, 0, 0, 3, 0, 0, 1}));
+        CHECK(a.transpose().to_dense() == dense.transpose());
+    }
+
+    SUBCASE("rebuild reuses storage")
+    {
+        SparseBuilder<float> builder(6, 6);
+        builder.add_block(0, 0, Matrix<3, 3, float>::identity());
+        builder.add_block(3, 3, Matrix<3, 3, float>::identity());
+        auto a = builder.build();
+
+        const size_t *const offsets = a.offsets().data();
+        const float *const  values  = a.values().data();
+        builder.reset(6, 6);
+        builder.add_block(3, 0, Matrix<3, 3, float>::identity() * 2.0f);
+        builder.add_block(0, 3, Matrix<3, 3, float>::identity());
+        builder.build(a);
+        CHECK(a.offsets().data() == offsets);
+        CHECK(a.values().data() == values);
+        CHECK(a.at(4, 1) == 2.0f);
+        CHECK(a.at(1, 1) == 0.0f);
+
+        // The values can be updated in place, keeping the pattern.
+        for (auto &value : a.values())
+        {
+            value = 1.0f;
+        }
+        CHECK(a.at(4, 1) == 1.0f);
+    }
+
+    SUBCASE("spmv")
+    {
+        std::mt19937 rng(3);
+        for (const size_t rows : {1, 10, 1000})
+        {
+            const auto a     = random_sparse(rng, rows, 300, rows * 8);
+            const auto dense = a.to_dense();
+
+            std::vector<double> x(a.cols());
+            std::vector<double> xt(a.rows());
+            for (size_t j = 0; j < x.size(); ++j)
+            {
+                x[j] = static_cast<double>(j % 7) - 3.0;
+            }
+            for (size_t i = 0; i < xt.size(); ++i)
+            {
+                xt[i] = static_cast<double>(i % 5) - 2.0;
+            }
+
+            CHECK(a * x == dense * x);
+
+            const execution::parallel_policy policy {4, 1};
+            std::vector<double>              y(a.rows());
+            spmv(policy, a, Span(x), Span(y));
+            CHECK(y == dense * x);
+
+            const std::vector<double> expected = dense.transpose() * xt;
+            std::vector<double>       yt(a.cols(), 42.0);
+            spmv_transpose(a, Span(xt), Span(yt));
+            CHECK(yt == expected);
+            spmv_transpose(policy, a, Span(xt), Span(yt));
+            CHECK(yt == expected);
+        }
+
+        const auto a = random_sparse(rng, 4, 3, 6);
+        const auto y = a * std::vector<float> {1, 2, 3};
+        static_assert(std::is_same_v<decltype(y), const std::vector<double>>);
+        CHECK_THROWS_AS((void)(a * std::vector<double>(4)),
+                        std::invalid_argument);
+        std::vector<double> x(4);
+        std::vector<double> small(2);
+        CHECK_THROWS_AS(spmv_transpose(a, Span(x), Span(small)),
+                        std::invalid_argument);
+    }
+}
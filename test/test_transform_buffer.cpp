@@ -0,0 +1,198 @@
+#include "colibra/transform_buffer.h"
+#include "doctest.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace colibra;
+using doctest::Approx;
+
+namespace {
+
+/// A frame turning around z at one radian per second while moving along x
+/// at two units per second. Interpolation reproduces it exactly up to
+/// rounding, slerp about a fixed axis and lerp are both linear in time.
+RigidTransform<double> moving_frame(const double time)
+{
+    return RigidTransform<double> {
+        Quaternion<double>::from_axis_angle(Vector {0.0, 0.0, 1.0}, time)
+            .to_matrix(),
+        Vector {2.0 * time, 1.0, -0.5}};
+}
+
+bool near(const RigidTransform<double> &actual,
+          const RigidTransform<double> &expected,
+          const double                  epsilon = 1e-9)
+{
+    for (size_t i = 0; i < 3; ++i)
+    {
+        for (size_t j = 0; j < 3; ++j)
+        {
+            if (std::abs(actual.rotation(i, j) - expected.rotation(i, j))
+                > epsilon)
+            {
+                return false;
+            }
+        }
+        if (std::abs(actual.translation[i] - expected.translation[i])
+            > epsilon)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_CASE("TransformBuffer")
+{
+    TransformBuffer<double> buffer(10);
+    CHECK(buffer.capacity() == 16);
+    CHECK(buffer.empty());
+    CHECK_THROWS_AS((void)buffer.lookup(0.0), std::out_of_range);
+
+    // Samples every 0.1 s from 0 to 1.
+    for (int k = 0; k <= 10; ++k)
+    {
+        buffer.push(0.1 * k, moving_frame(0.1 * k));
+    }
+    CHECK(buffer.size() == 11);
+
+    SUBCASE("lookup")
+    {
+        CHECK(near(buffer.lookup(0.0), moving_frame(0.0)));
+        CHECK(near(buffer.lookup(0.3), moving_frame(0.3)));
+        CHECK(near(buffer.lookup(0.37), moving_frame(0.37)));
+        CHECK(near(buffer.lookup(1.0), moving_frame(1.0)));
+
+        CHECK_THROWS_AS((void)buffer.lookup(-0.01), std::out_of_range);
+        CHECK_THROWS_AS((void)buffer.lookup(1.01), std::out_of_range);
+        CHECK_THROWS_AS(buffer.push(1.0, moving_frame(1.0)),
+                        std::invalid_argument);
+        CHECK_THROWS_AS(TransformBuffer<double>(1), std::invalid_argument);
+    }
+
+    SUBCASE("cursor")
+    {
+        // Increasing times, with steps within and across entries, then a
+        // step back.
+        TransformBuffer<double>::Cursor cursor;
+        for (double time = 0.0; time <= 1.0; time += 0.013)
+        {
+            CHECK(near(buffer.lookup(time, cursor), moving_frame(time)));
+        }
+        CHECK(near(buffer.lookup(0.05, cursor), moving_frame(0.05)));
+        CHECK(near(buffer.lookup(0.95, cursor), moving_frame(0.95)));
+    }
+
+    SUBCASE("overwriting the oldest transforms")
+    {
+        for (int k = 11; k <= 40; ++k)
+        {
+            buffer.push(0.1 * k, moving_frame(0.1 * k));
+        }
+        CHECK(buffer.size() == 16);
+        CHECK_THROWS_AS((void)buffer.lookup(2.0), std::out_of_range);
+        CHECK(near(buffer.lookup(2.5), moving_frame(2.5)));
+        CHECK(near(buffer.lookup(3.97), moving_frame(3.97)));
+    }
+
+    SUBCASE("composition")
+    {
+        TransformBuffer<double> mount(4);
+        const RigidTransform<double> offset {
+            Quaternion<double>::from_axis_angle(Vector {1.0, 0.0, 0.0}, 0.4)
+                .to_matrix(),
+            Vector {0.0, 0.2, 0.3}};
+        mount.push(0.0, offset);
+        mount.push(2.0, offset);
+
+        const Vector<3, double> p {1.0, -2.0, 0.5};
+        const Vector<3, double> actual =
+            lookup_composed(0.45, buffer, mount)(p);
+        const Vector<3, double> expected = moving_frame(0.45)(offset(p));
+        for (size_t d = 0; d < 3; ++d)
+        {
+            CHECK(actual[d] == Approx(expected[d]));
+        }
+    }
+
+    SUBCASE("integer timestamps")
+    {
+        TransformBuffer<float, int64_t> nanoseconds(8);
+        nanoseconds.push(1'000'000'000, RigidTransform<float> {});
+        nanoseconds.push(
+            2'000'000'000,
+            RigidTransform<float> {Matrix<3, 3, float>::identity(),
+                                   Vector {4.0f, 0.0f, 0.0f}});
+        CHECK(nanoseconds.lookup(1'250'000'000).translation[0]
+              == Approx(1.0f));
+    }
+}
+
+TEST_CASE("TransformBuffer concurrent lookups")
+{
+    // A small ring that the producer wraps many times while readers look up
+    // times near its newest entries. Every result must be a correct
+    // interpolation; torn reads would show up as wrong transforms.
+    TransformBuffer<double> buffer(8);
+    const int               pushes = 20000;
+    buffer.push(0.0, moving_frame(0.0));
+
+    std::atomic<int>    pushed {0};
+    std::atomic<bool>   done {false};
+    std::atomic<size_t> wrong {0};
+    std::atomic<size_t> found {0};
+
+    std::vector<std::thread> readers;
+    for (unsigned r = 0; r < 3; ++r)
+    {
+        readers.emplace_back([&, r] {
+            std::mt19937                           rng(r);
+            std::uniform_real_distribution<double> back(0.0, 8e-3);
+            TransformBuffer<double>::Cursor        cursor;
+            while (!done.load(std::memory_order_relaxed))
+            {
+                // Query up to the length of the ring behind the producer, some
+                // of these times get overwritten during the lookup.
+                const double time =
+                    1e-3 * pushed.load(std::memory_order_relaxed) - back(rng);
+                try
+                {
+                    const RigidTransform<double> transform =
+                        buffer.lookup(time, cursor);
+                    found.fetch_add(1, std::memory_order_relaxed);
+                    if (!near(transform, moving_frame(time), 1e-6))
+                    {
+                        wrong.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+                catch (const std::out_of_range &)
+                {
+                }
+            }
+        });
+    }
+
+    for (int k = 1; k <= pushes; ++k)
+    {
+        buffer.push(1e-3 * k, moving_frame(1e-3 * k));
+        pushed.store(k, std::memory_order_relaxed);
+        if (k % 64 == 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+    done = true;
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+    CHECK(wrong.load() == 0);
+    MESSAGE("successful concurrent lookups: " << found.load());
+}
@@ -0,0 +1,115 @@
+#include "colibra/transform_store.h"
+#include "colibra/quaternion.h"
+#include "doctest.h"
+
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace colibra;
+using doctest::Approx;
+
+namespace {
+
+/// The k-th transform published in the tests. Its translation repeats k,
+/// so a mix of two publishes shows up as unequal coefficients.
+RigidTransform<double> published(const int k)
+{
+    const double value = static_cast<double>(k);
+    return RigidTransform<double> {
+        Quaternion<double>::from_axis_angle(Vector {0.0, 1.0, 1.0}, value)
+            .to_matrix(),
+        Vector {value, value, value}};
+}
+
+} // namespace
+
+TEST_CASE("TransformStore")
+{
+    TransformStore<double> store(3);
+    CHECK(store.size() == 3);
+    CHECK(store.version(1) == 0);
+
+    const Vector<3, double> p {1.0, 2.0, 3.0};
+    CHECK(store(1, p) == p);
+
+    store.publish(1, published(5));
+    CHECK(store.version(1) == 1);
+    CHECK(store.version(0) == 0);
+    const Vector<3, double> expected = published(5)(p);
+    const Vector<3, double> actual   = store(1, p);
+    for (size_t d = 0; d < 3; ++d)
+    {
+        CHECK(actual[d] == Approx(expected[d]));
+    }
+
+    store.publish(1, published(6));
+    store.publish(1, published(7));
+    CHECK(store.version(1) == 3);
+    CHECK(store.load(1).translation[0] == 7.0);
+    CHECK(store.load(0).translation[0] == 0.0);
+
+    CHECK_THROWS_AS((void)store.load(3), std::out_of_range);
+    CHECK_THROWS_AS(store.publish(3, published(0)), std::out_of_range);
+}
+
+TEST_CASE("TransformStore concurrent reads")
+{
+    // One writer publishes both frames as fast as it can while readers load
+    // them. Torn reads would show up as unequal translation coefficients or
+    // rotations that do not belong to the translation.
+    TransformStore<double> store(2);
+    const int              publishes = 20000;
+
+    std::atomic<bool>   done {false};
+    std::atomic<size_t> wrong {0};
+
+    std::vector<std::thread> readers;
+    for (size_t r = 0; r < 3; ++r)
+    {
+        readers.emplace_back([&, r] {
+            double last = 0.0;
+            while (!done.load(std::memory_order_relaxed))
+            {
+                const RigidTransform<double> transform = store.load(r % 2);
+                const double k = transform.translation[0];
+                const RigidTransform<double> expected =
+                    published(static_cast<int>(k));
+                bool torn = transform.translation[1] != k
+                            || transform.translation[2] != k || k < last;
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    for (size_t j = 0; j < 3; ++j)
+                    {
+                        torn = torn
+                               || transform.rotation(i, j)
+                                      != expected.rotation(i, j);
+                    }
+                }
+                if (torn)
+                {
+                    wrong.fetch_add(1, std::memory_order_relaxed);
+                }
+                last = k;
+            }
+        });
+    }
+
+    for (int k = 1; k <= publishes; ++k)
+    {
+        store.publish(0, published(k));
+        store.publish(1, published(k));
+        if (k % 64 == 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+    done = true;
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+    CHECK(wrong.load() == 0);
+    CHECK(store.version(0) == publishes);
+}
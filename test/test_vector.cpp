@@ -2,12 +2,28 @@
 #include "colibra/vector.h"
 #include "doctest.h"
 
+#include <cmath>
 #include <complex>
 #include <iostream>
 
 using namespace colibra;
 using doctest::Approx;
 
+namespace {
+
+template<size_t l>
+constexpr Vector<l, int> ramp()
+{
+    Vector<l, int> v;
+    for (size_t i = 0; i < l; ++i)
+    {
+        v[i] = static_cast<int>(i);
+    }
+    return v;
+}
+
+} // namespace
+
 TEST_CASE("Vector")
 {
     constexpr auto b_1 {2.5};
@@ -51,8 +67,8 @@ TEST_CASE("Vector")
     SUBCASE("Complex")
     {
         constexpr Vector c1 {std::complex(10.2, 4.2), std::complex(2.0, 42.0)};
-        const auto c2 = c1 + c1; // operator+ of std::complex is not constexpr
-        const auto c3 = -c1;
+        constexpr auto c2 = c1 + c1;
+        constexpr auto c3 = -c1;
         for (int i = 0; i < c1.rank(); ++i)
         {
             CHECK(c2[i].real() == Approx(c1[i].real() * 2));
@@ -65,6 +81,16 @@ TEST_CASE("Vector")
         constexpr Vector<2, double> n {1.0};
         CHECK(n[1] == Approx(0.0));
         CHECK(n.norm() == Approx(1.0));
+
+        // Sums are evaluated as a tree, ((0 + 1) + (2 + 3)) + ... for small
+        // Vectors and with interleaved partial sums for large ones.
+        static_assert(ramp<5>() * ramp<5>() == 30);
+        static_assert(details::reduce<int, 7>([](size_t i) {
+                          return static_cast<int>(i);
+                      })
+                      == 21);
+        CHECK(ramp<4>().norm() == Approx(std::sqrt(14.0)));
+        CHECK(ramp<100>().norm() == Approx(std::sqrt(328350.0)));
     }
 
     SUBCASE("Multiplication")
@@ -139,6 +165,53 @@ TEST_CASE("Vector")
 
         // constexpr auto breaks {b * "hello"};
     }
+
+    SUBCASE("Large vectors")
+    {
+        // Above COLIBRA_UNROLL_LIMIT the operators run as loops, the results
+        // must not change and stay available at compile time.
+        constexpr auto v = ramp<103>();
+        constexpr auto w = v * 2;
+        static_assert(v.rank() == 103);
+        static_assert(w[102] == 204);
+        static_assert((v + w)[50] == 150);
+        static_assert((w - v)[7] == 7);
+        static_assert((-v)[3] == -3);
+        static_assert(v * v == 102 * 103 * 205 / 6);
+
+        const auto f = ramp<37>() * 0.5f;
+        float      expected {};
+        for (size_t i = 0; i < 37; ++i)
+        {
+            CHECK(f[i] == Approx(0.5 * static_cast<double>(i)));
+            expected += f[i] * f[i];
+        }
+        CHECK(f * f == Approx(expected));
+        CHECK(f.dot(ramp<37>()) == Approx(0.5 * 36 * 37 * 73 / 6));
+    }
+
+    SUBCASE("Cross product")
+    {
+        constexpr Vector x {1, 0, 0};
+        constexpr Vector y {0, 1, 0};
+        static_assert(cross(x, y) == Vector {0, 0, 1});
+        static_assert(cross(y, x) == Vector {0, 0, -1});
+
+        constexpr Vector a {1.5, -2.0, 0.5};
+        constexpr auto   c = cross(a, Vector {2, 1, 3});
+        static_assert(c * a == 0.0);
+        static_assert(c == Vector {-6.5, -3.5, 5.5});
+    }
+
+    SUBCASE("Lerp")
+    {
+        constexpr Vector a {1.0, -2.0, 0.5};
+        constexpr Vector c {0.1, 0.7, 3.0};
+        static_assert(lerp(a, c, 0.0) == a);
+        static_assert(lerp(a, c, 1.0) == c);
+        static_assert(lerp(Vector {0.0f, 2.0f}, Vector {4.0f, 0.0f}, 0.25)
+                      == Vector {1.0f, 1.5f});
+    }
 }
 
 // TEST_CASE("Sparse Vector creation")